@@ -0,0 +1,99 @@
+/**
+ * @file ethsimulator.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host side loopback model of the Ethernet MAC on the ETH stub.
+ */
+
+#ifndef ETHSIMULATOR_HPP_
+#define ETHSIMULATOR_HPP_
+
+#include "murasaki.hpp"
+
+// Preamble, start of the frame and the inter frame gap on the wire [byte].
+#define ETH_SIMULATOR_OVERHEAD 20
+// Frame check sequence appended by the MAC [byte].
+#define ETH_SIMULATOR_FCS_SIZE 4
+// Shortest frame on the wire, including the FCS. The MAC pads the shorter frame [byte].
+#define ETH_SIMULATOR_MIN_FRAME 64
+
+namespace murasaki {
+
+/**
+ * @brief Tx DMA, MAC and wire, which takes the frames from the Tx descriptors of the ETH stub.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The ETH stub of the host build keeps the frames in the Tx descriptors of the handle, as the real HAL does.
+ * This class plays the DMA and the MAC. It takes the frame of the next owned descriptor, inserts the IPv4
+ * header checksum and the UDP checksum as the checksum control of the descriptor says, and clears the OWN
+ * bit. The frame goes to the caller, as the receiver on the other side of the cable :
+ *
+ * @code
+ * HAL_ETH_Init(&heth);
+ * murasaki::EthTelemetry *telemetry = new murasaki::EthTelemetry(&heth, &TxConfig, 0xC0A800C8, 0xFFFFFFFF, 5555);
+ * telemetry->Start();
+ *
+ * murasaki::EthSimulator *wire = new murasaki::EthSimulator(&heth);
+ * size = wire->Receive(frame, sizeof(frame), 100);
+ * @endcode
+ *
+ * The descriptors are taken in the critical section, as the DMA runs in parallel with the tasks.
+ *
+ * The wire time is simulated. Each frame takes the padded frame, the FCS, the preamble and the inter frame
+ * gap at the speed of the MACCR. The receiver doesn't wait for the wire time. When no descriptor is owned,
+ * the receiver yields to the tasks, and tries again.
+ */
+class EthSimulator
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param heth The ETH handle. Initialized by HAL_ETH_Init().
+     */
+    EthSimulator(ETH_HandleTypeDef *heth);
+
+    /**
+     * @brief Take a frame from the Tx descriptors.
+     * @param frame Buffer to store the frame. Without the FCS.
+     * @param size Size of the buffer. The longer frame is truncated.
+     * @param timeout_ms Wait for the frame [mS].
+     * @return Length of the frame [byte]. 0 if time out.
+     */
+    unsigned int Receive(uint8_t *frame, unsigned int size, unsigned int timeout_ms);
+
+    /**
+     * @brief Accumulated simulated wire time of the frames [nS].
+     */
+    uint64_t GetWireTime() const;
+    /**
+     * @brief Number of the frames.
+     */
+    unsigned int GetFrameCount() const;
+    /**
+     * @brief Number of the bytes of the frames, without the FCS and the padding.
+     */
+    uint64_t GetByteCount() const;
+    /**
+     * @brief Clear the wire time and the counters.
+     */
+    void ResetStatistics();
+
+ private:
+    // Checksum insertion of the MAC, by the checksum control of the descriptor.
+    static void InsertChecksum(uint8_t *frame, unsigned int length, uint32_t cic);
+    static uint32_t Sum(const uint8_t *data, unsigned int length, uint32_t sum);
+    static uint16_t Fold(uint32_t sum);
+
+    ETH_HandleTypeDef *const heth_;
+    // Descriptor which the DMA reads next.
+    unsigned int index_;
+
+    uint64_t wire_time_;
+    unsigned int frames_;
+    uint64_t bytes_;
+};
+
+} /* namespace murasaki */
+
+#endif /* ETHSIMULATOR_HPP_ */
@@ -0,0 +1,236 @@
+/**
+ * @file i2csimulator.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host side I2C bus simulator with virtual slave devices.
+ */
+
+#ifndef I2CSIMULATOR_HPP_
+#define I2CSIMULATOR_HPP_
+
+#include "murasaki.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Base class of the virtual I2C slave device.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * A derived class implements the data phase by OnWrite() and OnRead(). This base class provides
+ * the scripting of the bus behavior :
+ * @li SetAddressNak() : the device doesn't respond to its address.
+ * @li SetDataNakAfter() : the device NAKs the data byte after the given number of bytes.
+ * @li SetStretch() : the device stretches SCL on each byte.
+ * @li InjectFault() : the next transactions fail with the given status.
+ */
+class I2cVirtualSlave
+{
+ public:
+    I2cVirtualSlave();
+    virtual ~I2cVirtualSlave();
+
+    /**
+     * @brief Called when the address matches.
+     * @param read true if the master reads.
+     * @details
+     * Called before the address phase is acknowledged. Override to catch the START condition.
+     */
+    virtual void OnStart(bool read);
+    /**
+     * @brief Called for each byte written by the master.
+     * @param data The byte from the master.
+     * @return true to ACK. false to NAK.
+     */
+    virtual bool OnWrite(uint8_t data) = 0;
+    /**
+     * @brief Called for each byte read by the master.
+     * @return The byte to the master.
+     */
+    virtual uint8_t OnRead() = 0;
+    /**
+     * @brief Called at the STOP condition.
+     */
+    virtual void OnStop();
+
+    /**
+     * @brief Make the device not to respond to its address.
+     * @param nak true to NAK the address.
+     */
+    void SetAddressNak(bool nak);
+    /**
+     * @brief NAK the data byte after the given number of bytes in a write transaction.
+     * @param bytes Number of the bytes to accept. Negative to disable.
+     */
+    void SetDataNakAfter(int bytes);
+    /**
+     * @brief Clock stretching of the device.
+     * @param ns_per_byte Time the device holds SCL low on each byte [nS].
+     */
+    void SetStretch(unsigned int ns_per_byte);
+    /**
+     * @brief Make the next transactions fail.
+     * @param status The status to return. For example, ki2csBussError.
+     * @param count Number of the transactions to fail.
+     */
+    void InjectFault(I2cStatus status, unsigned int count = 1);
+
+ private:
+    friend class I2cSimulator;
+
+    bool address_nak_;
+    int data_nak_after_;
+    unsigned int stretch_ns_;
+    I2cStatus fault_status_;
+    unsigned int fault_count_;
+};
+
+/**
+ * @brief Virtual I2C device with the 8bit register file.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The first byte of the write transaction sets the register pointer. The following bytes are
+ * written to the registers. The read transaction reads the registers from the pointer.
+ * The pointer is incremented on each data byte. It wraps around at num_registers.
+ */
+class I2cRegisterFileSlave : public I2cVirtualSlave
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param num_registers Number of the registers. Up to 256.
+     */
+    I2cRegisterFileSlave(unsigned int num_registers = 256);
+    virtual ~I2cRegisterFileSlave();
+
+    virtual void OnStart(bool read);
+    virtual bool OnWrite(uint8_t data);
+    virtual uint8_t OnRead();
+
+    /**
+     * @brief Set the register value from the test code. No bus access is simulated.
+     */
+    void SetRegister(unsigned int reg, uint8_t value);
+    /**
+     * @brief Get the register value from the test code. No bus access is simulated.
+     */
+    uint8_t GetRegister(unsigned int reg) const;
+
+ private:
+    const unsigned int num_registers_;
+    uint8_t registers_[256];
+    unsigned int pointer_;
+    bool pointer_phase_;   // The next written byte is the register pointer.
+};
+
+/**
+ * @brief I2C master which talks to the virtual slaves.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * A @ref I2cMasterStrategy for the host build. The application code and the platform classes
+ * like @ref I2cScanner and @ref I2cRegisterMap run on Linux without the real sensors.
+ *
+ * The transfer is completed synchronously. The bus time is simulated from the bus speed and
+ * the clock stretching of the slaves. It is not spent in the real time. GetBusTime() returns
+ * the accumulated simulated time, to estimate the latency on the real bus.
+ *
+ * @code
+ * murasaki::I2cSimulator * bus = new murasaki::I2cSimulator(murasaki::kibsFast);
+ * murasaki::I2cRegisterFileSlave * sensor = new murasaki::I2cRegisterFileSlave();
+ *
+ * bus->Attach(0x48, sensor);
+ * sensor->SetRegister(0x00, 0x5A);
+ * sensor->SetStretch(2000);   // 2uS on each byte.
+ * @endcode
+ */
+class I2cSimulator : public I2cMasterStrategy
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param bus_speed SCL frequency [Hz] to simulate the bus time.
+     */
+    I2cSimulator(unsigned int bus_speed = 100000);
+    virtual ~I2cSimulator();
+
+    /**
+     * @brief Connect a virtual slave to the bus.
+     * @param addrs 7bit address.
+     * @param slave The device. nullptr to disconnect.
+     */
+    void Attach(unsigned int addrs, I2cVirtualSlave *slave);
+
+    virtual I2cStatus Transmit(
+                               unsigned int addrs,
+                               const uint8_t *tx_data,
+                               unsigned int tx_size,
+                               unsigned int *transfered_count = nullptr,
+                               unsigned int timeout_ms = kwmsIndefinitely);
+    virtual I2cStatus Receive(
+                              unsigned int addrs,
+                              uint8_t *rx_data,
+                              unsigned int rx_size,
+                              unsigned int *transfered_count = nullptr,
+                              unsigned int timeout_ms = kwmsIndefinitely);
+    virtual I2cStatus TransmitThenReceive(
+                                          unsigned int addrs,
+                                          const uint8_t *tx_data,
+                                          unsigned int tx_size,
+                                          uint8_t *rx_data,
+                                          unsigned int rx_size,
+                                          unsigned int *tx_transfered_count = nullptr,
+                                          unsigned int *rx_transfered_count = nullptr,
+                                          unsigned int timeout_ms = kwmsIndefinitely);
+    /**
+     * @brief Not used. The simulator has no interrupt.
+     */
+    virtual bool TransmitCompleteCallback(void *ptr);
+    /**
+     * @brief Not used. The simulator has no interrupt.
+     */
+    virtual bool ReceiveCompleteCallback(void *ptr);
+    /**
+     * @brief Not used. The simulator has no interrupt.
+     */
+    virtual bool HandleError(void *ptr);
+
+    /**
+     * @brief Accumulated simulated bus time [nS].
+     */
+    uint64_t GetBusTime() const;
+    /**
+     * @brief Number of the transactions. A TransmitThenReceive() is counted as one.
+     */
+    unsigned int GetTransactionCount() const;
+    /**
+     * @brief Clear the bus time and the transaction count.
+     */
+    void ResetStatistics();
+
+ private:
+    // One START - STOP transaction. The phases with zero size are skipped except the address only write.
+    I2cStatus DoTransaction(
+                            unsigned int addrs,
+                            const uint8_t *tx_data,
+                            unsigned int tx_size,
+                            uint8_t *rx_data,
+                            unsigned int rx_size,
+                            bool has_rx_phase,
+                            unsigned int *tx_transfered_count,
+                            unsigned int *rx_transfered_count,
+                            unsigned int timeout_ms);
+    uint64_t ByteTime(const I2cVirtualSlave *slave) const;
+
+    virtual void* GetPeripheralHandle();
+
+    const unsigned int bus_speed_;
+    CriticalSection *const critical_section_;
+    I2cVirtualSlave *slaves_[128];
+
+    uint64_t bus_time_ns_;
+    unsigned int transactions_;
+};
+
+} /* namespace murasaki */
+
+#endif /* I2CSIMULATOR_HPP_ */
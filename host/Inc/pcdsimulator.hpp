@@ -0,0 +1,190 @@
+/**
+ * @file pcdsimulator.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host side USB host model on the PCD stub.
+ */
+
+#ifndef PCDSIMULATOR_HPP_
+#define PCDSIMULATOR_HPP_
+
+#include "murasaki.hpp"
+
+// Bulk packets of 64 bytes in a full speed frame. Around 1.2MB/s.
+#define PCD_SIMULATOR_PACKETS_PER_FRAME 19
+// Wait for the answer of the device on the control transfer [mS].
+#define PCD_SIMULATOR_CONTROL_TIMEOUT 100
+
+namespace murasaki {
+
+/**
+ * @brief USB host which talks to the device stack through the PCD stub.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The PCD stub of the host build keeps the transfers of the device in the endpoints of the handle,
+ * as the real HAL does. This class plays the host side of the bus. It sends the tokens to the
+ * endpoints, moves the data, and calls the registered callbacks of the handle. The device stack
+ * like @ref UsbCdcAcm runs on Linux without the USB hardware :
+ *
+ * @code
+ * HAL_PCD_Init(&hpcd);
+ * murasaki::UsbCdcAcm *usb = new murasaki::UsbCdcAcm(&hpcd);
+ * usb->Start();
+ *
+ * murasaki::PcdSimulator *host = new murasaki::PcdSimulator(&hpcd);
+ * host->Enumerate();
+ * host->SetControlLineState(true);   // Open the port, as a terminal does.
+ * received = host->BulkIn(buffer, sizeof(buffer), 100);
+ * @endcode
+ *
+ * The callbacks are called in the critical section, as the interrupt masks the task.
+ *
+ * The bus time is simulated. Each bulk packet takes 1/PCD_SIMULATOR_PACKETS_PER_FRAME of a 1mS frame.
+ * The host doesn't wait for the bus time. When the endpoint has no data, the host yields to the device
+ * tasks, and tries again. GetNakCount() counts them. On the real bus, the device has around 50uS per
+ * packet to refill the endpoint.
+ */
+class PcdSimulator
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param hpcd The PCD handle of the device. Initialized by HAL_PCD_Init().
+     */
+    PcdSimulator(PCD_HandleTypeDef *hpcd);
+
+    /**
+     * @brief Check the pull up of the device.
+     * @return true after HAL_PCD_Start().
+     */
+    bool IsConnected() const;
+
+    /**
+     * @brief Bus reset. The device goes to the default state.
+     */
+    void Reset();
+
+    /**
+     * @brief Unplug the cable.
+     */
+    void Disconnect();
+
+    /**
+     * @brief Reset the bus, read the descriptors, set the address and the configuration 1.
+     * @return true if success. The bulk endpoints are taken from the configuration descriptor.
+     */
+    bool Enumerate();
+
+    /**
+     * @brief Control transfer on the EP0.
+     * @param request_type bmRequestType. The bit 7 is the direction of the data stage.
+     * @param request bRequest.
+     * @param value wValue.
+     * @param index wIndex.
+     * @param data Data of the data stage. Can be nullptr if length is 0.
+     * @param length wLength.
+     * @param transfered_count Number of the bytes of the data stage. Can be nullptr.
+     * @return true if success. false on the stall or the time out.
+     */
+    bool ControlTransfer(
+                         uint8_t request_type,
+                         uint8_t request,
+                         uint16_t value,
+                         uint16_t index,
+                         uint8_t *data,
+                         uint16_t length,
+                         unsigned int *transfered_count = nullptr);
+
+    /**
+     * @brief CDC SET_LINE_CODING. 8N1.
+     * @param baud_rate Baud rate [baud].
+     * @return true if success.
+     */
+    bool SetLineCoding(unsigned int baud_rate);
+
+    /**
+     * @brief CDC SET_CONTROL_LINE_STATE.
+     * @param dtr true to assert DTR and RTS, as a terminal opens the port.
+     * @return true if success.
+     */
+    bool SetControlLineState(bool dtr);
+
+    /**
+     * @brief Bulk IN transfer.
+     * @param data Buffer to store the data. The size must be a multiple of the packet.
+     * @param size Size of the buffer.
+     * @param timeout_ms Upper bound of the wait for each packet [mS].
+     * @return Number of the received bytes. The transfer ends by a short packet or by the size.
+     */
+    unsigned int BulkIn(uint8_t *data, unsigned int size, unsigned int timeout_ms);
+
+    /**
+     * @brief Bulk OUT transfer.
+     * @param data Data to send.
+     * @param size Number of the bytes.
+     * @param timeout_ms Upper bound of the wait for each packet [mS].
+     * @return Number of the sent bytes.
+     */
+    unsigned int BulkOut(const uint8_t *data, unsigned int size, unsigned int timeout_ms);
+
+    /**
+     * @brief Device descriptor read by Enumerate().
+     */
+    const uint8_t* GetDeviceDescriptor() const;
+
+    /**
+     * @brief Accumulated simulated bus time of the bulk transfers [nS].
+     */
+    uint64_t GetBusTime() const;
+    /**
+     * @brief Number of the bulk packets, including the zero length packets.
+     */
+    unsigned int GetPacketCount() const;
+    /**
+     * @brief Number of the bulk tokens which found no data or no buffer.
+     */
+    unsigned int GetNakCount() const;
+    /**
+     * @brief Clear the bus time and the counters.
+     */
+    void ResetStatistics();
+
+ private:
+    enum PacketResult
+    {
+        kprAck,
+        kprNak,
+        kprStall
+    };
+
+    // Packet level. Called in the critical section.
+    PacketResult InToken(uint8_t ep_num, uint8_t *data, unsigned int *length);
+    PacketResult OutToken(uint8_t ep_num, const uint8_t *data, unsigned int length);
+    void SetupToken(const uint8_t *setup);
+
+    // Repeat the token while NAK, until the deadline.
+    PacketResult WaitIn(uint8_t ep_num, uint8_t *data, unsigned int *length, uint32_t start, unsigned int timeout_ms);
+    PacketResult WaitOut(
+                         uint8_t ep_num,
+                         const uint8_t *data,
+                         unsigned int length,
+                         uint32_t start,
+                         unsigned int timeout_ms);
+    void CountPacket();
+
+    PCD_HandleTypeDef *const hpcd_;
+    uint8_t device_descriptor_[18];
+    uint8_t data_in_;
+    uint8_t data_out_;
+    unsigned int max_packet_;
+
+    uint64_t frames_;
+    unsigned int packets_;
+    unsigned int packets_in_frame_;
+    unsigned int naks_;
+};
+
+} /* namespace murasaki */
+
+#endif /* PCDSIMULATOR_HPP_ */
@@ -0,0 +1,937 @@
+/**
+ * @file stm32f4xx_hal.h
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Stub of the STM32 HAL for the host build.
+ * @details
+ * The host build compiles the nucleo-f446-64 sources with this header instead of the real HAL.
+ * Only the definitions referred by the platform layer and the murasaki library are provided.
+ * The peripherals are modeled in stm32f4xx_hal_stub.cpp :
+ *
+ * @li GPIO : In memory port registers. The written value is read back from IDR.
+ * @li UART : Transmitted data goes to the standard output. Received data comes from the standard input.
+ * @li I2C : Routed to the @ref murasaki::I2cSimulator given by HostAttachI2c().
+ * @li EXTI : The callback is raised by HostPressButton().
+ * @li PCD : The transfers are kept in the handle. The @ref murasaki::PcdSimulator plays the USB host.
+ * @li ETH : The Tx descriptors of the H7 HAL are kept in the handle. The @ref murasaki::EthSimulator plays the
+ *     DMA, the MAC and the wire.
+ * @li CRC : The data register computes the CRC on the write. The programmable unit of the F0, G0, H7 and others.
+ *     The fixed CRC-32 unit of the F4, with HOST_CRC_FIXED_POLYNOMIAL.
+ *
+ * The interrupt callbacks are called from the "host isr" task, or from the HAL function itself.
+ * There is no interrupt context on the host.
+ */
+
+#ifndef STM32F4XX_HAL_H_
+#define STM32F4XX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HAL_MODULE_ENABLED
+#define HAL_I2C_MODULE_ENABLED
+#define HAL_UART_MODULE_ENABLED
+#define HAL_GPIO_MODULE_ENABLED
+#define HAL_EXTI_MODULE_ENABLED
+#define HAL_CORTEX_MODULE_ENABLED
+#define HAL_PCD_MODULE_ENABLED
+#define HAL_ETH_MODULE_ENABLED
+
+// The HAL calls the function pointers in the handle, as the hal_conf.h of the projects.
+#define USE_HAL_I2C_REGISTER_CALLBACKS 1U
+#define USE_HAL_UART_REGISTER_CALLBACKS 1U
+#define USE_HAL_PCD_REGISTER_CALLBACKS 1U
+
+#define __IO volatile
+#define __I volatile const
+#define __O volatile
+
+#define SET_BIT(REG, BIT)     ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)   ((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)    ((REG) & (BIT))
+#define WRITE_REG(REG, VAL)   ((REG) = (VAL))
+#define READ_REG(REG)         ((REG))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)  WRITE_REG((REG), (((READ_REG(REG)) & (~(CLEARMASK))) | (SETMASK)))
+
+/* ------------------------------- HAL common ----------------------------- */
+
+typedef enum
+{
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+    HAL_UNLOCKED = 0x00U,
+    HAL_LOCKED = 0x01U
+} HAL_LockTypeDef;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+extern uint32_t SystemCoreClock;
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_GetUIDw0(void);
+uint32_t HAL_GetUIDw1(void);
+uint32_t HAL_GetUIDw2(void);
+
+/* ------------------------------- Cortex-M4 ------------------------------ */
+
+#define __CORTEX_M (4U)
+#define __NVIC_PRIO_BITS 4U
+
+typedef enum
+{
+    NonMaskableInt_IRQn = -14,
+    HardFault_IRQn = -13,
+    MemoryManagement_IRQn = -12,
+    BusFault_IRQn = -11,
+    UsageFault_IRQn = -10,
+    SVCall_IRQn = -5,
+    DebugMonitor_IRQn = -4,
+    PendSV_IRQn = -2,
+    SysTick_IRQn = -1,
+    EXTI0_IRQn = 6,
+    EXTI1_IRQn = 7,
+    EXTI2_IRQn = 8,
+    EXTI3_IRQn = 9,
+    EXTI4_IRQn = 10,
+    EXTI9_5_IRQn = 23,
+    I2C1_EV_IRQn = 31,
+    I2C1_ER_IRQn = 32,
+    USART2_IRQn = 38,
+    EXTI15_10_IRQn = 40,
+    OTG_FS_IRQn = 67
+} IRQn_Type;
+
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+    __IO uint32_t CPICNT;
+    __IO uint32_t EXCCNT;
+    __IO uint32_t SLEEPCNT;
+    __IO uint32_t LSUCNT;
+    __IO uint32_t FOLDCNT;
+    __IO uint32_t PCSR;
+    __IO uint32_t LAR;
+} DWT_Type;
+
+typedef struct
+{
+    __IO uint32_t DHCSR;
+    __O uint32_t DCRSR;
+    __IO uint32_t DCRDR;
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+    __I uint32_t CALIB;
+} SysTick_Type;
+
+extern DWT_Type host_dwt;
+extern CoreDebug_Type host_core_debug;
+extern SysTick_Type host_systick;
+
+#define DWT (&host_dwt)
+#define CoreDebug (&host_core_debug)
+#define SysTick (&host_systick)
+
+#define DWT_CTRL_CYCCNTENA_Msk (1UL)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+// The host is always in the thread mode and never masks the interrupt.
+static inline uint32_t __get_IPSR(void)
+{
+    return 0;
+}
+static inline uint32_t __get_PRIMASK(void)
+{
+    return 0;
+}
+static inline void __set_PRIMASK(uint32_t priMask)
+{
+    (void) priMask;
+}
+static inline void __disable_irq(void)
+{
+}
+static inline void __enable_irq(void)
+{
+}
+static inline void __NOP(void)
+{
+}
+static inline void __DSB(void)
+{
+}
+static inline void __ISB(void)
+{
+}
+static inline uint32_t __REV(uint32_t value)
+{
+    return __builtin_bswap32(value);
+}
+static inline uint32_t __RBIT(uint32_t value)
+{
+    uint32_t result = 0;
+
+    for (int bit = 0; bit < 32; bit++, value >>= 1)
+        result = (result << 1) | (value & 1);
+    return result;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_SystemReset(void);
+
+/* --------------------------------- RCC ---------------------------------- */
+
+uint32_t HAL_RCC_GetSysClockFreq(void);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+
+#define __HAL_RCC_CRC_CLK_ENABLE() do { } while (0)
+
+/* --------------------------------- GPIO --------------------------------- */
+
+typedef struct
+{
+    __IO uint32_t MODER;
+    __IO uint32_t OTYPER;
+    __IO uint32_t OSPEEDR;
+    __IO uint32_t PUPDR;
+    __IO uint32_t IDR;
+    __IO uint32_t ODR;
+    __IO uint32_t BSRR;
+    __IO uint32_t LCKR;
+    __IO uint32_t AFR[2];
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef host_gpio[8];
+
+#define GPIOA (&host_gpio[0])
+#define GPIOB (&host_gpio[1])
+#define GPIOC (&host_gpio[2])
+#define GPIOD (&host_gpio[3])
+#define GPIOE (&host_gpio[4])
+#define GPIOF (&host_gpio[5])
+#define GPIOG (&host_gpio[6])
+#define GPIOH (&host_gpio[7])
+
+typedef struct
+{
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+#define GPIO_PIN_0   ((uint16_t)0x0001)
+#define GPIO_PIN_1   ((uint16_t)0x0002)
+#define GPIO_PIN_2   ((uint16_t)0x0004)
+#define GPIO_PIN_3   ((uint16_t)0x0008)
+#define GPIO_PIN_4   ((uint16_t)0x0010)
+#define GPIO_PIN_5   ((uint16_t)0x0020)
+#define GPIO_PIN_6   ((uint16_t)0x0040)
+#define GPIO_PIN_7   ((uint16_t)0x0080)
+#define GPIO_PIN_8   ((uint16_t)0x0100)
+#define GPIO_PIN_9   ((uint16_t)0x0200)
+#define GPIO_PIN_10  ((uint16_t)0x0400)
+#define GPIO_PIN_11  ((uint16_t)0x0800)
+#define GPIO_PIN_12  ((uint16_t)0x1000)
+#define GPIO_PIN_13  ((uint16_t)0x2000)
+#define GPIO_PIN_14  ((uint16_t)0x4000)
+#define GPIO_PIN_15  ((uint16_t)0x8000)
+#define GPIO_PIN_All ((uint16_t)0xFFFF)
+
+#define GPIO_MODE_INPUT        0x00000000U
+#define GPIO_MODE_OUTPUT_PP    0x00000001U
+#define GPIO_MODE_OUTPUT_OD    0x00000011U
+#define GPIO_MODE_AF_PP        0x00000002U
+#define GPIO_MODE_AF_OD        0x00000012U
+#define GPIO_MODE_ANALOG       0x00000003U
+#define GPIO_MODE_IT_RISING    0x10110000U
+#define GPIO_MODE_IT_FALLING   0x10210000U
+
+#define GPIO_NOPULL   0x00000000U
+#define GPIO_PULLUP   0x00000001U
+#define GPIO_PULLDOWN 0x00000002U
+
+#define GPIO_SPEED_FREQ_LOW       0x00000000U
+#define GPIO_SPEED_FREQ_MEDIUM    0x00000001U
+#define GPIO_SPEED_FREQ_HIGH      0x00000002U
+#define GPIO_SPEED_FREQ_VERY_HIGH 0x00000003U
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_IRQHandler(uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+/* --------------------------------- EXTI --------------------------------- */
+
+typedef struct
+{
+    uint32_t Line;
+    void (*PendingCallback)(void);
+} EXTI_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_EXTI_GetHandle(EXTI_HandleTypeDef *hexti, uint32_t ExtiLine);
+void HAL_EXTI_ClearPending(EXTI_HandleTypeDef *hexti, uint32_t Edge);
+void HAL_EXTI_GenerateSWI(EXTI_HandleTypeDef *hexti);
+
+/* --------------------------------- DMA ---------------------------------- */
+
+typedef struct
+{
+    void *Instance;
+    void *Parent;
+} DMA_HandleTypeDef;
+
+#define __HAL_DMA_GET_COUNTER(__HANDLE__) (0U)
+
+/* --------------------------------- UART --------------------------------- */
+
+typedef struct
+{
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+    __IO uint32_t BRR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t CR3;
+    __IO uint32_t GTPR;
+} USART_TypeDef;
+
+extern USART_TypeDef host_usart[3];
+
+#define USART1 (&host_usart[0])
+#define USART2 (&host_usart[1])
+#define USART3 (&host_usart[2])
+
+typedef struct
+{
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef uint32_t HAL_UART_StateTypeDef;
+typedef uint32_t HAL_UART_RxTypeTypeDef;
+
+#define HAL_UART_STATE_RESET    0x00000000U
+#define HAL_UART_STATE_READY    0x00000020U
+#define HAL_UART_STATE_BUSY     0x00000024U
+#define HAL_UART_STATE_BUSY_TX  0x00000021U
+#define HAL_UART_STATE_BUSY_RX  0x00000022U
+
+#define HAL_UART_RECEPTION_STANDARD 0x00000000U
+#define HAL_UART_RECEPTION_TOIDLE   0x00000001U
+
+#define HAL_UART_ERROR_NONE 0x00000000U
+#define HAL_UART_ERROR_PE   0x00000001U
+#define HAL_UART_ERROR_NE   0x00000002U
+#define HAL_UART_ERROR_FE   0x00000004U
+#define HAL_UART_ERROR_ORE  0x00000008U
+#define HAL_UART_ERROR_DMA  0x00000010U
+
+#define UART_WORDLENGTH_8B    0x00000000U
+#define UART_STOPBITS_1       0x00000000U
+#define UART_PARITY_NONE      0x00000000U
+#define UART_MODE_TX_RX       0x0000000CU
+#define UART_HWCONTROL_NONE   0x00000000U
+#define UART_OVERSAMPLING_16  0x00000000U
+#define UART_OVERSAMPLING_8   0x00008000U
+
+struct __UART_HandleTypeDef;
+typedef void (*pUART_CallbackTypeDef)(struct __UART_HandleTypeDef *huart);
+typedef void (*pUART_RxEventCallbackTypeDef)(struct __UART_HandleTypeDef *huart, uint16_t Pos);
+
+typedef enum
+{
+    HAL_UART_TX_COMPLETE_CB_ID = 0x01U,
+    HAL_UART_RX_COMPLETE_CB_ID = 0x03U,
+    HAL_UART_ERROR_CB_ID = 0x04U,
+    HAL_UART_ABORT_COMPLETE_CB_ID = 0x05U,
+    HAL_UART_ABORT_TRANSMIT_COMPLETE_CB_ID = 0x06U,
+    HAL_UART_ABORT_RECEIVE_COMPLETE_CB_ID = 0x07U
+} HAL_UART_CallbackIDTypeDef;
+
+typedef struct __UART_HandleTypeDef
+{
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+    uint8_t *pTxBuffPtr;
+    uint16_t TxXferSize;
+    __IO uint16_t TxXferCount;
+    uint8_t *pRxBuffPtr;
+    uint16_t RxXferSize;
+    __IO uint16_t RxXferCount;
+    __IO HAL_UART_RxTypeTypeDef ReceptionType;
+    DMA_HandleTypeDef *hdmatx;
+    DMA_HandleTypeDef *hdmarx;
+    HAL_LockTypeDef Lock;
+    __IO HAL_UART_StateTypeDef gState;
+    __IO HAL_UART_StateTypeDef RxState;
+    __IO uint32_t ErrorCode;
+    pUART_CallbackTypeDef TxCpltCallback;
+    pUART_CallbackTypeDef RxCpltCallback;
+    pUART_CallbackTypeDef ErrorCallback;
+    pUART_CallbackTypeDef AbortCpltCallback;
+    pUART_CallbackTypeDef AbortTransmitCpltCallback;
+    pUART_CallbackTypeDef AbortReceiveCpltCallback;
+    pUART_RxEventCallbackTypeDef RxEventCallback;
+} UART_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Abort_IT(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_AbortTransmit_IT(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_AbortReceive_IT(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_DMAStop(UART_HandleTypeDef *huart);
+HAL_UART_StateTypeDef HAL_UART_GetState(UART_HandleTypeDef *huart);
+uint32_t HAL_UART_GetError(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_RegisterCallback(UART_HandleTypeDef *huart, HAL_UART_CallbackIDTypeDef CallbackID,
+                                            pUART_CallbackTypeDef pCallback);
+HAL_StatusTypeDef HAL_UART_UnRegisterCallback(UART_HandleTypeDef *huart, HAL_UART_CallbackIDTypeDef CallbackID);
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+void HAL_UART_AbortCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_AbortTransmitCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_AbortReceiveCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+
+/* --------------------------------- I2C ---------------------------------- */
+
+// STM32F4 I2C. Same register set with the real device, for I2cTiming.
+typedef struct
+{
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t OAR1;
+    __IO uint32_t OAR2;
+    __IO uint32_t DR;
+    __IO uint32_t SR1;
+    __IO uint32_t SR2;
+    __IO uint32_t CCR;
+    __IO uint32_t TRISE;
+    __IO uint32_t FLTR;
+} I2C_TypeDef;
+
+extern I2C_TypeDef host_i2c[3];
+
+#define I2C1 (&host_i2c[0])
+#define I2C2 (&host_i2c[1])
+#define I2C3 (&host_i2c[2])
+
+#define I2C_CR1_PE    0x00000001U
+#define I2C_CR2_FREQ  0x0000003FU
+#define I2C_CCR_CCR   0x00000FFFU
+#define I2C_CCR_DUTY  0x00004000U
+#define I2C_CCR_FS    0x00008000U
+
+typedef struct
+{
+    uint32_t ClockSpeed;
+    uint32_t DutyCycle;
+    uint32_t OwnAddress1;
+    uint32_t AddressingMode;
+    uint32_t DualAddressMode;
+    uint32_t OwnAddress2;
+    uint32_t GeneralCallMode;
+    uint32_t NoStretchMode;
+} I2C_InitTypeDef;
+
+typedef enum
+{
+    HAL_I2C_STATE_RESET = 0x00U,
+    HAL_I2C_STATE_READY = 0x20U,
+    HAL_I2C_STATE_BUSY = 0x24U,
+    HAL_I2C_STATE_BUSY_TX = 0x21U,
+    HAL_I2C_STATE_BUSY_RX = 0x22U,
+    HAL_I2C_STATE_LISTEN = 0x28U,
+    HAL_I2C_STATE_ABORT = 0x60U,
+    HAL_I2C_STATE_TIMEOUT = 0xA0U,
+    HAL_I2C_STATE_ERROR = 0xE0U
+} HAL_I2C_StateTypeDef;
+
+typedef enum
+{
+    HAL_I2C_MODE_NONE = 0x00U,
+    HAL_I2C_MODE_MASTER = 0x10U,
+    HAL_I2C_MODE_SLAVE = 0x20U,
+    HAL_I2C_MODE_MEM = 0x40U
+} HAL_I2C_ModeTypeDef;
+
+#define HAL_I2C_ERROR_NONE     0x00000000U
+#define HAL_I2C_ERROR_BERR     0x00000001U
+#define HAL_I2C_ERROR_ARLO     0x00000002U
+#define HAL_I2C_ERROR_AF       0x00000004U
+#define HAL_I2C_ERROR_OVR      0x00000008U
+#define HAL_I2C_ERROR_DMA      0x00000010U
+#define HAL_I2C_ERROR_TIMEOUT  0x00000020U
+#define HAL_I2C_ERROR_SIZE     0x00000040U
+
+#define I2C_DUTYCYCLE_2               0x00000000U
+#define I2C_DUTYCYCLE_16_9            I2C_CCR_DUTY
+#define I2C_ADDRESSINGMODE_7BIT       0x00004000U
+#define I2C_DUALADDRESS_DISABLE       0x00000000U
+#define I2C_GENERALCALL_DISABLE       0x00000000U
+#define I2C_NOSTRETCH_DISABLE         0x00000000U
+
+#define I2C_FIRST_FRAME               0x00000001U
+#define I2C_FIRST_AND_NEXT_FRAME      0x00000002U
+#define I2C_NEXT_FRAME                0x00000004U
+#define I2C_FIRST_AND_LAST_FRAME      0x00000008U
+#define I2C_LAST_FRAME_NO_STOP        0x00000010U
+#define I2C_LAST_FRAME                0x00000020U
+
+#define I2C_DIRECTION_RECEIVE         0x00000000U
+#define I2C_DIRECTION_TRANSMIT        0x00000001U
+
+#define I2C_MEMADD_SIZE_8BIT          0x00000001U
+
+struct __I2C_HandleTypeDef;
+typedef void (*pI2C_CallbackTypeDef)(struct __I2C_HandleTypeDef *hi2c);
+
+typedef enum
+{
+    HAL_I2C_MASTER_TX_COMPLETE_CB_ID = 0x00U,
+    HAL_I2C_MASTER_RX_COMPLETE_CB_ID = 0x01U,
+    HAL_I2C_SLAVE_TX_COMPLETE_CB_ID = 0x02U,
+    HAL_I2C_SLAVE_RX_COMPLETE_CB_ID = 0x03U,
+    HAL_I2C_ERROR_CB_ID = 0x07U,
+    HAL_I2C_ABORT_CB_ID = 0x08U
+} HAL_I2C_CallbackIDTypeDef;
+
+typedef struct __I2C_HandleTypeDef
+{
+    I2C_TypeDef *Instance;
+    I2C_InitTypeDef Init;
+    uint8_t *pBuffPtr;
+    uint16_t XferSize;
+    __IO uint16_t XferCount;
+    __IO uint32_t XferOptions;
+    __IO uint32_t PreviousState;
+    DMA_HandleTypeDef *hdmatx;
+    DMA_HandleTypeDef *hdmarx;
+    HAL_LockTypeDef Lock;
+    __IO HAL_I2C_StateTypeDef State;
+    __IO HAL_I2C_ModeTypeDef Mode;
+    __IO uint32_t ErrorCode;
+    __IO uint32_t Devaddress;
+    pI2C_CallbackTypeDef MasterTxCpltCallback;
+    pI2C_CallbackTypeDef MasterRxCpltCallback;
+    pI2C_CallbackTypeDef SlaveTxCpltCallback;
+    pI2C_CallbackTypeDef SlaveRxCpltCallback;
+    pI2C_CallbackTypeDef ErrorCallback;
+    pI2C_CallbackTypeDef AbortCpltCallback;
+} I2C_HandleTypeDef;
+
+#define __HAL_I2C_ENABLE(__HANDLE__)  SET_BIT((__HANDLE__)->Instance->CR1, I2C_CR1_PE)
+#define __HAL_I2C_DISABLE(__HANDLE__) CLEAR_BIT((__HANDLE__)->Instance->CR1, I2C_CR1_PE)
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t XferOptions);
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t XferOptions);
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t XferOptions);
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t XferOptions);
+HAL_StatusTypeDef HAL_I2C_Master_Abort_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress);
+HAL_StatusTypeDef HAL_I2C_Slave_Transmit_IT(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Slave_Receive_IT(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Slave_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Slave_Receive_DMA(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t Size);
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef *hi2c);
+HAL_I2C_ModeTypeDef HAL_I2C_GetMode(I2C_HandleTypeDef *hi2c);
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_RegisterCallback(I2C_HandleTypeDef *hi2c, HAL_I2C_CallbackIDTypeDef CallbackID,
+                                           pI2C_CallbackTypeDef pCallback);
+HAL_StatusTypeDef HAL_I2C_UnRegisterCallback(I2C_HandleTypeDef *hi2c, HAL_I2C_CallbackIDTypeDef CallbackID);
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c);
+
+/* --------------------------------- PCD ---------------------------------- */
+
+// The registers of the OTG which the simulator refers. The pending transfers are stub only.
+typedef struct
+{
+    __IO uint32_t DCTL;        // Bit 1 : SDIS, the soft disconnect.
+    __IO uint32_t DAINTMSK;    // Opened endpoints. IN at [15:0], OUT at [31:16].
+    __IO uint32_t DIEPENA;     // Stub only. The IN transfer is pending at [15:0].
+    __IO uint32_t DOEPENA;     // Stub only. The OUT transfer is pending at [15:0].
+} USB_OTG_GlobalTypeDef;
+
+extern USB_OTG_GlobalTypeDef host_usb_otg_fs;
+
+#define USB_OTG_FS (&host_usb_otg_fs)
+
+#define USB_OTG_DCTL_SDIS 0x00000002U
+
+#define PCD_SPEED_FULL 3U
+#define PCD_PHY_EMBEDDED 2U
+
+#define EP_TYPE_CTRL 0U
+#define EP_TYPE_ISOC 1U
+#define EP_TYPE_BULK 2U
+#define EP_TYPE_INTR 3U
+
+typedef struct
+{
+    uint32_t dev_endpoints;
+    uint32_t speed;
+    uint32_t dma_enable;
+    uint32_t phy_itface;
+    uint32_t Sof_enable;
+    uint32_t low_power_enable;
+    uint32_t lpm_enable;
+    uint32_t battery_charging_enable;
+    uint32_t vbus_sensing_enable;
+    uint32_t use_dedicated_ep1;
+} PCD_InitTypeDef;
+
+typedef struct
+{
+    uint8_t num;
+    uint8_t is_in;
+    uint8_t is_stall;
+    uint8_t type;
+    uint32_t maxpacket;
+    uint8_t *xfer_buff;
+    uint32_t xfer_len;
+    uint32_t xfer_count;
+} PCD_EPTypeDef;
+
+typedef enum
+{
+    HAL_PCD_STATE_RESET = 0x00,
+    HAL_PCD_STATE_READY = 0x01,
+    HAL_PCD_STATE_ERROR = 0x02,
+    HAL_PCD_STATE_BUSY = 0x03,
+    HAL_PCD_STATE_TIMEOUT = 0x04
+} PCD_StateTypeDef;
+
+struct __PCD_HandleTypeDef;
+typedef void (*pPCD_CallbackTypeDef)(struct __PCD_HandleTypeDef *hpcd);
+typedef void (*pPCD_DataOutStageCallbackTypeDef)(struct __PCD_HandleTypeDef *hpcd, uint8_t epnum);
+typedef void (*pPCD_DataInStageCallbackTypeDef)(struct __PCD_HandleTypeDef *hpcd, uint8_t epnum);
+
+typedef enum
+{
+    HAL_PCD_SOF_CB_ID = 0x01,
+    HAL_PCD_SETUPSTAGE_CB_ID = 0x02,
+    HAL_PCD_RESET_CB_ID = 0x03,
+    HAL_PCD_SUSPEND_CB_ID = 0x04,
+    HAL_PCD_RESUME_CB_ID = 0x05,
+    HAL_PCD_CONNECT_CB_ID = 0x06,
+    HAL_PCD_DISCONNECT_CB_ID = 0x07
+} HAL_PCD_CallbackIDTypeDef;
+
+typedef struct __PCD_HandleTypeDef
+{
+    USB_OTG_GlobalTypeDef *Instance;
+    PCD_InitTypeDef Init;
+    __IO uint8_t USB_Address;
+    PCD_EPTypeDef IN_ep[16];
+    PCD_EPTypeDef OUT_ep[16];
+    HAL_LockTypeDef Lock;
+    __IO PCD_StateTypeDef State;
+    uint32_t Setup[12];
+    pPCD_CallbackTypeDef SOFCallback;
+    pPCD_CallbackTypeDef SetupStageCallback;
+    pPCD_CallbackTypeDef ResetCallback;
+    pPCD_CallbackTypeDef SuspendCallback;
+    pPCD_CallbackTypeDef ResumeCallback;
+    pPCD_CallbackTypeDef ConnectCallback;
+    pPCD_CallbackTypeDef DisconnectCallback;
+    pPCD_DataOutStageCallbackTypeDef DataOutStageCallback;
+    pPCD_DataInStageCallbackTypeDef DataInStageCallback;
+} PCD_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_PCD_Init(PCD_HandleTypeDef *hpcd);
+HAL_StatusTypeDef HAL_PCD_DeInit(PCD_HandleTypeDef *hpcd);
+HAL_StatusTypeDef HAL_PCD_Start(PCD_HandleTypeDef *hpcd);
+HAL_StatusTypeDef HAL_PCD_Stop(PCD_HandleTypeDef *hpcd);
+HAL_StatusTypeDef HAL_PCD_SetAddress(PCD_HandleTypeDef *hpcd, uint8_t address);
+HAL_StatusTypeDef HAL_PCD_EP_Open(PCD_HandleTypeDef *hpcd, uint8_t ep_addr, uint16_t ep_mps, uint8_t ep_type);
+HAL_StatusTypeDef HAL_PCD_EP_Close(PCD_HandleTypeDef *hpcd, uint8_t ep_addr);
+HAL_StatusTypeDef HAL_PCD_EP_Receive(PCD_HandleTypeDef *hpcd, uint8_t ep_addr, uint8_t *pBuf, uint32_t len);
+HAL_StatusTypeDef HAL_PCD_EP_Transmit(PCD_HandleTypeDef *hpcd, uint8_t ep_addr, uint8_t *pBuf, uint32_t len);
+HAL_StatusTypeDef HAL_PCD_EP_SetStall(PCD_HandleTypeDef *hpcd, uint8_t ep_addr);
+HAL_StatusTypeDef HAL_PCD_EP_ClrStall(PCD_HandleTypeDef *hpcd, uint8_t ep_addr);
+uint32_t HAL_PCD_EP_GetRxCount(PCD_HandleTypeDef *hpcd, uint8_t ep_addr);
+HAL_StatusTypeDef HAL_PCDEx_SetTxFiFo(PCD_HandleTypeDef *hpcd, uint8_t fifo, uint16_t size);
+HAL_StatusTypeDef HAL_PCDEx_SetRxFiFo(PCD_HandleTypeDef *hpcd, uint16_t size);
+HAL_StatusTypeDef HAL_PCD_RegisterCallback(PCD_HandleTypeDef *hpcd, HAL_PCD_CallbackIDTypeDef CallbackID,
+                                           pPCD_CallbackTypeDef pCallback);
+HAL_StatusTypeDef HAL_PCD_RegisterDataOutStageCallback(PCD_HandleTypeDef *hpcd,
+                                                       pPCD_DataOutStageCallbackTypeDef pCallback);
+HAL_StatusTypeDef HAL_PCD_RegisterDataInStageCallback(PCD_HandleTypeDef *hpcd,
+                                                      pPCD_DataInStageCallbackTypeDef pCallback);
+
+void HAL_PCD_SOFCallback(PCD_HandleTypeDef *hpcd);
+void HAL_PCD_SetupStageCallback(PCD_HandleTypeDef *hpcd);
+void HAL_PCD_ResetCallback(PCD_HandleTypeDef *hpcd);
+void HAL_PCD_SuspendCallback(PCD_HandleTypeDef *hpcd);
+void HAL_PCD_ResumeCallback(PCD_HandleTypeDef *hpcd);
+void HAL_PCD_ConnectCallback(PCD_HandleTypeDef *hpcd);
+void HAL_PCD_DisconnectCallback(PCD_HandleTypeDef *hpcd);
+void HAL_PCD_DataOutStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum);
+void HAL_PCD_DataInStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum);
+
+/* --------------------------------- ETH ---------------------------------- */
+
+// The ETH HAL of the H7, as the Nucleo-H743ZI project uses. The MAC configuration register of the stub.
+typedef struct
+{
+    __IO uint32_t MACCR;       // Bit 14 : FES, 100Mbps. Bit 13 : DM, full duplex.
+    __IO uint32_t MAC1USTCR;   // HCLK cycles per uS - 1.
+    __IO uint32_t MACMDIOAR;   // The stub keeps the HCLK divider of the MDC, instead of the CR field.
+} ETH_TypeDef;
+
+extern ETH_TypeDef host_eth;
+
+#define ETH (&host_eth)
+
+#define ETH_TX_DESC_CNT 4U
+#define ETH_RX_DESC_CNT 4U
+
+#define ETH_MACCR_DM 0x00002000U
+#define ETH_MACCR_FES 0x00004000U
+
+#define ETH_DMATXNDESCRF_OWN 0x80000000U
+#define ETH_DMATXNDESCRF_CIC 0x00030000U
+#define ETH_DMATXNDESCRF_FL 0x00007FFFU
+
+#define ETH_TX_PACKETS_FEATURES_CSUM 0x00000001U
+#define ETH_TX_PACKETS_FEATURES_CRCPAD 0x00000020U
+
+#define ETH_CHECKSUM_DISABLE 0x00000000U
+#define ETH_CHECKSUM_IPHDR_PAYLOAD_INSERT_PHDR_CALC 0x00030000U
+#define ETH_CRC_PAD_INSERT 0x00000000U
+
+#define ETH_SPEED_10M 0x00000000U
+#define ETH_SPEED_100M ETH_MACCR_FES
+#define ETH_HALFDUPLEX_MODE 0x00000000U
+#define ETH_FULLDUPLEX_MODE ETH_MACCR_DM
+
+#define HAL_ETH_MII_MODE 0x00000000U
+#define HAL_ETH_RMII_MODE 0x00800000U
+
+#define HAL_ETH_ERROR_NONE 0x00000000U
+#define HAL_ETH_ERROR_PARAM 0x00000001U
+#define HAL_ETH_ERROR_BUSY 0x00000002U
+
+// Tx descriptor. The real one has the buffer address in the 32bit DESC0. The stub keeps the pointer.
+typedef struct
+{
+    __IO uint32_t DESC3;       // Bit 31 : OWN. The DMA has the descriptor. Checksum control at [17:16]. Length at [14:0].
+    uint8_t *Buffer;           // Stub only. The buffer 1 of the DESC0.
+} ETH_DMADescTypeDef;
+
+typedef struct __ETH_BufferTypeDef
+{
+    uint8_t *buffer;
+    uint32_t len;
+    struct __ETH_BufferTypeDef *next;
+} ETH_BufferTypeDef;
+
+// The real one has the address of the descriptors in TxDesc. The stub has the descriptors.
+typedef struct
+{
+    ETH_DMADescTypeDef TxDesc[ETH_TX_DESC_CNT];
+    uint32_t CurTxDesc;
+    uint32_t *PacketAddress[ETH_TX_DESC_CNT];
+    uint32_t *CurrentPacketAddress;
+    uint32_t BuffersInUse;
+    uint32_t releaseIndex;
+} ETH_TxDescListTypeDef;
+
+typedef struct
+{
+    uint32_t Attributes;
+    uint32_t Length;
+    ETH_BufferTypeDef *TxBuffer;
+    uint32_t SrcAddrCtrl;
+    uint32_t CRCPadCtrl;
+    uint32_t ChecksumCtrl;
+    void *pData;
+} ETH_TxPacketConfig;
+
+typedef struct
+{
+    uint8_t *MACAddr;
+    uint32_t MediaInterface;
+    uint32_t RxBuffLen;
+} ETH_InitTypeDef;
+
+typedef struct
+{
+    uint32_t DuplexMode;
+    uint32_t Speed;
+} ETH_MACConfigTypeDef;
+
+typedef enum
+{
+    HAL_ETH_STATE_RESET = 0x00000000U,
+    HAL_ETH_STATE_READY = 0x00000010U,
+    HAL_ETH_STATE_STARTED = 0x00000023U,
+    HAL_ETH_STATE_ERROR = 0x000000E0U
+} HAL_ETH_StateTypeDef;
+
+typedef void (*pETH_txFreeCallbackTypeDef)(uint32_t *buff);
+
+typedef struct __ETH_HandleTypeDef
+{
+    ETH_TypeDef *Instance;
+    ETH_InitTypeDef Init;
+    ETH_TxDescListTypeDef TxDescList;
+    __IO HAL_ETH_StateTypeDef gState;
+    __IO uint32_t ErrorCode;
+    pETH_txFreeCallbackTypeDef txFreeCallback;
+} ETH_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_ETH_Init(ETH_HandleTypeDef *heth);
+HAL_StatusTypeDef HAL_ETH_Start(ETH_HandleTypeDef *heth);
+HAL_StatusTypeDef HAL_ETH_Stop(ETH_HandleTypeDef *heth);
+HAL_StatusTypeDef HAL_ETH_Transmit_IT(ETH_HandleTypeDef *heth, ETH_TxPacketConfig *pTxConfig);
+HAL_StatusTypeDef HAL_ETH_ReleaseTxPacket(ETH_HandleTypeDef *heth);
+HAL_StatusTypeDef HAL_ETH_RegisterTxFreeCallback(ETH_HandleTypeDef *heth, pETH_txFreeCallbackTypeDef txFreeCallback);
+HAL_StatusTypeDef HAL_ETH_ReadPHYRegister(ETH_HandleTypeDef *heth, uint32_t PHYAddr, uint32_t PHYReg, uint32_t *pRegValue);
+HAL_StatusTypeDef HAL_ETH_GetMACConfig(ETH_HandleTypeDef *heth, ETH_MACConfigTypeDef *macconf);
+HAL_StatusTypeDef HAL_ETH_SetMACConfig(ETH_HandleTypeDef *heth, ETH_MACConfigTypeDef *macconf);
+void HAL_ETH_SetMDIOClockRange(ETH_HandleTypeDef *heth);
+
+void HAL_ETH_TxFreeCallback(uint32_t *buff);
+
+/* --------------------------------- CRC ---------------------------------- */
+
+#ifdef __cplusplus
+// Data register of the CRC unit. The CRC is computed by the write of the word, as the hardware does.
+class HostCrcData
+{
+ public:
+    HostCrcData &operator=(uint32_t data);
+    operator uint32_t();
+
+ private:
+    void ApplyReset();
+
+    uint32_t crc_;
+};
+
+// The CRC unit of the G0 and H7 reference manuals. The DR is at the offset 0.
+typedef struct
+{
+    HostCrcData DR;
+    __IO uint8_t IDR;
+    uint8_t RESERVED0;
+    uint16_t RESERVED1;
+    __IO uint32_t CR;          // The RESET bit is applied by the next access to the DR.
+    uint32_t RESERVED2;
+    __IO uint32_t INIT;
+    __IO uint32_t POL;
+} CRC_TypeDef;
+
+extern CRC_TypeDef host_crc;
+
+#define CRC (&host_crc)
+
+#define CRC_CR_RESET 0x00000001U
+#if !defined(HOST_CRC_FIXED_POLYNOMIAL)
+#define CRC_CR_POLYSIZE 0x00000018U
+#define CRC_CR_POLYSIZE_0 0x00000008U
+#define CRC_CR_POLYSIZE_1 0x00000010U
+#define CRC_CR_REV_IN 0x00000060U
+#define CRC_CR_REV_IN_0 0x00000020U
+#define CRC_CR_REV_IN_1 0x00000040U
+#define CRC_CR_REV_OUT 0x00000080U
+#endif
+#endif
+
+/* ------------------------------ Host models ----------------------------- */
+
+/**
+ * @brief Start the task which raises the simulated interrupts.
+ * @details
+ * Call after the scheduler start, before the peripherals are used.
+ */
+void HostStartInterruptTask(void);
+
+/**
+ * @brief Push the user button. The EXTI callback is raised by the interrupt task.
+ * @param port GPIO port of the button.
+ * @param pin GPIO pin of the button.
+ */
+void HostPressButton(GPIO_TypeDef *port, uint16_t pin);
+
+#ifdef __cplusplus
+}
+
+namespace murasaki {
+class I2cSimulator;
+}
+
+/**
+ * @brief Connect the simulated bus to the I2C peripheral.
+ * @param hi2c The peripheral.
+ * @param bus The bus. The transfer of the hi2c is executed by this bus.
+ */
+extern "C" void HostAttachI2c(I2C_HandleTypeDef *hi2c, murasaki::I2cSimulator *bus);
+#endif
+
+#endif /* STM32F4XX_HAL_H_ */
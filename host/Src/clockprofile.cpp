@@ -0,0 +1,75 @@
+/**
+ * @file clockprofile.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host implementation of the ClockProfile.
+ * @details
+ * Replaces the clockprofile.cpp of the project. The host has no clock tree. The SystemCoreClock
+ * of the stub follows the profiles of the STM32F446, and the I2C and the status LED are re-timed.
+ */
+
+#include "clockprofile.hpp"
+#include "i2crecoveringmaster.hpp"
+#include "statusled.hpp"
+
+static const uint32_t kHostClocks[] = { 16000000, 84000000, 180000000 };
+
+namespace murasaki {
+
+ClockProfile::ClockProfile(UART_HandleTypeDef *uart, I2cRecoveringMaster *i2c_master, StatusLed *status_led)
+        :
+        uart_(uart),
+        i2c_master_(i2c_master),
+        status_led_(status_led),
+        level_(kcpBalanced)
+{
+}
+
+bool ClockProfile::Set(ClockProfileLevel level)
+{
+    if (!IsSupported(level))
+        return false;
+
+    if (nullptr != i2c_master_)
+        i2c_master_->Suspend();
+    SystemCoreClock = kHostClocks[level];
+    if (nullptr != i2c_master_)
+        i2c_master_->Resume();
+    if (nullptr != status_led_)
+        status_led_->Retime();
+
+    level_ = level;
+    return true;
+}
+
+ClockProfileLevel ClockProfile::Get() const
+{
+    return level_;
+}
+
+bool ClockProfile::IsSupported(ClockProfileLevel level)
+{
+    return kcpLow <= level && level <= kcpMax;
+}
+
+unsigned int ClockProfile::GetFrequency(ClockProfileLevel level)
+{
+    return IsSupported(level) ? kHostClocks[level] : 0;
+}
+
+void ClockProfile::DrainUart()
+{
+}
+
+void ClockProfile::RetimeUart()
+{
+}
+
+bool ClockProfile::SwitchClock(ClockProfileLevel level)
+{
+    (void) level;
+    return false;
+}
+
+} /* namespace murasaki */
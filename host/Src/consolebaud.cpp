@@ -0,0 +1,70 @@
+/**
+ * @file consolebaud.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host implementation of the ConsoleBaud.
+ * @details
+ * Replaces the consolebaud.cpp of the project. The console of the host is the standard input and output.
+ * There is no baud rate to negotiate, and no framing error. The baud rate is kept in the handle only.
+ */
+
+#include "consolebaud.hpp"
+
+namespace murasaki {
+
+ConsoleBaud *ConsoleBaud::instance_ = nullptr;
+
+ConsoleBaud::ConsoleBaud(UART_HandleTypeDef *huart)
+        :
+        huart_(huart),
+        default_baud_rate_(huart->Init.BaudRate),
+        console_(nullptr),
+        task_(nullptr),
+        framing_errors_(0)
+{
+}
+
+bool ConsoleBaud::Negotiate(unsigned int window_ms)
+{
+    // The standard input belongs to the console.
+    (void) window_ms;
+    return false;
+}
+
+void ConsoleBaud::Start(UartStrategy *console)
+{
+    console_ = console;
+    instance_ = this;
+}
+
+void ConsoleBaud::FallBack()
+{
+    SetBaudRate(huart_, default_baud_rate_);
+}
+
+unsigned int ConsoleBaud::GetBaudRate() const
+{
+    return huart_->Init.BaudRate;
+}
+
+unsigned int ConsoleBaud::GetFramingErrors() const
+{
+    return framing_errors_;
+}
+
+bool ConsoleBaud::SetBaudRate(UART_HandleTypeDef *huart, unsigned int baud_rate)
+{
+    if (0 == baud_rate)
+        return false;
+
+    huart->Init.BaudRate = baud_rate;
+    return true;
+}
+
+bool ConsoleBaud::Retime(UART_HandleTypeDef *huart)
+{
+    return SetBaudRate(huart, huart->Init.BaudRate);
+}
+
+} /* namespace murasaki */
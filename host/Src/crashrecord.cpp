@@ -0,0 +1,45 @@
+/**
+ * @file crashrecord.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host implementation of the CrashRecord.
+ * @details
+ * Replaces the crashrecord.cpp of the project. The host has no fault exception and no
+ * memory kept over the run. The record is never valid.
+ */
+
+#include "crashrecord.hpp"
+
+namespace murasaki {
+
+CrashRecord::Record CrashRecord::record_;
+
+void CrashRecord::Save(uint32_t *stack_pointer, uint32_t exc_return)
+{
+    (void) stack_pointer;
+    (void) exc_return;
+    HAL_NVIC_SystemReset();
+}
+
+bool CrashRecord::IsValid()
+{
+    return false;
+}
+
+void CrashRecord::Print()
+{
+}
+
+void CrashRecord::Clear()
+{
+    record_.magic = 0;
+}
+
+uint32_t CrashRecord::Crc(const Record &record)
+{
+    (void) record;
+    return 0;
+}
+
+} /* namespace murasaki */
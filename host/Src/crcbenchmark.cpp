@@ -0,0 +1,149 @@
+/**
+ * @file crcbenchmark.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Check and speed benchmark of the CRC service on the host.
+ * @details
+ * Compares the @ref murasaki::CrcService on the model of the CRC unit with its software fallback. The result must
+ * be identical for each size, alignment and continuation. Prints the speed as CSV :
+ *
+ * @li benchmark : Name of the benchmark.
+ * @li bytes : Size of the data.
+ * @li iterations : Number of the computations.
+ * @li host_ns_per_byte : Host CPU time per byte [nS].
+ *
+ * The hardware rows measure the bit by bit model, not the CRC unit. Run the RtosBenchmark::RunCrc() on the board
+ * for the cycles of the CRC unit and the DMA.
+ *
+ * The crc_bench models the programmable unit of the F091 and H743. The crc_bench_fixed models the fixed CRC-32
+ * unit of the F446. The exit status is not zero if a check failed.
+ *
+ * Usage : crc_bench [iterations]
+ */
+
+#include "murasaki.hpp"
+
+#include "crcservice.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Essential definition. murasaki_platform.cpp is not linked to the benchmark.
+murasaki::Platform murasaki::platform;
+murasaki::Debugger *murasaki::debugger;
+
+// Size of the image [byte].
+#define IMAGE_SIZE 4096
+// Largest size of the checked data [byte].
+#define CHECK_SIZE 300
+
+static unsigned int iterations = 1000;
+static unsigned int failures = 0;
+static uint8_t image[IMAGE_SIZE + 4];
+static volatile uint32_t result;        // Keeps the computation from the optimization.
+
+static uint64_t NowNs()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+static void Check(bool condition, const char *message)
+{
+    if (!condition) {
+        fprintf(stderr, "CHECK FAILED : %s\n", message);
+        failures++;
+    }
+}
+
+// Print a row of the result.
+static void Report(const char *name, unsigned int bytes, uint64_t host_ns)
+{
+    printf("%s,%u,%u,%.3f\n",
+           name,
+           bytes,
+           iterations,
+           static_cast<double>(host_ns) / iterations / bytes);
+}
+
+static void BenchmarkTask(void *ptr)
+{
+    const uint8_t *check = reinterpret_cast<const uint8_t*>("123456789");
+    murasaki::CrcService service;
+    uint64_t start;
+
+    for (unsigned int i = 0; i < sizeof(image); i++)
+        image[i] = rand();
+
+    // Check values of the catalogue.
+    Check(0xCBF43926 == murasaki::CrcService::SoftwareCrc32(check, 9), "software CRC-32 check value");
+    Check(0x29B1 == murasaki::CrcService::SoftwareCrc16(check, 9), "software CRC-16 check value");
+    Check(0xCBF43926 == service.Crc32(check, 9), "CRC-32 check value");
+    Check(0x29B1 == service.Crc16(check, 9), "CRC-16 check value");
+
+    // Same result with the software, for each alignment of the head and the tail.
+    for (unsigned int offset = 0; offset < 4; offset++)
+        for (unsigned int size = 0; size <= CHECK_SIZE; size++) {
+            const uint8_t *data = &image[offset];
+
+            Check(murasaki::CrcService::SoftwareCrc32(data, size) == service.Crc32(data, size), "CRC-32");
+            Check(murasaki::CrcService::SoftwareCrc16(data, size) == service.Crc16(data, size), "CRC-16");
+        }
+
+    // Continued from the previous result.
+    for (unsigned int split = 0; split <= CHECK_SIZE; split += 7) {
+        Check(murasaki::CrcService::SoftwareCrc32(image, CHECK_SIZE)
+                      == service.Crc32(&image[split], CHECK_SIZE - split, service.Crc32(image, split)),
+              "continued CRC-32");
+        Check(murasaki::CrcService::SoftwareCrc16(image, CHECK_SIZE)
+                      == service.Crc16(&image[split], CHECK_SIZE - split, service.Crc16(image, split)),
+              "continued CRC-16");
+    }
+
+    printf("benchmark,bytes,iterations,host_ns_per_byte\n");
+
+    start = NowNs();
+    for (unsigned int i = 0; i < iterations; i++)
+        result = murasaki::CrcService::SoftwareCrc32(image, IMAGE_SIZE);
+    Report("crc32_software", IMAGE_SIZE, NowNs() - start);
+
+    start = NowNs();
+    for (unsigned int i = 0; i < iterations; i++)
+        result = service.Crc32(image, IMAGE_SIZE);
+    Report("crc32_hardware_model", IMAGE_SIZE, NowNs() - start);
+
+    start = NowNs();
+    for (unsigned int i = 0; i < iterations; i++)
+        result = murasaki::CrcService::SoftwareCrc16(image, IMAGE_SIZE);
+    Report("crc16_software", IMAGE_SIZE, NowNs() - start);
+
+    start = NowNs();
+    for (unsigned int i = 0; i < iterations; i++)
+        result = service.Crc16(image, IMAGE_SIZE);
+    Report("crc16_hardware_model", IMAGE_SIZE, NowNs() - start);
+
+    if (!murasaki::CrcService::IsProgrammable())
+        printf("# the CRC unit has the fixed polynomial. crc16_hardware_model is the software\n");
+
+    fflush(stdout);
+    exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+        iterations = atoi(argv[1]);
+    if (iterations == 0)
+        iterations = 1;
+
+    xTaskCreate(BenchmarkTask, "bench", configMINIMAL_STACK_SIZE * 4, nullptr, tskIDLE_PRIORITY + 1, nullptr);
+    vTaskStartScheduler();
+
+    // Never reach here.
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file cyclecounter.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host implementation of the CycleCounter.
+ * @details
+ * Replaces the cyclecounter.cpp of the project. The DWT of the HAL stub is just a memory.
+ * The cycle is calculated from the monotonic clock of the host, by SystemCoreClock.
+ */
+
+#include "cyclecounter.hpp"
+
+#include <time.h>
+
+namespace murasaki {
+
+void CycleCounter::Init()
+{
+}
+
+uint32_t CycleCounter::Get()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint32_t>(
+            (static_cast<uint64_t>(now.tv_sec) * 1000000000ull + now.tv_nsec) * (SystemCoreClock / 1000000) / 1000);
+}
+
+uint32_t CycleCounter::MicroSecondsToCycles(unsigned int us)
+{
+    return static_cast<uint32_t>((static_cast<uint64_t>(SystemCoreClock) * us) / 1000000);
+}
+
+unsigned int CycleCounter::CyclesToMicroSeconds(uint32_t cycles)
+{
+    return static_cast<unsigned int>((static_cast<uint64_t>(cycles) * 1000000) / SystemCoreClock);
+}
+
+void CycleCounter::DelayMicroSeconds(unsigned int us)
+{
+    const uint32_t cycles = MicroSecondsToCycles(us);
+    const uint32_t start = Get();
+
+    while (Get() - start < cycles)
+        ;
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,336 @@
+/**
+ * @file ethbenchmark.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Throughput benchmark of the Ethernet telemetry sink on the host.
+ * @details
+ * Runs the @ref murasaki::EthTelemetry on the @ref murasaki::EthSimulator, and prints the result as CSV :
+ *
+ * @li benchmark : Name of the benchmark.
+ * @li bytes : Number of the record bytes.
+ * @li host_ns_per_byte : Host CPU time per byte [nS]. The software overhead of the sink.
+ * @li host_mb_per_s : Throughput of the sink on the host CPU [MB/s].
+ * @li wire_mb_per_s : Throughput of the records on the simulated 100Mbps wire [MB/s].
+ * @li records_per_frame : Records batched in a frame.
+ * @li drops : Records dropped by no free buffer.
+ *
+ * The headers, the checksums inserted by the MAC, the sequence numbers and the data are checked.
+ * The exit status is not zero if a check failed.
+ *
+ * Usage : eth_bench [bytes]
+ */
+
+#include "murasaki.hpp"
+
+#include "ethsimulator.hpp"
+#include "ethtelemetry.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Essential definition. murasaki_platform.cpp is not linked to the benchmark.
+murasaki::Platform murasaki::platform;
+murasaki::Debugger *murasaki::debugger;
+
+#define SOURCE_IP 0xC0A800C8
+#define DESTINATION_IP 0xFFFFFFFF
+#define PORT 5555
+// Wait for the other side [mS].
+#define STREAM_TIMEOUT 1000
+// Record of the drop test [byte].
+#define DROP_RECORD_SIZE 256
+
+static unsigned int bytes = 16 * 1024 * 1024;
+static unsigned int failures = 0;
+
+static ETH_HandleTypeDef heth;
+static ETH_TxPacketConfig tx_config;
+static uint8_t mac_address[6] = { 0x00, 0x80, 0xE1, 0x00, 0x00, 0x00 };
+
+// Sequence number of the next frame.
+static uint32_t next_sequence = 0;
+
+// Parameter of the writer task.
+struct Stream
+{
+    murasaki::EthTelemetry *telemetry;
+    unsigned int record;
+    unsigned int size;
+    bool zero_copy;
+    volatile bool done;
+    volatile bool ok;
+};
+
+static uint64_t NowNs()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+static void Check(bool condition, const char *message)
+{
+    if (!condition) {
+        fprintf(stderr, "CHECK FAILED : %s\n", message);
+        failures++;
+    }
+}
+
+// Data at the position of the stream. Not periodic in the frame, to find the lost or the doubled frame.
+static uint8_t Pattern(unsigned int position)
+{
+    return static_cast<uint8_t>(position + (position >> 8) + (position >> 16));
+}
+
+static unsigned int GetBe16(const uint8_t *p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+static uint32_t GetBe32(const uint8_t *p)
+{
+    return (GetBe16(p) << 16) | GetBe16(p + 2);
+}
+
+// One's complement sum. 0xFFFF if the checksum in the data is right.
+static uint16_t Checksum(const uint8_t *data, unsigned int length, uint32_t sum)
+{
+    for (unsigned int i = 0; i + 1 < length; i += 2)
+        sum += GetBe16(data + i);
+    if (length & 1)
+        sum += data[length - 1] << 8;
+    while (sum >> 16)
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    return sum;
+}
+
+// Check the headers and the sequence number. Returns the records in the payload.
+static const uint8_t* CheckFrame(const uint8_t *frame, unsigned int length, unsigned int *record_bytes)
+{
+    const uint8_t *ip = frame + 14;
+    const uint8_t *udp = ip + 20;
+    bool ok = length > ETH_TELEMETRY_HEADER_SIZE + ETH_TELEMETRY_SEQUENCE_SIZE;
+
+    ok = ok && 0 == memcmp(frame, "\xFF\xFF\xFF\xFF\xFF\xFF", 6);
+    ok = ok && 0 == memcmp(frame + 6, mac_address, 6);
+    ok = ok && 0x0800 == GetBe16(frame + 12);
+    ok = ok && 0x45 == ip[0] && 17 == ip[9];
+    ok = ok && length - 14 == GetBe16(ip + 2);
+    ok = ok && SOURCE_IP == GetBe32(ip + 12) && DESTINATION_IP == GetBe32(ip + 16);
+    ok = ok && 0xFFFF == Checksum(ip, 20, 0);
+    ok = ok && PORT == GetBe16(udp) && PORT == GetBe16(udp + 2);
+    ok = ok && length - 34 == GetBe16(udp + 4);
+    // Pseudo header. Source, destination, protocol and UDP length.
+    ok = ok && 0xFFFF == Checksum(udp, length - 34, Checksum(ip + 12, 8, 0) + 17 + (length - 34));
+    Check(ok, "frame header");
+    if (!ok)
+        return nullptr;
+
+    const uint8_t *payload = frame + ETH_TELEMETRY_HEADER_SIZE;
+    const uint32_t sequence = payload[0] | (payload[1] << 8) | (payload[2] << 16) | (payload[3] << 24);
+
+    Check(sequence == next_sequence, "sequence number");
+    next_sequence = sequence + 1;
+
+    *record_bytes = length - ETH_TELEMETRY_HEADER_SIZE - ETH_TELEMETRY_SEQUENCE_SIZE;
+    return payload + ETH_TELEMETRY_SEQUENCE_SIZE;
+}
+
+// Print a row of the result.
+static void Report(
+                   const char *name,
+                   unsigned int count,
+                   uint64_t host_ns,
+                   murasaki::EthSimulator *wire,
+                   unsigned int records,
+                   unsigned int drops)
+{
+    const unsigned int frames = wire->GetFrameCount();
+
+    printf("%s,%u,%.2f,%.1f,%.2f,%.1f,%u\n",
+           name,
+           count,
+           static_cast<double>(host_ns) / count,
+           host_ns > 0 ? count * 1000.0 / host_ns : 0.0,    // byte per nS is GB/s.
+           wire->GetWireTime() > 0 ? count * 1000.0 / wire->GetWireTime() : 0.0,
+           frames > 0 ? static_cast<double>(records) / frames : 0.0,
+           drops);
+}
+
+// Board side. Send the stream by Write(), or by Reserve() and Commit().
+static void WriterTask(void *ptr)
+{
+    Stream *stream = static_cast<Stream*>(ptr);
+    uint8_t *buffer = new uint8_t[stream->record];
+    unsigned int position = 0;
+
+    stream->ok = true;
+    while (position < stream->size) {
+        const unsigned int length = std::min(stream->record, stream->size - position);
+
+        if (stream->zero_copy) {
+            uint8_t *record = stream->telemetry->Reserve(length, STREAM_TIMEOUT);
+
+            if (nullptr == record) {
+                stream->ok = false;
+                break;
+            }
+            for (unsigned int i = 0; i < length; i++)
+                record[i] = Pattern(position + i);
+            stream->telemetry->Commit(length);
+        }
+        else {
+            for (unsigned int i = 0; i < length; i++)
+                buffer[i] = Pattern(position + i);
+            if (!stream->telemetry->Write(buffer, length, STREAM_TIMEOUT)) {
+                stream->ok = false;
+                break;
+            }
+        }
+        position += length;
+    }
+    if (!stream->telemetry->Flush(STREAM_TIMEOUT))
+        stream->ok = false;
+
+    delete[] buffer;
+    stream->done = true;
+    vTaskDelete(nullptr);
+}
+
+// Receiver side. Returns true if all data is received in order.
+static bool ReadStream(murasaki::EthSimulator *wire, unsigned int size)
+{
+    static uint8_t frame[ETH_TELEMETRY_BUFFER_SIZE];
+    unsigned int position = 0;
+    bool ok = true;
+
+    while (position < size) {
+        const unsigned int length = wire->Receive(frame, sizeof(frame), STREAM_TIMEOUT);
+        unsigned int record_bytes;
+        const uint8_t *records;
+
+        if (0 == length)
+            break;
+        records = CheckFrame(frame, length, &record_bytes);
+        if (nullptr == records)
+            return false;
+        for (unsigned int i = 0; i < record_bytes; i++)
+            if (records[i] != Pattern(position + i))
+                ok = false;
+        position += record_bytes;
+    }
+    return ok && position == size;
+}
+
+static void StreamBenchmark(
+                            const char *name,
+                            murasaki::EthTelemetry *telemetry,
+                            murasaki::EthSimulator *wire,
+                            unsigned int record,
+                            bool zero_copy)
+{
+    Stream stream = { telemetry, record, bytes, zero_copy, false, false };
+    const unsigned int records = telemetry->GetRecordCount();
+    const unsigned int drops = telemetry->GetDropCount();
+    uint64_t start;
+    bool received;
+
+    wire->ResetStatistics();
+    start = NowNs();
+    xTaskCreate(WriterTask, "writer", configMINIMAL_STACK_SIZE * 4, &stream, tskIDLE_PRIORITY + 1, nullptr);
+    received = ReadStream(wire, bytes);
+    Report(name, bytes, NowNs() - start, wire,
+           telemetry->GetRecordCount() - records,
+           telemetry->GetDropCount() - drops);
+
+    while (!stream.done)
+        vTaskDelay(1);
+    Check(stream.ok, name);
+    Check(received, name);
+}
+
+static void BenchmarkTask(void *ptr)
+{
+    murasaki::EthTelemetry *telemetry;
+    murasaki::EthSimulator *wire;
+
+    heth.Instance = ETH;
+    heth.Init.MACAddr = mac_address;
+    heth.Init.MediaInterface = HAL_ETH_RMII_MODE;
+    heth.Init.RxBuffLen = 1536;
+    HAL_ETH_Init(&heth);
+
+    // Same with the CubeIDE generated code of the Nucleo-H743ZI.
+    tx_config.Attributes = ETH_TX_PACKETS_FEATURES_CSUM | ETH_TX_PACKETS_FEATURES_CRCPAD;
+    tx_config.ChecksumCtrl = ETH_CHECKSUM_IPHDR_PAYLOAD_INSERT_PHDR_CALC;
+    tx_config.CRCPadCtrl = ETH_CRC_PAD_INSERT;
+
+    telemetry = new murasaki::EthTelemetry(&heth, &tx_config, SOURCE_IP, DESTINATION_IP, PORT);
+    wire = new murasaki::EthSimulator(&heth);
+
+    Check(telemetry->Start(), "Start()");
+    Check(telemetry->IsLinkUp(), "link up");
+
+    printf("benchmark,bytes,host_ns_per_byte,host_mb_per_s,wire_mb_per_s,records_per_frame,drops\n");
+
+    // Small samples to a full frame of a record.
+    StreamBenchmark("write_16", telemetry, wire, 16, false);
+    StreamBenchmark("write_64", telemetry, wire, 64, false);
+    StreamBenchmark("write_256", telemetry, wire, 256, false);
+    StreamBenchmark("write_1468", telemetry, wire, ETH_TELEMETRY_MAX_RECORD, false);
+    // The record is written in the DMA buffer.
+    StreamBenchmark("reserve_commit_64", telemetry, wire, 64, true);
+
+    // Nobody takes the frames. The buffers run out, and the record is dropped without the wait.
+    {
+        static uint8_t record[DROP_RECORD_SIZE];
+        static uint8_t frame[ETH_TELEMETRY_BUFFER_SIZE];
+        const unsigned int drops = telemetry->GetDropCount();
+        unsigned int written = 0;
+        unsigned int received = 0;
+        unsigned int length;
+
+        while (written < 1000 && telemetry->Write(record, sizeof(record), 0))
+            written++;
+        Check(written < 1000, "drop without receiver");
+        Check(telemetry->GetDropCount() == drops + 1, "drop count");
+
+        // The queued records are still sent, in sequence.
+        while (0 != (length = wire->Receive(frame, sizeof(frame), 10))) {
+            unsigned int record_bytes = 0;
+
+            if (nullptr != CheckFrame(frame, length, &record_bytes))
+                received += record_bytes;
+        }
+        Check(telemetry->Flush(STREAM_TIMEOUT), "Flush() after drop");
+        while (0 != (length = wire->Receive(frame, sizeof(frame), 10))) {
+            unsigned int record_bytes = 0;
+
+            if (nullptr != CheckFrame(frame, length, &record_bytes))
+                received += record_bytes;
+        }
+        Check(received == written * sizeof(record), "records after drop");
+    }
+
+    fflush(stdout);
+    exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+        bytes = atoi(argv[1]);
+    if (bytes == 0)
+        bytes = 1;
+
+    xTaskCreate(BenchmarkTask, "bench", configMINIMAL_STACK_SIZE * 4, nullptr, tskIDLE_PRIORITY + 1, nullptr);
+    vTaskStartScheduler();
+
+    // Never reach here.
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file ethsimulator.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host side loopback model of the Ethernet MAC on the ETH stub.
+ */
+
+#include "ethsimulator.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+// Checksum control of the descriptor.
+#define CIC_SHIFT 16
+#define CIC_IP_HEADER 0x1
+#define CIC_FULL 0x3
+
+// Offsets in the frame.
+#define OFFSET_ETHER_TYPE 12
+#define OFFSET_IP 14
+#define ETHER_TYPE_IPV4 0x0800
+#define IP_PROTOCOL_UDP 17
+
+namespace murasaki {
+
+EthSimulator::EthSimulator(ETH_HandleTypeDef *heth)
+        :
+        heth_(heth),
+        index_(0),
+        wire_time_(0),
+        frames_(0),
+        bytes_(0)
+{
+    MURASAKI_ASSERT(nullptr != heth)
+}
+
+unsigned int EthSimulator::Receive(uint8_t *frame, unsigned int size, unsigned int timeout_ms)
+{
+    const uint32_t start = HAL_GetTick();
+    unsigned int length = 0;
+    bool received = false;
+
+    while (!received) {
+        taskENTER_CRITICAL();
+        {
+            ETH_DMADescTypeDef *desc = &heth_->TxDescList.TxDesc[index_];
+
+            if (HAL_ETH_STATE_STARTED == heth_->gState && (desc->DESC3 & ETH_DMATXNDESCRF_OWN)) {
+                const uint32_t cic = (desc->DESC3 & ETH_DMATXNDESCRF_CIC) >> CIC_SHIFT;
+
+                length = desc->DESC3 & ETH_DMATXNDESCRF_FL;
+                if (length > size)
+                    length = size;
+                memcpy(frame, desc->Buffer, length);
+                InsertChecksum(frame, length, cic);
+
+                // Give the descriptor back. The HAL_ETH_ReleaseTxPacket() finds it.
+                desc->DESC3 &= ~ETH_DMATXNDESCRF_OWN;
+                index_ = (index_ + 1) % ETH_TX_DESC_CNT;
+                received = true;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if (!received) {
+            if (HAL_GetTick() - start >= timeout_ms)
+                return 0;
+            taskYIELD();
+        }
+    }
+
+    // Padded frame, FCS, preamble and inter frame gap. 10nS per bit at 100Mbps.
+    const unsigned int wire_bytes = std::max<unsigned int>(length + ETH_SIMULATOR_FCS_SIZE, ETH_SIMULATOR_MIN_FRAME)
+            + ETH_SIMULATOR_OVERHEAD;
+    wire_time_ += wire_bytes * 8ull * ((heth_->Instance->MACCR & ETH_MACCR_FES) ? 10 : 100);
+    frames_++;
+    bytes_ += length;
+
+    return length;
+}
+
+uint64_t EthSimulator::GetWireTime() const
+{
+    return wire_time_;
+}
+
+unsigned int EthSimulator::GetFrameCount() const
+{
+    return frames_;
+}
+
+uint64_t EthSimulator::GetByteCount() const
+{
+    return bytes_;
+}
+
+void EthSimulator::ResetStatistics()
+{
+    wire_time_ = 0;
+    frames_ = 0;
+    bytes_ = 0;
+}
+
+// Only the IPv4 and the UDP are modeled. The other frames go as is.
+void EthSimulator::InsertChecksum(uint8_t *frame, unsigned int length, uint32_t cic)
+{
+    if (!(cic & CIC_IP_HEADER) || length < OFFSET_IP + 20
+            || ((frame[OFFSET_ETHER_TYPE] << 8) | frame[OFFSET_ETHER_TYPE + 1]) != ETHER_TYPE_IPV4)
+        return;
+
+    uint8_t *ip = frame + OFFSET_IP;
+    const unsigned int ip_header_length = (ip[0] & 0x0F) * 4;
+    const unsigned int ip_length = (ip[2] << 8) | ip[3];
+    uint16_t checksum;
+
+    if (ip_length < ip_header_length || OFFSET_IP + ip_length > length)
+        return;
+
+    ip[10] = 0;
+    ip[11] = 0;
+    checksum = ~Fold(Sum(ip, ip_header_length, 0));
+    ip[10] = checksum >> 8;
+    ip[11] = checksum;
+
+    if (CIC_FULL == cic && IP_PROTOCOL_UDP == ip[9] && ip_length >= ip_header_length + 8) {
+        uint8_t *udp = ip + ip_header_length;
+        const unsigned int udp_length = ip_length - ip_header_length;
+        uint32_t sum;
+
+        // Pseudo header. Source, destination, protocol and UDP length.
+        sum = Sum(ip + 12, 8, 0) + IP_PROTOCOL_UDP + udp_length;
+        udp[6] = 0;
+        udp[7] = 0;
+        checksum = ~Fold(Sum(udp, udp_length, sum));
+        // 0 means no checksum in the UDP.
+        if (0 == checksum)
+            checksum = 0xFFFF;
+        udp[6] = checksum >> 8;
+        udp[7] = checksum;
+    }
+}
+
+uint32_t EthSimulator::Sum(const uint8_t *data, unsigned int length, uint32_t sum)
+{
+    for (unsigned int i = 0; i + 1 < length; i += 2)
+        sum += (data[i] << 8) | data[i + 1];
+    if (length & 1)
+        sum += data[length - 1] << 8;
+    return sum;
+}
+
+uint16_t EthSimulator::Fold(uint32_t sum)
+{
+    while (sum >> 16)
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    return sum;
+}
+
+} /* namespace murasaki */
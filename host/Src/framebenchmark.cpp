@@ -0,0 +1,312 @@
+/**
+ * @file framebenchmark.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Size and speed benchmark of the framed console on the host.
+ * @details
+ * Sends the same samples as the Printf() text, as the framed text and as the framed binary records,
+ * through the @ref murasaki::FramedConsole on a UART which captures the bytes. Prints the result as CSV :
+ *
+ * @li benchmark : Name of the benchmark.
+ * @li records : Number of the samples.
+ * @li bytes : Number of the bytes on the UART.
+ * @li bytes_per_record : Bytes on the UART per sample.
+ * @li host_ns_per_record : Host CPU time per sample [nS]. Formatting, CRC and COBS.
+ *
+ * The captured frames are decoded, and the CRC, the sequence numbers and the data are checked.
+ * The exit status is not zero if a check failed.
+ *
+ * Usage : frame_bench [records]
+ *         frame_bench --raw [records]
+ *
+ * With --raw, the framed stream of the text and the records is written to the standard output instead,
+ * to check the tools/framedconsole.py.
+ */
+
+#include "murasaki.hpp"
+
+#include "framedconsole.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+
+// Essential definition. murasaki_platform.cpp is not linked to the benchmark.
+murasaki::Platform murasaki::platform;
+murasaki::Debugger *murasaki::debugger;
+
+static unsigned int records = 100000;
+static unsigned int failures = 0;
+
+// Sample of the demo. Tick, counter and CPU load.
+struct Sample
+{
+    uint32_t tick;
+    uint32_t count;
+    uint32_t load;
+};
+
+// UART which keeps the transmitted bytes.
+class CaptureUart : public murasaki::UartStrategy
+{
+ public:
+    virtual murasaki::UartStatus Transmit(const uint8_t *data, unsigned int size, murasaki::WaitMilliSeconds timeout_ms)
+    {
+        captured.append(reinterpret_cast<const char*>(data), size);
+        return murasaki::kursOK;
+    }
+    virtual murasaki::UartStatus Receive(
+                                         uint8_t *data,
+                                         unsigned int count,
+                                         unsigned int *transfered_count,
+                                         murasaki::UartTimeout uart_timeout,
+                                         murasaki::WaitMilliSeconds timeout_ms)
+    {
+        return murasaki::kursTimeOut;
+    }
+    virtual bool TransmitCompleteCallback(void *ptr)
+    {
+        return false;
+    }
+    virtual bool ReceiveCompleteCallback(void *ptr)
+    {
+        return false;
+    }
+    virtual bool HandleError(void *ptr)
+    {
+        return false;
+    }
+
+    std::string captured;
+
+ private:
+    virtual void* GetPeripheralHandle()
+    {
+        return nullptr;
+    }
+};
+
+// Decoded frame.
+struct Frame
+{
+    unsigned int channel;
+    unsigned int sequence;
+    std::string payload;
+};
+
+static uint64_t NowNs()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+static void Check(bool condition, const char *message)
+{
+    if (!condition) {
+        fprintf(stderr, "CHECK FAILED : %s\n", message);
+        failures++;
+    }
+}
+
+static Sample MakeSample(unsigned int i)
+{
+    return Sample { i * 500, i, (i * 37) % 1001 };
+}
+
+// Split the stream by 0x00, decode the COBS, and check the CRC. The broken frames are counted.
+static std::vector<Frame> Decode(const std::string &stream, unsigned int *broken)
+{
+    std::vector<Frame> frames;
+    size_t start = 0;
+
+    *broken = 0;
+    while (start < stream.size()) {
+        size_t end = stream.find('\0', start);
+        std::string decoded;
+
+        if (std::string::npos == end)
+            end = stream.size();
+        // Empty chunk is the delimiter before the first frame.
+        if (end == start) {
+            start = end + 1;
+            continue;
+        }
+
+        for (size_t i = start; i < end;) {
+            const unsigned int code = static_cast<uint8_t>(stream[i]);
+
+            decoded.append(stream, i + 1, std::min<size_t>(code - 1, end - i - 1));
+            i += code;
+            if (code < 0xFF && i < end)
+                decoded.push_back('\0');
+        }
+        start = end + 1;
+
+        const uint8_t *data = reinterpret_cast<const uint8_t*>(decoded.data());
+        if (decoded.size() < 4
+                || murasaki::FramedConsole::Crc16(data, decoded.size() - 2)
+                        != (data[decoded.size() - 2] | (data[decoded.size() - 1] << 8))) {
+            (*broken)++;
+            continue;
+        }
+        frames.push_back(Frame { data[0], data[1], decoded.substr(2, decoded.size() - 4) });
+    }
+    return frames;
+}
+
+// Print a row of the result.
+static void Report(const char *name, unsigned int bytes, uint64_t host_ns)
+{
+    printf("%s,%u,%u,%.1f,%.1f\n",
+           name,
+           records,
+           bytes,
+           static_cast<double>(bytes) / records,
+           static_cast<double>(host_ns) / records);
+}
+
+static int FormatSample(char *line, unsigned int size, const Sample &sample)
+{
+    return snprintf(line, size, "tick %u count %u load %u\n", sample.tick, sample.count, sample.load);
+}
+
+static void BenchmarkTask(void *ptr)
+{
+    const bool raw = nullptr != ptr;
+    char line[64];
+    uint64_t start;
+    unsigned int broken;
+
+    // CRC-16/CCITT-FALSE check value.
+    Check(0x29B1 == murasaki::FramedConsole::Crc16(reinterpret_cast<const uint8_t*>("123456789"), 9), "CRC check value");
+
+    // Text on the console, as the Printf() does.
+    {
+        CaptureUart uart;
+        murasaki::UartLogger logger(&uart);
+
+        start = NowNs();
+        for (unsigned int i = 0; i < records; i++)
+            logger.putMessage(line, FormatSample(line, sizeof(line), MakeSample(i)));
+        if (!raw)
+            Report("text_printf", uart.captured.size(), NowNs() - start);
+    }
+
+    // Same text in the channel 0.
+    {
+        CaptureUart uart;
+        murasaki::FramedConsole console(&uart);
+        std::string text;
+        std::vector<Frame> frames;
+
+        start = NowNs();
+        for (unsigned int i = 0; i < records; i++)
+            console.putMessage(line, FormatSample(line, sizeof(line), MakeSample(i)));
+        if (!raw)
+            Report("text_framed", uart.captured.size(), NowNs() - start);
+
+        frames = Decode(uart.captured, &broken);
+        Check(0 == broken, "text_framed CRC");
+        Check(frames.size() == records, "text_framed frames");
+        for (unsigned int i = 0; i < frames.size(); i++) {
+            Check(FRAMED_CONSOLE_CHANNEL_TEXT == frames[i].channel, "text_framed channel");
+            Check((i & 0xFF) == frames[i].sequence, "text_framed sequence");
+            text += frames[i].payload;
+        }
+        for (unsigned int i = 0, position = 0; i < records; i++) {
+            const int length = FormatSample(line, sizeof(line), MakeSample(i));
+
+            if (0 != text.compare(position, length, line)) {
+                Check(false, "text_framed data");
+                break;
+            }
+            position += length;
+        }
+    }
+
+    // Binary records in the channel 1. Written in the transmission buffer.
+    {
+        CaptureUart uart;
+        murasaki::FramedConsole console(&uart);
+        std::vector<Frame> frames;
+
+        start = NowNs();
+        for (unsigned int i = 0; i < records; i++) {
+            Sample *sample = reinterpret_cast<Sample*>(console.Begin(FRAMED_CONSOLE_CHANNEL_TELEMETRY));
+
+            *sample = MakeSample(i);
+            console.End(sizeof(Sample));
+        }
+        if (!raw)
+            Report("binary_framed", uart.captured.size(), NowNs() - start);
+        Check(console.GetFrameCount() == records, "binary_framed frame count");
+        Check(console.GetByteCount() == uart.captured.size(), "binary_framed byte count");
+
+        frames = Decode(uart.captured, &broken);
+        Check(0 == broken, "binary_framed CRC");
+        Check(frames.size() == records, "binary_framed frames");
+        for (unsigned int i = 0; i < frames.size(); i++) {
+            const Sample expected = MakeSample(i);
+
+            Check(FRAMED_CONSOLE_CHANNEL_TELEMETRY == frames[i].channel
+                          && (i & 0xFF) == frames[i].sequence
+                          && frames[i].payload.size() == sizeof(Sample)
+                          && 0 == memcmp(frames[i].payload.data(), &expected, sizeof(Sample)),
+                  "binary_framed data");
+        }
+
+        // A broken byte is found by the CRC. The next frame is received.
+        uart.captured[10] ^= 0x40;
+        frames = Decode(uart.captured, &broken);
+        Check(1 == broken && frames.size() == records - 1, "broken frame");
+    }
+
+    // Text and records interleaved, for the host tool.
+    if (raw) {
+        CaptureUart uart;
+        murasaki::FramedConsole console(&uart);
+
+        for (unsigned int i = 0; i < records; i++) {
+            const Sample sample = MakeSample(i);
+
+            console.putMessage(line, FormatSample(line, sizeof(line), sample));
+            console.Send(FRAMED_CONSOLE_CHANNEL_TELEMETRY, &sample, sizeof(sample));
+        }
+        fwrite(uart.captured.data(), 1, uart.captured.size(), stdout);
+    }
+
+    fflush(stdout);
+    exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+    bool raw = false;
+
+    if (argc > 1 && 0 == strcmp(argv[1], "--raw")) {
+        raw = true;
+        argc--;
+        argv++;
+    }
+    if (argc > 1)
+        records = atoi(argv[1]);
+    if (records == 0)
+        records = 1;
+
+    if (!raw)
+        printf("benchmark,records,bytes,bytes_per_record,host_ns_per_record\n");
+
+    // The non null parameter selects the raw output.
+    xTaskCreate(BenchmarkTask, "bench", configMINIMAL_STACK_SIZE * 4, raw ? &raw : nullptr, tskIDLE_PRIORITY + 1, nullptr);
+    vTaskStartScheduler();
+
+    // Never reach here.
+    return EXIT_FAILURE;
+}
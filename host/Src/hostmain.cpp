@@ -0,0 +1,161 @@
+/**
+ * @file hostmain.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief main() of the host build of the platform.
+ * @details
+ * Runs the InitPlatform() and ExecPlatform() of the nucleo-f446-64 project on the host,
+ * as the main.c of the project does. The console UART is connected to the standard input and output.
+ *
+ * The I2C1 is connected to a simulated bus with following devices :
+ * @li 0x1A : Register file. Same address with the audio codec.
+ * @li 0x48 : Register file. Same address with the temperature sensor.
+ *
+ * Usage : sample [--press ms] [--run ms]
+ * @li --press : Push the blue button after given time [mS]. Default is 1000. 0 to disable.
+ * @li --run : Exit after given time [mS]. Default is 0, run forever.
+ */
+
+#include "main.h"
+#include "murasaki_platform.hpp"
+#include "i2csimulator.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Peripheral handles. Defined by the main.c in the project.
+I2C_HandleTypeDef hi2c1;
+UART_HandleTypeDef huart2;
+
+// Firmware image and .data of the sample. 1KB code, followed by the 256 bytes initial values of the .data.
+// The g_pfnVectors and _sdata of the linker script are renamed to these by the Makefile.
+extern "C" const uint32_t host_image[256 + 64] = { 0x20020000, 0x08000199 };
+extern "C" uint32_t host_data[64];
+uint32_t host_data[64];
+// The _sidata and _edata, at the end of the code and of the .data.
+__asm__(".globl host_sidata\n"
+        ".set host_sidata, host_image + 1024\n"
+        ".globl host_edata\n"
+        ".set host_edata, host_data + 256\n");
+
+// Wiring of the I2C1. Pulled up on the board.
+#define HOST_I2C_SCL_PORT GPIOB
+#define HOST_I2C_SCL_PIN GPIO_PIN_8
+#define HOST_I2C_SDA_PORT GPIOB
+#define HOST_I2C_SDA_PIN GPIO_PIN_9
+
+static unsigned int press_ms = 1000;
+static unsigned int run_ms = 0;
+
+// Same configuration with the main.c of the project.
+static void MX_I2C1_Init(void)
+{
+    hi2c1.Instance = I2C1;
+    hi2c1.Init.ClockSpeed = 100000;
+    hi2c1.Init.DutyCycle = I2C_DUTYCYCLE_2;
+    hi2c1.Init.OwnAddress1 = 0;
+    hi2c1.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+    hi2c1.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+    hi2c1.Init.OwnAddress2 = 0;
+    hi2c1.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+    hi2c1.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+    if (HAL_I2C_Init(&hi2c1) != HAL_OK)
+        Error_Handler();
+}
+
+static void MX_USART2_UART_Init(void)
+{
+    huart2.Instance = USART2;
+    huart2.Init.BaudRate = 115200;
+    huart2.Init.WordLength = UART_WORDLENGTH_8B;
+    huart2.Init.StopBits = UART_STOPBITS_1;
+    huart2.Init.Parity = UART_PARITY_NONE;
+    huart2.Init.Mode = UART_MODE_TX_RX;
+    huart2.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+    huart2.Init.OverSampling = UART_OVERSAMPLING_16;
+    if (HAL_UART_Init(&huart2) != HAL_OK)
+        Error_Handler();
+}
+
+// The levels of the pulled up input.
+static void MX_GPIO_Init(void)
+{
+    B1_GPIO_Port->IDR |= B1_Pin;
+    HOST_I2C_SCL_PORT->IDR |= HOST_I2C_SCL_PIN;
+    HOST_I2C_SDA_PORT->IDR |= HOST_I2C_SDA_PIN;
+}
+
+// Devices on the simulated I2C1 bus.
+static void AttachI2cDevices(void)
+{
+    murasaki::I2cSimulator *bus = new murasaki::I2cSimulator(hi2c1.Init.ClockSpeed);
+    murasaki::I2cRegisterFileSlave *codec = new murasaki::I2cRegisterFileSlave(0x60);
+    murasaki::I2cRegisterFileSlave *sensor = new murasaki::I2cRegisterFileSlave();
+
+    bus->Attach(0x1A, codec);
+    bus->Attach(0x48, sensor);
+    HostAttachI2c(&hi2c1, bus);
+}
+
+void Error_Handler(void)
+{
+    fprintf(stderr, "Error_Handler() is called\n");
+    exit(EXIT_FAILURE);
+}
+
+// Operation of the user. The button and the time limit.
+static void OperatorTask(void *ptr)
+{
+    TickType_t start = xTaskGetTickCount();
+
+    if (press_ms > 0) {
+        vTaskDelay(pdMS_TO_TICKS(press_ms));
+        HostPressButton(B1_GPIO_Port, B1_Pin);
+    }
+
+    if (run_ms == 0)
+        vTaskDelete(nullptr);
+
+    vTaskDelayUntil(&start, pdMS_TO_TICKS(run_ms));
+    fflush(stdout);
+    exit(EXIT_SUCCESS);
+}
+
+static void StartDefaultTask(void *argument)
+{
+    HostStartInterruptTask();
+    InitPlatform();
+    ExecPlatform();
+}
+
+int main(int argc, char *argv[])
+{
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (0 == strcmp(argv[i], "--press"))
+            press_ms = atoi(argv[i + 1]);
+        else if (0 == strcmp(argv[i], "--run"))
+            run_ms = atoi(argv[i + 1]);
+        else {
+            fprintf(stderr, "Usage : %s [--press ms] [--run ms]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    MX_GPIO_Init();
+    MX_I2C1_Init();
+    MX_USART2_UART_Init();
+    AttachI2cDevices();
+
+    // Same priority with the defaultTask of the main.c ( osPriorityNormal ).
+    xTaskCreate(StartDefaultTask, "defaultTask", configMINIMAL_STACK_SIZE * 4, nullptr, tskIDLE_PRIORITY + 3, nullptr);
+    xTaskCreate(OperatorTask, "operator", configMINIMAL_STACK_SIZE, nullptr, tskIDLE_PRIORITY + 1, nullptr);
+    vTaskStartScheduler();
+
+    // Never reach here.
+    return EXIT_FAILURE;
+}
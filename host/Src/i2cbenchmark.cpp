@@ -0,0 +1,216 @@
+/**
+ * @file i2cbenchmark.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Throughput and latency benchmark of the I2C stack on the host.
+ * @details
+ * Runs the I2C platform classes on the @ref murasaki::I2cSimulator, and prints the result as CSV :
+ *
+ * @li benchmark : Name of the benchmark.
+ * @li iterations : Number of the operations.
+ * @li host_ns_per_op : Host CPU time per operation [nS]. The software overhead of the stack.
+ * @li bus_us_per_op : Simulated bus time per operation [uS]. The latency on the real bus.
+ * @li transactions_per_op : I2C transactions per operation.
+ *
+ * The data read back is checked. The exit status is not zero if a check failed.
+ *
+ * Usage : i2c_bench [iterations]
+ */
+
+#include "murasaki.hpp"
+
+#include "i2cregistermap.hpp"
+#include "i2cscanner.hpp"
+#include "i2csimulator.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Essential definition. murasaki_platform.cpp is not linked to the benchmark.
+murasaki::Platform murasaki::platform;
+murasaki::Debugger *murasaki::debugger;
+
+// Device addresses on the simulated bus.
+#define SENSOR_ADDRS 0x48       // Register file.
+#define SLOW_SENSOR_ADDRS 0x50  // Register file with the clock stretching.
+#define CODEC_ADDRS 0x1A        // Register file. Used by the I2cRegisterMap benchmarks.
+#define ABSENT_ADDRS 0x10       // Nobody.
+
+// Simulated bus speed [Hz].
+#define BUS_SPEED 400000
+
+// Clock stretching of the slow sensor [nS/byte].
+#define SLOW_SENSOR_STRETCH 5000
+
+static unsigned int iterations = 10000;
+static unsigned int failures = 0;
+
+static uint64_t NowNs()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+static void Check(bool condition, const char *message)
+{
+    if (!condition) {
+        fprintf(stderr, "CHECK FAILED : %s\n", message);
+        failures++;
+    }
+}
+
+// Print a row of the result.
+static void Report(const char *name, unsigned int count, uint64_t host_ns, murasaki::I2cSimulator *bus)
+{
+    printf("%s,%u,%.1f,%.2f,%.2f\n",
+           name,
+           count,
+           static_cast<double>(host_ns) / count,
+           static_cast<double>(bus->GetBusTime()) / 1000 / count,
+           static_cast<double>(bus->GetTransactionCount()) / count);
+}
+
+static void BenchmarkTask(void *ptr)
+{
+    murasaki::I2cSimulator *bus = new murasaki::I2cSimulator(BUS_SPEED);
+    murasaki::I2cRegisterFileSlave *sensor = new murasaki::I2cRegisterFileSlave();
+    murasaki::I2cRegisterFileSlave *slow_sensor = new murasaki::I2cRegisterFileSlave();
+    murasaki::I2cRegisterFileSlave *codec = new murasaki::I2cRegisterFileSlave(0x60);
+    uint8_t buffer[16];
+    uint8_t reg;
+    uint64_t start;
+
+    bus->Attach(SENSOR_ADDRS, sensor);
+    bus->Attach(SLOW_SENSOR_ADDRS, slow_sensor);
+    bus->Attach(CODEC_ADDRS, codec);
+    slow_sensor->SetStretch(SLOW_SENSOR_STRETCH);
+    for (unsigned int i = 0; i < 256; i++) {
+        sensor->SetRegister(i, i);
+        slow_sensor->SetRegister(i, ~i);
+    }
+
+    printf("benchmark,iterations,host_ns_per_op,bus_us_per_op,transactions_per_op\n");
+
+    // Single byte write.
+    bus->ResetStatistics();
+    buffer[0] = 0x00;
+    start = NowNs();
+    for (unsigned int i = 0; i < iterations; i++)
+        bus->Transmit(SENSOR_ADDRS, buffer, 1);
+    Report("transmit_1", iterations, NowNs() - start, bus);
+
+    // Register pointer write, then 16 bytes read.
+    bus->ResetStatistics();
+    reg = 0x20;
+    start = NowNs();
+    for (unsigned int i = 0; i < iterations; i++)
+        bus->TransmitThenReceive(SENSOR_ADDRS, &reg, 1, buffer, 16);
+    Report("write_read_16", iterations, NowNs() - start, bus);
+    Check(buffer[0] == 0x20 && buffer[15] == 0x2F, "write_read_16 data");
+
+    // Same with the clock stretching device.
+    bus->ResetStatistics();
+    start = NowNs();
+    for (unsigned int i = 0; i < iterations; i++)
+        bus->TransmitThenReceive(SLOW_SENSOR_ADDRS, &reg, 1, buffer, 16);
+    Report("stretch_write_read_16", iterations, NowNs() - start, bus);
+    Check(buffer[0] == static_cast<uint8_t>(~0x20), "stretch_write_read_16 data");
+
+    // Address only probe of the absent device.
+    bus->ResetStatistics();
+    start = NowNs();
+    for (unsigned int i = 0; i < iterations; i++)
+        bus->Transmit(ABSENT_ADDRS, buffer, 0);
+    Report("probe_absent", iterations, NowNs() - start, bus);
+    Check(murasaki::ki2csNak == bus->Transmit(ABSENT_ADDRS, buffer, 0), "probe_absent NAK");
+
+    // Full bus scan.
+    {
+        murasaki::I2cScanner *scanner = new murasaki::I2cScanner(bus);
+        const unsigned int count = iterations / 100 + 1;
+
+        bus->ResetStatistics();
+        start = NowNs();
+        for (unsigned int i = 0; i < count; i++)
+            scanner->Scan();
+        Report("scanner_scan", count, NowNs() - start, bus);
+        Check(3 == scanner->GetDeviceCount(), "scanner_scan device count");
+        Check(scanner->IsPresent(CODEC_ADDRS) && !scanner->IsPresent(ABSENT_ADDRS), "scanner_scan result");
+
+        delete scanner;
+    }
+
+    // Register map. All registers are volatile. Every read goes to the bus.
+    {
+        murasaki::I2cRegisterMap *map = new murasaki::I2cRegisterMap(bus, CODEC_ADDRS, 0x60);
+
+        map->SetVolatile(0x00, 0x5F);
+        bus->ResetStatistics();
+        start = NowNs();
+        for (unsigned int i = 0; i < iterations; i++)
+            map->Read(i % 0x60, buffer);
+        Report("regmap_read_volatile", iterations, NowNs() - start, bus);
+
+        delete map;
+    }
+
+    // Register map. Served from the cache after the first read.
+    {
+        murasaki::I2cRegisterMap *map = new murasaki::I2cRegisterMap(bus, CODEC_ADDRS, 0x60);
+
+        bus->ResetStatistics();
+        start = NowNs();
+        for (unsigned int i = 0; i < iterations; i++)
+            map->Read(i % 0x60, buffer);
+        Report("regmap_read_cached", iterations, NowNs() - start, bus);
+
+        // Read-modify-write. Write through. Half of them don't change the value.
+        bus->ResetStatistics();
+        start = NowNs();
+        for (unsigned int i = 0; i < iterations; i++)
+            map->UpdateBits(0x10, 0x01, (i / 2) & 1);
+        Report("regmap_update_bits", iterations, NowNs() - start, bus);
+        Check(codec->GetRegister(0x10) == (((iterations - 1) / 2) & 1), "regmap_update_bits data");
+
+        delete map;
+    }
+
+    // Register map. 16 registers are written back by a burst.
+    {
+        murasaki::I2cRegisterMap *map = new murasaki::I2cRegisterMap(bus, CODEC_ADDRS, 0x60, true);
+        const unsigned int count = iterations / 16 + 1;
+
+        bus->ResetStatistics();
+        start = NowNs();
+        for (unsigned int i = 0; i < count; i++) {
+            for (unsigned int r = 0; r < 16; r++)
+                map->Write(0x20 + r, i + r);
+            map->Flush();
+        }
+        Report("regmap_write_back_16", count, NowNs() - start, bus);
+        Check(codec->GetRegister(0x2F) == static_cast<uint8_t>(count - 1 + 15), "regmap_write_back_16 data");
+
+        delete map;
+    }
+
+    fflush(stdout);
+    exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+        iterations = atoi(argv[1]);
+    if (iterations == 0)
+        iterations = 1;
+
+    xTaskCreate(BenchmarkTask, "bench", configMINIMAL_STACK_SIZE * 4, nullptr, tskIDLE_PRIORITY + 1, nullptr);
+    vTaskStartScheduler();
+
+    // Never reach here.
+    return EXIT_FAILURE;
+}
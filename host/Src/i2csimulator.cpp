@@ -0,0 +1,331 @@
+/**
+ * @file i2csimulator.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host side I2C bus simulator with virtual slave devices.
+ */
+
+#include "i2csimulator.hpp"
+
+#include <string.h>
+
+namespace murasaki {
+
+/* ------------------------- I2cVirtualSlave ------------------------------ */
+
+I2cVirtualSlave::I2cVirtualSlave()
+        :
+        address_nak_(false),
+        data_nak_after_(-1),
+        stretch_ns_(0),
+        fault_status_(ki2csOK),
+        fault_count_(0)
+{
+}
+
+I2cVirtualSlave::~I2cVirtualSlave()
+{
+}
+
+void I2cVirtualSlave::OnStart(bool read)
+{
+}
+
+void I2cVirtualSlave::OnStop()
+{
+}
+
+void I2cVirtualSlave::SetAddressNak(bool nak)
+{
+    address_nak_ = nak;
+}
+
+void I2cVirtualSlave::SetDataNakAfter(int bytes)
+{
+    data_nak_after_ = bytes;
+}
+
+void I2cVirtualSlave::SetStretch(unsigned int ns_per_byte)
+{
+    stretch_ns_ = ns_per_byte;
+}
+
+void I2cVirtualSlave::InjectFault(I2cStatus status, unsigned int count)
+{
+    fault_status_ = status;
+    fault_count_ = count;
+}
+
+/* ----------------------- I2cRegisterFileSlave --------------------------- */
+
+I2cRegisterFileSlave::I2cRegisterFileSlave(unsigned int num_registers)
+        :
+        num_registers_(num_registers),
+        pointer_(0),
+        pointer_phase_(false)
+{
+    MURASAKI_ASSERT(0 < num_registers_ && num_registers_ <= 256)
+
+    ::memset(registers_, 0, sizeof(registers_));
+}
+
+I2cRegisterFileSlave::~I2cRegisterFileSlave()
+{
+}
+
+void I2cRegisterFileSlave::OnStart(bool read)
+{
+    // The first byte of a write transaction is the register pointer.
+    pointer_phase_ = !read;
+}
+
+bool I2cRegisterFileSlave::OnWrite(uint8_t data)
+{
+    if (pointer_phase_) {
+        pointer_ = data % num_registers_;
+        pointer_phase_ = false;
+    }
+    else {
+        registers_[pointer_] = data;
+        pointer_ = (pointer_ + 1) % num_registers_;
+    }
+    return true;
+}
+
+uint8_t I2cRegisterFileSlave::OnRead()
+{
+    uint8_t data = registers_[pointer_];
+
+    pointer_ = (pointer_ + 1) % num_registers_;
+    return data;
+}
+
+void I2cRegisterFileSlave::SetRegister(unsigned int reg, uint8_t value)
+{
+    MURASAKI_ASSERT(reg < num_registers_)
+    registers_[reg] = value;
+}
+
+uint8_t I2cRegisterFileSlave::GetRegister(unsigned int reg) const
+{
+    MURASAKI_ASSERT(reg < num_registers_)
+    return registers_[reg];
+}
+
+/* ---------------------------- I2cSimulator ------------------------------ */
+
+I2cSimulator::I2cSimulator(unsigned int bus_speed)
+        :
+        bus_speed_(bus_speed),
+        critical_section_(new CriticalSection()),
+        bus_time_ns_(0),
+        transactions_(0)
+{
+    MURASAKI_ASSERT(0 < bus_speed_)
+    MURASAKI_ASSERT(nullptr != critical_section_)
+
+    for (unsigned int i = 0; i < 128; i++)
+        slaves_[i] = nullptr;
+}
+
+I2cSimulator::~I2cSimulator()
+{
+    delete critical_section_;
+}
+
+void I2cSimulator::Attach(unsigned int addrs, I2cVirtualSlave *slave)
+{
+    MURASAKI_ASSERT(addrs < 128)
+
+    critical_section_->Enter();
+    slaves_[addrs] = slave;
+    critical_section_->Leave();
+}
+
+I2cStatus I2cSimulator::Transmit(
+                                 unsigned int addrs,
+                                 const uint8_t *tx_data,
+                                 unsigned int tx_size,
+                                 unsigned int *transfered_count,
+                                 unsigned int timeout_ms)
+{
+    return DoTransaction(addrs, tx_data, tx_size, nullptr, 0, false, transfered_count, nullptr, timeout_ms);
+}
+
+I2cStatus I2cSimulator::Receive(
+                                unsigned int addrs,
+                                uint8_t *rx_data,
+                                unsigned int rx_size,
+                                unsigned int *transfered_count,
+                                unsigned int timeout_ms)
+{
+    return DoTransaction(addrs, nullptr, 0, rx_data, rx_size, true, nullptr, transfered_count, timeout_ms);
+}
+
+I2cStatus I2cSimulator::TransmitThenReceive(
+                                            unsigned int addrs,
+                                            const uint8_t *tx_data,
+                                            unsigned int tx_size,
+                                            uint8_t *rx_data,
+                                            unsigned int rx_size,
+                                            unsigned int *tx_transfered_count,
+                                            unsigned int *rx_transfered_count,
+                                            unsigned int timeout_ms)
+{
+    MURASAKI_ASSERT(0 < tx_size)
+
+    return DoTransaction(
+                         addrs,
+                         tx_data,
+                         tx_size,
+                         rx_data,
+                         rx_size,
+                         true,
+                         tx_transfered_count,
+                         rx_transfered_count,
+                         timeout_ms);
+}
+
+bool I2cSimulator::TransmitCompleteCallback(void *ptr)
+{
+    return false;
+}
+
+bool I2cSimulator::ReceiveCompleteCallback(void *ptr)
+{
+    return false;
+}
+
+bool I2cSimulator::HandleError(void *ptr)
+{
+    return false;
+}
+
+uint64_t I2cSimulator::GetBusTime() const
+{
+    return bus_time_ns_;
+}
+
+unsigned int I2cSimulator::GetTransactionCount() const
+{
+    return transactions_;
+}
+
+void I2cSimulator::ResetStatistics()
+{
+    critical_section_->Enter();
+    bus_time_ns_ = 0;
+    transactions_ = 0;
+    critical_section_->Leave();
+}
+
+I2cStatus I2cSimulator::DoTransaction(
+                                      unsigned int addrs,
+                                      const uint8_t *tx_data,
+                                      unsigned int tx_size,
+                                      uint8_t *rx_data,
+                                      unsigned int rx_size,
+                                      bool has_rx_phase,
+                                      unsigned int *tx_transfered_count,
+                                      unsigned int *rx_transfered_count,
+                                      unsigned int timeout_ms)
+{
+    MURASAKI_ASSERT(addrs < 128)
+
+    const uint64_t bit_ns = 1000000000ull / bus_speed_;
+    const uint64_t timeout_ns = (kwmsIndefinitely == timeout_ms) ? UINT64_MAX : timeout_ms * 1000000ull;
+    const bool has_tx_phase = (0 < tx_size) || !has_rx_phase;
+    I2cStatus status = ki2csOK;
+    unsigned int tx_count = 0;
+    unsigned int rx_count = 0;
+    uint64_t stretch_ns = 0;
+
+    critical_section_->Enter();
+
+    I2cVirtualSlave *const slave = slaves_[addrs];
+    uint64_t time_ns = bit_ns;  // START condition.
+    transactions_++;
+
+    if (nullptr != slave && 0 < slave->fault_count_) {
+        // Scripted failure. The bus is occupied until the timeout, in case of the timeout.
+        slave->fault_count_--;
+        status = slave->fault_status_;
+        time_ns += ByteTime(slave);
+        if (ki2csTimeOut == status && UINT64_MAX != timeout_ns)
+            time_ns += timeout_ns;
+    }
+    else if (nullptr == slave || slave->address_nak_) {
+        time_ns += 9 * bit_ns;  // Address byte with NAK.
+        status = ki2csNak;
+    }
+    else {
+        // Write phase.
+        if (has_tx_phase) {
+            slave->OnStart(false);
+            time_ns += ByteTime(slave);
+            stretch_ns += slave->stretch_ns_;
+
+            for (; tx_count < tx_size && ki2csOK == status; tx_count++) {
+                time_ns += ByteTime(slave);
+                stretch_ns += slave->stretch_ns_;
+                if (stretch_ns > timeout_ns)
+                    status = ki2csTimeOut;
+                else if (0 <= slave->data_nak_after_ && tx_count >= static_cast<unsigned int>(slave->data_nak_after_))
+                    status = ki2csNak;
+                else if (!slave->OnWrite(tx_data[tx_count]))
+                    status = ki2csNak;
+            }
+            // The byte which failed is not counted as transfered.
+            if (ki2csOK != status)
+                tx_count--;
+        }
+
+        // Read phase, after the repeated START if needed.
+        if (has_rx_phase && ki2csOK == status) {
+            if (has_tx_phase)
+                time_ns += bit_ns;
+            slave->OnStart(true);
+            time_ns += ByteTime(slave);
+            stretch_ns += slave->stretch_ns_;
+
+            for (; rx_count < rx_size && ki2csOK == status; rx_count++) {
+                time_ns += ByteTime(slave);
+                stretch_ns += slave->stretch_ns_;
+                if (stretch_ns > timeout_ns)
+                    status = ki2csTimeOut;
+                else
+                    rx_data[rx_count] = slave->OnRead();
+            }
+            if (ki2csOK != status)
+                rx_count--;
+        }
+
+        slave->OnStop();
+    }
+
+    time_ns += bit_ns;  // STOP condition.
+    bus_time_ns_ += time_ns;
+
+    critical_section_->Leave();
+
+    if (nullptr != tx_transfered_count)
+        *tx_transfered_count = tx_count;
+    if (nullptr != rx_transfered_count)
+        *rx_transfered_count = rx_count;
+
+    return status;
+}
+
+uint64_t I2cSimulator::ByteTime(const I2cVirtualSlave *slave) const
+{
+    // 8 data bits and ACK.
+    return 9 * 1000000000ull / bus_speed_ + slave->stretch_ns_;
+}
+
+void* I2cSimulator::GetPeripheralHandle()
+{
+    return this;
+}
+
+} /* namespace murasaki */
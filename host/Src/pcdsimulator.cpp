@@ -0,0 +1,397 @@
+/**
+ * @file pcdsimulator.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host side USB host model on the PCD stub.
+ */
+
+#include "pcdsimulator.hpp"
+
+#include <string.h>
+
+// Standard requests.
+#define REQUEST_SET_ADDRESS 0x05
+#define REQUEST_GET_DESCRIPTOR 0x06
+#define REQUEST_SET_CONFIGURATION 0x09
+// CDC requests.
+#define REQUEST_SET_LINE_CODING 0x20
+#define REQUEST_SET_CONTROL_LINE_STATE 0x22
+
+#define DESCRIPTOR_DEVICE 0x01
+#define DESCRIPTOR_CONFIGURATION 0x02
+#define DESCRIPTOR_ENDPOINT 0x05
+
+// Address given by Enumerate().
+#define DEVICE_ADDRESS 5
+// Max packet of the EP0 before the device descriptor is read.
+#define DEFAULT_PACKET_SIZE 64
+
+// Length of a frame [nS].
+#define FRAME_NS 1000000ull
+
+namespace murasaki {
+
+PcdSimulator::PcdSimulator(PCD_HandleTypeDef *hpcd)
+        :
+        hpcd_(hpcd),
+        data_in_(0),
+        data_out_(0),
+        max_packet_(DEFAULT_PACKET_SIZE),
+        frames_(0),
+        packets_(0),
+        packets_in_frame_(0),
+        naks_(0)
+{
+    MURASAKI_ASSERT(nullptr != hpcd)
+    memset(device_descriptor_, 0, sizeof(device_descriptor_));
+}
+
+bool PcdSimulator::IsConnected() const
+{
+    return !(hpcd_->Instance->DCTL & USB_OTG_DCTL_SDIS);
+}
+
+void PcdSimulator::Reset()
+{
+    taskENTER_CRITICAL();
+    {
+        // The core drops all transfers, and the device goes back to the address 0.
+        hpcd_->USB_Address = 0;
+        hpcd_->Instance->DAINTMSK = 0;
+        hpcd_->Instance->DIEPENA = 0;
+        hpcd_->Instance->DOEPENA = 0;
+        hpcd_->ResetCallback(hpcd_);
+    }
+    taskEXIT_CRITICAL();
+}
+
+void PcdSimulator::Disconnect()
+{
+    taskENTER_CRITICAL();
+    {
+        hpcd_->Instance->DIEPENA = 0;
+        hpcd_->Instance->DOEPENA = 0;
+        hpcd_->DisconnectCallback(hpcd_);
+    }
+    taskEXIT_CRITICAL();
+}
+
+bool PcdSimulator::Enumerate()
+{
+    uint8_t buffer[255];
+    unsigned int count;
+
+    if (!IsConnected())
+        return false;
+
+    Reset();
+
+    // Ask 64 bytes as the Windows does. The device ends the transfer by a short packet.
+    if (!ControlTransfer(0x80, REQUEST_GET_DESCRIPTOR, DESCRIPTOR_DEVICE << 8, 0, buffer, 64, &count)
+            || count != sizeof(device_descriptor_))
+        return false;
+    memcpy(device_descriptor_, buffer, sizeof(device_descriptor_));
+
+    if (!ControlTransfer(0x00, REQUEST_SET_ADDRESS, DEVICE_ADDRESS, 0, nullptr, 0)
+            || hpcd_->USB_Address != DEVICE_ADDRESS)
+        return false;
+
+    // Header first, then the whole configuration.
+    if (!ControlTransfer(0x80, REQUEST_GET_DESCRIPTOR, DESCRIPTOR_CONFIGURATION << 8, 0, buffer, 9, &count)
+            || count != 9)
+        return false;
+    const unsigned int total = buffer[2] | (buffer[3] << 8);
+    if (total > sizeof(buffer)
+            || !ControlTransfer(0x80, REQUEST_GET_DESCRIPTOR, DESCRIPTOR_CONFIGURATION << 8, 0, buffer, total, &count)
+            || count != total)
+        return false;
+
+    // Take the bulk endpoints.
+    data_in_ = 0;
+    data_out_ = 0;
+    for (unsigned int i = 0; i + 1 < total && buffer[i] != 0; i += buffer[i]) {
+        if (buffer[i + 1] == DESCRIPTOR_ENDPOINT && (buffer[i + 3] & 0x03) == EP_TYPE_BULK) {
+            if (buffer[i + 2] & 0x80)
+                data_in_ = buffer[i + 2];
+            else
+                data_out_ = buffer[i + 2];
+            max_packet_ = buffer[i + 4] | (buffer[i + 5] << 8);
+        }
+    }
+    if (data_in_ == 0 || data_out_ == 0)
+        return false;
+
+    return ControlTransfer(0x00, REQUEST_SET_CONFIGURATION, buffer[5], 0, nullptr, 0);
+}
+
+bool PcdSimulator::ControlTransfer(
+                                   uint8_t request_type,
+                                   uint8_t request,
+                                   uint16_t value,
+                                   uint16_t index,
+                                   uint8_t *data,
+                                   uint16_t length,
+                                   unsigned int *transfered_count)
+{
+    const uint8_t setup[8] = {
+            request_type,
+            request,
+            static_cast<uint8_t>(value),
+            static_cast<uint8_t>(value >> 8),
+            static_cast<uint8_t>(index),
+            static_cast<uint8_t>(index >> 8),
+            static_cast<uint8_t>(length),
+            static_cast<uint8_t>(length >> 8) };
+    const unsigned int ep0_packet = hpcd_->IN_ep[0].maxpacket ? hpcd_->IN_ep[0].maxpacket : DEFAULT_PACKET_SIZE;
+    const uint32_t start = HAL_GetTick();
+    unsigned int transfered = 0;
+    unsigned int received;
+    uint8_t packet[DEFAULT_PACKET_SIZE];
+
+    if (transfered_count != nullptr)
+        *transfered_count = 0;
+
+    taskENTER_CRITICAL();
+    SetupToken(setup);
+    taskEXIT_CRITICAL();
+
+    if (length > 0 && (request_type & 0x80)) {
+        // IN data stage, until the short packet or the wLength.
+        do {
+            if (kprAck != WaitIn(0, packet, &received, start, PCD_SIMULATOR_CONTROL_TIMEOUT))
+                return false;
+            const unsigned int copy = received < length - transfered ? received : length - transfered;
+            memcpy(data + transfered, packet, copy);
+            transfered += copy;
+        } while (received == ep0_packet && transfered < length);
+
+        // OUT status stage.
+        if (kprAck != WaitOut(0, nullptr, 0, start, PCD_SIMULATOR_CONTROL_TIMEOUT))
+            return false;
+    }
+    else {
+        // OUT data stage.
+        while (transfered < length) {
+            const unsigned int size = length - transfered < ep0_packet ? length - transfered : ep0_packet;
+
+            if (kprAck != WaitOut(0, data + transfered, size, start, PCD_SIMULATOR_CONTROL_TIMEOUT))
+                return false;
+            transfered += size;
+        }
+
+        // IN status stage. A zero length packet.
+        if (kprAck != WaitIn(0, packet, &received, start, PCD_SIMULATOR_CONTROL_TIMEOUT) || received != 0)
+            return false;
+    }
+
+    if (transfered_count != nullptr)
+        *transfered_count = transfered;
+    return true;
+}
+
+bool PcdSimulator::SetLineCoding(unsigned int baud_rate)
+{
+    uint8_t line_coding[7] = {
+            static_cast<uint8_t>(baud_rate),
+            static_cast<uint8_t>(baud_rate >> 8),
+            static_cast<uint8_t>(baud_rate >> 16),
+            static_cast<uint8_t>(baud_rate >> 24),
+            0,      // 1 stop bit.
+            0,      // No parity.
+            8 };    // 8 data bits.
+
+    return ControlTransfer(0x21, REQUEST_SET_LINE_CODING, 0, 0, line_coding, sizeof(line_coding));
+}
+
+bool PcdSimulator::SetControlLineState(bool dtr)
+{
+    // DTR at bit 0, RTS at bit 1. The terminals assert both.
+    return ControlTransfer(0x21, REQUEST_SET_CONTROL_LINE_STATE, dtr ? 0x03 : 0x00, 0, nullptr, 0);
+}
+
+unsigned int PcdSimulator::BulkIn(uint8_t *data, unsigned int size, unsigned int timeout_ms)
+{
+    unsigned int transfered = 0;
+    unsigned int received;
+    uint8_t packet[DEFAULT_PACKET_SIZE];
+
+    MURASAKI_ASSERT(0 != data_in_)
+    MURASAKI_ASSERT(max_packet_ <= sizeof(packet))
+
+    while (transfered < size) {
+        if (kprAck != WaitIn(data_in_ & 0x0F, packet, &received, HAL_GetTick(), timeout_ms))
+            break;
+        CountPacket();
+
+        const unsigned int copy = received < size - transfered ? received : size - transfered;
+        memcpy(data + transfered, packet, copy);
+        transfered += copy;
+
+        // The short packet, or the zero length packet ends the transfer.
+        if (received < max_packet_)
+            break;
+    }
+    return transfered;
+}
+
+unsigned int PcdSimulator::BulkOut(const uint8_t *data, unsigned int size, unsigned int timeout_ms)
+{
+    unsigned int transfered = 0;
+
+    MURASAKI_ASSERT(0 != data_out_)
+
+    while (transfered < size) {
+        const unsigned int length = size - transfered < max_packet_ ? size - transfered : max_packet_;
+
+        if (kprAck != WaitOut(data_out_ & 0x0F, data + transfered, length, HAL_GetTick(), timeout_ms))
+            break;
+        CountPacket();
+        transfered += length;
+    }
+    return transfered;
+}
+
+const uint8_t* PcdSimulator::GetDeviceDescriptor() const
+{
+    return device_descriptor_;
+}
+
+uint64_t PcdSimulator::GetBusTime() const
+{
+    return frames_ * FRAME_NS;
+}
+
+unsigned int PcdSimulator::GetPacketCount() const
+{
+    return packets_;
+}
+
+unsigned int PcdSimulator::GetNakCount() const
+{
+    return naks_;
+}
+
+void PcdSimulator::ResetStatistics()
+{
+    frames_ = 0;
+    packets_ = 0;
+    packets_in_frame_ = 0;
+    naks_ = 0;
+}
+
+PcdSimulator::PacketResult PcdSimulator::InToken(uint8_t ep_num, uint8_t *data, unsigned int *length)
+{
+    PCD_EPTypeDef *ep = &hpcd_->IN_ep[ep_num];
+
+    if (!(hpcd_->Instance->DAINTMSK & (1U << ep_num)) || ep->is_stall)
+        return kprStall;
+    if (!(hpcd_->Instance->DIEPENA & (1U << ep_num)))
+        return kprNak;
+
+    const unsigned int remaining = ep->xfer_len - ep->xfer_count;
+
+    *length = remaining < ep->maxpacket ? remaining : ep->maxpacket;
+    if (*length > 0)
+        memcpy(data, ep->xfer_buff + ep->xfer_count, *length);
+    ep->xfer_count += *length;
+
+    // The last packet of the transfer. A transfer of zero byte is one zero length packet.
+    if (ep->xfer_count >= ep->xfer_len) {
+        CLEAR_BIT(hpcd_->Instance->DIEPENA, 1U << ep_num);
+        hpcd_->DataInStageCallback(hpcd_, ep_num);
+    }
+    return kprAck;
+}
+
+PcdSimulator::PacketResult PcdSimulator::OutToken(uint8_t ep_num, const uint8_t *data, unsigned int length)
+{
+    PCD_EPTypeDef *ep = &hpcd_->OUT_ep[ep_num];
+
+    if (!(hpcd_->Instance->DAINTMSK & (1U << (16 + ep_num))) || ep->is_stall)
+        return kprStall;
+    if (!(hpcd_->Instance->DOEPENA & (1U << ep_num)))
+        return kprNak;
+
+    // The core drops the bytes over the buffer.
+    const unsigned int room = ep->xfer_len - ep->xfer_count;
+    const unsigned int copy = length < room ? length : room;
+
+    if (copy > 0)
+        memcpy(ep->xfer_buff + ep->xfer_count, data, copy);
+    ep->xfer_count += copy;
+
+    // The short packet, or the full buffer completes the transfer.
+    if (length < ep->maxpacket || ep->xfer_count >= ep->xfer_len) {
+        CLEAR_BIT(hpcd_->Instance->DOEPENA, 1U << ep_num);
+        hpcd_->DataOutStageCallback(hpcd_, ep_num);
+    }
+    return kprAck;
+}
+
+void PcdSimulator::SetupToken(const uint8_t *setup)
+{
+    // The SETUP is always accepted. It clears the stall of the EP0.
+    hpcd_->IN_ep[0].is_stall = 0;
+    hpcd_->OUT_ep[0].is_stall = 0;
+    memcpy(hpcd_->Setup, setup, 8);
+    hpcd_->SetupStageCallback(hpcd_);
+}
+
+PcdSimulator::PacketResult PcdSimulator::WaitIn(
+                                                uint8_t ep_num,
+                                                uint8_t *data,
+                                                unsigned int *length,
+                                                uint32_t start,
+                                                unsigned int timeout_ms)
+{
+    while (true) {
+        PacketResult result;
+
+        taskENTER_CRITICAL();
+        result = InToken(ep_num, data, length);
+        taskEXIT_CRITICAL();
+
+        if (kprNak != result)
+            return result;
+        naks_++;
+        if (HAL_GetTick() - start >= timeout_ms)
+            return kprNak;
+        // Let the device task fill the endpoint.
+        taskYIELD();
+    }
+}
+
+PcdSimulator::PacketResult PcdSimulator::WaitOut(
+                                                 uint8_t ep_num,
+                                                 const uint8_t *data,
+                                                 unsigned int length,
+                                                 uint32_t start,
+                                                 unsigned int timeout_ms)
+{
+    while (true) {
+        PacketResult result;
+
+        taskENTER_CRITICAL();
+        result = OutToken(ep_num, data, length);
+        taskEXIT_CRITICAL();
+
+        if (kprNak != result)
+            return result;
+        naks_++;
+        if (HAL_GetTick() - start >= timeout_ms)
+            return kprNak;
+        taskYIELD();
+    }
+}
+
+void PcdSimulator::CountPacket()
+{
+    // A new frame starts at the first packet, and after the full frame.
+    if (0 == packets_in_frame_)
+        frames_++;
+    packets_in_frame_ = (packets_in_frame_ + 1) % PCD_SIMULATOR_PACKETS_PER_FRAME;
+    packets_++;
+}
+
+} /* namespace murasaki */
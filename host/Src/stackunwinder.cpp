@@ -0,0 +1,49 @@
+/**
+ * @file stackunwinder.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host implementation of the StackUnwinder.
+ * @details
+ * Replaces the stackunwinder.cpp of the project. The host addresses don't fit to 32bit,
+ * and there is no linker symbol of the Nucleo. The call chain is always empty. Use the debugger of the host.
+ */
+
+#include "stackunwinder.hpp"
+
+namespace murasaki {
+
+bool StackUnwinder::IsReturnAddress(uint32_t address)
+{
+    (void) address;
+    return false;
+}
+
+bool StackUnwinder::IsStackAddress(const void *address, unsigned int size)
+{
+    (void) address;
+    (void) size;
+    return false;
+}
+
+unsigned int StackUnwinder::Unwind(const uint32_t *stack_pointer, uint32_t *chain, unsigned int depth)
+{
+    (void) stack_pointer;
+    (void) chain;
+    (void) depth;
+    return 0;
+}
+
+unsigned int StackUnwinder::Here(uint32_t *chain, unsigned int depth)
+{
+    return Unwind(nullptr, chain, depth);
+}
+
+void StackUnwinder::Print(const uint32_t *chain, unsigned int count)
+{
+    (void) chain;
+    (void) count;
+    murasaki::debugger->Printf("Call chain : not available on the host\n");
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,54 @@
+/**
+ * @file statusled.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Host implementation of the StatusLed.
+ * @details
+ * Replaces the statusled.cpp of the project. The host has no timer interrupt. The pattern is
+ * kept, but the LED is not driven.
+ */
+
+#include "statusled.hpp"
+
+namespace murasaki {
+
+StatusLed *StatusLed::instance_ = nullptr;
+
+StatusLed::StatusLed(GPIO_TypeDef *port, uint16_t pin)
+        :
+        port_(port),
+        pin_(pin),
+        request_(kslOff),
+        pattern_(kslOff),
+        code_(0),
+        step_(0)
+{
+    MURASAKI_ASSERT(nullptr != port)
+    MURASAKI_ASSERT(nullptr == instance_)
+    instance_ = this;
+}
+
+void StatusLed::Start(StatusLedPattern pattern, unsigned int code)
+{
+    SetPattern(pattern, code);
+}
+
+void StatusLed::SetPattern(StatusLedPattern pattern, unsigned int code)
+{
+    MURASAKI_ASSERT(kslErrorCode != pattern || (1 <= code && code <= 15))
+
+    request_ = (code << 8) | pattern;
+    pattern_ = pattern;
+    code_ = code;
+}
+
+void StatusLed::Retime()
+{
+}
+
+void StatusLed::HandleInterrupt()
+{
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,1361 @@
+/**
+ * @file stm32f4xx_hal_stub.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Stub of the STM32 HAL for the host build.
+ * @details
+ * The peripheral models behind the stm32f4xx_hal.h. The completion of the interrupt
+ * transfer is signaled by the HAL callbacks, as the real HAL does :
+ *
+ * @li UART transmission is written to the standard output, and completes immediately.
+ * @li UART reception completes in the "host isr" task, when the standard input has data.
+ * @li I2C transfer is executed by the attached @ref murasaki::I2cSimulator, and completes immediately.
+ *     The time out of the simulator doesn't call any callback. The caller detects the time out.
+ * @li The EXTI callback is called by the "host isr" task.
+ * @li PCD transfer is kept in the endpoint of the handle. The @ref murasaki::PcdSimulator moves the data,
+ *     and calls the callbacks.
+ * @li ETH transmission is kept in the Tx descriptors of the handle. The @ref murasaki::EthSimulator takes the
+ *     frames, and clears the OWN bit. The PHY is always linked at 100Mbps full duplex.
+ * @li CRC is computed bit by bit by the write to the data register, with the polynomial size and the reversal
+ *     of the control register. Only the 32bit write is modeled.
+ *
+ * The murasaki library defines the callbacks. The weak definitions here are used by the programs
+ * which don't link the library.
+ */
+
+#include "stm32f4xx_hal.h"
+#include "i2csimulator.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Same with the Nucleo F446RE. Referred to convert the cycles and time.
+uint32_t SystemCoreClock = 180000000;
+
+DWT_Type host_dwt;
+CoreDebug_Type host_core_debug;
+SysTick_Type host_systick = { };
+GPIO_TypeDef host_gpio[8];
+USART_TypeDef host_usart[3];
+I2C_TypeDef host_i2c[3];
+// Disconnected until HAL_PCD_Start().
+USB_OTG_GlobalTypeDef host_usb_otg_fs = { USB_OTG_DCTL_SDIS };
+ETH_TypeDef host_eth;
+// Reset values. The DR is loaded from the INIT by the first reset.
+CRC_TypeDef host_crc = { HostCrcData(), 0, 0, 0, 0, 0, 0xFFFFFFFF, 0x04C11DB7 };
+
+// Number of the I2C and UART handles which can be modeled.
+#define HOST_MAX_HANDLES 4
+
+// Registers of the LAN8742A. Linked at 100Mbps full duplex by the auto negotiation.
+#define HOST_PHY_BSR 1
+#define HOST_PHY_BSR_VALUE 0x782D
+#define HOST_PHY_SCSR 31
+#define HOST_PHY_SCSR_VALUE 0x1058
+
+// Maximum length of the first frame of the sequential transfer.
+#define HOST_I2C_MAX_FIRST_FRAME 64
+
+namespace {
+
+// I2C handle and the simulated bus connected.
+struct HostI2cModel {
+    I2C_HandleTypeDef *hi2c;
+    murasaki::I2cSimulator *bus;
+    // First frame of the sequential transfer. Sent with the next frame by a repeated start.
+    uint8_t first_frame[HOST_I2C_MAX_FIRST_FRAME];
+    unsigned int first_frame_size;
+    bool first_frame_pending;
+};
+
+HostI2cModel i2c_models[HOST_MAX_HANDLES];
+
+// UART handles which have the reception on going.
+UART_HandleTypeDef *uart_receivers[HOST_MAX_HANDLES];
+bool stdin_closed = false;
+
+// EXTI request from the HostPressButton()
+GPIO_TypeDef *volatile button_port = nullptr;
+volatile uint16_t button_pin = 0;
+
+// The weak callbacks, as the HAL does at the initialization from the reset state.
+void InitUartCallbacks(UART_HandleTypeDef *huart)
+{
+    huart->TxCpltCallback = HAL_UART_TxCpltCallback;
+    huart->RxCpltCallback = HAL_UART_RxCpltCallback;
+    huart->ErrorCallback = HAL_UART_ErrorCallback;
+    huart->AbortCpltCallback = HAL_UART_AbortCpltCallback;
+    huart->AbortTransmitCpltCallback = HAL_UART_AbortTransmitCpltCallback;
+    huart->AbortReceiveCpltCallback = HAL_UART_AbortReceiveCpltCallback;
+    huart->RxEventCallback = HAL_UARTEx_RxEventCallback;
+}
+
+void InitI2cCallbacks(I2C_HandleTypeDef *hi2c)
+{
+    hi2c->MasterTxCpltCallback = HAL_I2C_MasterTxCpltCallback;
+    hi2c->MasterRxCpltCallback = HAL_I2C_MasterRxCpltCallback;
+    hi2c->SlaveTxCpltCallback = HAL_I2C_SlaveTxCpltCallback;
+    hi2c->SlaveRxCpltCallback = HAL_I2C_SlaveRxCpltCallback;
+    hi2c->ErrorCallback = HAL_I2C_ErrorCallback;
+    hi2c->AbortCpltCallback = HAL_I2C_AbortCpltCallback;
+}
+
+void InitPcdCallbacks(PCD_HandleTypeDef *hpcd)
+{
+    hpcd->SOFCallback = HAL_PCD_SOFCallback;
+    hpcd->SetupStageCallback = HAL_PCD_SetupStageCallback;
+    hpcd->ResetCallback = HAL_PCD_ResetCallback;
+    hpcd->SuspendCallback = HAL_PCD_SuspendCallback;
+    hpcd->ResumeCallback = HAL_PCD_ResumeCallback;
+    hpcd->ConnectCallback = HAL_PCD_ConnectCallback;
+    hpcd->DisconnectCallback = HAL_PCD_DisconnectCallback;
+    hpcd->DataOutStageCallback = HAL_PCD_DataOutStageCallback;
+    hpcd->DataInStageCallback = HAL_PCD_DataInStageCallback;
+}
+
+// Endpoint of the handle by the address. The bit 7 is the direction.
+PCD_EPTypeDef* FindEndpoint(PCD_HandleTypeDef *hpcd, uint8_t ep_addr)
+{
+    if (0x80 & ep_addr)
+        return &hpcd->IN_ep[ep_addr & 0x0F];
+    else
+        return &hpcd->OUT_ep[ep_addr & 0x0F];
+}
+
+// Bit of the endpoint in the DAINTMSK.
+uint32_t EndpointBit(uint8_t ep_addr)
+{
+    return (0x80 & ep_addr) ? 1U << (ep_addr & 0x0F) : 1U << (16 + (ep_addr & 0x0F));
+}
+
+HostI2cModel* FindI2cModel(I2C_HandleTypeDef *hi2c)
+{
+    for (auto &model : i2c_models)
+        if (model.hi2c == hi2c)
+            return &model;
+    return nullptr;
+}
+
+// Convert the result of the simulator to the HAL callback.
+void CompleteI2c(I2C_HandleTypeDef *hi2c, murasaki::I2cStatus status, bool receive)
+{
+    switch (status) {
+        case murasaki::ki2csOK:
+            hi2c->State = HAL_I2C_STATE_READY;
+            if (receive)
+                hi2c->MasterRxCpltCallback(hi2c);
+            else
+                hi2c->MasterTxCpltCallback(hi2c);
+            return;
+        case murasaki::ki2csTimeOut:
+            // Slave holds the bus. No interrupt comes.
+            return;
+        case murasaki::ki2csNak:
+            hi2c->ErrorCode |= HAL_I2C_ERROR_AF;
+            break;
+        case murasaki::ki2csBussError:
+            hi2c->ErrorCode |= HAL_I2C_ERROR_BERR;
+            break;
+        case murasaki::ki2csArbitrationLost:
+            hi2c->ErrorCode |= HAL_I2C_ERROR_ARLO;
+            break;
+        default:
+            hi2c->ErrorCode |= HAL_I2C_ERROR_OVR;
+            break;
+    }
+    hi2c->State = HAL_I2C_STATE_READY;
+    hi2c->ErrorCallback(hi2c);
+}
+
+// Start an interrupt / DMA transfer. The DevAddress is 8bit form, as the real HAL.
+HAL_StatusTypeDef StartI2c(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, bool receive,
+                           bool keep_first_frame)
+{
+    HostI2cModel *model = FindI2cModel(hi2c);
+    murasaki::I2cStatus status;
+
+    if (HAL_I2C_STATE_READY != hi2c->State)
+        return HAL_BUSY;
+
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    hi2c->Devaddress = DevAddress;
+    hi2c->Mode = HAL_I2C_MODE_MASTER;
+    hi2c->State = receive ? HAL_I2C_STATE_BUSY_RX : HAL_I2C_STATE_BUSY_TX;
+
+    if (nullptr == model) {
+        // Nothing is connected.
+        CompleteI2c(hi2c, murasaki::ki2csNak, receive);
+        return HAL_OK;
+    }
+
+    if (keep_first_frame && Size <= HOST_I2C_MAX_FIRST_FRAME) {
+        // Send later with the next frame.
+        ::memcpy(model->first_frame, pData, Size);
+        model->first_frame_size = Size;
+        model->first_frame_pending = true;
+        CompleteI2c(hi2c, murasaki::ki2csOK, false);
+        return HAL_OK;
+    }
+
+    if (receive && model->first_frame_pending)
+        status = model->bus->TransmitThenReceive(DevAddress >> 1, model->first_frame, model->first_frame_size, pData, Size);
+    else if (receive)
+        status = model->bus->Receive(DevAddress >> 1, pData, Size);
+    else
+        status = model->bus->Transmit(DevAddress >> 1, pData, Size);
+    model->first_frame_pending = false;
+
+    CompleteI2c(hi2c, status, receive);
+    return HAL_OK;
+}
+
+// Blocking transfer.
+HAL_StatusTypeDef PollI2c(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, bool receive)
+{
+    HostI2cModel *model = FindI2cModel(hi2c);
+    murasaki::I2cStatus status;
+
+    if (nullptr == model)
+        status = murasaki::ki2csNak;
+    else if (receive)
+        status = model->bus->Receive(DevAddress >> 1, pData, Size);
+    else
+        status = model->bus->Transmit(DevAddress >> 1, pData, Size);
+
+    switch (status) {
+        case murasaki::ki2csOK:
+            hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+            return HAL_OK;
+        case murasaki::ki2csTimeOut:
+            hi2c->ErrorCode = HAL_I2C_ERROR_TIMEOUT;
+            return HAL_TIMEOUT;
+        default:
+            hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+            return HAL_ERROR;
+    }
+}
+
+HAL_StatusTypeDef StartUartReceive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t type)
+{
+    if (HAL_UART_STATE_READY != huart->RxState)
+        return HAL_BUSY;
+
+    huart->pRxBuffPtr = pData;
+    huart->RxXferSize = Size;
+    huart->RxXferCount = Size;
+    huart->ReceptionType = type;
+    huart->ErrorCode = HAL_UART_ERROR_NONE;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+
+    taskENTER_CRITICAL();
+    for (auto &receiver : uart_receivers)
+        if (nullptr == receiver || huart == receiver) {
+            receiver = huart;
+            break;
+        }
+    taskEXIT_CRITICAL();
+    return HAL_OK;
+}
+
+// Move the data from the standard input to the on going reception.
+void ServiceUartReceive()
+{
+    struct pollfd fds = { STDIN_FILENO, POLLIN, 0 };
+
+    if (stdin_closed || ::poll(&fds, 1, 0) <= 0)
+        return;
+
+    for (auto &receiver : uart_receivers) {
+        UART_HandleTypeDef *huart = receiver;
+
+        if (nullptr == huart || HAL_UART_STATE_BUSY_RX != huart->RxState)
+            continue;
+
+        ssize_t received = ::read(STDIN_FILENO, huart->pRxBuffPtr, huart->RxXferCount);
+
+        if (received == 0)
+            stdin_closed = true;
+        if (received <= 0)
+            return;
+
+        huart->pRxBuffPtr += received;
+        huart->RxXferCount -= received;
+
+        if (HAL_UART_RECEPTION_TOIDLE == huart->ReceptionType) {
+            // The rest of the line is the next reception. The line is idle now.
+            huart->RxState = HAL_UART_STATE_READY;
+            huart->RxEventCallback(huart, huart->RxXferSize - huart->RxXferCount);
+        }
+        else if (0 == huart->RxXferCount) {
+            huart->RxState = HAL_UART_STATE_READY;
+            huart->RxCpltCallback(huart);
+        }
+        return;
+    }
+}
+
+// Press and release the button. The button is active low, as the Nucleo.
+void ServiceButton()
+{
+    GPIO_TypeDef *port = button_port;
+    uint16_t pin = button_pin;
+
+    if (nullptr == port)
+        return;
+
+    button_port = nullptr;
+    port->IDR &= ~pin;
+    HAL_GPIO_EXTI_IRQHandler(pin);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    port->IDR |= pin;
+}
+
+// Raise the simulated interrupts every tick.
+void InterruptTask(void *ptr)
+{
+    while (true) {
+        ServiceUartReceive();
+        ServiceButton();
+        vTaskDelay(1);
+    }
+}
+
+}  // namespace
+
+extern "C" {
+
+/* ------------------------------- HAL common ----------------------------- */
+
+uint32_t HAL_GetTick(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) (now.tv_sec * 1000 + now.tv_nsec / 1000000);
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    struct timespec wait = { Delay / 1000, (Delay % 1000) * 1000000L };
+
+    nanosleep(&wait, NULL);
+}
+
+// Same value on every run. The serial number string of the USB is made from it.
+uint32_t HAL_GetUIDw0(void)
+{
+    return 0x00330044;
+}
+
+uint32_t HAL_GetUIDw1(void)
+{
+    return 0x484B5001;
+}
+
+uint32_t HAL_GetUIDw2(void)
+{
+    return 0x20373650;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+}
+
+void HAL_NVIC_SystemReset(void)
+{
+    ::exit(EXIT_FAILURE);
+}
+
+// Nucleo F446RE. HCLK 180MHz, APB1 45MHz, APB2 90MHz.
+uint32_t HAL_RCC_GetSysClockFreq(void)
+{
+    return SystemCoreClock;
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+    return SystemCoreClock;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return SystemCoreClock / 4;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+    return SystemCoreClock / 2;
+}
+
+/* --------------------------------- GPIO --------------------------------- */
+
+// The pins are wired back to the IDR. The input pins keep the level set by the host program.
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    for (unsigned int pin = 0; pin < 16; pin++) {
+        if (!(GPIO_Init->Pin & (1U << pin)))
+            continue;
+        MODIFY_REG(GPIOx->MODER, 3U << (pin * 2), (GPIO_Init->Mode & 3U) << (pin * 2));
+        MODIFY_REG(GPIOx->OTYPER, 1U << pin, ((GPIO_Init->Mode >> 4) & 1U) << pin);
+        MODIFY_REG(GPIOx->PUPDR, 3U << (pin * 2), GPIO_Init->Pull << (pin * 2));
+    }
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin)
+{
+    for (unsigned int pin = 0; pin < 16; pin++)
+        if (GPIO_Pin & (1U << pin))
+            CLEAR_BIT(GPIOx->MODER, 3U << (pin * 2));
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if (GPIO_PIN_RESET != PinState) {
+        GPIOx->ODR |= GPIO_Pin;
+        GPIOx->IDR |= GPIO_Pin;
+    }
+    else {
+        GPIOx->ODR &= ~GPIO_Pin;
+        GPIOx->IDR &= ~GPIO_Pin;
+    }
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    HAL_GPIO_WritePin(GPIOx, GPIO_Pin, (GPIOx->ODR & GPIO_Pin) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+}
+
+void HAL_GPIO_EXTI_IRQHandler(uint16_t GPIO_Pin)
+{
+    HAL_GPIO_EXTI_Callback(GPIO_Pin);
+}
+
+/* --------------------------------- EXTI --------------------------------- */
+
+HAL_StatusTypeDef HAL_EXTI_GetHandle(EXTI_HandleTypeDef *hexti, uint32_t ExtiLine)
+{
+    hexti->Line = ExtiLine;
+    hexti->PendingCallback = nullptr;
+    return HAL_OK;
+}
+
+void HAL_EXTI_ClearPending(EXTI_HandleTypeDef *hexti, uint32_t Edge)
+{
+}
+
+void HAL_EXTI_GenerateSWI(EXTI_HandleTypeDef *hexti)
+{
+    HAL_GPIO_EXTI_IRQHandler(1U << (hexti->Line & 0x1FU));
+}
+
+/* --------------------------------- UART --------------------------------- */
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+    if (HAL_UART_STATE_RESET == huart->gState)
+        InitUartCallbacks(huart);
+    huart->ErrorCode = HAL_UART_ERROR_NONE;
+    huart->gState = HAL_UART_STATE_READY;
+    huart->RxState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart)
+{
+    huart->gState = HAL_UART_STATE_RESET;
+    huart->RxState = HAL_UART_STATE_RESET;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    while (Size > 0) {
+        ssize_t written = ::write(STDOUT_FILENO, pData, Size);
+
+        if (written < 0 && EINTR != errno)
+            return HAL_ERROR;
+        if (written > 0) {
+            pData += written;
+            Size -= written;
+        }
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    uint32_t start = HAL_GetTick();
+
+    while (Size > 0) {
+        struct pollfd fds = { STDIN_FILENO, POLLIN, 0 };
+        ssize_t received = 0;
+
+        if (::poll(&fds, 1, 0) > 0)
+            received = ::read(STDIN_FILENO, pData, Size);
+        if (received > 0) {
+            pData += received;
+            Size -= received;
+        }
+        else if (HAL_GetTick() - start >= Timeout)
+            return HAL_TIMEOUT;
+        else
+            vTaskDelay(1);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    HAL_StatusTypeDef status;
+
+    if (HAL_UART_STATE_READY != huart->gState)
+        return HAL_BUSY;
+
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    status = HAL_UART_Transmit(huart, pData, Size, HAL_MAX_DELAY);
+    huart->gState = HAL_UART_STATE_READY;
+
+    if (HAL_OK == status)
+        huart->TxCpltCallback(huart);
+    return status;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    return StartUartReceive(huart, pData, Size, HAL_UART_RECEPTION_STANDARD);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    return HAL_UART_Transmit_IT(huart, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    return StartUartReceive(huart, pData, Size, HAL_UART_RECEPTION_STANDARD);
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    return StartUartReceive(huart, pData, Size, HAL_UART_RECEPTION_TOIDLE);
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    return StartUartReceive(huart, pData, Size, HAL_UART_RECEPTION_TOIDLE);
+}
+
+HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *huart)
+{
+    huart->gState = HAL_UART_STATE_READY;
+    huart->RxState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef *huart)
+{
+    huart->gState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart)
+{
+    huart->RxState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Abort_IT(UART_HandleTypeDef *huart)
+{
+    HAL_UART_Abort(huart);
+    huart->AbortCpltCallback(huart);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortTransmit_IT(UART_HandleTypeDef *huart)
+{
+    HAL_UART_AbortTransmit(huart);
+    huart->AbortTransmitCpltCallback(huart);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive_IT(UART_HandleTypeDef *huart)
+{
+    HAL_UART_AbortReceive(huart);
+    huart->AbortReceiveCpltCallback(huart);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_DMAStop(UART_HandleTypeDef *huart)
+{
+    return HAL_UART_Abort(huart);
+}
+
+HAL_UART_StateTypeDef HAL_UART_GetState(UART_HandleTypeDef *huart)
+{
+    return huart->gState | huart->RxState;
+}
+
+uint32_t HAL_UART_GetError(UART_HandleTypeDef *huart)
+{
+    return huart->ErrorCode;
+}
+
+HAL_StatusTypeDef HAL_UART_RegisterCallback(UART_HandleTypeDef *huart, HAL_UART_CallbackIDTypeDef CallbackID,
+                                            pUART_CallbackTypeDef pCallback)
+{
+    if (nullptr == pCallback || HAL_UART_STATE_READY != huart->gState)
+        return HAL_ERROR;
+
+    switch (CallbackID) {
+        case HAL_UART_TX_COMPLETE_CB_ID:
+            huart->TxCpltCallback = pCallback;
+            break;
+        case HAL_UART_RX_COMPLETE_CB_ID:
+            huart->RxCpltCallback = pCallback;
+            break;
+        case HAL_UART_ERROR_CB_ID:
+            huart->ErrorCallback = pCallback;
+            break;
+        case HAL_UART_ABORT_COMPLETE_CB_ID:
+            huart->AbortCpltCallback = pCallback;
+            break;
+        case HAL_UART_ABORT_TRANSMIT_COMPLETE_CB_ID:
+            huart->AbortTransmitCpltCallback = pCallback;
+            break;
+        case HAL_UART_ABORT_RECEIVE_COMPLETE_CB_ID:
+            huart->AbortReceiveCpltCallback = pCallback;
+            break;
+        default:
+            return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_UnRegisterCallback(UART_HandleTypeDef *huart, HAL_UART_CallbackIDTypeDef CallbackID)
+{
+    UART_HandleTypeDef defaults;
+
+    InitUartCallbacks(&defaults);
+    switch (CallbackID) {
+        case HAL_UART_TX_COMPLETE_CB_ID:
+            return HAL_UART_RegisterCallback(huart, CallbackID, defaults.TxCpltCallback);
+        case HAL_UART_RX_COMPLETE_CB_ID:
+            return HAL_UART_RegisterCallback(huart, CallbackID, defaults.RxCpltCallback);
+        case HAL_UART_ERROR_CB_ID:
+            return HAL_UART_RegisterCallback(huart, CallbackID, defaults.ErrorCallback);
+        case HAL_UART_ABORT_COMPLETE_CB_ID:
+            return HAL_UART_RegisterCallback(huart, CallbackID, defaults.AbortCpltCallback);
+        case HAL_UART_ABORT_TRANSMIT_COMPLETE_CB_ID:
+            return HAL_UART_RegisterCallback(huart, CallbackID, defaults.AbortTransmitCpltCallback);
+        case HAL_UART_ABORT_RECEIVE_COMPLETE_CB_ID:
+            return HAL_UART_RegisterCallback(huart, CallbackID, defaults.AbortReceiveCpltCallback);
+        default:
+            return HAL_ERROR;
+    }
+}
+
+/* --------------------------------- I2C ---------------------------------- */
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+    if (HAL_I2C_STATE_RESET == hi2c->State)
+        InitI2cCallbacks(hi2c);
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    hi2c->State = HAL_I2C_STATE_READY;
+    hi2c->Mode = HAL_I2C_MODE_NONE;
+    __HAL_I2C_ENABLE(hi2c);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c)
+{
+    __HAL_I2C_DISABLE(hi2c);
+    hi2c->State = HAL_I2C_STATE_RESET;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    return PollI2c(hi2c, DevAddress, pData, Size, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    return PollI2c(hi2c, DevAddress, pData, Size, true);
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout)
+{
+    return PollI2c(hi2c, DevAddress, nullptr, 0, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+    return StartI2c(hi2c, DevAddress, pData, Size, false, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+    return StartI2c(hi2c, DevAddress, pData, Size, true, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+    return StartI2c(hi2c, DevAddress, pData, Size, false, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+    return StartI2c(hi2c, DevAddress, pData, Size, true, false);
+}
+
+// The first frame without STOP is kept, and sent with the next frame.
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t XferOptions)
+{
+    hi2c->XferOptions = XferOptions;
+    return StartI2c(hi2c, DevAddress, pData, Size, false,
+                    I2C_FIRST_FRAME == XferOptions || I2C_FIRST_AND_NEXT_FRAME == XferOptions);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t XferOptions)
+{
+    hi2c->XferOptions = XferOptions;
+    return StartI2c(hi2c, DevAddress, pData, Size, true, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t XferOptions)
+{
+    return HAL_I2C_Master_Seq_Transmit_IT(hi2c, DevAddress, pData, Size, XferOptions);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t XferOptions)
+{
+    return HAL_I2C_Master_Seq_Receive_IT(hi2c, DevAddress, pData, Size, XferOptions);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Abort_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress)
+{
+    HostI2cModel *model = FindI2cModel(hi2c);
+
+    if (nullptr != model)
+        model->first_frame_pending = false;
+    hi2c->State = HAL_I2C_STATE_READY;
+    hi2c->AbortCpltCallback(hi2c);
+    return HAL_OK;
+}
+
+// The host has no I2C slave peripheral.
+HAL_StatusTypeDef HAL_I2C_Slave_Transmit_IT(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t Size)
+{
+    return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Slave_Receive_IT(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t Size)
+{
+    return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Slave_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t Size)
+{
+    return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Slave_Receive_DMA(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t Size)
+{
+    return HAL_ERROR;
+}
+
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef *hi2c)
+{
+    return hi2c->State;
+}
+
+HAL_I2C_ModeTypeDef HAL_I2C_GetMode(I2C_HandleTypeDef *hi2c)
+{
+    return hi2c->Mode;
+}
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c)
+{
+    return hi2c->ErrorCode;
+}
+
+HAL_StatusTypeDef HAL_I2C_RegisterCallback(I2C_HandleTypeDef *hi2c, HAL_I2C_CallbackIDTypeDef CallbackID,
+                                           pI2C_CallbackTypeDef pCallback)
+{
+    if (nullptr == pCallback || HAL_I2C_STATE_READY != hi2c->State)
+        return HAL_ERROR;
+
+    switch (CallbackID) {
+        case HAL_I2C_MASTER_TX_COMPLETE_CB_ID:
+            hi2c->MasterTxCpltCallback = pCallback;
+            break;
+        case HAL_I2C_MASTER_RX_COMPLETE_CB_ID:
+            hi2c->MasterRxCpltCallback = pCallback;
+            break;
+        case HAL_I2C_SLAVE_TX_COMPLETE_CB_ID:
+            hi2c->SlaveTxCpltCallback = pCallback;
+            break;
+        case HAL_I2C_SLAVE_RX_COMPLETE_CB_ID:
+            hi2c->SlaveRxCpltCallback = pCallback;
+            break;
+        case HAL_I2C_ERROR_CB_ID:
+            hi2c->ErrorCallback = pCallback;
+            break;
+        case HAL_I2C_ABORT_CB_ID:
+            hi2c->AbortCpltCallback = pCallback;
+            break;
+        default:
+            return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_UnRegisterCallback(I2C_HandleTypeDef *hi2c, HAL_I2C_CallbackIDTypeDef CallbackID)
+{
+    I2C_HandleTypeDef defaults;
+
+    InitI2cCallbacks(&defaults);
+    switch (CallbackID) {
+        case HAL_I2C_MASTER_TX_COMPLETE_CB_ID:
+            return HAL_I2C_RegisterCallback(hi2c, CallbackID, defaults.MasterTxCpltCallback);
+        case HAL_I2C_MASTER_RX_COMPLETE_CB_ID:
+            return HAL_I2C_RegisterCallback(hi2c, CallbackID, defaults.MasterRxCpltCallback);
+        case HAL_I2C_SLAVE_TX_COMPLETE_CB_ID:
+            return HAL_I2C_RegisterCallback(hi2c, CallbackID, defaults.SlaveTxCpltCallback);
+        case HAL_I2C_SLAVE_RX_COMPLETE_CB_ID:
+            return HAL_I2C_RegisterCallback(hi2c, CallbackID, defaults.SlaveRxCpltCallback);
+        case HAL_I2C_ERROR_CB_ID:
+            return HAL_I2C_RegisterCallback(hi2c, CallbackID, defaults.ErrorCallback);
+        case HAL_I2C_ABORT_CB_ID:
+            return HAL_I2C_RegisterCallback(hi2c, CallbackID, defaults.AbortCpltCallback);
+        default:
+            return HAL_ERROR;
+    }
+}
+
+/* --------------------------------- PCD ---------------------------------- */
+
+HAL_StatusTypeDef HAL_PCD_Init(PCD_HandleTypeDef *hpcd)
+{
+    if (HAL_PCD_STATE_RESET == hpcd->State)
+        InitPcdCallbacks(hpcd);
+    for (unsigned int i = 0; i < 16; i++) {
+        hpcd->IN_ep[i] = PCD_EPTypeDef { static_cast<uint8_t>(i), 1, 0, EP_TYPE_CTRL, 0, nullptr, 0, 0 };
+        hpcd->OUT_ep[i] = PCD_EPTypeDef { static_cast<uint8_t>(i), 0, 0, EP_TYPE_CTRL, 0, nullptr, 0, 0 };
+    }
+    hpcd->USB_Address = 0;
+    hpcd->Instance->DCTL = USB_OTG_DCTL_SDIS;
+    hpcd->Instance->DAINTMSK = 0;
+    hpcd->Instance->DIEPENA = 0;
+    hpcd->Instance->DOEPENA = 0;
+    hpcd->State = HAL_PCD_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_DeInit(PCD_HandleTypeDef *hpcd)
+{
+    HAL_PCD_Stop(hpcd);
+    hpcd->State = HAL_PCD_STATE_RESET;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_Start(PCD_HandleTypeDef *hpcd)
+{
+    CLEAR_BIT(hpcd->Instance->DCTL, USB_OTG_DCTL_SDIS);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_Stop(PCD_HandleTypeDef *hpcd)
+{
+    SET_BIT(hpcd->Instance->DCTL, USB_OTG_DCTL_SDIS);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_SetAddress(PCD_HandleTypeDef *hpcd, uint8_t address)
+{
+    hpcd->USB_Address = address;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_EP_Open(PCD_HandleTypeDef *hpcd, uint8_t ep_addr, uint16_t ep_mps, uint8_t ep_type)
+{
+    PCD_EPTypeDef *ep = FindEndpoint(hpcd, ep_addr);
+
+    ep->maxpacket = ep_mps;
+    ep->type = ep_type;
+    ep->is_stall = 0;
+    SET_BIT(hpcd->Instance->DAINTMSK, EndpointBit(ep_addr));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_EP_Close(PCD_HandleTypeDef *hpcd, uint8_t ep_addr)
+{
+    const uint32_t bit = EndpointBit(ep_addr);
+
+    CLEAR_BIT(hpcd->Instance->DAINTMSK, bit);
+    CLEAR_BIT((0x80 & ep_addr) ? hpcd->Instance->DIEPENA : hpcd->Instance->DOEPENA, 1U << (ep_addr & 0x0F));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_EP_Receive(PCD_HandleTypeDef *hpcd, uint8_t ep_addr, uint8_t *pBuf, uint32_t len)
+{
+    PCD_EPTypeDef *ep = FindEndpoint(hpcd, ep_addr & 0x0F);
+
+    ep->xfer_buff = pBuf;
+    ep->xfer_len = len;
+    ep->xfer_count = 0;
+    SET_BIT(hpcd->Instance->DOEPENA, 1U << (ep_addr & 0x0F));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_EP_Transmit(PCD_HandleTypeDef *hpcd, uint8_t ep_addr, uint8_t *pBuf, uint32_t len)
+{
+    PCD_EPTypeDef *ep = FindEndpoint(hpcd, ep_addr | 0x80);
+
+    ep->xfer_buff = pBuf;
+    ep->xfer_len = len;
+    ep->xfer_count = 0;
+    SET_BIT(hpcd->Instance->DIEPENA, 1U << (ep_addr & 0x0F));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_EP_SetStall(PCD_HandleTypeDef *hpcd, uint8_t ep_addr)
+{
+    FindEndpoint(hpcd, ep_addr)->is_stall = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_EP_ClrStall(PCD_HandleTypeDef *hpcd, uint8_t ep_addr)
+{
+    FindEndpoint(hpcd, ep_addr)->is_stall = 0;
+    return HAL_OK;
+}
+
+uint32_t HAL_PCD_EP_GetRxCount(PCD_HandleTypeDef *hpcd, uint8_t ep_addr)
+{
+    return hpcd->OUT_ep[ep_addr & 0x0F].xfer_count;
+}
+
+HAL_StatusTypeDef HAL_PCDEx_SetTxFiFo(PCD_HandleTypeDef *hpcd, uint8_t fifo, uint16_t size)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCDEx_SetRxFiFo(PCD_HandleTypeDef *hpcd, uint16_t size)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_RegisterCallback(PCD_HandleTypeDef *hpcd, HAL_PCD_CallbackIDTypeDef CallbackID,
+                                           pPCD_CallbackTypeDef pCallback)
+{
+    if (nullptr == pCallback || HAL_PCD_STATE_READY != hpcd->State)
+        return HAL_ERROR;
+
+    switch (CallbackID) {
+        case HAL_PCD_SOF_CB_ID:
+            hpcd->SOFCallback = pCallback;
+            break;
+        case HAL_PCD_SETUPSTAGE_CB_ID:
+            hpcd->SetupStageCallback = pCallback;
+            break;
+        case HAL_PCD_RESET_CB_ID:
+            hpcd->ResetCallback = pCallback;
+            break;
+        case HAL_PCD_SUSPEND_CB_ID:
+            hpcd->SuspendCallback = pCallback;
+            break;
+        case HAL_PCD_RESUME_CB_ID:
+            hpcd->ResumeCallback = pCallback;
+            break;
+        case HAL_PCD_CONNECT_CB_ID:
+            hpcd->ConnectCallback = pCallback;
+            break;
+        case HAL_PCD_DISCONNECT_CB_ID:
+            hpcd->DisconnectCallback = pCallback;
+            break;
+        default:
+            return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_RegisterDataOutStageCallback(PCD_HandleTypeDef *hpcd,
+                                                       pPCD_DataOutStageCallbackTypeDef pCallback)
+{
+    if (nullptr == pCallback || HAL_PCD_STATE_READY != hpcd->State)
+        return HAL_ERROR;
+
+    hpcd->DataOutStageCallback = pCallback;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_PCD_RegisterDataInStageCallback(PCD_HandleTypeDef *hpcd,
+                                                      pPCD_DataInStageCallbackTypeDef pCallback)
+{
+    if (nullptr == pCallback || HAL_PCD_STATE_READY != hpcd->State)
+        return HAL_ERROR;
+
+    hpcd->DataInStageCallback = pCallback;
+    return HAL_OK;
+}
+
+/* --------------------------------- ETH ---------------------------------- */
+
+HAL_StatusTypeDef HAL_ETH_Init(ETH_HandleTypeDef *heth)
+{
+    if (HAL_ETH_STATE_RESET == heth->gState)
+        heth->txFreeCallback = HAL_ETH_TxFreeCallback;
+    heth->TxDescList = ETH_TxDescListTypeDef { };
+    heth->Instance->MACCR = ETH_SPEED_100M | ETH_FULLDUPLEX_MODE;
+    heth->ErrorCode = HAL_ETH_ERROR_NONE;
+    heth->gState = HAL_ETH_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ETH_Start(ETH_HandleTypeDef *heth)
+{
+    if (HAL_ETH_STATE_READY != heth->gState)
+        return HAL_ERROR;
+    heth->gState = HAL_ETH_STATE_STARTED;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ETH_Stop(ETH_HandleTypeDef *heth)
+{
+    if (HAL_ETH_STATE_STARTED != heth->gState)
+        return HAL_ERROR;
+    heth->gState = HAL_ETH_STATE_READY;
+    return HAL_OK;
+}
+
+// One descriptor per frame. The chained buffers of the real HAL are not modeled.
+HAL_StatusTypeDef HAL_ETH_Transmit_IT(ETH_HandleTypeDef *heth, ETH_TxPacketConfig *pTxConfig)
+{
+    ETH_TxDescListTypeDef *list = &heth->TxDescList;
+    const uint32_t index = list->CurTxDesc;
+    ETH_DMADescTypeDef *desc = &list->TxDesc[index];
+    uint32_t desc3;
+
+    if (nullptr == pTxConfig || nullptr == pTxConfig->TxBuffer || nullptr != pTxConfig->TxBuffer->next) {
+        heth->ErrorCode |= HAL_ETH_ERROR_PARAM;
+        return HAL_ERROR;
+    }
+    if (HAL_ETH_STATE_STARTED != heth->gState)
+        return HAL_ERROR;
+
+    // The descriptor is still in the DMA, or not released yet.
+    if ((desc->DESC3 & ETH_DMATXNDESCRF_OWN) || nullptr != list->PacketAddress[index]) {
+        heth->ErrorCode |= HAL_ETH_ERROR_BUSY;
+        return HAL_ERROR;
+    }
+
+    desc->Buffer = pTxConfig->TxBuffer->buffer;
+    desc3 = pTxConfig->Length & ETH_DMATXNDESCRF_FL;
+    if (pTxConfig->Attributes & ETH_TX_PACKETS_FEATURES_CSUM)
+        desc3 |= pTxConfig->ChecksumCtrl & ETH_DMATXNDESCRF_CIC;
+    list->CurrentPacketAddress = static_cast<uint32_t*>(pTxConfig->pData);
+    list->PacketAddress[index] = list->CurrentPacketAddress;
+    list->CurTxDesc = (index + 1) % ETH_TX_DESC_CNT;
+    list->BuffersInUse++;
+
+    // The buffer is written before the DMA owns the descriptor, as the __DSB() of the HAL.
+    __sync_synchronize();
+    desc->DESC3 = desc3 | ETH_DMATXNDESCRF_OWN;
+    return HAL_OK;
+}
+
+// Same with the HAL. The sent frames are returned in order, until the first descriptor in the DMA.
+HAL_StatusTypeDef HAL_ETH_ReleaseTxPacket(ETH_HandleTypeDef *heth)
+{
+    ETH_TxDescListTypeDef *list = &heth->TxDescList;
+    uint32_t count = list->BuffersInUse;
+    uint32_t index = list->releaseIndex;
+
+    while (count != 0) {
+        count--;
+        if (nullptr == list->PacketAddress[index]) {
+            index = (index + 1) % ETH_TX_DESC_CNT;
+            continue;
+        }
+        if (list->TxDesc[index].DESC3 & ETH_DMATXNDESCRF_OWN)
+            break;
+
+        heth->txFreeCallback(list->PacketAddress[index]);
+        list->PacketAddress[index] = nullptr;
+        index = (index + 1) % ETH_TX_DESC_CNT;
+        list->BuffersInUse = count;
+        list->releaseIndex = index;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ETH_RegisterTxFreeCallback(ETH_HandleTypeDef *heth, pETH_txFreeCallbackTypeDef txFreeCallback)
+{
+    if (nullptr == txFreeCallback)
+        return HAL_ERROR;
+    heth->txFreeCallback = txFreeCallback;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ETH_ReadPHYRegister(ETH_HandleTypeDef *heth, uint32_t PHYAddr, uint32_t PHYReg, uint32_t *pRegValue)
+{
+    switch (PHYReg) {
+        case HOST_PHY_BSR:
+            *pRegValue = HOST_PHY_BSR_VALUE;
+            break;
+        case HOST_PHY_SCSR:
+            *pRegValue = HOST_PHY_SCSR_VALUE;
+            break;
+        default:
+            *pRegValue = 0;
+            break;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ETH_GetMACConfig(ETH_HandleTypeDef *heth, ETH_MACConfigTypeDef *macconf)
+{
+    macconf->Speed = heth->Instance->MACCR & ETH_MACCR_FES;
+    macconf->DuplexMode = heth->Instance->MACCR & ETH_MACCR_DM;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ETH_SetMACConfig(ETH_HandleTypeDef *heth, ETH_MACConfigTypeDef *macconf)
+{
+    if (nullptr == macconf)
+        return HAL_ERROR;
+    MODIFY_REG(heth->Instance->MACCR, ETH_MACCR_FES | ETH_MACCR_DM, macconf->Speed | macconf->DuplexMode);
+    return HAL_OK;
+}
+
+void HAL_ETH_SetMDIOClockRange(ETH_HandleTypeDef *heth)
+{
+    // The smallest divider which keeps the MDC under 2.5MHz.
+    heth->Instance->MACMDIOAR = (HAL_RCC_GetHCLKFreq() + 2499999) / 2500000;
+}
+
+/* --------------------------------- CRC ---------------------------------- */
+
+// The unit which has the data register at the offset 0.
+static CRC_TypeDef* CrcUnit(HostCrcData *dr)
+{
+    return reinterpret_cast<CRC_TypeDef*>(dr);
+}
+
+// Polynomial size [bit].
+static unsigned int CrcWidth(const CRC_TypeDef *unit)
+{
+#if defined(HOST_CRC_FIXED_POLYNOMIAL)
+    return 32;
+#else
+    static const unsigned int widths[4] = { 32, 16, 8, 7 };
+
+    return widths[(unit->CR & CRC_CR_POLYSIZE) / CRC_CR_POLYSIZE_0];
+#endif
+}
+
+HostCrcData &HostCrcData::operator=(uint32_t data)
+{
+    CRC_TypeDef *const unit = CrcUnit(this);
+    const unsigned int width = CrcWidth(unit);
+    const uint32_t mask = (32 == width) ? 0xFFFFFFFF : (1u << width) - 1;
+#if defined(HOST_CRC_FIXED_POLYNOMIAL)
+    const uint32_t polynomial = 0x04C11DB7;
+#else
+    const uint32_t polynomial = unit->POL;
+
+    // Bit reversal by byte, by half word or by word.
+    switch (unit->CR & CRC_CR_REV_IN) {
+        case CRC_CR_REV_IN_0:
+            data = __REV(__RBIT(data));
+            break;
+        case CRC_CR_REV_IN_1:
+            data = __RBIT(data);
+            data = (data << 16) | (data >> 16);
+            break;
+        case CRC_CR_REV_IN:
+            data = __RBIT(data);
+            break;
+    }
+#endif
+
+    ApplyReset();
+    for (int bit = 31; bit >= 0; bit--) {
+        const uint32_t feedback = ((crc_ >> (width - 1)) ^ (data >> bit)) & 1;
+
+        crc_ = ((crc_ << 1) ^ (feedback ? polynomial : 0)) & mask;
+    }
+    return *this;
+}
+
+HostCrcData::operator uint32_t()
+{
+    ApplyReset();
+#if !defined(HOST_CRC_FIXED_POLYNOMIAL)
+    // Reversed in the polynomial size.
+    if (CrcUnit(this)->CR & CRC_CR_REV_OUT)
+        return __RBIT(crc_) >> (32 - CrcWidth(CrcUnit(this)));
+#endif
+    return crc_;
+}
+
+void HostCrcData::ApplyReset()
+{
+    CRC_TypeDef *const unit = CrcUnit(this);
+
+    if (unit->CR & CRC_CR_RESET) {
+#if defined(HOST_CRC_FIXED_POLYNOMIAL)
+        crc_ = 0xFFFFFFFF;
+#else
+        crc_ = unit->INIT & ((32 == CrcWidth(unit)) ? 0xFFFFFFFF : (1u << CrcWidth(unit)) - 1);
+#endif
+        unit->CR &= ~CRC_CR_RESET;
+    }
+}
+
+/* ------------------------------ Host models ----------------------------- */
+
+void HostAttachI2c(I2C_HandleTypeDef *hi2c, murasaki::I2cSimulator *bus)
+{
+    for (auto &model : i2c_models)
+        if (nullptr == model.hi2c || hi2c == model.hi2c) {
+            model.hi2c = hi2c;
+            model.bus = bus;
+            model.first_frame_pending = false;
+            return;
+        }
+}
+
+void HostStartInterruptTask(void)
+{
+    xTaskCreate(InterruptTask, "host isr", configMINIMAL_STACK_SIZE, nullptr, configMAX_PRIORITIES - 1, nullptr);
+}
+
+void HostPressButton(GPIO_TypeDef *port, uint16_t pin)
+{
+    button_pin = pin;
+    button_port = port;
+}
+
+/* --------------------------- Default callbacks -------------------------- */
+
+__attribute__((weak)) void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+}
+
+__attribute__((weak)) void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+}
+
+__attribute__((weak)) void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+}
+
+__attribute__((weak)) void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+}
+
+__attribute__((weak)) void HAL_UART_AbortCpltCallback(UART_HandleTypeDef *huart)
+{
+}
+
+__attribute__((weak)) void HAL_UART_AbortTransmitCpltCallback(UART_HandleTypeDef *huart)
+{
+}
+
+__attribute__((weak)) void HAL_UART_AbortReceiveCpltCallback(UART_HandleTypeDef *huart)
+{
+}
+
+__attribute__((weak)) void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+}
+
+__attribute__((weak)) void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+}
+
+__attribute__((weak)) void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+}
+
+__attribute__((weak)) void HAL_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+}
+
+__attribute__((weak)) void HAL_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+}
+
+__attribute__((weak)) void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+}
+
+__attribute__((weak)) void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+}
+
+__attribute__((weak)) void HAL_PCD_SOFCallback(PCD_HandleTypeDef *hpcd)
+{
+}
+
+__attribute__((weak)) void HAL_PCD_SetupStageCallback(PCD_HandleTypeDef *hpcd)
+{
+}
+
+__attribute__((weak)) void HAL_PCD_ResetCallback(PCD_HandleTypeDef *hpcd)
+{
+}
+
+__attribute__((weak)) void HAL_PCD_SuspendCallback(PCD_HandleTypeDef *hpcd)
+{
+}
+
+__attribute__((weak)) void HAL_PCD_ResumeCallback(PCD_HandleTypeDef *hpcd)
+{
+}
+
+__attribute__((weak)) void HAL_PCD_ConnectCallback(PCD_HandleTypeDef *hpcd)
+{
+}
+
+__attribute__((weak)) void HAL_PCD_DisconnectCallback(PCD_HandleTypeDef *hpcd)
+{
+}
+
+__attribute__((weak)) void HAL_PCD_DataOutStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum)
+{
+}
+
+__attribute__((weak)) void HAL_PCD_DataInStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum)
+{
+}
+
+__attribute__((weak)) void HAL_ETH_TxFreeCallback(uint32_t *buff)
+{
+}
+
+}  // extern "C"
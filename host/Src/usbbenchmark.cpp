@@ -0,0 +1,288 @@
+/**
+ * @file usbbenchmark.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Throughput benchmark of the USB CDC-ACM console on the host.
+ * @details
+ * Runs the @ref murasaki::UsbCdcAcm on the @ref murasaki::PcdSimulator, and prints the result as CSV :
+ *
+ * @li benchmark : Name of the benchmark.
+ * @li bytes : Number of the transferred bytes.
+ * @li host_ns_per_byte : Host CPU time per byte [nS]. The software overhead of the stack.
+ * @li bus_kb_per_s : Throughput on the simulated full speed bus [kB/s].
+ * @li packets_per_frame : Bulk packets per 1mS frame. Up to PCD_SIMULATOR_PACKETS_PER_FRAME.
+ * @li naks : Tokens which found no data or no buffer. The device didn't keep up.
+ *
+ * The enumeration, the open of the port and the data are checked. The exit status is not zero if a check failed.
+ *
+ * Usage : usb_bench [bytes]
+ */
+
+#include "murasaki.hpp"
+
+#include "pcdsimulator.hpp"
+#include "usbcdcacm.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Essential definition. murasaki_platform.cpp is not linked to the benchmark.
+murasaki::Platform murasaki::platform;
+murasaki::Debugger *murasaki::debugger;
+
+// Line length of the logger benchmark [byte]. A typical log line.
+#define LOG_LINE_SIZE 80
+// Wait for the data of the other side [mS].
+#define STREAM_TIMEOUT 1000
+
+static unsigned int bytes = 1024 * 1024;
+static unsigned int failures = 0;
+
+static PCD_HandleTypeDef hpcd;
+
+// Parameter of the device side task.
+struct Stream
+{
+    murasaki::UsbCdcAcm *usb;
+    murasaki::UartLogger *logger;
+    unsigned int chunk;
+    unsigned int size;
+    volatile bool done;
+    volatile bool ok;
+};
+
+static uint64_t NowNs()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+static void Check(bool condition, const char *message)
+{
+    if (!condition) {
+        fprintf(stderr, "CHECK FAILED : %s\n", message);
+        failures++;
+    }
+}
+
+// Data at the position of the stream. Not periodic in the packet, to find the lost or the doubled packet.
+static uint8_t Pattern(unsigned int position)
+{
+    return static_cast<uint8_t>(position + (position >> 8) + (position >> 16));
+}
+
+// Print a row of the result.
+static void Report(const char *name, unsigned int count, uint64_t host_ns, murasaki::PcdSimulator *host)
+{
+    const double frames = static_cast<double>(host->GetBusTime()) / 1000000;
+
+    printf("%s,%u,%.1f,%.1f,%.2f,%u\n",
+           name,
+           count,
+           static_cast<double>(host_ns) / count,
+           frames > 0 ? count / frames : 0.0,    // byte per mS is kB/s.
+           frames > 0 ? host->GetPacketCount() / frames : 0.0,
+           host->GetNakCount());
+}
+
+// Device side. Send the stream by Transmit(), or by the logger.
+static void WriterTask(void *ptr)
+{
+    Stream *stream = static_cast<Stream*>(ptr);
+    uint8_t *buffer = new uint8_t[stream->chunk];
+    unsigned int position = 0;
+
+    stream->ok = true;
+    while (position < stream->size) {
+        const unsigned int length = std::min(stream->chunk, stream->size - position);
+
+        for (unsigned int i = 0; i < length; i++)
+            buffer[i] = Pattern(position + i);
+        if (stream->logger != nullptr)
+            stream->logger->putMessage(reinterpret_cast<char*>(buffer), length);
+        else if (murasaki::kursOK != stream->usb->Transmit(buffer, length, STREAM_TIMEOUT)) {
+            stream->ok = false;
+            break;
+        }
+        position += length;
+    }
+
+    delete[] buffer;
+    stream->done = true;
+    vTaskDelete(nullptr);
+}
+
+// Device side. Receive the stream by Receive().
+static void ReaderTask(void *ptr)
+{
+    Stream *stream = static_cast<Stream*>(ptr);
+    uint8_t *buffer = new uint8_t[stream->chunk];
+    unsigned int position = 0;
+
+    stream->ok = true;
+    while (position < stream->size) {
+        unsigned int received;
+
+        if (murasaki::kursOK != stream->usb->Receive(buffer,
+                                                      std::min(stream->chunk, stream->size - position),
+                                                      &received,
+                                                      murasaki::kutIdleTimeout,
+                                                      STREAM_TIMEOUT)) {
+            stream->ok = false;
+            break;
+        }
+        for (unsigned int i = 0; i < received; i++)
+            if (buffer[i] != Pattern(position + i))
+                stream->ok = false;
+        position += received;
+    }
+
+    delete[] buffer;
+    stream->done = true;
+    vTaskDelete(nullptr);
+}
+
+// Host side of the device to host benchmark. Returns true if all data is received in order.
+static bool ReadStream(murasaki::PcdSimulator *host, unsigned int size)
+{
+    static uint8_t buffer[4096];
+    unsigned int position = 0;
+    unsigned int empty = 0;
+    bool ok = true;
+
+    while (position < size) {
+        const unsigned int received = host->BulkIn(buffer, sizeof(buffer), STREAM_TIMEOUT);
+
+        // A zero length packet ends the transfer of the multiple of the packet. Never twice in a row.
+        if (received == 0) {
+            if (++empty > 1)
+                break;
+            continue;
+        }
+        empty = 0;
+        for (unsigned int i = 0; i < received; i++)
+            if (buffer[i] != Pattern(position + i))
+                ok = false;
+        position += received;
+    }
+    return ok && position == size;
+}
+
+static void TransmitBenchmark(
+                              const char *name,
+                              murasaki::PcdSimulator *host,
+                              murasaki::UsbCdcAcm *usb,
+                              murasaki::UartLogger *logger,
+                              unsigned int chunk)
+{
+    Stream stream = { usb, logger, chunk, bytes, false, false };
+    uint64_t start;
+    bool received;
+
+    host->ResetStatistics();
+    start = NowNs();
+    xTaskCreate(WriterTask, "writer", configMINIMAL_STACK_SIZE * 4, &stream, tskIDLE_PRIORITY + 1, nullptr);
+    received = ReadStream(host, bytes);
+    Report(name, bytes, NowNs() - start, host);
+
+    while (!stream.done)
+        vTaskDelay(1);
+    Check(stream.ok, name);
+    Check(received, name);
+}
+
+static void BenchmarkTask(void *ptr)
+{
+    murasaki::UsbCdcAcm *usb;
+    murasaki::PcdSimulator *host;
+    murasaki::UartLogger *logger;
+    const uint8_t *descriptor;
+    uint8_t data[8];
+
+    hpcd.Instance = USB_OTG_FS;
+    hpcd.Init.dev_endpoints = 4;
+    hpcd.Init.speed = PCD_SPEED_FULL;
+    hpcd.Init.phy_itface = PCD_PHY_EMBEDDED;
+    HAL_PCD_Init(&hpcd);
+
+    usb = new murasaki::UsbCdcAcm(&hpcd);
+    host = new murasaki::PcdSimulator(&hpcd);
+    logger = new murasaki::UartLogger(usb);
+
+    Check(!host->IsConnected(), "disconnected before Start()");
+    Check(usb->Start(), "Start()");
+    Check(host->IsConnected(), "connected by Start()");
+
+    // Enumeration.
+    Check(host->Enumerate(), "enumeration");
+    descriptor = host->GetDeviceDescriptor();
+    Check((descriptor[8] | (descriptor[9] << 8)) == USB_CDC_ACM_VID, "enumeration VID");
+    Check((descriptor[10] | (descriptor[11] << 8)) == USB_CDC_ACM_PID, "enumeration PID");
+    Check(!usb->IsOpen(), "closed before DTR");
+    Check(murasaki::kursTimeOut == usb->Transmit(data, sizeof(data), 10), "Transmit() time out before DTR");
+
+    // Terminal opens the port.
+    Check(host->SetLineCoding(921600), "SET_LINE_CODING");
+    Check(usb->GetLineCodingBaudRate() == 921600, "line coding baud rate");
+    Check(host->SetControlLineState(true), "SET_CONTROL_LINE_STATE");
+    Check(usb->IsOpen(), "open by DTR");
+
+    printf("benchmark,bytes,host_ns_per_byte,bus_kb_per_s,packets_per_frame,naks\n");
+
+    // Device to host. By the chunk of a packet, of a buffer and over a buffer.
+    TransmitBenchmark("transmit_64", host, usb, nullptr, 64);
+    TransmitBenchmark("transmit_512", host, usb, nullptr, 512);
+    TransmitBenchmark("transmit_2048", host, usb, nullptr, USB_CDC_ACM_TX_BUFFER_SIZE);
+    TransmitBenchmark("transmit_8192", host, usb, nullptr, 4 * USB_CDC_ACM_TX_BUFFER_SIZE);
+    // Log lines through the UartLogger, as the debugger does.
+    TransmitBenchmark("logger_80", host, usb, logger, LOG_LINE_SIZE);
+
+    // Host to device.
+    {
+        uint8_t *buffer = new uint8_t[bytes];
+        Stream stream = { usb, nullptr, 256, bytes, false, false };
+        uint64_t start;
+        unsigned int sent;
+
+        for (unsigned int i = 0; i < bytes; i++)
+            buffer[i] = Pattern(i);
+
+        host->ResetStatistics();
+        start = NowNs();
+        xTaskCreate(ReaderTask, "reader", configMINIMAL_STACK_SIZE * 4, &stream, tskIDLE_PRIORITY + 1, nullptr);
+        sent = host->BulkOut(buffer, bytes, STREAM_TIMEOUT);
+        while (!stream.done)
+            vTaskDelay(1);
+        Report("receive_256", bytes, NowNs() - start, host);
+        Check(sent == bytes, "receive_256 sent");
+        Check(stream.ok, "receive_256 data");
+
+        delete[] buffer;
+    }
+
+    // Terminal closes the port.
+    Check(host->SetControlLineState(false), "SET_CONTROL_LINE_STATE close");
+    Check(!usb->IsOpen(), "closed by DTR");
+
+    fflush(stdout);
+    exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+        bytes = atoi(argv[1]);
+    if (bytes == 0)
+        bytes = 1;
+
+    xTaskCreate(BenchmarkTask, "bench", configMINIMAL_STACK_SIZE * 4, nullptr, tskIDLE_PRIORITY + 1, nullptr);
+    vTaskStartScheduler();
+
+    // Never reach here.
+    return EXIT_FAILURE;
+}
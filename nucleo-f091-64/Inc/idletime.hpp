@@ -0,0 +1,76 @@
+/**
+ * @file idletime.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Idle time accounting by the idle hook of the FreeRTOS.
+ */
+
+#ifndef IDLETIME_HPP_
+#define IDLETIME_HPP_
+
+#include "murasaki.hpp"
+
+// Longest idle loop [cycle]. The longer gap between the idle hooks is the time of the other tasks.
+#define IDLE_TIME_MAX_LOOP_CYCLES 1000
+
+namespace murasaki {
+
+/**
+ * @brief Accumulator of the CPU cycles spent in the idle task.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The vApplicationIdleHook() calls Hook() in every loop of the idle task. Hook() measures the
+ * gap from the previous call by the @ref CycleCounter. The gap shorter than IDLE_TIME_MAX_LOOP_CYCLES
+ * is the idle loop itself, and added to the idle cycles. The longer gap means the idle task
+ * was preempted, and is not counted.
+ *
+ * The load is measured by sampling GetCycles() and GetTotalCycles() at the same time :
+ *
+ * @code
+ * uint32_t idle = murasaki::IdleTime::GetCycles();
+ * uint32_t total = murasaki::IdleTime::GetTotalCycles();
+ * murasaki::Sleep(100);
+ * idle = murasaki::IdleTime::GetCycles() - idle;
+ * total = murasaki::IdleTime::GetTotalCycles() - total;
+ * unsigned int load_percent = 100 - idle * 100ull / total;
+ * @endcode
+ *
+ * The short interrupts in the idle task are counted as idle. The tasks which run shorter than
+ * IDLE_TIME_MAX_LOOP_CYCLES are counted as idle, too. Both are small enough for the frequency
+ * decision and the headroom estimation.
+ *
+ * The configUSE_IDLE_HOOK is overridden to 1 in the user code section of the FreeRTOSConfig.h.
+ */
+class IdleTime
+{
+ public:
+    /**
+     * @brief Account the idle loop. Called from the vApplicationIdleHook(). Do not call from the application.
+     */
+    static void Hook();
+
+    /**
+     * @brief Get the accumulated idle cycles.
+     * @return Count in CPU cycles. Wraps around at 2^32. Take the difference by the unsigned subtraction.
+     */
+    static uint32_t GetCycles();
+
+    /**
+     * @brief Get the elapsed CPU cycles. The denominator of the load.
+     * @return Count in CPU cycles. Wraps around at 2^32. Take the difference by the unsigned subtraction.
+     * @details
+     * The DWT cycle counter on Cortex-M3/M4/M7/M33. On Cortex-M0/M0+, the RTOS tick count and the SysTick
+     * current value. The SysTick extension of the @ref CycleCounter can't be used for the total, because nobody
+     * calls it while the idle task is preempted. Call from a task, after the scheduler is started.
+     */
+    static uint32_t GetTotalCycles();
+
+ private:
+    static uint32_t last_;          // CycleCounter at the last Hook().
+    static volatile uint32_t cycles_;
+};
+
+} /* namespace murasaki */
+
+#endif /* IDLETIME_HPP_ */
@@ -15,6 +15,21 @@
 #define PLATFORM_DEFS_HPP_
 
 namespace murasaki {
+
+// Platform classes defined in this project.
+class ClockProfile;
+class ConsoleBaud;
+class CrcService;
+class EthTelemetry;
+class FramedConsole;
+class Governor;
+class I2cScanner;
+class I2cRecoveringMaster;
+class LoadMeter;
+class StatusLed;
+class Supervisor;
+class UsbCdcAcm;
+
 /**
  * \brief Custom aggregation struct for user platform.
  * @ingroup MURASAKI_PLATFORM_GROUP
@@ -33,11 +48,22 @@ struct Platform
     // Platform dependent Custom variables.
     UartStrategy *uart_console;    ///< UART wrapping class object for debugging
     LoggerStrategy *logger;        ///< logging class object for debugger
+    ConsoleBaud *console_baud;     ///< Baud rate of the console, negotiated with the host tool
+    UsbCdcAcm *usb_console;        ///< USB CDC-ACM console. nullptr if the console is the UART
+    EthTelemetry *eth_telemetry;   ///< UDP telemetry sink on the Ethernet. nullptr if not used
+    FramedConsole *framed_console;  ///< Framed binary channels on the console. nullptr if not used
+    CrcService *crc_service;       ///< Checksum by the CRC unit
 
     BitOutStrategy *led;           ///< GP out under test
-    TaskStrategy *task1;           ///< Task under test
     I2cMasterStrategy *i2c_master;  ///< I2C Master under test
     InterruptStrategy *b1;     ///< Exti demo
+    I2cScanner *i2c_scanner;   ///< Cached I2C bus enumeration
+    I2cRecoveringMaster *i2c_recovering_master;  ///< Same object with i2c_master. For the statistics.
+    Supervisor *supervisor;    ///< Task liveness supervisor with the IWDG
+    StatusLed *status_led;     ///< Blink patterns by the timer PWM and the DMA
+    ClockProfile *clock_profile;  ///< System clock switcher
+    Governor *governor;        ///< Clock profile selection by the CPU load
+    LoadMeter *load_meter;     ///< Moving averages of the CPU load
 
     // Following block is just sample
 
@@ -0,0 +1,181 @@
+/**
+ * @file crashrecord.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Crash record kept in the no-init RAM over the reset.
+ */
+
+#include "crashrecord.hpp"
+#include "crcservice.hpp"
+#include "murasaki_platform.hpp"
+#include "stackunwinder.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <cstddef>
+#include <cstring>
+
+// "CRSH"
+#define CRASH_RECORD_MAGIC 0x48535243
+
+// Words of the basic and the extended ( with FPU registers ) exception frame.
+#define BASIC_FRAME_WORDS 8
+#define EXTENDED_FRAME_WORDS 26
+
+// Words to search the exception frame, when the HardFault_Handler() pushed the registers.
+#define FRAME_SEARCH_WORDS 4
+
+// The entry of the fault. Thumb-1 only, to run on the all Cortex-M.
+// Pass the stack pointer of the exception frame and the EXC_RETURN to CrashRecordSave().
+extern "C" void __attribute__((naked)) CrashRecordHandler()
+{
+    asm volatile (
+            "    movs r0, #4              \n"
+            "    mov r1, lr               \n"
+            "    tst r0, r1               \n"   // Bit 2 of EXC_RETURN : 0 = MSP, 1 = PSP
+            "    beq 1f                   \n"
+            "    mrs r0, psp              \n"
+            "    b 2f                     \n"
+            "1:  mrs r0, msp              \n"
+            "2:  ldr r2, =CrashRecordSave \n"
+            "    bx r2                    \n"
+    );
+}
+
+extern "C" void CrashRecordSave(uint32_t *stack_pointer, uint32_t exc_return)
+{
+    murasaki::CrashRecord::Save(stack_pointer, exc_return);
+}
+
+namespace murasaki {
+
+CrashRecord::Record CrashRecord::record_ __attribute__((section(".noinit")));
+
+void CrashRecord::Save(uint32_t *stack_pointer, uint32_t exc_return)
+{
+    __disable_irq();
+
+    std::memset(&record_, 0, sizeof(record_));
+
+    // HardFault_Handler() is a C function. It may push the registers to MSP before jumping here.
+    // Search the frame by the Thumb bit of the stacked xPSR, which is always 1.
+    if (0 == (exc_return & 4))
+        for (int i = 0;
+                i < FRAME_SEARCH_WORDS
+                        && StackUnwinder::IsStackAddress(stack_pointer, BASIC_FRAME_WORDS * 4)
+                        && 0 == (stack_pointer[7] & xPSR_T_Msk);
+                i++)
+            stack_pointer++;
+
+    // The broken stack pointer. Reading the frame causes the lockup.
+    if (!StackUnwinder::IsStackAddress(stack_pointer, BASIC_FRAME_WORDS * 4))
+        stack_pointer = nullptr;
+
+    record_.exc_return = exc_return;
+    record_.ipsr = __get_IPSR();
+
+    if (nullptr != stack_pointer) {
+        record_.r0 = stack_pointer[0];
+        record_.r1 = stack_pointer[1];
+        record_.r2 = stack_pointer[2];
+        record_.r3 = stack_pointer[3];
+        record_.r12 = stack_pointer[4];
+        record_.lr = stack_pointer[5];
+        record_.pc = stack_pointer[6];
+        record_.xpsr = stack_pointer[7];
+
+        // The stack pointer before the exception. Bit 4 of EXC_RETURN is 0 when the FPU registers are stacked.
+        // Bit 9 of the stacked xPSR is 1 when a padding word was inserted for the 8 byte alignment.
+        uint32_t *caller_stack = stack_pointer + ((exc_return & 0x10) ? BASIC_FRAME_WORDS : EXTENDED_FRAME_WORDS);
+        if (record_.xpsr & (1 << 9))
+            caller_stack++;
+        record_.sp = reinterpret_cast<uintptr_t>(caller_stack);
+        if (StackUnwinder::IsStackAddress(caller_stack, sizeof(record_.stack)))
+            for (int i = 0; i < CRASH_RECORD_STACK_WORDS; i++)
+                record_.stack[i] = caller_stack[i];
+
+        // The LR is the return address of the faulting function, if it is a leaf function.
+        if (StackUnwinder::IsReturnAddress(record_.lr))
+            record_.chain[record_.chain_length++] = record_.lr;
+        record_.chain_length += StackUnwinder::Unwind(caller_stack,
+                                                      &record_.chain[record_.chain_length],
+                                                      CRASH_RECORD_CHAIN_DEPTH - record_.chain_length);
+    }
+
+#if (__CORTEX_M >= 3U)
+    record_.cfsr = SCB->CFSR;
+    record_.hfsr = SCB->HFSR;
+    record_.mmfar = SCB->MMFAR;
+    record_.bfar = SCB->BFAR;
+#endif
+
+    if (taskSCHEDULER_NOT_STARTED != ::xTaskGetSchedulerState())
+        std::strncpy(record_.task, ::pcTaskGetName(nullptr), CRASH_RECORD_TASK_NAME_LENGTH - 1);
+
+    record_.magic = CRASH_RECORD_MAGIC;
+    record_.crc = Crc(record_);
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    // Write back the record before the reset.
+    SCB_CleanDCache();
+#endif
+    __DSB();
+    HAL_NVIC_SystemReset();
+
+    while (true)
+        ;
+}
+
+bool CrashRecord::IsValid()
+{
+    return (CRASH_RECORD_MAGIC == record_.magic) && (Crc(record_) == record_.crc);
+}
+
+void CrashRecord::Print()
+{
+    MURASAKI_ASSERT(IsValid())
+
+    murasaki::debugger->Printf("!!! Crash record of the last reset. Exception %u in task \"%s\"\n",
+                               static_cast<unsigned int>(record_.ipsr & 0x1FF),
+                               record_.task);
+    murasaki::debugger->Printf("PC   : 0x%08x, LR   : 0x%08x, SP   : 0x%08x, xPSR : 0x%08x\n",
+                               static_cast<unsigned int>(record_.pc),
+                               static_cast<unsigned int>(record_.lr),
+                               static_cast<unsigned int>(record_.sp),
+                               static_cast<unsigned int>(record_.xpsr));
+    murasaki::debugger->Printf("R0   : 0x%08x, R1   : 0x%08x, R2   : 0x%08x, R3   : 0x%08x, R12 : 0x%08x\n",
+                               static_cast<unsigned int>(record_.r0),
+                               static_cast<unsigned int>(record_.r1),
+                               static_cast<unsigned int>(record_.r2),
+                               static_cast<unsigned int>(record_.r3),
+                               static_cast<unsigned int>(record_.r12));
+    murasaki::debugger->Printf("CFSR : 0x%08x, HFSR : 0x%08x, MMFAR : 0x%08x, BFAR : 0x%08x, EXC_RETURN : 0x%08x\n",
+                               static_cast<unsigned int>(record_.cfsr),
+                               static_cast<unsigned int>(record_.hfsr),
+                               static_cast<unsigned int>(record_.mmfar),
+                               static_cast<unsigned int>(record_.bfar),
+                               static_cast<unsigned int>(record_.exc_return));
+    for (int i = 0; i < CRASH_RECORD_STACK_WORDS; i += 4)
+        murasaki::debugger->Printf("SP+%02x : 0x%08x 0x%08x 0x%08x 0x%08x\n",
+                                   i * 4,
+                                   static_cast<unsigned int>(record_.stack[i]),
+                                   static_cast<unsigned int>(record_.stack[i + 1]),
+                                   static_cast<unsigned int>(record_.stack[i + 2]),
+                                   static_cast<unsigned int>(record_.stack[i + 3]));
+    StackUnwinder::Print(record_.chain, record_.chain_length);
+}
+
+void CrashRecord::Clear()
+{
+    record_.magic = 0;
+}
+
+// CRC-32 ( IEEE 802.3 ). By the software, because the CRC unit may be in use at the fault.
+uint32_t CrashRecord::Crc(const Record &record)
+{
+    return CrcService::SoftwareCrc32(&record, offsetof(Record, crc));
+}
+
+} /* namespace murasaki */
@@ -406,6 +406,7 @@ void assert_failed(uint8_t *file, uint32_t line)
   /* USER CODE BEGIN 6 */
   /* User can add his own implementation to report the file name and line number,
      tex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+    PrintCallChain();
     CustomAssertFailed(file, line);
   /* USER CODE END 6 */
 }
@@ -0,0 +1,526 @@
+/**
+ * @file statusled.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Status LED pattern engine driven by a hardware timer.
+ */
+
+#include "statusled.hpp"
+
+#include <algorithm>
+
+// Timer for the LED. Not used by the HAL time base of any project.
+// Where the LED pin is a timer output and a free DMA takes the request of that timer, the timer plays the pattern
+// by the PWM, and the DMA writes the compare register every period. Otherwise, a basic timer interrupts at the edges.
+#if defined(STM32F446xx)
+// PA5 is TIM2_CH1 ( AF1 ). TIM2_UP is the channel 3 of the DMA1 stream 1.
+#define LED_TIMER TIM2
+#define LED_TIMER_CLK_ENABLE() __HAL_RCC_TIM2_CLK_ENABLE()
+#define LED_PWM_AF GPIO_AF1_TIM2
+#define LED_PWM_CCR CCR1
+#define LED_PWM_CCMR1 (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE)
+#define LED_PWM_CCER TIM_CCER_CC1E
+#define LED_PWM_DIER TIM_DIER_UDE
+#define LED_DMA_STREAM DMA1_Stream1
+#define LED_DMA_CHSEL DMA_CHANNEL_3
+#define LED_DMA_CLEAR_FLAGS() \
+    (DMA1->LIFCR = DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 | DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1)
+#define LED_DMA_CLK_ENABLE() __HAL_RCC_DMA1_CLK_ENABLE()
+#elif defined(STM32F722xx) || defined(STM32F746xx)
+// PB7 ( LD2 ) is TIM4_CH2 ( AF2 ). TIM4_UP is the channel 2 of the DMA1 stream 6.
+#define LED_TIMER TIM4
+#define LED_TIMER_CLK_ENABLE() __HAL_RCC_TIM4_CLK_ENABLE()
+#define LED_PWM_AF GPIO_AF2_TIM4
+#define LED_PWM_CCR CCR2
+#define LED_PWM_CCMR1 (TIM_CCMR1_OC2M_2 | TIM_CCMR1_OC2M_1 | TIM_CCMR1_OC2PE)
+#define LED_PWM_CCER TIM_CCER_CC2E
+#define LED_PWM_DIER TIM_DIER_UDE
+#define LED_DMA_STREAM DMA1_Stream6
+#define LED_DMA_CHSEL DMA_CHANNEL_2
+#define LED_DMA_CLEAR_FLAGS() \
+    (DMA1->HIFCR = DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6 | DMA_HIFCR_CDMEIF6 | DMA_HIFCR_CFEIF6)
+#define LED_DMA_CLK_ENABLE() __HAL_RCC_DMA1_CLK_ENABLE()
+#elif defined(STM32H743xx)
+// PB7 ( LD2 ) is TIM4_CH2 ( AF2 ). TIM4_UP is routed to the DMA1 stream 2 by the DMAMUX1 channel 2.
+#define LED_TIMER TIM4
+#define LED_TIMER_CLK_ENABLE() __HAL_RCC_TIM4_CLK_ENABLE()
+#define LED_PWM_AF GPIO_AF2_TIM4
+#define LED_PWM_CCR CCR2
+#define LED_PWM_CCMR1 (TIM_CCMR1_OC2M_2 | TIM_CCMR1_OC2M_1 | TIM_CCMR1_OC2PE)
+#define LED_PWM_CCER TIM_CCER_CC2E
+#define LED_PWM_DIER TIM_DIER_UDE
+#define LED_DMA_STREAM DMA1_Stream2
+#define LED_DMA_CHSEL 0
+#define LED_DMA_CLEAR_FLAGS() \
+    (DMA1->LIFCR = DMA_LIFCR_CTCIF2 | DMA_LIFCR_CHTIF2 | DMA_LIFCR_CTEIF2 | DMA_LIFCR_CDMEIF2 | DMA_LIFCR_CFEIF2)
+#define LED_DMA_ROUTE() (DMAMUX1_Channel2->CCR = DMA_REQUEST_TIM4_UP)
+#define LED_DMA_CLK_ENABLE() __HAL_RCC_DMA1_CLK_ENABLE()
+#elif defined(STM32L152xE)
+// PA5 is TIM2_CH1 ( AF1 ). TIM2_UP is the DMA1 channel 2.
+#define LED_TIMER TIM2
+#define LED_TIMER_CLK_ENABLE() __HAL_RCC_TIM2_CLK_ENABLE()
+#define LED_PWM_AF GPIO_AF1_TIM2
+#define LED_PWM_CCR CCR1
+#define LED_PWM_CCMR1 (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE)
+#define LED_PWM_CCER TIM_CCER_CC1E
+#define LED_PWM_DIER TIM_DIER_UDE
+#define LED_DMA_CHANNEL DMA1_Channel2
+#define LED_DMA_CLK_ENABLE() __HAL_RCC_DMA1_CLK_ENABLE()
+#elif defined(STM32F091xC)
+// PA5 is TIM2_CH1 ( AF2 ). TIM2_UP is only on the DMA1 channel 2, which is taken by the console.
+// The compare of the TIM2_CH2 at zero is remapped to the DMA1 channel 3 instead. It is requested at the start of the
+// period, as well as the update.
+#define LED_TIMER TIM2
+#define LED_TIMER_CLK_ENABLE() __HAL_RCC_TIM2_CLK_ENABLE()
+#define LED_PWM_AF GPIO_AF2_TIM2
+#define LED_PWM_CCR CCR1
+#define LED_PWM_CCMR1 (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE)
+#define LED_PWM_CCER TIM_CCER_CC1E
+#define LED_PWM_DIER TIM_DIER_CC2DE
+#define LED_DMA_CHANNEL DMA1_Channel3
+#define LED_DMA_ROUTE() __HAL_DMA1_REMAP(HAL_DMA1_CH3_TIM2_CH2)
+#define LED_DMA_CLK_ENABLE() __HAL_RCC_DMA1_CLK_ENABLE()
+#elif defined(STM32G0B1xx)
+// PA5 is TIM2_CH1 ( AF2 ). TIM2_UP is routed to the DMA1 channel 3 by the DMAMUX1 channel 2.
+#define LED_TIMER TIM2
+#define LED_TIMER_CLK_ENABLE() __HAL_RCC_TIM2_CLK_ENABLE()
+#define LED_PWM_AF GPIO_AF2_TIM2
+#define LED_PWM_CCR CCR1
+#define LED_PWM_CCMR1 (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE)
+#define LED_PWM_CCER TIM_CCER_CC1E
+#define LED_PWM_DIER TIM_DIER_UDE
+#define LED_DMA_CHANNEL DMA1_Channel3
+#define LED_DMA_ROUTE() (DMAMUX1_Channel2->CCR = DMA_REQUEST_TIM2_UP)
+#define LED_DMA_CLK_ENABLE() __HAL_RCC_DMA1_CLK_ENABLE()
+#elif defined(STM32G431xx)
+// PA5 is TIM2_CH1 ( AF1 ). TIM2_UP is routed to the DMA1 channel 3 by the DMAMUX1 channel 2.
+#define LED_TIMER TIM2
+#define LED_TIMER_CLK_ENABLE() __HAL_RCC_TIM2_CLK_ENABLE()
+#define LED_PWM_AF GPIO_AF1_TIM2
+#define LED_PWM_CCR CCR1
+#define LED_PWM_CCMR1 (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE)
+#define LED_PWM_CCER TIM_CCER_CC1E
+#define LED_PWM_DIER TIM_DIER_UDE
+#define LED_DMA_CHANNEL DMA1_Channel3
+#define LED_DMA_ROUTE() (DMAMUX1_Channel2->CCR = DMA_REQUEST_TIM2_UP)
+#define LED_DMA_CLK_ENABLE() \
+    do { __HAL_RCC_DMAMUX1_CLK_ENABLE(); __HAL_RCC_DMA1_CLK_ENABLE(); } while (0)
+#elif defined(STM32L412xx)
+// PB13 ( LD4 ) is TIM15_CH1N ( AF14 ). TIM15_UP is the request 7 of the DMA1 channel 5.
+// The TIM15 is on the APB2.
+#define LED_TIMER TIM15
+#define LED_TIMER_CLK_ENABLE() __HAL_RCC_TIM15_CLK_ENABLE()
+#define LED_TIMER_PCLK() HAL_RCC_GetPCLK2Freq()
+#define LED_PWM_AF GPIO_AF14_TIM15
+#define LED_PWM_CCR CCR1
+#define LED_PWM_CCMR1 (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE)
+#define LED_PWM_CCER TIM_CCER_CC1NE
+#define LED_PWM_BDTR TIM_BDTR_MOE
+#define LED_PWM_DIER TIM_DIER_UDE
+#define LED_DMA_CHANNEL DMA1_Channel5
+#define LED_DMA_ROUTE() (DMA1_CSELR->CSELR = (DMA1_CSELR->CSELR & ~DMA_CSELR_C5S) | (7 << DMA_CSELR_C5S_Pos))
+#define LED_DMA_CLK_ENABLE() __HAL_RCC_DMA1_CLK_ENABLE()
+#elif defined(STM32H503xx)
+// PA5 is TIM2_CH1 ( AF1 ). TIM2_UP is the request of the GPDMA1 channel 0.
+#define LED_TIMER TIM2
+#define LED_TIMER_CLK_ENABLE() __HAL_RCC_TIM2_CLK_ENABLE()
+#define LED_PWM_AF GPIO_AF1_TIM2
+#define LED_PWM_CCR CCR1
+#define LED_PWM_CCMR1 (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE)
+#define LED_PWM_CCER TIM_CCER_CC1E
+#define LED_PWM_DIER TIM_DIER_UDE
+#define LED_GPDMA_CHANNEL GPDMA1_Channel0
+#define LED_DMA_REQUEST GPDMA1_REQUEST_TIM2_UP
+#define LED_DMA_CLK_ENABLE() __HAL_RCC_GPDMA1_CLK_ENABLE()
+#else
+// G070. PA5 is not a timer output. The TIM7 interrupts at the edges.
+#define LED_TIMER TIM7
+#define LED_TIMER_IRQn TIM7_IRQn
+#define LED_TIMER_IRQHandler TIM7_IRQHandler
+#define LED_TIMER_CLK_ENABLE() __HAL_RCC_TIM7_CLK_ENABLE()
+#endif
+
+#if !defined(LED_TIMER_PCLK)
+#define LED_TIMER_PCLK() HAL_RCC_GetPCLK1Freq()
+#endif
+
+// Length of the segments [tick].
+#define STEADY_TICKS 10000              // Off and On. Just to keep the timer running.
+#define BLINK_TICKS 5000
+#define FLASH_TICKS 1000                // Heartbeat.
+#define HEARTBEAT_PAUSE_TICKS 7000
+#define CODE_ON_TICKS 2000              // Error code.
+#define CODE_OFF_TICKS 3000
+#define CODE_PAUSE_TICKS 15000
+#define BREATH_PERIOD_TICKS 100         // 100Hz PWM.
+#define BREATH_STEPS 100                // PWM periods to fade in. The same to fade out.
+// Shortest segment [tick]. The basic timer stops counting with ARR = 0, and never updates again.
+#define MIN_SEGMENT_TICKS 2
+
+#if defined(LED_PWM_CCR)
+// PWM period of the patterns other than the breathing [tick]. The segments above are multiple of this.
+#define PWM_UNIT_TICKS 1000
+// Compare values for one cycle of the pattern. The breathing is the longest.
+#define PWM_TABLE_SIZE (BREATH_STEPS * 2)
+
+// Read by the DMA. Aligned to the cache line for the cleaning on F7 and H7.
+static uint32_t pwm_table[PWM_TABLE_SIZE] __attribute__((aligned(32)));
+#else
+extern "C" void LED_TIMER_IRQHandler()
+{
+    murasaki::StatusLed::HandleInterrupt();
+}
+#endif
+
+#if defined(LED_GPDMA_CHANNEL)
+// Linked list item of the GPDMA. Reloads the count and the source, and links to itself. So, the table is circular.
+static uint32_t gpdma_node[3] __attribute__((aligned(4)));
+#endif
+
+namespace murasaki {
+
+StatusLed *StatusLed::instance_ = nullptr;
+
+StatusLed::StatusLed(GPIO_TypeDef *port, uint16_t pin)
+        :
+        port_(port),
+        pin_(pin),
+        request_(kslOff),
+        pattern_(kslOff),
+        code_(0),
+        step_(0)
+{
+    MURASAKI_ASSERT(nullptr != port)
+    MURASAKI_ASSERT(nullptr == instance_)
+    instance_ = this;
+}
+
+#if defined(LED_PWM_CCR)
+
+void StatusLed::Start(StatusLedPattern pattern, unsigned int code)
+{
+    LED_TIMER_CLK_ENABLE();
+    LED_DMA_CLK_ENABLE();
+#if defined(LED_DMA_ROUTE)
+    LED_DMA_ROUTE();
+#endif
+
+    LED_TIMER->CR1 = 0;
+    LED_TIMER->DIER = 0;
+    LED_TIMER->PSC = Prescaler();
+    LED_TIMER->ARR = PWM_UNIT_TICKS - 1;
+    LED_TIMER->LED_PWM_CCR = 0;
+    // PWM mode 1 with the preload. The compare value written by the DMA is effective from the next period.
+    LED_TIMER->CCMR1 = LED_PWM_CCMR1;
+    LED_TIMER->CCER = LED_PWM_CCER;
+#if defined(LED_PWM_BDTR)
+    LED_TIMER->BDTR = LED_PWM_BDTR;
+#endif
+#if defined(STM32F091xC)
+    // The CH2 is not an output. Its compare at zero requests the DMA.
+    LED_TIMER->CCR2 = 0;
+#endif
+    LED_TIMER->CR1 = TIM_CR1_ARPE | TIM_CR1_CEN;
+
+    // The timer drives the LED pin, instead of the ODR.
+    GPIO_InitTypeDef init = { };
+    init.Pin = pin_;
+    init.Mode = GPIO_MODE_AF_PP;
+    init.Pull = GPIO_NOPULL;
+    init.Speed = GPIO_SPEED_FREQ_LOW;
+    init.Alternate = LED_PWM_AF;
+    HAL_GPIO_Init(port_, &init);
+
+    SetPattern(pattern, code);
+}
+
+void StatusLed::SetPattern(StatusLedPattern pattern, unsigned int code)
+{
+    MURASAKI_ASSERT(kslErrorCode != pattern || (1 <= code && code <= 15))
+
+    // The task and the ISR may change the pattern at the same time.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    request_ = (code << 8) | pattern;
+    pattern_ = pattern;
+    code_ = code;
+    step_ = 0;
+
+    LED_TIMER->DIER = 0;
+    StopDma();
+
+    if (kslOff == pattern_ || kslOn == pattern_) {
+        // No DMA. The compare above the ARR keeps the output high.
+        LED_TIMER->ARR = PWM_UNIT_TICKS - 1;
+        LED_TIMER->LED_PWM_CCR = (kslOn == pattern_) ? PWM_UNIT_TICKS : 0;
+        LED_TIMER->EGR = TIM_EGR_UG;
+    }
+    else {
+        const unsigned int period = (kslBreathing == pattern_) ? BREATH_PERIOD_TICKS : PWM_UNIT_TICKS;
+        const unsigned int length = FillTable();
+
+        // The first two periods are written by the CPU. The update event now loads the first one, and the
+        // second one waits in the preload register. The DMA starts from the third one.
+        LED_TIMER->ARR = period - 1;
+        LED_TIMER->LED_PWM_CCR = pwm_table[0];
+        LED_TIMER->EGR = TIM_EGR_UG;
+        LED_TIMER->LED_PWM_CCR = pwm_table[1];
+        std::rotate(pwm_table, pwm_table + 2, pwm_table + length);
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+        // The DMA reads the memory, not the cache.
+        if (SCB->CCR & SCB_CCR_DC_Msk)
+            SCB_CleanDCache_by_Addr(pwm_table, sizeof(pwm_table));
+#endif
+        StartDma(length);
+        LED_TIMER->SR = 0;
+        LED_TIMER->DIER = LED_PWM_DIER;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+unsigned int StatusLed::FillTable()
+{
+    unsigned int length = 0;
+    bool on;
+
+    if (kslBreathing == pattern_) {
+        // A pair of the on and off segments is a PWM period.
+        do {
+            pwm_table[length++] = NextSegment(on);
+            NextSegment(on);
+        } while (0 != step_);
+    }
+    else {
+        // A segment is the repeat of the PWM period, on or off.
+        do {
+            unsigned int ticks = NextSegment(on);
+
+            MURASAKI_ASSERT(0 == ticks % PWM_UNIT_TICKS)
+            for (; 0 < ticks; ticks -= PWM_UNIT_TICKS)
+                pwm_table[length++] = on ? PWM_UNIT_TICKS : 0;
+        } while (0 != step_);
+    }
+
+    MURASAKI_ASSERT(2 <= length && length <= PWM_TABLE_SIZE)
+    return length;
+}
+
+#if defined(LED_DMA_STREAM)
+
+void StatusLed::StartDma(unsigned int length)
+{
+    LED_DMA_CLEAR_FLAGS();
+    LED_DMA_STREAM->PAR = reinterpret_cast<uint32_t>(&LED_TIMER->LED_PWM_CCR);
+    LED_DMA_STREAM->M0AR = reinterpret_cast<uint32_t>(pwm_table);
+    LED_DMA_STREAM->NDTR = length;
+    // Word to word, memory to peripheral, circular. The FIFO is not used.
+    LED_DMA_STREAM->CR = LED_DMA_CHSEL | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1 | DMA_SxCR_MINC | DMA_SxCR_CIRC
+            | DMA_SxCR_DIR_0 | DMA_SxCR_EN;
+}
+
+void StatusLed::StopDma()
+{
+    LED_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+    // The stream finishes the current transfer.
+    while (LED_DMA_STREAM->CR & DMA_SxCR_EN)
+        ;
+}
+
+#elif defined(LED_DMA_CHANNEL)
+
+void StatusLed::StartDma(unsigned int length)
+{
+    LED_DMA_CHANNEL->CPAR = reinterpret_cast<uint32_t>(&LED_TIMER->LED_PWM_CCR);
+    LED_DMA_CHANNEL->CMAR = reinterpret_cast<uint32_t>(pwm_table);
+    LED_DMA_CHANNEL->CNDTR = length;
+    // Word to word, memory to peripheral, circular.
+    LED_DMA_CHANNEL->CCR = DMA_CCR_MSIZE_1 | DMA_CCR_PSIZE_1 | DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_DIR
+            | DMA_CCR_EN;
+}
+
+void StatusLed::StopDma()
+{
+    LED_DMA_CHANNEL->CCR = 0;
+}
+
+#elif defined(LED_GPDMA_CHANNEL)
+
+void StatusLed::StartDma(unsigned int length)
+{
+    const uint32_t node = reinterpret_cast<uint32_t>(gpdma_node);
+    const uint32_t link = DMA_CLLR_UB1 | DMA_CLLR_USA | DMA_CLLR_ULL | (node & DMA_CLLR_LA);
+
+    // The node is loaded at the end of the block. Its fields are in the order of the registers.
+    gpdma_node[0] = length * sizeof(uint32_t);          // CBR1
+    gpdma_node[1] = reinterpret_cast<uint32_t>(pwm_table);  // CSAR
+    gpdma_node[2] = link;                               // CLLR
+
+    LED_GPDMA_CHANNEL->CFCR = DMA_CFCR_TCF | DMA_CFCR_HTF | DMA_CFCR_DTEF | DMA_CFCR_ULEF | DMA_CFCR_USEF
+            | DMA_CFCR_SUSPF | DMA_CFCR_TOF;
+    LED_GPDMA_CHANNEL->CLBAR = node & DMA_CLBAR_LBA;
+    // Word to word. The source increments. The timer, the destination, requests each word.
+    LED_GPDMA_CHANNEL->CTR1 = DMA_CTR1_SDW_LOG2_1 | DMA_CTR1_SINC | DMA_CTR1_DDW_LOG2_1;
+    LED_GPDMA_CHANNEL->CTR2 = (LED_DMA_REQUEST << DMA_CTR2_REQSEL_Pos) | DMA_CTR2_DREQ;
+    LED_GPDMA_CHANNEL->CBR1 = gpdma_node[0];
+    LED_GPDMA_CHANNEL->CSAR = gpdma_node[1];
+    LED_GPDMA_CHANNEL->CDAR = reinterpret_cast<uint32_t>(&LED_TIMER->LED_PWM_CCR);
+    LED_GPDMA_CHANNEL->CLLR = link;
+    LED_GPDMA_CHANNEL->CCR = DMA_CCR_EN;
+}
+
+void StatusLed::StopDma()
+{
+    // The enabled channel is suspended before the reset.
+    if (LED_GPDMA_CHANNEL->CCR & DMA_CCR_EN) {
+        LED_GPDMA_CHANNEL->CCR |= DMA_CCR_SUSP;
+        while (!(LED_GPDMA_CHANNEL->CSR & DMA_CSR_SUSPF))
+            ;
+        LED_GPDMA_CHANNEL->CCR = DMA_CCR_RESET;
+    }
+}
+
+#endif
+
+void StatusLed::HandleInterrupt()
+{
+    // The PWM and the DMA play the pattern. No interrupt.
+}
+
+#else
+
+void StatusLed::Start(StatusLedPattern pattern, unsigned int code)
+{
+    MURASAKI_ASSERT(kslErrorCode != pattern || (1 <= code && code <= 15))
+    request_ = (code << 8) | pattern;
+
+    LED_TIMER_CLK_ENABLE();
+    LED_TIMER->CR1 = 0;
+    LED_TIMER->PSC = Prescaler();
+    LED_TIMER->ARR = 1;
+    // Load the prescaler. The update flag by this is cleared.
+    LED_TIMER->EGR = TIM_EGR_UG;
+    LED_TIMER->SR = 0;
+    LED_TIMER->DIER = TIM_DIER_UIE;
+
+    // The handler doesn't call the RTOS. The lowest priority is enough.
+    HAL_NVIC_SetPriority(LED_TIMER_IRQn, (1 << __NVIC_PRIO_BITS) - 1, 0);
+    HAL_NVIC_EnableIRQ(LED_TIMER_IRQn);
+
+    LED_TIMER->CR1 = TIM_CR1_CEN;
+}
+
+void StatusLed::SetPattern(StatusLedPattern pattern, unsigned int code)
+{
+    MURASAKI_ASSERT(kslErrorCode != pattern || (1 <= code && code <= 15))
+
+    request_ = (code << 8) | pattern;
+    // Update event now. The interrupt handler takes the request.
+    LED_TIMER->EGR = TIM_EGR_UG;
+}
+
+#endif
+
+void StatusLed::Retime()
+{
+    // The PSC is buffered. Loaded at the next update event.
+    if (LED_TIMER->CR1 & TIM_CR1_CEN)
+        LED_TIMER->PSC = Prescaler();
+}
+
+uint32_t StatusLed::Prescaler()
+{
+    // The timers on APB run at twice of PCLK, when the APB is divided.
+    uint32_t clock = LED_TIMER_PCLK();
+    if (clock != HAL_RCC_GetHCLKFreq())
+        clock *= 2;
+
+    return clock / kTickHz - 1;
+}
+
+unsigned int StatusLed::NextSegment(bool &on)
+{
+    unsigned int ticks;
+
+    switch (pattern_) {
+        case kslOn:
+        case kslOff:
+            on = (kslOn == pattern_);
+            ticks = STEADY_TICKS;
+            step_ = 0;
+            break;
+        case kslBlink:
+            on = (0 == step_);
+            ticks = BLINK_TICKS;
+            step_ = (step_ + 1) % 2;
+            break;
+        case kslHeartbeat:
+            on = (0 == (step_ & 1));
+            ticks = (3 == step_) ? HEARTBEAT_PAUSE_TICKS : FLASH_TICKS;
+            step_ = (step_ + 1) % 4;
+            break;
+        case kslErrorCode:
+            on = (0 == (step_ & 1));
+            ticks = on ? CODE_ON_TICKS : ((step_ == code_ * 2 - 1) ? CODE_PAUSE_TICKS : CODE_OFF_TICKS);
+            step_ = (step_ + 1) % (code_ * 2);
+            break;
+        case kslBreathing: {
+            // Triangle of the brightness, squared for the eye.
+            const unsigned int period = step_ / 2;
+            const unsigned int level = (period < BREATH_STEPS) ? period : (BREATH_STEPS * 2 - 1 - period);
+            unsigned int on_ticks = level * level * BREATH_PERIOD_TICKS / (BREATH_STEPS * BREATH_STEPS);
+
+            // Too short pulse is folded into the off segment. The off segment is 2 ticks at least by the square.
+            if (on_ticks < MIN_SEGMENT_TICKS)
+                on_ticks = 0;
+
+            on = (0 == (step_ & 1));
+            ticks = on ? on_ticks : BREATH_PERIOD_TICKS - on_ticks;
+            step_ = (step_ + 1) % (BREATH_STEPS * 4);
+            break;
+        }
+        default:
+            on = false;
+            ticks = STEADY_TICKS;
+            break;
+    }
+    return ticks;
+}
+
+#if !defined(LED_PWM_CCR)
+
+void StatusLed::HandleInterrupt()
+{
+    StatusLed *const self = instance_;
+    unsigned int ticks;
+    bool on;
+
+    // The basic timer has only the UIF.
+    LED_TIMER->SR = 0;
+    if (nullptr == self)
+        return;
+
+    // New pattern from SetPattern().
+    const uint32_t request = self->request_;
+    if (request != ((self->code_ << 8) | self->pattern_)) {
+        self->pattern_ = static_cast<StatusLedPattern>(request & 0xFF);
+        self->code_ = request >> 8;
+        self->step_ = 0;
+    }
+
+    // The zero length segment is skipped. Any shorter one would stop the timer.
+    do
+        ticks = self->NextSegment(on);
+    while (ticks < MIN_SEGMENT_TICKS);
+
+    self->port_->BSRR = on ? self->pin_ : self->pin_ << 16;
+    // The preload is disabled. The new length is effective in this period.
+    LED_TIMER->ARR = ticks - 1;
+}
+
+#endif
+
+} /* namespace murasaki */
@@ -0,0 +1,84 @@
+/**
+ * @file cyclecounter.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Portable CPU cycle counter and busy wait.
+ */
+
+#ifndef CYCLECOUNTER_HPP_
+#define CYCLECOUNTER_HPP_
+
+#include "murasaki.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief CPU cycle counter for the short time measurement and busy wait.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The source of the count depends on the core :
+ * @li Cortex-M3/M4/M7/M33 : DWT cycle counter.
+ * @li Cortex-M0/M0+ : The SysTick current value, extended to 32bit by software.
+ *
+ * The SysTick version counts correctly only when Get() is called at least once in a
+ * SysTick period ( 1mS with the FreeRTOS default ). And the SysTick must be running. That is,
+ * the scheduler must be started. This is enough for the busy wait and the short measurement.
+ *
+ * The count wraps around at 2^32. Take the difference by the unsigned subtraction.
+ *
+ * @code
+ * murasaki::CycleCounter::Init();
+ * uint32_t start = murasaki::CycleCounter::Get();
+ * DoSomething();
+ * uint32_t cycles = murasaki::CycleCounter::Get() - start;
+ * @endcode
+ */
+class CycleCounter
+{
+ public:
+    /**
+     * @brief Start the counter.
+     * @details
+     * Can be called many times.
+     */
+    static void Init();
+
+    /**
+     * @brief Get the current count.
+     * @return Count in CPU cycles.
+     */
+    static uint32_t Get();
+
+    /**
+     * @brief Convert the micro seconds to the CPU cycles.
+     * @param us Time [uS]
+     * @return Cycles with the current core clock.
+     */
+    static uint32_t MicroSecondsToCycles(unsigned int us);
+
+    /**
+     * @brief Convert the CPU cycles to the micro seconds.
+     * @param cycles Count of the CPU cycles.
+     * @return Time [uS] with the current core clock.
+     */
+    static unsigned int CyclesToMicroSeconds(uint32_t cycles);
+
+    /**
+     * @brief Busy wait.
+     * @param us Time to wait [uS]. Must be shorter than a SysTick period on Cortex-M0/M0+.
+     * @details
+     * The wait doesn't yield the CPU. Use only for the short wait like the bit-banging.
+     */
+    static void DelayMicroSeconds(unsigned int us);
+
+ private:
+#if !defined(DWT_CTRL_CYCCNTENA_Msk)
+    static uint32_t last_value_;   // The last SysTick->VAL.
+    static uint32_t count_;        // Extended count.
+#endif
+};
+
+} /* namespace murasaki */
+
+#endif /* CYCLECOUNTER_HPP_ */
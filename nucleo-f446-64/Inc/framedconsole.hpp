@@ -0,0 +1,144 @@
+/**
+ * @file framedconsole.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief COBS framed binary channels on the console UART.
+ */
+
+#ifndef FRAMEDCONSOLE_HPP_
+#define FRAMEDCONSOLE_HPP_
+
+#include "murasaki.hpp"
+
+// Largest payload of a frame. The frame before the COBS is up to 254 bytes, with the channel, the sequence and the CRC.
+#define FRAMED_CONSOLE_MAX_PAYLOAD 250
+// Number of the channels. Each channel has its own sequence number.
+#define FRAMED_CONSOLE_CHANNEL_COUNT 16
+// Channel of the text of the debugger.
+#define FRAMED_CONSOLE_CHANNEL_TEXT 0
+// Channel of the binary record of the demo.
+#define FRAMED_CONSOLE_CHANNEL_TELEMETRY 1
+// Delimiter, code, channel, sequence, payload, CRC and delimiter [byte].
+#define FRAMED_CONSOLE_BUFFER_SIZE (FRAMED_CONSOLE_MAX_PAYLOAD + 7)
+
+namespace murasaki {
+
+class CrcService;
+
+/**
+ * @brief Logger which multiplexes the text and the binary records on the console, by the COBS frames.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The host tool parses the text of the Printf() is fragile, and the text is around 3 times bigger than the data.
+ * This class sends the binary records at the raw byte rate, on the same UART with the debugger. Each frame is :
+ *
+ * | Byte      | Content                                                              |
+ * |-----------|----------------------------------------------------------------------|
+ * | 0         | Channel. FRAMED_CONSOLE_CHANNEL_TEXT for the debugger.               |
+ * | 1         | Sequence number of the channel. Incremented by each frame.           |
+ * | 2 - n+1   | Payload. Up to FRAMED_CONSOLE_MAX_PAYLOAD bytes.                     |
+ * | n+2 - n+3 | CRC-16/CCITT-FALSE of the above, little endian.                      |
+ *
+ * The frame is encoded by the COBS, and terminated by 0x00. The receiver finds the frame boundary by the 0x00,
+ * the corrupted frame by the CRC, and the lost frame by the sequence number. See tools/framedconsole.py.
+ *
+ * The class is a UartLogger. Give it to the debugger instead of the UartLogger. The text of the debugger goes to
+ * the channel 0. The other channels are for the binary records, written in place by the builder :
+ *
+ * @code
+ * murasaki::platform.framed_console = new murasaki::FramedConsole(murasaki::platform.uart_console);
+ * murasaki::debugger = new murasaki::Debugger(murasaki::platform.framed_console);
+ *
+ * uint32_t *record = reinterpret_cast<uint32_t*>(murasaki::platform.framed_console->Begin(1));
+ * record[0] = HAL_GetTick();
+ * record[1] = sample;
+ * murasaki::platform.framed_console->End(8);
+ * @endcode
+ *
+ * The payload is written directly in the transmission buffer. The COBS encoding is done in place, because a frame
+ * is shorter than 255 bytes. There is no intermediate copy. The COBS adds 2 bytes per frame, the header and the
+ * CRC add 4 bytes.
+ *
+ * The Begin() and the End() are a pair. The console is locked between them, and while the frame is transmitted.
+ * Thread safe. Not callable from the ISR. The post mortem output of the debugger is the text, not framed.
+ *
+ * The CRC is computed by the @ref CrcService, if given. The CRC unit takes the large text frames from the CPU.
+ */
+class FramedConsole : public UartLogger
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param uart The console. Shared with the UartLogger part.
+     * @param crc CRC unit for the frames. nullptr to compute by the software.
+     */
+    FramedConsole(UartStrategy *uart, CrcService *crc = nullptr);
+
+    /**
+     * @brief Send the text of the debugger in the channel 0.
+     * @param message Text. Not terminated by the null.
+     * @param size Length of the text. Split into the frames of FRAMED_CONSOLE_MAX_PAYLOAD bytes.
+     */
+    virtual void putMessage(char message[], unsigned int size);
+
+    /**
+     * @brief Start a frame.
+     * @param channel Channel of the frame. Up to FRAMED_CONSOLE_CHANNEL_COUNT - 1.
+     * @return Pointer to write the payload. FRAMED_CONSOLE_MAX_PAYLOAD bytes. Aligned by 4.
+     * @details
+     * Must be followed by End().
+     */
+    uint8_t* Begin(unsigned int channel);
+
+    /**
+     * @brief Encode and transmit the frame started by the Begin().
+     * @param size Size of the written payload [byte]. Up to FRAMED_CONSOLE_MAX_PAYLOAD.
+     */
+    void End(unsigned int size);
+
+    /**
+     * @brief Copy and send a record in a frame.
+     * @param channel Channel of the frame. Up to FRAMED_CONSOLE_CHANNEL_COUNT - 1.
+     * @param record Record to send.
+     * @param size Size of the record [byte]. Up to FRAMED_CONSOLE_MAX_PAYLOAD.
+     */
+    void Send(unsigned int channel, const void *record, unsigned int size);
+
+    /**
+     * @brief Number of the sent frames.
+     */
+    unsigned int GetFrameCount() const;
+    /**
+     * @brief Number of the bytes on the UART, including the framing.
+     */
+    unsigned int GetByteCount() const;
+
+    /**
+     * @brief CRC-16/CCITT-FALSE. Polynomial 0x1021, initial value 0xFFFF, no reflection.
+     * @param data Data.
+     * @param size Size of the data [byte].
+     * @param crc Initial value. The result of the previous data to continue.
+     * @return CRC of the data.
+     */
+    static uint16_t Crc16(const uint8_t *data, unsigned int size, uint16_t crc = 0xFFFF);
+
+ private:
+    UartStrategy *const uart_;
+    CrcService *const crc_;
+    CriticalSection *critical_section_;
+
+    // The first frame is preceded by a delimiter, to separate it from the text before.
+    bool synced_;
+    uint8_t sequences_[FRAMED_CONSOLE_CHANNEL_COUNT];
+
+    unsigned int frames_;
+    unsigned int bytes_;
+
+    // The payload is at the offset 4.
+    alignas(4) uint8_t buffer_[FRAMED_CONSOLE_BUFFER_SIZE];
+};
+
+} /* namespace murasaki */
+
+#endif /* FRAMEDCONSOLE_HPP_ */
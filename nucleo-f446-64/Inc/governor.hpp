@@ -0,0 +1,119 @@
+/**
+ * @file governor.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Clock profile governor driven by the idle time.
+ */
+
+#ifndef GOVERNOR_HPP_
+#define GOVERNOR_HPP_
+
+#include "murasaki.hpp"
+#include "clockprofile.hpp"
+
+// Number of the samples in the sliding window.
+#define GOVERNOR_WINDOW 10
+// Step up when the load of the window exceeds this value [%].
+#define GOVERNOR_UP_PERCENT 80
+// Step down when the load estimated at the lower profile is below this value [%].
+#define GOVERNOR_DOWN_PERCENT 60
+
+namespace murasaki {
+
+/**
+ * @brief Automatic selector of the @ref ClockProfile by the CPU load.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The governor task samples the idle cycles and the total cycles of @ref IdleTime in every period.
+ * The load is the average of the last GOVERNOR_WINDOW samples.
+ *
+ * @li The profile steps up when the load exceeds GOVERNOR_UP_PERCENT.
+ * @li The profile steps down when the load scaled to the lower frequency is below GOVERNOR_DOWN_PERCENT.
+ *
+ * The gap between two thresholds is the hysteresis. After each switching, the window is cleared.
+ * So, the next decision waits for the window filled with the new clock.
+ *
+ * A task can pin the minimum profile while it does the latency critical work :
+ *
+ * @code
+ * murasaki::platform.governor->Pin(murasaki::kcpMax);
+ * // Burst of the I2C transactions.
+ * murasaki::platform.governor->Unpin(murasaki::kcpMax);
+ * @endcode
+ *
+ * Pin() switches the clock immediately, if the current profile is lower. The pins are counted.
+ * The profile doesn't go below the highest pinned one.
+ */
+class Governor
+{
+ public:
+    /**
+     * @brief Constructor.
+     * @param profile Clock switcher to drive.
+     * @param period_ms Sampling period [mS].
+     * @details
+     * The governor doesn't run until Start() is called.
+     */
+    Governor(ClockProfile *profile, unsigned int period_ms);
+
+    /**
+     * @brief Start the governor task.
+     */
+    void Start();
+
+    /**
+     * @brief Hold the profile at the given level or above.
+     * @param level Minimum profile.
+     * @details
+     * Must be called from a task. Call Unpin() with the same level after the work.
+     */
+    void Pin(ClockProfileLevel level);
+
+    /**
+     * @brief Release the pin by Pin().
+     * @param level The level given to Pin().
+     * @details
+     * The clock is not lowered immediately. The governor decides it later.
+     */
+    void Unpin(ClockProfileLevel level);
+
+    /**
+     * @brief Get the CPU load of the window.
+     * @return Load [%].
+     */
+    unsigned int GetLoad() const;
+
+    /**
+     * @brief Get the number of the switching by the governor and Pin().
+     * @return Count of the switching.
+     */
+    unsigned int GetSwitches() const;
+
+ private:
+    static void TaskBody(const void *ptr);
+    // Following functions must be called in the critical section.
+    void Sample();
+    void Decide();
+    bool Switch(ClockProfileLevel level);
+    void ClearWindow();
+    ClockProfileLevel GetFloor() const;
+
+    ClockProfile *const profile_;
+    const unsigned int period_ms_;
+    CriticalSection *const critical_section_;    // Serializes the switching.
+    murasaki::SimpleTask *task_;
+    unsigned int pins_[kcpMax + 1];
+    uint32_t idle_[GOVERNOR_WINDOW];            // [cycle]
+    uint32_t total_[GOVERNOR_WINDOW];           // [cycle]
+    unsigned int head_;
+    unsigned int count_;                        // Valid samples in the window.
+    uint32_t last_idle_;
+    uint32_t last_total_;
+    volatile unsigned int load_;
+    volatile unsigned int switches_;
+};
+
+} /* namespace murasaki */
+
+#endif /* GOVERNOR_HPP_ */
@@ -0,0 +1,89 @@
+/**
+ * @file stackunwinder.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Heuristic call chain unwinder for the fault and assert reports.
+ */
+
+#ifndef STACKUNWINDER_HPP_
+#define STACKUNWINDER_HPP_
+
+#include "murasaki.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Call chain of the return addresses, without the frame pointer nor the unwind table.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * Scans the stack upward from the given stack pointer, and picks the words which look like
+ * the return address :
+ * @li The Thumb bit is set, and the address is in the code area of the flash.
+ * @li The instruction just before the address is a BL or BLX.
+ *
+ * The result may include the stale return addresses left in the stack, and may miss the
+ * functions which don't push LR. Still, it is good enough to locate the caller of the fault
+ * or assertion. The unwinder doesn't use the heap, the RTOS nor the peripherals. So, it can run in the fault
+ * handler.
+ *
+ * The addresses are converted to the function name and line by tools/symbolize.py with the ELF file.
+ *
+ * The code area and the RAM area are given by the symbols of the linker script :
+ * g_pfnVectors, _etext, _sdata and _estack.
+ */
+class StackUnwinder
+{
+ public:
+    /**
+     * @brief Collect the return addresses from the stack.
+     * @param stack_pointer Where to start the scan.
+     * @param chain Array to store the return addresses.
+     * @param depth Size of the chain array.
+     * @return Number of the addresses stored.
+     * @details
+     * The scan stops at the end of RAM, or after kScanWords words. Returns 0 if the stack_pointer is not in RAM.
+     */
+    static unsigned int Unwind(const uint32_t *stack_pointer, uint32_t *chain, unsigned int depth);
+
+    /**
+     * @brief Collect the return addresses of the caller.
+     * @param chain Array to store the return addresses.
+     * @param depth Size of the chain array.
+     * @return Number of the addresses stored.
+     */
+    static unsigned int Here(uint32_t *chain, unsigned int depth);
+
+    /**
+     * @brief Check whether the address is a return address after a BL / BLX.
+     * @param address Address to check. Bit 0 must be set.
+     * @return true if the address looks like a return address.
+     */
+    static bool IsReturnAddress(uint32_t address);
+
+    /**
+     * @brief Check whether the address is in the RAM.
+     * @param address Address to check.
+     * @param size Size of the area to read from the address [byte].
+     * @return true if the whole area is readable RAM.
+     */
+    static bool IsStackAddress(const void *address, unsigned int size);
+
+    /**
+     * @brief Print the call chain to the debugger console.
+     * @param chain Return addresses.
+     * @param count Number of the addresses.
+     * @details
+     * One line started with "Call chain :". tools/symbolize.py looks for this line.
+     */
+    static void Print(const uint32_t *chain, unsigned int count);
+
+    /**
+     * @brief Maximum number of the words to scan.
+     */
+    static const unsigned int kScanWords = 512;
+};
+
+} /* namespace murasaki */
+
+#endif /* STACKUNWINDER_HPP_ */
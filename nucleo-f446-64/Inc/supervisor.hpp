@@ -0,0 +1,150 @@
+/**
+ * @file supervisor.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Task liveness supervisor with the independent watchdog.
+ */
+
+#ifndef SUPERVISOR_HPP_
+#define SUPERVISOR_HPP_
+
+#include "murasaki.hpp"
+
+// Maximum number of the supervised tasks.
+#define SUPERVISOR_MAX_TASKS 8
+// Length of the task name in the record, including the null termination.
+#define SUPERVISOR_NAME_LENGTH 16
+
+namespace murasaki {
+
+/**
+ * @brief Heartbeat collector which kicks the independent watchdog only when all tasks are alive.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * Each supervised task registers itself with its deadline, and checks in its slot regularly.
+ * The check-in is an increment of a word owned by the task. No lock, no RTOS call.
+ * So, it can be placed in the hot loop.
+ *
+ * @code
+ * unsigned int slot = murasaki::platform.supervisor->Register("defaultTask", 2000);
+ * while (true) {
+ *     murasaki::platform.supervisor->CheckIn(slot);
+ *     ...
+ * }
+ * @endcode
+ *
+ * The supervisor task checks the slots every quarter of the watchdog timeout. The IWDG is
+ * refreshed only when every registered task has checked in within its deadline.
+ * Once a task misses its deadline, the supervisor writes the name of the task into the .noinit section,
+ * and stops refreshing. The IWDG resets the system. The IWDG also resets the system when the
+ * supervisor task itself can't run.
+ *
+ * The record is printed at the next boot :
+ *
+ * @code
+ * if (murasaki::Supervisor::IsRecordValid()) {
+ *     murasaki::Supervisor::PrintRecord();
+ *     murasaki::Supervisor::ClearRecord();
+ * }
+ * @endcode
+ *
+ * The IWDG is driven by the registers directly. The HAL IWDG module is not needed.
+ * Once started, the IWDG can't be stopped until the reset. The IWDG is frozen while the debugger
+ * halts the core.
+ */
+class Supervisor
+{
+ public:
+    /**
+     * @brief Constructor.
+     * @param timeout_ms Timeout of the IWDG [mS].
+     * @details
+     * The watchdog doesn't run until Start() is called.
+     */
+    Supervisor(unsigned int timeout_ms);
+
+    /**
+     * @brief Add a task to the supervision.
+     * @param name Name of the task, for the record.
+     * @param deadline_ms Maximum interval of the check-in [mS].
+     * @return Slot to check in.
+     * @details
+     * The deadline is counted from this call. Can be called before and after Start().
+     */
+    unsigned int Register(const char *name, unsigned int deadline_ms);
+
+    /**
+     * @brief Tell the supervisor that the task is alive.
+     * @param slot The return value of Register().
+     * @details
+     * Only the task which registered the slot may check in. The slot is not checked.
+     */
+    inline void CheckIn(unsigned int slot)
+    {
+        beats_[slot] = beats_[slot] + 1;
+    }
+
+    /**
+     * @brief Start the IWDG and the supervisor task.
+     */
+    void Start();
+
+    /**
+     * @brief Check whether the last reset was caused by the IWDG.
+     * @return true if the reset flag of the IWDG is set.
+     * @details
+     * Clears the reset flags of the RCC.
+     */
+    static bool IsWatchdogReset();
+
+    /**
+     * @brief Check whether the valid deadline miss record exists.
+     * @return true if the record was written before the last reset, and not cleared yet.
+     */
+    static bool IsRecordValid();
+
+    /**
+     * @brief Print the deadline miss record to the debugger console.
+     */
+    static void PrintRecord();
+
+    /**
+     * @brief Invalidate the record.
+     */
+    static void ClearRecord();
+
+ private:
+    // Kept in the .noinit section over the reset.
+    struct Record {
+        uint32_t magic;
+        char task[SUPERVISOR_NAME_LENGTH];
+        uint32_t deadline_ms;
+        uint32_t elapsed_ms;            // Since the last check-in.
+        uint32_t crc;                   // CRC-32 of the all above.
+    };
+
+    static void TaskBody(const void *ptr);
+    static uint32_t Crc(const Record &record);
+    static Record record_;
+
+    void StartWatchdog();
+    void RefreshWatchdog();
+    // Return the slot of the task which missed the deadline. -1 if all tasks are alive.
+    int Inspect();
+    void SaveRecord(int slot);
+
+    const unsigned int timeout_ms_;
+    murasaki::SimpleTask *task_;
+    volatile unsigned int count_;
+    volatile uint32_t beats_[SUPERVISOR_MAX_TASKS];
+    // Following members are accessed by the supervisor task only, after the registration.
+    const char *names_[SUPERVISOR_MAX_TASKS];
+    uint32_t deadlines_[SUPERVISOR_MAX_TASKS];       // [tick]
+    uint32_t last_beats_[SUPERVISOR_MAX_TASKS];
+    uint32_t last_seen_[SUPERVISOR_MAX_TASKS];       // [tick]
+};
+
+} /* namespace murasaki */
+
+#endif /* SUPERVISOR_HPP_ */
@@ -0,0 +1,110 @@
+/**
+ * @file uartfifo.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief FIFO mode of the UART on the STM32G0, G4, H5 and H7.
+ */
+
+#ifndef UARTFIFO_HPP_
+#define UARTFIFO_HPP_
+
+#include "murasaki.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Threshold of the UART FIFO, in the fraction of the FIFO depth.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ */
+enum UartFifoThreshold
+{
+    kuftOneEighth = 0,      ///< 1/8 of the depth.
+    kuftQuarter,            ///< 1/4 of the depth.
+    kuftHalf,               ///< 1/2 of the depth.
+    kuftThreeQuarters,      ///< 3/4 of the depth.
+    kuftSevenEighths,       ///< 7/8 of the depth.
+    kuftFull                ///< Tx FIFO empty / Rx FIFO full.
+};
+
+/**
+ * @brief FIFO mode configurator of the UART.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The USART of the STM32G0, G4, H5 and H7 has the Tx and Rx FIFO. 8 or 16 bytes deep, depending on the series.
+ * The CubeIDE sets the thresholds, but disables the FIFO by HAL_UARTEx_DisableFifoMode() in the generated main.c.
+ * The peripheral then raises the interrupt or the DMA request for each byte.
+ *
+ * Enable() sets the thresholds and enables the FIFO. With the interrupt transfer, the HAL switches
+ * to its FIFO handlers. Each interrupt moves the threshold worth of bytes :
+ *
+ * | Threshold         | Bytes per interrupt of the 16 bytes FIFO |
+ * |-------------------|------------------------------------------|
+ * | kuftOneEighth     | 2                                        |
+ * | kuftHalf          | 8                                        |
+ * | kuftThreeQuarters | 12                                       |
+ * | kuftFull          | 16                                       |
+ *
+ * The reception shorter than the Rx threshold is received byte by byte, as without the FIFO.
+ * With the DMA transfer, the FIFO absorbs the latency of the DMA, and the receiver overrun is less likely.
+ *
+ * @code
+ * murasaki::UartFifo::Enable(&huart3, murasaki::kuftThreeQuarters, murasaki::kuftHalf);
+ * @endcode
+ *
+ * The STM32F0, F4, F7, L1 and L4 (except L4+) have no FIFO. Also, not all USARTs of the G0 have it.
+ * On these UARTs, Enable() returns false and the UART is left untouched.
+ *
+ * The configuration must be done while the UART is idle. That is, before the first transfer.
+ */
+class UartFifo
+{
+ public:
+    /**
+     * @brief Check whether the UART has the FIFO.
+     * @param huart Peripheral handle created by CubeIDE.
+     * @return true if the FIFO is available.
+     */
+    static bool IsSupported(UART_HandleTypeDef *huart);
+
+    /**
+     * @brief Set the thresholds and enable the FIFO.
+     * @param huart Peripheral handle created by CubeIDE.
+     * @param tx_threshold Threshold of the Tx FIFO.
+     * @param rx_threshold Threshold of the Rx FIFO.
+     * @return true if success. false if the UART has no FIFO.
+     */
+    static bool Enable(UART_HandleTypeDef *huart, UartFifoThreshold tx_threshold, UartFifoThreshold rx_threshold);
+
+    /**
+     * @brief Disable the FIFO.
+     * @param huart Peripheral handle created by CubeIDE.
+     * @return true if success. false if the UART has no FIFO.
+     */
+    static bool Disable(UART_HandleTypeDef *huart);
+
+    /**
+     * @brief Check whether the FIFO is enabled.
+     * @param huart Peripheral handle created by CubeIDE.
+     * @return true if enabled.
+     */
+    static bool IsEnabled(UART_HandleTypeDef *huart);
+
+    /**
+     * @brief Number of the bytes moved by each Tx interrupt.
+     * @param huart Peripheral handle created by CubeIDE.
+     * @return Bytes per interrupt. 1 if the FIFO is disabled.
+     */
+    static unsigned int GetTxBytesPerInterrupt(UART_HandleTypeDef *huart);
+
+    /**
+     * @brief Number of the bytes moved by each Rx interrupt.
+     * @param huart Peripheral handle created by CubeIDE.
+     * @return Bytes per interrupt. 1 if the FIFO is disabled.
+     */
+    static unsigned int GetRxBytesPerInterrupt(UART_HandleTypeDef *huart);
+};
+
+} /* namespace murasaki */
+
+#endif /* UARTFIFO_HPP_ */
@@ -0,0 +1,105 @@
+/**
+ * @file crashrecord.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Crash record kept in the no-init RAM over the reset.
+ */
+
+#ifndef CRASHRECORD_HPP_
+#define CRASHRECORD_HPP_
+
+#include "murasaki.hpp"
+
+// Length of the task name in the record, including the null termination.
+#define CRASH_RECORD_TASK_NAME_LENGTH 16
+// Number of the words of the stack just above the exception frame.
+#define CRASH_RECORD_STACK_WORDS 16
+// Number of the return addresses in the call chain.
+#define CRASH_RECORD_CHAIN_DEPTH 8
+
+namespace murasaki {
+
+/**
+ * @brief Crash record of the fault exception.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The fault handler ( CrashRecordHandler() ) doesn't print anything. It writes the record
+ * into the .noinit section and reset the system immediately. The record is printed at the next boot :
+ *
+ * @code
+ * if (murasaki::CrashRecord::IsValid()) {
+ *     murasaki::CrashRecord::Print();
+ *     murasaki::CrashRecord::Clear();
+ * }
+ * @endcode
+ *
+ * The record includes the call chain of the return addresses by the @ref StackUnwinder.
+ *
+ * The record is protected by a magic number and the CRC-32. The garbage of the RAM at
+ * the power on is not mistaken as a record.
+ *
+ * The .noinit section must be defined in the linker script as NOLOAD, and must not be
+ * cleared by the startup.
+ */
+class CrashRecord
+{
+ public:
+    /**
+     * @brief Write the record and reset. Never return.
+     * @param stack_pointer The stack pointer at the exception. Points the exception frame.
+     * @param exc_return The EXC_RETURN value in LR at the exception entry.
+     * @details
+     * Called from CrashRecordHandler(). Do not call from the application.
+     */
+    static void Save(uint32_t *stack_pointer, uint32_t exc_return);
+
+    /**
+     * @brief Check whether the valid record exists.
+     * @return true if the record was written by the last crash, and not cleared yet.
+     */
+    static bool IsValid();
+
+    /**
+     * @brief Print the record to the debugger console.
+     */
+    static void Print();
+
+    /**
+     * @brief Invalidate the record.
+     */
+    static void Clear();
+
+ private:
+    // The layout of the record in the RAM. Only the words, to keep the layout simple.
+    struct Record {
+        uint32_t magic;
+        uint32_t r0;                    // Exception frame.
+        uint32_t r1;
+        uint32_t r2;
+        uint32_t r3;
+        uint32_t r12;
+        uint32_t lr;
+        uint32_t pc;
+        uint32_t xpsr;
+        uint32_t sp;                    // Stack pointer before the exception.
+        uint32_t exc_return;
+        uint32_t ipsr;                  // Exception number of the fault.
+        uint32_t cfsr;                  // Fault status. Zero on Cortex-M0/M0+.
+        uint32_t hfsr;
+        uint32_t mmfar;
+        uint32_t bfar;
+        char task[CRASH_RECORD_TASK_NAME_LENGTH];
+        uint32_t stack[CRASH_RECORD_STACK_WORDS];
+        uint32_t chain_length;
+        uint32_t chain[CRASH_RECORD_CHAIN_DEPTH];   // By StackUnwinder. The newest first.
+        uint32_t crc;                   // CRC-32 of the all above.
+    };
+
+    static uint32_t Crc(const Record &record);
+    static Record record_;
+};
+
+} /* namespace murasaki */
+
+#endif /* CRASHRECORD_HPP_ */
@@ -0,0 +1,180 @@
+/**
+ * @file i2cregistermap.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Cached register map of an I2C device.
+ */
+
+#ifndef I2CREGISTERMAP_HPP_
+#define I2CREGISTERMAP_HPP_
+
+#include "murasaki.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Register map of an I2C device with the register cache.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * A generic layer between a device driver and the @ref I2cMasterStrategy. The typical I2C device
+ * has a set of 8bit registers with 8bit address, and auto increment of the address in the burst access.
+ * This class keeps a copy of these registers to eliminate the redundant bus traffic.
+ *
+ * @li Read of the cached register doesn't access the bus.
+ * @li Write of the same value with the cache doesn't access the bus.
+ * @li In the write back mode, writes are kept in the cache as dirty. Flush() writes the contiguous
+ *     dirty registers by one burst transfer.
+ * @li The registers declared by SetVolatile() are never cached. For example, status registers
+ *     and data registers.
+ *
+ * Assumption : The device increments the register address in the burst access.
+ *
+ * @code
+ * murasaki::I2cRegisterMap * codec = new murasaki::I2cRegisterMap(murasaki::platform.i2c_master, 0x1A, 0x60, true);
+ * codec->SetVolatile(0x00, 0x01);      // status registers.
+ *
+ * codec->UpdateBits(0x10, 0x03, 0x01); // No bus access if the value is not changed.
+ * codec->Write(0x11, 0x80);
+ * codec->Write(0x12, 0x80);
+ * codec->Flush();                      // 0x10-0x12 are written by one transfer.
+ * @endcode
+ *
+ * All member functions are thread safe.
+ */
+class I2cRegisterMap
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param master I2C master which the device is connected to.
+     * @param device_addrs 7bit I2C address of the device.
+     * @param num_registers Number of the registers. The register address must be smaller than this.
+     * @param write_back true to keep the writes in the cache until Flush(). false to write through.
+     * @param timeout_ms Timeout of each I2C transfer [mS].
+     * @details
+     * At the beginning, the cache is empty. The first read of each register accesses the bus.
+     */
+    I2cRegisterMap(
+                   I2cMasterStrategy *master,
+                   unsigned int device_addrs,
+                   unsigned int num_registers,
+                   bool write_back = false,
+                   WaitMilliSeconds timeout_ms = kwmsIndefinitely);
+    /**
+     * @brief Destructor
+     * @details
+     * The dirty registers are not flushed. Call Flush() explicitly if needed.
+     */
+    virtual ~I2cRegisterMap();
+
+    /**
+     * @brief Declare the volatile registers.
+     * @param first_reg The first register address of the range.
+     * @param last_reg The last register address of the range. Inclusive.
+     * @details
+     * The volatile registers are always read and written through the bus.
+     */
+    void SetVolatile(unsigned int first_reg, unsigned int last_reg);
+
+    /**
+     * @brief Read a register.
+     * @param reg Register address
+     * @param value Read value
+     * @return Status of the I2C transfer. ki2csOK if served from the cache.
+     */
+    I2cStatus Read(unsigned int reg, uint8_t *value);
+
+    /**
+     * @brief Read the contiguous registers.
+     * @param reg The first register address
+     * @param values Buffer to receive the values.
+     * @param count Number of registers to read.
+     * @return Status of the I2C transfer. ki2csOK if served from the cache.
+     * @details
+     * If all registers in the range are cached, no bus access happens. Otherwise, the entire range is
+     * read by one burst transfer, and the cache is updated. The dirty registers in the range keep the
+     * cached value.
+     */
+    I2cStatus ReadBlock(unsigned int reg, uint8_t values[], unsigned int count);
+
+    /**
+     * @brief Write a register.
+     * @param reg Register address
+     * @param value Value to write.
+     * @return Status of the I2C transfer. ki2csOK if no bus access happened.
+     * @details
+     * If the cached value is same with the given value, nothing happens.
+     * In the write back mode, the non-volatile register is just marked as dirty.
+     */
+    I2cStatus Write(unsigned int reg, uint8_t value);
+
+    /**
+     * @brief Read-modify-write of the register.
+     * @param reg Register address
+     * @param mask Bits to modify.
+     * @param value New value of the masked bits.
+     * @return Status of the I2C transfer.
+     */
+    I2cStatus UpdateBits(unsigned int reg, uint8_t mask, uint8_t value);
+
+    /**
+     * @brief Write all dirty registers to the device.
+     * @return Status of the I2C transfer. The first error stops the flush.
+     * @details
+     * The contiguous dirty registers are written by one burst transfer, up to kMaxBurstLength registers.
+     */
+    I2cStatus Flush();
+
+    /**
+     * @brief Discard all cached values including the dirty ones.
+     * @details
+     * Call this after the device reset.
+     */
+    void Invalidate();
+
+    /**
+     * @brief Number of the I2C transfers issued by this object.
+     */
+    unsigned int GetTransferCount() const;
+
+    /**
+     * @brief Number of the accesses which were completed without the I2C transfer.
+     */
+    unsigned int GetAvoidedTransferCount() const;
+
+    /**
+     * @brief Maximum number of registers written by one burst transfer.
+     */
+    static const unsigned int kMaxBurstLength = 32;
+
+ private:
+    // Internal functions are called inside the critical section.
+    I2cStatus ReadInternal(unsigned int reg, uint8_t values[], unsigned int count);
+    I2cStatus WriteInternal(unsigned int reg, uint8_t value);
+    I2cStatus WriteToDevice(unsigned int reg, const uint8_t values[], unsigned int count);
+    I2cStatus FlushInternal();
+
+    static bool TestBit(const uint32_t table[], unsigned int index);
+    static void SetBit(uint32_t table[], unsigned int index);
+    static void ClearBit(uint32_t table[], unsigned int index);
+
+    I2cMasterStrategy *const master_;
+    const unsigned int device_addrs_;
+    const unsigned int num_registers_;
+    const bool write_back_;
+    const WaitMilliSeconds timeout_ms_;
+    CriticalSection *const critical_section_;
+
+    uint8_t *const cache_;           // Cached register values.
+    uint32_t *const valid_;          // bit table. The cache entry is valid.
+    uint32_t *const dirty_;          // bit table. The cache entry is not written yet.
+    uint32_t *const volatile_;       // bit table. The register is never cached.
+
+    unsigned int transfer_count_;
+    unsigned int avoided_count_;
+};
+
+} /* namespace murasaki */
+
+#endif /* I2CREGISTERMAP_HPP_ */
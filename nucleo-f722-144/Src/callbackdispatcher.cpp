@@ -0,0 +1,203 @@
+/**
+ * @file callbackdispatcher.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief O(1) dispatch of the HAL completion callbacks to the peripheral objects.
+ */
+
+#include "callbackdispatcher.hpp"
+
+#if defined(HAL_UART_MODULE_ENABLED) && (USE_HAL_UART_REGISTER_CALLBACKS == 1)
+#define DISPATCH_UART 1
+#else
+#define DISPATCH_UART 0
+#endif
+
+#if defined(HAL_I2C_MODULE_ENABLED) && (USE_HAL_I2C_REGISTER_CALLBACKS == 1)
+#define DISPATCH_I2C 1
+#else
+#define DISPATCH_I2C 0
+#endif
+
+#if DISPATCH_UART || DISPATCH_I2C
+// Slot of the handle. A free slot if the handle is not registered. -1 if no slot is left.
+template<typename T>
+static int FindSlot(T *const (&handles)[CALLBACK_DISPATCHER_SLOTS], const T *handle, bool allocate)
+{
+    int free_slot = -1;
+
+    for (int i = 0; i < CALLBACK_DISPATCHER_SLOTS; i++) {
+        if (handles[i] == handle)
+            return i;
+        if (nullptr == handles[i] && 0 > free_slot)
+            free_slot = i;
+    }
+    return allocate ? free_slot : -1;
+}
+#endif
+
+#if DISPATCH_UART
+static UART_HandleTypeDef *uart_handles[CALLBACK_DISPATCHER_SLOTS];
+static murasaki::UartStrategy *uart_objects[CALLBACK_DISPATCHER_SLOTS];
+
+// Called by the HAL from the ISR. One function per slot, so that the slot is known without the search.
+template<unsigned int N>
+static void UartTxComplete(UART_HandleTypeDef *huart)
+{
+    uart_objects[N]->TransmitCompleteCallback(huart);
+}
+
+template<unsigned int N>
+static void UartRxComplete(UART_HandleTypeDef *huart)
+{
+    uart_objects[N]->ReceiveCompleteCallback(huart);
+}
+
+template<unsigned int N>
+static void UartError(UART_HandleTypeDef *huart)
+{
+    uart_objects[N]->HandleError(huart);
+}
+
+struct UartTrampolines
+{
+    pUART_CallbackTypeDef tx_complete;
+    pUART_CallbackTypeDef rx_complete;
+    pUART_CallbackTypeDef error;
+};
+
+#define UART_TRAMPOLINES(n) { &UartTxComplete<n>, &UartRxComplete<n>, &UartError<n> }
+static const UartTrampolines kUartTrampolines[] = {
+        UART_TRAMPOLINES(0), UART_TRAMPOLINES(1), UART_TRAMPOLINES(2), UART_TRAMPOLINES(3),
+        UART_TRAMPOLINES(4), UART_TRAMPOLINES(5), UART_TRAMPOLINES(6), UART_TRAMPOLINES(7)
+};
+static_assert(sizeof(kUartTrampolines) / sizeof(kUartTrampolines[0]) == CALLBACK_DISPATCHER_SLOTS,
+              "Trampolines must be given for all slots.");
+#endif
+
+#if DISPATCH_I2C
+static I2C_HandleTypeDef *i2c_handles[CALLBACK_DISPATCHER_SLOTS];
+static murasaki::I2cMasterStrategy *i2c_objects[CALLBACK_DISPATCHER_SLOTS];
+
+template<unsigned int N>
+static void I2cTxComplete(I2C_HandleTypeDef *hi2c)
+{
+    i2c_objects[N]->TransmitCompleteCallback(hi2c);
+}
+
+template<unsigned int N>
+static void I2cRxComplete(I2C_HandleTypeDef *hi2c)
+{
+    i2c_objects[N]->ReceiveCompleteCallback(hi2c);
+}
+
+template<unsigned int N>
+static void I2cError(I2C_HandleTypeDef *hi2c)
+{
+    i2c_objects[N]->HandleError(hi2c);
+}
+
+struct I2cTrampolines
+{
+    pI2C_CallbackTypeDef tx_complete;
+    pI2C_CallbackTypeDef rx_complete;
+    pI2C_CallbackTypeDef error;
+};
+
+#define I2C_TRAMPOLINES(n) { &I2cTxComplete<n>, &I2cRxComplete<n>, &I2cError<n> }
+static const I2cTrampolines kI2cTrampolines[] = {
+        I2C_TRAMPOLINES(0), I2C_TRAMPOLINES(1), I2C_TRAMPOLINES(2), I2C_TRAMPOLINES(3),
+        I2C_TRAMPOLINES(4), I2C_TRAMPOLINES(5), I2C_TRAMPOLINES(6), I2C_TRAMPOLINES(7)
+};
+static_assert(sizeof(kI2cTrampolines) / sizeof(kI2cTrampolines[0]) == CALLBACK_DISPATCHER_SLOTS,
+              "Trampolines must be given for all slots.");
+#endif
+
+namespace murasaki {
+
+#ifdef HAL_UART_MODULE_ENABLED
+bool CallbackDispatcher::Register(UART_HandleTypeDef *huart, UartStrategy *uart)
+{
+    MURASAKI_ASSERT(nullptr != huart)
+    MURASAKI_ASSERT(nullptr != uart)
+
+#if DISPATCH_UART
+    const int slot = FindSlot(uart_handles, huart, true);
+    if (0 > slot)
+        return false;
+
+    // The object first. The HAL calls the trampoline as soon as it is set.
+    uart_objects[slot] = uart;
+    uart_handles[slot] = huart;
+
+    const UartTrampolines &trampolines = kUartTrampolines[slot];
+    return HAL_OK == HAL_UART_RegisterCallback(huart, HAL_UART_TX_COMPLETE_CB_ID, trampolines.tx_complete)
+            && HAL_OK == HAL_UART_RegisterCallback(huart, HAL_UART_RX_COMPLETE_CB_ID, trampolines.rx_complete)
+            && HAL_OK == HAL_UART_RegisterCallback(huart, HAL_UART_ERROR_CB_ID, trampolines.error);
+#else
+    return false;
+#endif
+}
+
+void CallbackDispatcher::Unregister(UART_HandleTypeDef *huart)
+{
+    MURASAKI_ASSERT(nullptr != huart)
+
+#if DISPATCH_UART
+    const int slot = FindSlot(uart_handles, huart, false);
+    if (0 > slot)
+        return;
+
+    // The handle first. The object may be deleted after this.
+    HAL_UART_UnRegisterCallback(huart, HAL_UART_TX_COMPLETE_CB_ID);
+    HAL_UART_UnRegisterCallback(huart, HAL_UART_RX_COMPLETE_CB_ID);
+    HAL_UART_UnRegisterCallback(huart, HAL_UART_ERROR_CB_ID);
+    uart_handles[slot] = nullptr;
+    uart_objects[slot] = nullptr;
+#endif
+}
+#endif
+
+#ifdef HAL_I2C_MODULE_ENABLED
+bool CallbackDispatcher::Register(I2C_HandleTypeDef *hi2c, I2cMasterStrategy *i2c)
+{
+    MURASAKI_ASSERT(nullptr != hi2c)
+    MURASAKI_ASSERT(nullptr != i2c)
+
+#if DISPATCH_I2C
+    const int slot = FindSlot(i2c_handles, hi2c, true);
+    if (0 > slot)
+        return false;
+
+    i2c_objects[slot] = i2c;
+    i2c_handles[slot] = hi2c;
+
+    const I2cTrampolines &trampolines = kI2cTrampolines[slot];
+    return HAL_OK == HAL_I2C_RegisterCallback(hi2c, HAL_I2C_MASTER_TX_COMPLETE_CB_ID, trampolines.tx_complete)
+            && HAL_OK == HAL_I2C_RegisterCallback(hi2c, HAL_I2C_MASTER_RX_COMPLETE_CB_ID, trampolines.rx_complete)
+            && HAL_OK == HAL_I2C_RegisterCallback(hi2c, HAL_I2C_ERROR_CB_ID, trampolines.error);
+#else
+    return false;
+#endif
+}
+
+void CallbackDispatcher::Unregister(I2C_HandleTypeDef *hi2c)
+{
+    MURASAKI_ASSERT(nullptr != hi2c)
+
+#if DISPATCH_I2C
+    const int slot = FindSlot(i2c_handles, hi2c, false);
+    if (0 > slot)
+        return;
+
+    HAL_I2C_UnRegisterCallback(hi2c, HAL_I2C_MASTER_TX_COMPLETE_CB_ID);
+    HAL_I2C_UnRegisterCallback(hi2c, HAL_I2C_MASTER_RX_COMPLETE_CB_ID);
+    HAL_I2C_UnRegisterCallback(hi2c, HAL_I2C_ERROR_CB_ID);
+    i2c_handles[slot] = nullptr;
+    i2c_objects[slot] = nullptr;
+#endif
+}
+#endif
+
+} /* namespace murasaki */
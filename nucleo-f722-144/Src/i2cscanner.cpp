@@ -0,0 +1,191 @@
+/**
+ * @file i2cscanner.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Fast I2C bus enumeration with cached result.
+ */
+
+#include "i2cscanner.hpp"
+
+#include <string.h>
+
+// The first and last address which are not reserved by the I2C specification.
+#define I2C_FIRST_GENERAL_ADDRESS 0x08
+#define I2C_LAST_GENERAL_ADDRESS 0x77
+
+// Stack size of the background scan task [word].
+#define I2C_SCAN_TASK_STACK_SIZE 256
+
+namespace murasaki {
+
+I2cScanner::I2cScanner(I2cMasterStrategy *master, WaitMilliSeconds probe_timeout_ms)
+        :
+        master_(master),
+        probe_timeout_ms_(probe_timeout_ms),
+        request_(new Synchronizer()),
+        done_(new Synchronizer()),
+        task_(nullptr),
+        valid_(false),
+        scanning_(false)
+{
+    MURASAKI_ASSERT(nullptr != master_)
+    MURASAKI_ASSERT(nullptr != request_)
+    MURASAKI_ASSERT(nullptr != done_)
+
+    ::memset(present_, 0, sizeof(present_));
+    ::memset(error_, 0, sizeof(error_));
+}
+
+I2cScanner::~I2cScanner()
+{
+    delete request_;
+    delete done_;
+}
+
+void I2cScanner::Scan()
+{
+    uint32_t present[128 / 32] = { 0 };
+    uint32_t error[128 / 32] = { 0 };
+    uint8_t dummy[1];
+
+    for (unsigned int addrs = I2C_FIRST_GENERAL_ADDRESS; addrs <= I2C_LAST_GENERAL_ADDRESS; addrs++) {
+        // Address only probe. No data byte follows the address.
+        I2cStatus result = master_->Transmit(addrs, dummy, 0, nullptr, probe_timeout_ms_);
+
+        if (ki2csOK == result)
+            SetBit(present, addrs);
+        else if (ki2csNak != result)
+            SetBit(error, addrs);
+    }
+
+    // Update the cache at once.
+    ::memcpy(present_, present, sizeof(present_));
+    ::memcpy(error_, error, sizeof(error_));
+    valid_ = true;
+}
+
+void I2cScanner::StartBackgroundScan()
+{
+    if (scanning_)
+        return;     // already running.
+
+    if (nullptr == task_) {
+        task_ = new SimpleTask(
+                               "i2cscan",
+                               I2C_SCAN_TASK_STACK_SIZE,
+                               ktpNormal,
+                               this,
+                               &ScanTaskBody);
+        MURASAKI_ASSERT(nullptr != task_)
+        task_->Start();
+    }
+
+    // Clear the left signal of the last scan.
+    done_->Wait(kwmsPolling);
+
+    scanning_ = true;
+    request_->Release();
+}
+
+bool I2cScanner::WaitForScan(WaitMilliSeconds timeout_ms)
+{
+    if (!scanning_)
+        return valid_;
+
+    if (!done_->Wait(timeout_ms))
+        return false;
+
+    // Pass the signal to the other waiting tasks.
+    done_->Release();
+    return valid_;
+}
+
+bool I2cScanner::IsPresent(unsigned int addrs)
+{
+    MURASAKI_ASSERT(addrs < 128)
+
+    if (scanning_)
+        WaitForScan();
+    else if (!valid_)
+        Scan();
+
+    return TestBit(present_, addrs);
+}
+
+unsigned int I2cScanner::GetDeviceCount()
+{
+    unsigned int count = 0;
+
+    if (!WaitForScan())
+        return 0;
+
+    for (unsigned int addrs = I2C_FIRST_GENERAL_ADDRESS; addrs <= I2C_LAST_GENERAL_ADDRESS; addrs++)
+        if (TestBit(present_, addrs))
+            count++;
+
+    return count;
+}
+
+void I2cScanner::Invalidate()
+{
+    valid_ = false;
+}
+
+void I2cScanner::Print()
+{
+    if (scanning_)
+        WaitForScan();
+    else if (!valid_)
+        Scan();
+
+    murasaki::debugger->Printf("\n            Probing I2C devices \n");
+    murasaki::debugger->Printf("   | 0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F\n");
+    murasaki::debugger->Printf("---+------------------------------------------------\n");
+
+    for (unsigned int row = 0; row < 128; row += 16) {
+        murasaki::debugger->Printf("%2x |", row);
+        for (unsigned int col = 0; col < 16; col++) {
+            unsigned int addrs = row + col;
+
+            if (IsReserved(addrs))
+                murasaki::debugger->Printf("   ");
+            else if (TestBit(present_, addrs))
+                murasaki::debugger->Printf(" %2x", addrs);
+            else if (TestBit(error_, addrs))
+                murasaki::debugger->Printf(" ??");
+            else
+                murasaki::debugger->Printf(" --");
+        }
+        murasaki::debugger->Printf("\n");
+    }
+}
+
+void I2cScanner::ScanTaskBody(const void *ptr)
+{
+    I2cScanner *const this_ptr = const_cast<I2cScanner*>(static_cast<const I2cScanner*>(ptr));
+
+    while (true) {
+        this_ptr->request_->Wait();
+        this_ptr->Scan();
+        this_ptr->scanning_ = false;
+        this_ptr->done_->Release();
+    }
+}
+
+bool I2cScanner::IsReserved(unsigned int addrs)
+{
+    return (addrs < I2C_FIRST_GENERAL_ADDRESS) || (addrs > I2C_LAST_GENERAL_ADDRESS);
+}
+
+bool I2cScanner::TestBit(const uint32_t table[], unsigned int addrs)
+{
+    return table[addrs / 32] & (1u << (addrs % 32));
+}
+
+void I2cScanner::SetBit(uint32_t table[], unsigned int addrs)
+{
+    table[addrs / 32] |= 1u << (addrs % 32);
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,59 @@
+/**
+ * @file idletime.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Idle time accounting by the idle hook of the FreeRTOS.
+ */
+
+#include "idletime.hpp"
+#include "cyclecounter.hpp"
+#include "FreeRTOS.h"
+#include "task.h"
+
+extern "C" void vApplicationIdleHook()
+{
+    murasaki::IdleTime::Hook();
+}
+
+namespace murasaki {
+
+uint32_t IdleTime::last_;
+volatile uint32_t IdleTime::cycles_;
+
+void IdleTime::Hook()
+{
+    const uint32_t now = CycleCounter::Get();
+    const uint32_t gap = now - last_;
+
+    last_ = now;
+    // Only the idle task writes. A 32bit store is atomic for the readers.
+    if (gap < IDLE_TIME_MAX_LOOP_CYCLES)
+        cycles_ = cycles_ + gap;
+}
+
+uint32_t IdleTime::GetCycles()
+{
+    return cycles_;
+}
+
+uint32_t IdleTime::GetTotalCycles()
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    return CycleCounter::Get();
+#else
+    TickType_t tick;
+    uint32_t value;
+
+    // Read again if the tick interrupt came between.
+    do {
+        tick = xTaskGetTickCount();
+        value = SysTick->VAL;
+    } while (tick != xTaskGetTickCount());
+
+    // SysTick counts down from LOAD to 0.
+    return tick * (SysTick->LOAD + 1) + (SysTick->LOAD - value);
+#endif
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,161 @@
+/**
+ * @file busio.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Multi-pin GPIO bus output and input.
+ */
+
+#ifndef BUSIO_HPP_
+#define BUSIO_HPP_
+
+#include "murasaki.hpp"
+
+// Maximum number of the pins in a bus.
+#define BUS_MAX_PINS 16
+
+namespace murasaki {
+
+/**
+ * @brief A pin of the bus.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ */
+struct BusPin
+{
+    GPIO_TypeDef *port;     ///< GPIO port of the pin.
+    uint16_t pin;           ///< Pin mask. One of the GPIO_PIN_x.
+};
+
+/**
+ * @brief Mapping between the bits of a value and the GPIO pins.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * Base class of the @ref BusOut and the @ref BusIn.
+ *
+ * The pins are grouped by the port at the construction. In each port, the pins are grouped again
+ * by the distance between the bit position in the value and the pin position in the port.
+ * A group of the same distance is a "run". The bits of a run are moved between the value and the port
+ * by one shift and one mask. The pins 0-7 of a port as the bit 0-7 of the value is one run.
+ */
+class BusPinMap
+{
+ protected:
+    /**
+     * @brief Constructor
+     * @param pins Pins of the bus. The pins[0] is the LSB of the value.
+     * @param count Number of the pins. Up to BUS_MAX_PINS.
+     */
+    BusPinMap(const BusPin pins[], unsigned int count);
+
+    // Pins of the same port with the same distance.
+    struct Run
+    {
+        uint16_t mask;          // Pins in the port.
+        int8_t shift;           // Pin position - bit position.
+    };
+
+    struct Port
+    {
+        GPIO_TypeDef *registers;
+        uint16_t mask;          // All pins of the bus in this port.
+        uint8_t first_run;      // Index of runs_.
+        uint8_t num_runs;
+    };
+
+    // Bits of the value to the pins of a port.
+    inline uint32_t Scatter(const Port &port, unsigned int value) const
+    {
+        uint32_t bits = 0;
+
+        for (unsigned int i = port.first_run; i < port.first_run + port.num_runs; i++)
+            bits |= ((runs_[i].shift >= 0) ? (value << runs_[i].shift) : (value >> -runs_[i].shift)) & runs_[i].mask;
+        return bits;
+    }
+
+    // Pins of a port to the bits of the value.
+    inline unsigned int Gather(const Port &port, uint32_t bits) const
+    {
+        unsigned int value = 0;
+
+        for (unsigned int i = port.first_run; i < port.first_run + port.num_runs; i++) {
+            const uint32_t masked = bits & runs_[i].mask;
+            value |= (runs_[i].shift >= 0) ? (masked >> runs_[i].shift) : (masked << -runs_[i].shift);
+        }
+        return value;
+    }
+
+    Port ports_[BUS_MAX_PINS];
+    unsigned int num_ports_;
+    Run runs_[BUS_MAX_PINS];
+};
+
+/**
+ * @brief Multi-pin output. The pins are written at once per port.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The pins can be in the different ports. Write() stores to the BSRR once per port. The pins in a
+ * port change at the same time, and the other pins of the port are not disturbed.
+ *
+ * @code
+ * static const murasaki::BusPin kPins[] = {
+ *         { GPIOA, GPIO_PIN_0 },     // bit 0
+ *         { GPIOA, GPIO_PIN_1 },     // bit 1
+ *         { GPIOC, GPIO_PIN_7 },     // bit 2
+ * };
+ * murasaki::BusOut *bus = new murasaki::BusOut(kPins, 3);
+ *
+ * bus->Write(5);
+ * @endcode
+ *
+ * The pins must be configured as output by CubeIDE.
+ */
+class BusOut : public BusPinMap
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param pins Pins of the bus. The pins[0] is the LSB of the value.
+     * @param count Number of the pins. Up to BUS_MAX_PINS.
+     */
+    BusOut(const BusPin pins[], unsigned int count);
+
+    /**
+     * @brief Drive the pins.
+     * @param value Value to output. The bits above the width are ignored.
+     */
+    void Write(unsigned int value);
+
+    /**
+     * @brief Read the output state of the pins.
+     * @return Value of the ODR of the pins.
+     */
+    unsigned int Read();
+};
+
+/**
+ * @brief Multi-pin input. The pins are read at once per port.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The pins can be in the different ports. Read() loads the IDR once per port.
+ * The pins in a port are sampled at the same time.
+ */
+class BusIn : public BusPinMap
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param pins Pins of the bus. The pins[0] is the LSB of the value.
+     * @param count Number of the pins. Up to BUS_MAX_PINS.
+     */
+    BusIn(const BusPin pins[], unsigned int count);
+
+    /**
+     * @brief Read the pins.
+     * @return Value of the IDR of the pins.
+     */
+    unsigned int Read();
+};
+
+} /* namespace murasaki */
+
+#endif /* BUSIO_HPP_ */
@@ -0,0 +1,92 @@
+/**
+ * @file callbackdispatcher.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief O(1) dispatch of the HAL completion callbacks to the peripheral objects.
+ */
+
+#ifndef CALLBACKDISPATCHER_HPP_
+#define CALLBACKDISPATCHER_HPP_
+
+#include "murasaki.hpp"
+
+// Number of the handles which can be registered, for each of the UART and the I2C.
+#define CALLBACK_DISPATCHER_SLOTS 8
+
+namespace murasaki {
+
+/**
+ * @brief Router from the HAL handle to the murasaki peripheral object by the registered callbacks.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * Without the registered callbacks, the HAL calls the global HAL_UART_TxCpltCallback() and so on.
+ * The callback asks each peripheral object whether the handle is its own, until one says yes.
+ * The cost of the interrupt grows with the number of the objects.
+ *
+ * With USE_HAL_UART_REGISTER_CALLBACKS and USE_HAL_I2C_REGISTER_CALLBACKS set to 1 in the hal_conf.h,
+ * the HAL calls the function pointer in the handle instead. Register() stores the object in a slot,
+ * and sets the trampoline of that slot to the handle. The trampoline calls the object directly :
+ *
+ * @code
+ * // In the ISR of the HAL.
+ * huart->TxCpltCallback(huart);      // Trampoline of the slot.
+ * //   -> uart_objects[N]->TransmitCompleteCallback(huart);
+ * @endcode
+ *
+ * That is one indirect call and one virtual call, regardless of the number of the instances.
+ *
+ * | Callback of the HAL      | UartStrategy / I2cMasterStrategy |
+ * |--------------------------|----------------------------------|
+ * | Tx complete              | TransmitCompleteCallback()       |
+ * | Rx complete              | ReceiveCompleteCallback()        |
+ * | Error                    | HandleError()                    |
+ *
+ * The I2C callbacks are the master ones. The other callbacks like the abort and the UART Rx event are not
+ * registered. The HAL keeps calling the global callbacks for them, and for the handles which are not registered.
+ *
+ * Register() must be called after the HAL initialized the handle, from a task, while the peripheral is idle.
+ * The HAL_UART_Init() and HAL_I2C_Init() of the handle in the reset state clear the registration.
+ * Register again after them. Calling Register() twice for the same handle reuses the slot.
+ *
+ * When the registered callbacks are disabled in the hal_conf.h, Register() returns false and nothing changes.
+ */
+class CallbackDispatcher
+{
+ public:
+#ifdef HAL_UART_MODULE_ENABLED
+    /**
+     * @brief Route the callbacks of the UART handle to the object.
+     * @param huart HAL handle of the UART.
+     * @param uart Object which handles the callbacks of the huart.
+     * @return true if success. false if no slot is left, or the registered callbacks are disabled.
+     */
+    static bool Register(UART_HandleTypeDef *huart, UartStrategy *uart);
+
+    /**
+     * @brief Give the callbacks of the UART handle back to the global callbacks of the HAL.
+     * @param huart HAL handle of the UART.
+     */
+    static void Unregister(UART_HandleTypeDef *huart);
+#endif
+
+#ifdef HAL_I2C_MODULE_ENABLED
+    /**
+     * @brief Route the master callbacks of the I2C handle to the object.
+     * @param hi2c HAL handle of the I2C.
+     * @param i2c Object which handles the callbacks of the hi2c.
+     * @return true if success. false if no slot is left, or the registered callbacks are disabled.
+     */
+    static bool Register(I2C_HandleTypeDef *hi2c, I2cMasterStrategy *i2c);
+
+    /**
+     * @brief Give the callbacks of the I2C handle back to the global callbacks of the HAL.
+     * @param hi2c HAL handle of the I2C.
+     */
+    static void Unregister(I2C_HandleTypeDef *hi2c);
+#endif
+};
+
+} /* namespace murasaki */
+
+#endif /* CALLBACKDISPATCHER_HPP_ */
@@ -0,0 +1,123 @@
+/**
+ * @file framedconsole.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief COBS framed binary channels on the console UART.
+ */
+
+#include "framedconsole.hpp"
+#include "crcservice.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+// Offsets in the buffer.
+#define OFFSET_DELIMITER 0
+#define OFFSET_CODE 1
+#define OFFSET_CHANNEL 2
+#define OFFSET_SEQUENCE 3
+#define OFFSET_PAYLOAD 4
+// Channel, sequence and CRC around the payload [byte].
+#define FRAME_OVERHEAD 4
+
+namespace murasaki {
+
+FramedConsole::FramedConsole(UartStrategy *uart, CrcService *crc)
+        :
+        UartLogger(uart),
+        uart_(uart),
+        crc_(crc),
+        synced_(false),
+        frames_(0),
+        bytes_(0)
+{
+    MURASAKI_ASSERT(nullptr != uart)
+
+    critical_section_ = new CriticalSection();
+    MURASAKI_ASSERT(nullptr != critical_section_)
+
+    memset(sequences_, 0, sizeof(sequences_));
+    buffer_[OFFSET_DELIMITER] = 0;
+}
+
+void FramedConsole::putMessage(char message[], unsigned int size)
+{
+    while (size > 0) {
+        const unsigned int length = std::min(size, static_cast<unsigned int>(FRAMED_CONSOLE_MAX_PAYLOAD));
+
+        Send(FRAMED_CONSOLE_CHANNEL_TEXT, message, length);
+        message += length;
+        size -= length;
+    }
+}
+
+uint8_t* FramedConsole::Begin(unsigned int channel)
+{
+    MURASAKI_ASSERT(channel < FRAMED_CONSOLE_CHANNEL_COUNT)
+
+    critical_section_->Enter();
+
+    // Still locked. End() unlocks.
+    buffer_[OFFSET_CHANNEL] = channel;
+    buffer_[OFFSET_SEQUENCE] = sequences_[channel]++;
+    return &buffer_[OFFSET_PAYLOAD];
+}
+
+void FramedConsole::End(unsigned int size)
+{
+    MURASAKI_ASSERT(size <= FRAMED_CONSOLE_MAX_PAYLOAD)
+
+    const unsigned int length = size + FRAME_OVERHEAD;
+    const uint16_t crc = (nullptr != crc_) ?
+            crc_->Crc16(&buffer_[OFFSET_CHANNEL], size + 2) : Crc16(&buffer_[OFFSET_CHANNEL], size + 2);
+    unsigned int code = OFFSET_CODE;
+
+    buffer_[OFFSET_PAYLOAD + size] = crc;
+    buffer_[OFFSET_PAYLOAD + size + 1] = crc >> 8;
+
+    // COBS in place. Each 0x00 is replaced by the distance to the next one. The frame has no run over 254 bytes.
+    for (unsigned int i = OFFSET_CHANNEL; i < OFFSET_CHANNEL + length; i++)
+        if (0 == buffer_[i]) {
+            buffer_[code] = i - code;
+            code = i;
+        }
+    buffer_[code] = OFFSET_CHANNEL + length - code;
+    buffer_[OFFSET_CHANNEL + length] = 0;
+
+    // Code, frame and delimiter. The first frame has another delimiter before.
+    const unsigned int start = synced_ ? OFFSET_CODE : OFFSET_DELIMITER;
+    const unsigned int count = OFFSET_CHANNEL + length + 1 - start;
+
+    uart_->Transmit(&buffer_[start], count);
+    synced_ = true;
+    frames_++;
+    bytes_ += count;
+
+    critical_section_->Leave();
+}
+
+void FramedConsole::Send(unsigned int channel, const void *record, unsigned int size)
+{
+    MURASAKI_ASSERT(size <= FRAMED_CONSOLE_MAX_PAYLOAD)
+
+    memcpy(Begin(channel), record, size);
+    End(size);
+}
+
+unsigned int FramedConsole::GetFrameCount() const
+{
+    return frames_;
+}
+
+unsigned int FramedConsole::GetByteCount() const
+{
+    return bytes_;
+}
+
+uint16_t FramedConsole::Crc16(const uint8_t *data, unsigned int size, uint16_t crc)
+{
+    return CrcService::SoftwareCrc16(data, size, crc);
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,179 @@
+/**
+ * @file governor.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Clock profile governor driven by the idle time.
+ */
+
+#include "governor.hpp"
+#include "idletime.hpp"
+
+namespace murasaki {
+
+Governor::Governor(ClockProfile *profile, unsigned int period_ms)
+        :
+        profile_(profile),
+        period_ms_(period_ms),
+        critical_section_(new CriticalSection()),
+        task_(nullptr),
+        head_(0),
+        count_(0),
+        last_idle_(0),
+        last_total_(0),
+        load_(0),
+        switches_(0)
+{
+    MURASAKI_ASSERT(nullptr != profile)
+    MURASAKI_ASSERT(0 < period_ms)
+    MURASAKI_ASSERT(nullptr != critical_section_)
+
+    for (unsigned int i = 0; i <= kcpMax; i++)
+        pins_[i] = 0;
+}
+
+void Governor::Start()
+{
+    MURASAKI_ASSERT(nullptr == task_)
+
+    // Above the application tasks, to sample in time. The work of each period is short.
+    task_ = new murasaki::SimpleTask(
+                                     "governor",
+                                     256,
+                                     murasaki::ktpHigh,
+                                     this,
+                                     &Governor::TaskBody);
+    MURASAKI_ASSERT(nullptr != task_)
+
+    critical_section_->Enter();
+    ClearWindow();
+    critical_section_->Leave();
+
+    task_->Start();
+}
+
+void Governor::Pin(ClockProfileLevel level)
+{
+    MURASAKI_ASSERT(kcpLow <= level && level <= kcpMax)
+
+    critical_section_->Enter();
+    pins_[level]++;
+    if (profile_->Get() < level)
+        Switch(level);
+    critical_section_->Leave();
+}
+
+void Governor::Unpin(ClockProfileLevel level)
+{
+    MURASAKI_ASSERT(kcpLow <= level && level <= kcpMax)
+
+    critical_section_->Enter();
+    MURASAKI_ASSERT(0 < pins_[level])
+    pins_[level]--;
+    critical_section_->Leave();
+}
+
+unsigned int Governor::GetLoad() const
+{
+    return load_;
+}
+
+unsigned int Governor::GetSwitches() const
+{
+    return switches_;
+}
+
+void Governor::TaskBody(const void *ptr)
+{
+    Governor *const self = const_cast<Governor*>(static_cast<const Governor*>(ptr));
+
+    while (true) {
+        murasaki::Sleep(self->period_ms_);
+
+        self->critical_section_->Enter();
+        self->Sample();
+        self->Decide();
+        self->critical_section_->Leave();
+    }
+}
+
+void Governor::Sample()
+{
+    const uint32_t idle = IdleTime::GetCycles();
+    const uint32_t total = IdleTime::GetTotalCycles();
+    uint64_t idle_sum = 0;
+    uint64_t total_sum = 0;
+
+    idle_[head_] = idle - last_idle_;
+    total_[head_] = total - last_total_;
+    last_idle_ = idle;
+    last_total_ = total;
+    head_ = (head_ + 1) % GOVERNOR_WINDOW;
+    if (count_ < GOVERNOR_WINDOW)
+        count_++;
+
+    // The window is cleared at the switching. All samples are at the same clock.
+    for (unsigned int i = 0; i < count_; i++) {
+        idle_sum += idle_[i];
+        total_sum += total_[i];
+    }
+    if (idle_sum > total_sum)
+        idle_sum = total_sum;
+    if (0 < total_sum)
+        load_ = 100 - static_cast<unsigned int>(idle_sum * 100 / total_sum);
+}
+
+void Governor::Decide()
+{
+    const ClockProfileLevel current = profile_->Get();
+    const ClockProfileLevel floor = GetFloor();
+
+    if (current < floor) {
+        Switch(floor);
+        return;
+    }
+
+    // Wait for the full window at the current clock.
+    if (count_ < GOVERNOR_WINDOW)
+        return;
+
+    if (load_ > GOVERNOR_UP_PERCENT && current < kcpMax)
+        Switch(static_cast<ClockProfileLevel>(current + 1));
+    else if (current > floor) {
+        const ClockProfileLevel lower = static_cast<ClockProfileLevel>(current - 1);
+        const uint64_t lower_clock = ClockProfile::GetFrequency(lower);
+
+        // The same work takes longer at the lower clock.
+        if (0 < lower_clock
+                && static_cast<uint64_t>(load_) * ClockProfile::GetFrequency(current) / lower_clock < GOVERNOR_DOWN_PERCENT)
+            Switch(lower);
+    }
+}
+
+bool Governor::Switch(ClockProfileLevel level)
+{
+    if (!ClockProfile::IsSupported(level) || !profile_->Set(level))
+        return false;
+
+    switches_ = switches_ + 1;
+    ClearWindow();
+    return true;
+}
+
+void Governor::ClearWindow()
+{
+    head_ = 0;
+    count_ = 0;
+    last_idle_ = IdleTime::GetCycles();
+    last_total_ = IdleTime::GetTotalCycles();
+}
+
+ClockProfileLevel Governor::GetFloor() const
+{
+    for (int level = kcpMax; level > kcpLow; level--)
+        if (0 < pins_[level])
+            return static_cast<ClockProfileLevel>(level);
+    return kcpLow;
+}
+
+} /* namespace murasaki */
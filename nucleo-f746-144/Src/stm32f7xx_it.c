@@ -24,6 +24,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "murasaki_platform.hpp"
+#include "FreeRTOS.h"        // Trace recorder hooks.
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -89,7 +90,8 @@ void NMI_Handler(void)
 void HardFault_Handler(void)
 {
   /* USER CODE BEGIN HardFault_IRQn 0 */
-  CustomDefaultHandler();
+  // Jump with the EXC_RETURN in LR. The crash record is printed at the next boot.
+  __asm volatile ("ldr r0, =CrashRecordHandler \n bx r0");
 
   /* USER CODE END HardFault_IRQn 0 */
   while (1)
@@ -198,11 +200,11 @@ void DMA1_Stream3_IRQHandler(void)
 void I2C1_EV_IRQHandler(void)
 {
   /* USER CODE BEGIN I2C1_EV_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END I2C1_EV_IRQn 0 */
   HAL_I2C_EV_IRQHandler(&hi2c1);
   /* USER CODE BEGIN I2C1_EV_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END I2C1_EV_IRQn 1 */
 }
 
@@ -212,11 +214,11 @@ void I2C1_EV_IRQHandler(void)
 void I2C1_ER_IRQHandler(void)
 {
   /* USER CODE BEGIN I2C1_ER_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END I2C1_ER_IRQn 0 */
   HAL_I2C_ER_IRQHandler(&hi2c1);
   /* USER CODE BEGIN I2C1_ER_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END I2C1_ER_IRQn 1 */
 }
 
@@ -226,11 +228,11 @@ void I2C1_ER_IRQHandler(void)
 void USART3_IRQHandler(void)
 {
   /* USER CODE BEGIN USART3_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END USART3_IRQn 0 */
   HAL_UART_IRQHandler(&huart3);
   /* USER CODE BEGIN USART3_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END USART3_IRQn 1 */
 }
 
@@ -240,11 +242,11 @@ void USART3_IRQHandler(void)
 void EXTI15_10_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI15_10_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END EXTI15_10_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(B1_Pin);
   /* USER CODE BEGIN EXTI15_10_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END EXTI15_10_IRQn 1 */
 }
 
@@ -111,6 +111,14 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+
+/* Idle time accounting by murasaki::IdleTime. The vApplicationIdleHook() is defined in idletime.cpp. */
+#undef configUSE_IDLE_HOOK
+#define configUSE_IDLE_HOOK 1
+
+/* Kernel trace recorder. Set 1 to record the task switches, interrupts and queue operations. */
+#define TRACE_RECORDER_ENABLE 0
+#include "tracerecorder.h"
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
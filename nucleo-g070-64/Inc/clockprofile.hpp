@@ -0,0 +1,121 @@
+/**
+ * @file clockprofile.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Selectable system clock profiles with the runtime switching.
+ */
+
+#ifndef CLOCKPROFILE_HPP_
+#define CLOCKPROFILE_HPP_
+
+#include "murasaki.hpp"
+
+namespace murasaki {
+
+class I2cRecoveringMaster;
+class StatusLed;
+
+/**
+ * @brief Performance level of the system clock.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ */
+enum ClockProfileLevel
+{
+    kcpLow = 0,         ///< Lower clock and voltage for the power saving.
+    kcpBalanced,        ///< The CubeIDE configuration of the project.
+    kcpMax              ///< The maximum frequency of the device.
+};
+
+/**
+ * @brief System clock switcher which re-times the clock dependent peripherals.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The CubeIDE configuration of some projects runs far below the capability of the device.
+ * This class switches the PLL, the voltage scaling and the flash wait states among the
+ * profiles, at run time.
+ *
+ * | Device       | kcpLow        | kcpBalanced | kcpMax                         |
+ * |--------------|---------------|-------------|--------------------------------|
+ * | STM32F446    | 16MHz HSI     | 84MHz       | 180MHz, over-drive             |
+ * | STM32F746    | 16MHz HSI     | 72MHz       | 216MHz, over-drive, ART        |
+ * | STM32H743    | 48MHz, VOS3   | 96MHz       | 480MHz VOS0 ( rev.V ), 384MHz VOS1 ( rev.Y ) |
+ *
+ * The PLL1Q of the STM32H743 is kept at 48MHz for the USB. The other devices accept only kcpBalanced.
+ *
+ * @code
+ * murasaki::platform.clock_profile = new murasaki::ClockProfile(&huart2,
+ *                                                               murasaki::platform.i2c_recovering_master,
+ *                                                               murasaki::platform.status_led);
+ * murasaki::platform.clock_profile->Set(murasaki::kcpMax);
+ * @endcode
+ *
+ * Set() must be called from a task. The scheduler is suspended and the interrupts are disabled while the switching.
+ * Following clocks are re-timed after the switching :
+ * @li SysTick of the FreeRTOS. The switching starts at the tick boundary. Only the switching time is lost from the tick.
+ * @li HAL time base. Re-initialized by HAL_RCC_ClockConfig(). The elapsed time in the current tick is carried over.
+ * @li Baud rate of the given UART. The transmission is drained before the switching.
+ *     The character in receiving may be lost.
+ * @li Bus timing of the given I2C master. The switching waits for the end of the current transfer.
+ * @li Prescaler of the given murasaki::StatusLed.
+ * @li MDC divider of the started murasaki::EthTelemetry.
+ */
+class ClockProfile
+{
+ public:
+    /**
+     * @brief Constructor.
+     * @param uart UART to re-time. Can be nullptr.
+     * @param i2c_master I2C master to re-time. Can be nullptr.
+     * @param status_led Status LED to re-time. Can be nullptr.
+     * @details
+     * The clock is not changed until Set() is called.
+     */
+    ClockProfile(UART_HandleTypeDef *uart, I2cRecoveringMaster *i2c_master, StatusLed *status_led);
+
+    /**
+     * @brief Switch the system clock.
+     * @param level Profile to switch to.
+     * @return true if success. false if the profile is not supported on this device, or the HAL failed.
+     * @details
+     * The clock is left untouched when the profile is not supported. When the HAL failed,
+     * the system keeps running on the HSI.
+     */
+    bool Set(ClockProfileLevel level);
+
+    /**
+     * @brief Get the current profile.
+     * @return The last profile given to the successful Set(). kcpBalanced until then.
+     */
+    ClockProfileLevel Get() const;
+
+    /**
+     * @brief Check whether the profile is supported on this device.
+     * @param level Profile to check.
+     * @return true if supported.
+     */
+    static bool IsSupported(ClockProfileLevel level);
+
+    /**
+     * @brief Get the system clock of the profile.
+     * @param level Profile to check.
+     * @return SYSCLK [Hz]. 0 if not supported.
+     */
+    static unsigned int GetFrequency(ClockProfileLevel level);
+
+ private:
+    // Wait for the end of the transmission, and set the baud rate from the new clock.
+    void DrainUart();
+    void RetimeUart();
+    // Change the clock tree. Called with the interrupts disabled.
+    static bool SwitchClock(ClockProfileLevel level);
+
+    UART_HandleTypeDef *const uart_;
+    I2cRecoveringMaster *const i2c_master_;
+    StatusLed *const status_led_;
+    ClockProfileLevel level_;
+};
+
+} /* namespace murasaki */
+
+#endif /* CLOCKPROFILE_HPP_ */
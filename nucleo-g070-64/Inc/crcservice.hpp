@@ -0,0 +1,139 @@
+/**
+ * @file crcservice.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Checksum by the CRC unit, with the software fallback.
+ */
+
+#ifndef CRCSERVICE_HPP_
+#define CRCSERVICE_HPP_
+
+#include "murasaki.hpp"
+
+// Size of the buffer from which the DMA feeds the CRC unit [byte]. The smaller buffer is written by the CPU.
+#define CRC_SERVICE_DMA_THRESHOLD 1024
+// Largest transfer of the DMA [word]. The counter of the DMA is 16bit.
+#define CRC_SERVICE_DMA_MAX_WORDS 65535u
+
+namespace murasaki {
+
+#if defined(DMA_SxCR_EN)
+// DMA stream of the F4, F7 and H7. On the F4 and F7, only the DMA2 transfers memory to memory.
+typedef DMA_Stream_TypeDef CrcDmaChannel;
+#elif defined(DMA_CCR_MEM2MEM)
+// DMA channel of the F0, G0, G4, L1 and L4.
+typedef DMA_Channel_TypeDef CrcDmaChannel;
+#else
+// No DMA to feed the CRC unit.
+typedef void CrcDmaChannel;
+#endif
+
+/**
+ * @brief Checksum service by the CRC unit of the STM32.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * Every STM32 has the CRC unit. This class computes the checksums of the frames, the persistent records and
+ * the firmware image by the unit, and by the table driven software where the unit can't. Both give the same
+ * result :
+ *
+ * | Checksum           | Polynomial | Initial    | Reflected | Final xor  | Check ("123456789") |
+ * |--------------------|------------|------------|-----------|------------|---------------------|
+ * | Crc32()            | 0x04C11DB7 | 0xFFFFFFFF | Yes       | 0xFFFFFFFF | 0xCBF43926          |
+ * | Crc16()            | 0x1021     | 0xFFFF     | No        | 0x0000     | 0x29B1              |
+ *
+ * The Crc32() is the one of the Ethernet and the zlib. The Crc16() is the CRC-16/CCITT-FALSE of the
+ * @ref FramedConsole. The crc parameter of both continues the checksum from the result of the previous data.
+ *
+ * The F091, F7, G0, G4, H5, H7 and L4 have the programmable polynomial and the bit reversal. The unit computes both,
+ * from any initial value. The bytes before the first word boundary and after the last one are computed by the
+ * software. The F4 and L1 have the fixed CRC-32 unit. The unit computes the Crc32() from the initial value, with the
+ * reversal by the CPU. The Crc16() and the continued Crc32() are the software on these devices.
+ *
+ * The large buffer is fed to the CRC unit by the memory to memory DMA, if a DMA channel is given. The calling task
+ * yields to the other tasks of the same priority while the DMA runs. Only for the Crc32() of the programmable unit.
+ * The DMA channel must be free, and its controller must be clocked. The interrupt of the channel is not used.
+ * On the H7, the buffer in the TCM is written by the CPU, and the data cache is cleaned before the DMA.
+ *
+ * @code
+ * murasaki::platform.crc_service = new murasaki::CrcService(DMA1_Stream7);
+ *
+ * uint32_t crc = murasaki::platform.crc_service->Crc32(image, image_size);
+ * @endcode
+ *
+ * The CRC unit is locked during the computation, by the lock shared among all instances. Thread safe. Not callable
+ * from the ISR. The instances may have the different DMA channels. The SoftwareCrc32() and the SoftwareCrc16() don't use the unit, and are callable from anywhere, including
+ * the fault handler.
+ */
+class CrcService
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param dma DMA channel to feed the CRC unit. nullptr to write by the CPU always. Ignored on the fixed unit.
+     * @param dma_threshold Size of the buffer from which the DMA is used [byte].
+     * @details
+     * Enables the clock of the CRC unit.
+     */
+    CrcService(CrcDmaChannel *dma = nullptr, unsigned int dma_threshold = CRC_SERVICE_DMA_THRESHOLD);
+    /**
+     * @brief Destructor
+     */
+    virtual ~CrcService();
+
+    /**
+     * @brief CRC-32 of the IEEE 802.3.
+     * @param data Data.
+     * @param size Size of the data [byte].
+     * @param crc The result of the previous data to continue. 0 to start.
+     * @return CRC of the data.
+     */
+    uint32_t Crc32(const void *data, unsigned int size, uint32_t crc = 0);
+
+    /**
+     * @brief CRC-16/CCITT-FALSE.
+     * @param data Data.
+     * @param size Size of the data [byte].
+     * @param crc The result of the previous data to continue. 0xFFFF to start.
+     * @return CRC of the data.
+     */
+    uint16_t Crc16(const void *data, unsigned int size, uint16_t crc = 0xFFFF);
+
+    /**
+     * @brief Same with Crc32(), by the software.
+     */
+    static uint32_t SoftwareCrc32(const void *data, unsigned int size, uint32_t crc = 0);
+
+    /**
+     * @brief Same with Crc16(), by the software.
+     */
+    static uint16_t SoftwareCrc16(const void *data, unsigned int size, uint16_t crc = 0xFFFF);
+
+    /**
+     * @brief Whether the CRC unit has the programmable polynomial.
+     * @return false on the F4 and L1. The Crc16() is the software.
+     */
+    static bool IsProgrammable();
+
+    /**
+     * @brief Whether the large buffers are fed by the DMA.
+     */
+    bool IsDmaEnabled() const;
+
+ private:
+    // Continue the CRC by the software. The state is not inverted at the end.
+    static uint32_t UpdateCrc32(uint32_t state, const uint8_t *data, unsigned int size);
+    static uint16_t UpdateCrc16(uint16_t state, const uint8_t *data, unsigned int size);
+
+    // Write the words in the CRC unit by the DMA. The data is aligned by 4. false on the transfer error.
+    bool FeedByDma(const uint8_t *data, unsigned int words);
+
+    CrcDmaChannel *const dma_;
+    const unsigned int dma_threshold_;
+    // Lock of the CRC unit. One for all instances.
+    static CriticalSection *unit_lock_;
+};
+
+} /* namespace murasaki */
+
+#endif /* CRCSERVICE_HPP_ */
@@ -0,0 +1,218 @@
+/**
+ * @file i2crecoveringmaster.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief I2C master with the bus recovery and the error accounting.
+ */
+
+#ifndef I2CRECOVERINGMASTER_HPP_
+#define I2CRECOVERINGMASTER_HPP_
+
+#include "murasaki.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Error and retry counters of an I2C device.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ */
+struct I2cDeviceStatistics
+{
+    unsigned int addrs;        ///< 7bit address of the device.
+    unsigned int transfers;    ///< Number of the transfers requested by the application.
+    unsigned int naks;         ///< Number of the NAK responses.
+    unsigned int errors;       ///< Number of the failed attempts except NAK.
+    unsigned int retries;      ///< Number of the retries after the bus recovery.
+};
+
+/**
+ * @brief I2C master with the automatic bus recovery.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * A decorator of the @ref I2cMaster. When a slave device holds the SDA low, the I2C peripheral can't
+ * generate the START condition, and every transfer on the bus fails with the timeout. This class
+ * detects this situation and recovers the bus by the following sequence :
+ *
+ * @li De-initialize the I2C peripheral, and drive the SCL/SDA pins as the open drain GPIO.
+ * @li Clock out up to 9 pulses on SCL until the slave releases SDA.
+ * @li Generate the STOP condition.
+ * @li Re-initialize the I2C peripheral.
+ *
+ * The bus recovery is triggered by the timeout, bus error, arbitration lost or unknown error of the
+ * transfer, and by SDA low before the transfer. After the recovery, the transfer is retried.
+ *
+ * To avoid one flaky device stalls the other transfers, the time is bounded :
+ * @li The timeout of each transfer is clipped to the transfer_timeout_ms given to the constructor.
+ * @li The GPIO sequence of the recovery is aborted at kRecoveryLimitUs, even if a slave stretches SCL.
+ *
+ * The errors and retries are counted for each device, and for the bus. The errors reported by the
+ * I2C error interrupt through HandleError() are counted too. PrintStatistics() shows them on the debugger.
+ *
+ * The completion and error callbacks of the handle are routed to this object by the @ref CallbackDispatcher.
+ * The registration is renewed after the re-initialization of the peripheral in the recovery.
+ *
+ * @code
+ * murasaki::platform.i2c_master = new murasaki::I2cRecoveringMaster(&hi2c1,
+ *                                                                   GPIOB, GPIO_PIN_8,   // SCL
+ *                                                                   GPIOB, GPIO_PIN_9);  // SDA
+ * @endcode
+ */
+class I2cRecoveringMaster : public I2cMasterStrategy
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param i2c_handle Peripheral handle created by CubeIDE.
+     * @param scl_port GPIO port of the SCL pin.
+     * @param scl_pin GPIO pin of the SCL. For example, GPIO_PIN_8.
+     * @param sda_port GPIO port of the SDA pin.
+     * @param sda_pin GPIO pin of the SDA.
+     * @param transfer_timeout_ms Upper bound of the timeout of each transfer [mS].
+     * @param max_retries Number of the retries after the bus recovery.
+     */
+    I2cRecoveringMaster(
+                        I2C_HandleTypeDef *i2c_handle,
+                        GPIO_TypeDef *scl_port,
+                        uint16_t scl_pin,
+                        GPIO_TypeDef *sda_port,
+                        uint16_t sda_pin,
+                        WaitMilliSeconds transfer_timeout_ms = PLATFORM_CONFIG_I2C_TRANSFER_TIMEOUT,
+                        unsigned int max_retries = PLATFORM_CONFIG_I2C_MAX_RETRIES);
+    /**
+     * @brief Destructor
+     */
+    virtual ~I2cRecoveringMaster();
+
+    virtual I2cStatus Transmit(
+                               unsigned int addrs,
+                               const uint8_t *tx_data,
+                               unsigned int tx_size,
+                               unsigned int *transfered_count = nullptr,
+                               unsigned int timeout_ms = kwmsIndefinitely);
+    virtual I2cStatus Receive(
+                              unsigned int addrs,
+                              uint8_t *rx_data,
+                              unsigned int rx_size,
+                              unsigned int *transfered_count = nullptr,
+                              unsigned int timeout_ms = kwmsIndefinitely);
+    virtual I2cStatus TransmitThenReceive(
+                                          unsigned int addrs,
+                                          const uint8_t *tx_data,
+                                          unsigned int tx_size,
+                                          uint8_t *rx_data,
+                                          unsigned int rx_size,
+                                          unsigned int *tx_transfered_count = nullptr,
+                                          unsigned int *rx_transfered_count = nullptr,
+                                          unsigned int timeout_ms = kwmsIndefinitely);
+    virtual bool TransmitCompleteCallback(void *ptr);
+    virtual bool ReceiveCompleteCallback(void *ptr);
+    /**
+     * @brief Count the error reported by the I2C error interrupt, then pass it to the I2cMaster.
+     * @param ptr Pointer to the I2C_HandleTypeDef.
+     * @return true if ptr is the handle of this object.
+     */
+    virtual bool HandleError(void *ptr);
+
+    /**
+     * @brief Recover the bus explicitly.
+     * @return true if the SDA is released.
+     * @details
+     * Usually, there is no need to call this function. The recovery is done automatically.
+     */
+    bool Recover();
+
+    /**
+     * @brief Hold the bus for the change of the I2C kernel clock.
+     * @details
+     * Waits for the end of the current transfer. The other transfers wait until Resume().
+     * Must be followed by Resume() from the same task.
+     */
+    void Suspend();
+
+    /**
+     * @brief Re-compute the bus timing from the current kernel clock, and release the bus.
+     * @return true if the timing is re-computed. See I2cTiming::Retime().
+     */
+    bool Resume();
+
+    /**
+     * @brief Get the counters of a device.
+     * @param addrs 7bit address of the device.
+     * @return Pointer to the counters. nullptr if the device has never been accessed successfully or failed.
+     */
+    const I2cDeviceStatistics* GetDeviceStatistics(unsigned int addrs) const;
+
+    /**
+     * @brief Show the bus and device counters on the debugger.
+     */
+    void PrintStatistics() const;
+
+    /**
+     * @brief Upper bound of the GPIO sequence of the bus recovery [uS].
+     */
+    static const unsigned int kRecoveryLimitUs = 1000;
+
+    /**
+     * @brief Number of the devices which have the individual counters.
+     * @details
+     * The other devices are counted only in the bus counters.
+     */
+    static const unsigned int kMaxDevices = 8;
+
+ private:
+    // Signature of the transfer. All three transfers are handled by the same retry logic.
+    enum TransferType
+    {
+        kttTransmit,
+        kttReceive,
+        kttTransmitThenReceive
+    };
+
+    I2cStatus DoTransfer(
+                         TransferType type,
+                         unsigned int addrs,
+                         const uint8_t *tx_data,
+                         unsigned int tx_size,
+                         uint8_t *rx_data,
+                         unsigned int rx_size,
+                         unsigned int *tx_transfered_count,
+                         unsigned int *rx_transfered_count,
+                         unsigned int timeout_ms);
+    bool RecoverInternal();
+    bool WaitForSclHigh(uint32_t start, uint32_t limit);
+    bool IsSdaHigh();
+    void ConfigurePins(bool gpio);
+    I2cDeviceStatistics* FindDevice(unsigned int addrs, bool allocate);
+    static bool NeedsRecovery(I2cStatus status);
+
+    virtual void* GetPeripheralHandle();
+
+    I2C_HandleTypeDef *const peripheral_;
+    I2cMasterStrategy *const master_;
+    GPIO_TypeDef *const scl_port_;
+    const uint16_t scl_pin_;
+    GPIO_TypeDef *const sda_port_;
+    const uint16_t sda_pin_;
+    const WaitMilliSeconds transfer_timeout_ms_;
+    const unsigned int max_retries_;
+    CriticalSection *const critical_section_;
+
+    static const unsigned int kEmptySlot = 0xFF;   // addrs of the unused devices_[] entry.
+    static const unsigned int kHalfClockUs = 5;    // 100kHz clock pulse of the recovery.
+
+    I2cDeviceStatistics devices_[kMaxDevices];
+
+    // Bus counters.
+    unsigned int recoveries_;
+    unsigned int failed_recoveries_;
+    uint32_t max_recovery_cycles_;
+    volatile unsigned int bus_errors_;        // Reported by the error interrupt.
+    volatile unsigned int arbitration_losts_;
+    volatile unsigned int overruns_;
+    volatile unsigned int acknowledge_failures_;
+};
+
+} /* namespace murasaki */
+
+#endif /* I2CRECOVERINGMASTER_HPP_ */
@@ -0,0 +1,130 @@
+/**
+ * @file i2cscanner.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Fast I2C bus enumeration with cached result.
+ */
+
+#ifndef I2CSCANNER_HPP_
+#define I2CSCANNER_HPP_
+
+#include "murasaki.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Fast I2C bus scanner with cached result table.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * A faster replacement of the I2cSearch(). The differences are :
+ * @li Each address is probed by the address-only (zero length) transfer.
+ * @li Each probe is done with the short timeout. A stuck device doesn't block the scan for long.
+ * @li The reserved address ranges ( 0x00-0x07 and 0x78-0x7F ) are skipped.
+ * @li The result is kept in the internal table.
+ *
+ * The scan can run synchronously by Scan(), or in the background by StartBackgroundScan().
+ * Once the table is valid, IsPresent() and Print() are served from the cache without touching the bus.
+ * If the bus configuration is changed, call Invalidate() or re-scan.
+ *
+ * @code
+ * // At boot. Scanning runs in the other task.
+ * murasaki::platform.i2c_scanner->StartBackgroundScan();
+ * ...
+ * // Later. This waits for the end of scan if it is not finished yet.
+ * if ( murasaki::platform.i2c_scanner->IsPresent(0x3C) )
+ *     InitDisplay();
+ * @endcode
+ */
+class I2cScanner
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param master I2C master to scan.
+     * @param probe_timeout_ms Timeout of the each address probe [mS].
+     */
+    I2cScanner(I2cMasterStrategy *master, WaitMilliSeconds probe_timeout_ms = kProbeTimeoutMs);
+    /**
+     * @brief Destructor
+     */
+    virtual ~I2cScanner();
+
+    /**
+     * @brief Scan the bus synchronously and refresh the cache.
+     * @details
+     * Do not call this member function while the background scan is running.
+     */
+    void Scan();
+
+    /**
+     * @brief Start the scan in the background task.
+     * @details
+     * The background task is created at the first call. Then, the task scans the bus and refresh the cache.
+     * The caller returns immediately.
+     */
+    void StartBackgroundScan();
+
+    /**
+     * @brief Wait for the end of the background scan.
+     * @param timeout_ms Timeout [mS]
+     * @return true if the cache is valid. false if timeout.
+     */
+    bool WaitForScan(WaitMilliSeconds timeout_ms = kwmsIndefinitely);
+
+    /**
+     * @brief Check whether a device responded to the last scan.
+     * @param addrs 7bit address of the device.
+     * @return true if the device answered ACK.
+     * @details
+     * If the cache is not valid, the bus is scanned first. If the background scan is running,
+     * wait for its end.
+     */
+    bool IsPresent(unsigned int addrs);
+
+    /**
+     * @brief Number of the devices found by the last scan.
+     * @return Number of the devices.
+     */
+    unsigned int GetDeviceCount();
+
+    /**
+     * @brief Discard the cached result.
+     * @details
+     * The next IsPresent() call will re-scan the bus.
+     */
+    void Invalidate();
+
+    /**
+     * @brief Print the cached table to the debugger console.
+     * @details
+     * The format is same with the I2cSearch(). The reserved addresses are shown as blank, and the
+     * addresses which returned the error other than NAK are shown as "??".
+     */
+    void Print();
+
+    /**
+     * @brief Default timeout of the each address probe [mS].
+     */
+    static const WaitMilliSeconds kProbeTimeoutMs = 5;
+
+ private:
+    static void ScanTaskBody(const void *ptr);
+    static bool IsReserved(unsigned int addrs);
+    static bool TestBit(const uint32_t table[], unsigned int addrs);
+    static void SetBit(uint32_t table[], unsigned int addrs);
+
+    I2cMasterStrategy *const master_;
+    const WaitMilliSeconds probe_timeout_ms_;
+    Synchronizer *const request_;      // Trigger to the background task
+    Synchronizer *const done_;         // Signaled by the background task.
+    TaskStrategy *task_;               // Created at first StartBackgroundScan().
+    volatile bool valid_;              // true if the table is valid.
+    volatile bool scanning_;           // true while the background scan is running.
+    uint32_t present_[128 / 32];       // bit table of the ACKed address.
+    uint32_t error_[128 / 32];         // bit table of the address which returned error other than NAK.
+};
+
+} /* namespace murasaki */
+
+#endif /* I2CSCANNER_HPP_ */
@@ -29,4 +29,72 @@
 // Define following macro as true to halt the cycle counter inside MURASAKI_SYSLOG macro.
 #define MURASAKI_CONFIG_NOSYCCNT false
 
+// SCL frequency of the I2C master [Hz]. 100000, 400000 and 1000000 are supported.
+// The timing is computed from the I2C kernel clock at run time by murasaki::I2cTiming.
+#define PLATFORM_CONFIG_I2C_BUS_SPEED 100000
+
+// Upper bound of the timeout of each I2C transfer [mS]. Applied by murasaki::I2cRecoveringMaster.
+#define PLATFORM_CONFIG_I2C_TRANSFER_TIMEOUT 100
+
+// Number of the I2C transfer retries after the bus recovery.
+#define PLATFORM_CONFIG_I2C_MAX_RETRIES 1
+
+// Define following macro as true to enable the FIFO of the console UART by murasaki::UartFifo.
+// The STM32G0, G4, H5 and H7 only. The UART without the FIFO is left untouched.
+#define PLATFORM_CONFIG_UART_FIFO true
+
+// Thresholds of the Tx and Rx FIFO of the console UART. murasaki::kuftOneEighth to murasaki::kuftFull.
+#define PLATFORM_CONFIG_UART_TX_FIFO_THRESHOLD murasaki::kuftThreeQuarters
+#define PLATFORM_CONFIG_UART_RX_FIFO_THRESHOLD murasaki::kuftHalf
+
+// Wait for the baud rate request of the tools/consolebaud.py at the boot [mS], by murasaki::ConsoleBaud.
+// 0 to keep the baud rate of the CubeIDE.
+#define PLATFORM_CONFIG_CONSOLE_BAUD_WINDOW 300
+
+// Define following macro as true to use the USB CDC-ACM on the user USB connector as the console, by murasaki::UsbCdcAcm.
+// The STM32F722 and H743 only. The other boards keep the UART console.
+#define PLATFORM_CONFIG_USB_CONSOLE false
+
+// Define following macro as true to send the demo message to the Ethernet by murasaki::EthTelemetry. The STM32H743 only.
+// UDP from the source address to the destination address and port. The destination can be the broadcast.
+#define PLATFORM_CONFIG_ETH_TELEMETRY false
+#define PLATFORM_CONFIG_ETH_TELEMETRY_SOURCE_IP 0xC0A800C8         // 192.168.0.200
+#define PLATFORM_CONFIG_ETH_TELEMETRY_DESTINATION_IP 0xFFFFFFFF    // 255.255.255.255
+#define PLATFORM_CONFIG_ETH_TELEMETRY_PORT 5555
+
+// Define following macro as true to multiplex the text and the binary records on the console by murasaki::FramedConsole.
+// The console is read by tools/framedconsole.py, instead of the terminal.
+#define PLATFORM_CONFIG_FRAMED_CONSOLE false
+
+// Define following macro as true to run the murasaki::RtosBenchmark instead of the demo in ExecPlatform().
+#define PLATFORM_CONFIG_BENCHMARK false
+
+// Number of the samples of each benchmark of the murasaki::RtosBenchmark.
+#define PLATFORM_CONFIG_BENCHMARK_ITERATIONS 1000
+
+// Define following macro as true to start the independent watchdog by murasaki::Supervisor.
+// Once started, the watchdog resets the system when a supervised task misses its deadline.
+#define PLATFORM_CONFIG_WATCHDOG true
+
+// Timeout of the independent watchdog [mS]. Up to 32000 at the 32kHz LSI.
+#define PLATFORM_CONFIG_WATCHDOG_TIMEOUT 2000
+
+// Deadline of the check-in of the supervised tasks [mS].
+#define PLATFORM_CONFIG_WATCHDOG_DEADLINE 3000
+
+// Clock profile applied by InitPlatform(). murasaki::kcpLow, murasaki::kcpBalanced or murasaki::kcpMax.
+// The kcpBalanced is the CubeIDE configuration. The other profiles are supported only on the STM32F446, F746 and H743.
+#define PLATFORM_CONFIG_CLOCK_PROFILE murasaki::kcpMax
+
+// Define following macro as true to select the clock profile by the CPU load, with murasaki::Governor.
+// The PLATFORM_CONFIG_CLOCK_PROFILE is the profile until the governor decides.
+#define PLATFORM_CONFIG_GOVERNOR true
+
+// Sampling period of the CPU load by the governor [mS]. The decision is made on the last 10 samples.
+#define PLATFORM_CONFIG_GOVERNOR_PERIOD 100
+
+// Period of the CPU load report to the console by murasaki::LoadMeter [mS]. 0 to disable the report.
+// The load is measured regardless of this period.
+#define PLATFORM_CONFIG_LOAD_METER_REPORT 10000
+
 #endif /* PLATFORM_CONFIG_HPP_ */
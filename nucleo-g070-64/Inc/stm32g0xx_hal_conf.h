@@ -77,7 +77,7 @@ extern "C" {
 #define USE_HAL_DAC_REGISTER_CALLBACKS    0u
 #define USE_HAL_FDCAN_REGISTER_CALLBACKS  0u
 #define USE_HAL_HCD_REGISTER_CALLBACKS    0u
-#define USE_HAL_I2C_REGISTER_CALLBACKS    0u
+#define USE_HAL_I2C_REGISTER_CALLBACKS    1u
 #define USE_HAL_I2S_REGISTER_CALLBACKS    0u
 #define USE_HAL_IRDA_REGISTER_CALLBACKS   0u
 #define USE_HAL_LPTIM_REGISTER_CALLBACKS  0u
@@ -87,7 +87,7 @@ extern "C" {
 #define USE_HAL_SMBUS_REGISTER_CALLBACKS  0u
 #define USE_HAL_SPI_REGISTER_CALLBACKS    0u
 #define USE_HAL_TIM_REGISTER_CALLBACKS    0u
-#define USE_HAL_UART_REGISTER_CALLBACKS   0u
+#define USE_HAL_UART_REGISTER_CALLBACKS   1u
 #define USE_HAL_USART_REGISTER_CALLBACKS  0u
 #define USE_HAL_WWDG_REGISTER_CALLBACKS   0u
 
@@ -0,0 +1,128 @@
+/**
+ * @file tracerecorder.h
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Kernel trace recorder.
+ * @details
+ * Records the task switches, the interrupts and the queue / semaphore / mutex operations into
+ * a RAM ring buffer. Each entry is 8 byte, with the @ref murasaki::CycleCounter time stamp.
+ *
+ * This file is included at the end of the FreeRTOSConfig.h, to define the trace hook macros of the kernel.
+ * To enable, define TRACE_RECORDER_ENABLE as 1 before including. The hooks use only the members
+ * of the kernel objects which are common to FreeRTOS V10.0.1 - V10.4.6, and don't need the
+ * configUSE_TRACE_FACILITY.
+ *
+ * The interrupt handlers to trace call TRACE_ISR_ENTER() and TRACE_ISR_EXIT() in the
+ * stm32xxxx_it.c.
+ *
+ * The TracePrint() prints the buffer to the console. The log is converted to the Chrome / Perfetto JSON
+ * or the CTF by tools/traceconvert.py.
+ */
+
+#ifndef TRACERECORDER_H_
+#define TRACERECORDER_H_
+
+#ifndef TRACE_RECORDER_ENABLE
+#define TRACE_RECORDER_ENABLE 0
+#endif
+
+// Number of the entries in the ring buffer. 8 byte each.
+#ifndef TRACE_RECORDER_BUFFER_SIZE
+#define TRACE_RECORDER_BUFFER_SIZE 256
+#endif
+
+// Number of the tasks and queues which name is recorded.
+#ifndef TRACE_RECORDER_MAX_OBJECTS
+#define TRACE_RECORDER_MAX_OBJECTS 16
+#endif
+
+// Event codes. The queue events are added the kind of the queue and the ISR flag.
+#define TRACE_EVENT_TASK_SWITCHED_IN 0x01
+#define TRACE_EVENT_TASK_SWITCHED_OUT 0x02
+#define TRACE_EVENT_ISR_ENTER 0x03
+#define TRACE_EVENT_ISR_EXIT 0x04
+#define TRACE_EVENT_QUEUE_SEND 0x10
+#define TRACE_EVENT_QUEUE_RECEIVE 0x20
+#define TRACE_EVENT_QUEUE_BLOCK_SEND 0x30
+#define TRACE_EVENT_QUEUE_BLOCK_RECEIVE 0x40
+#define TRACE_EVENT_QUEUE_FAILED 0x50           // Send or receive failed without blocking.
+
+#define TRACE_EVENT_FROM_ISR 0x08
+#define TRACE_EVENT_KIND_QUEUE 0x00
+#define TRACE_EVENT_KIND_SEMAPHORE 0x01
+#define TRACE_EVENT_KIND_MUTEX 0x02
+
+// Kind of the objects in the name table.
+#define TRACE_OBJECT_TASK 1
+#define TRACE_OBJECT_QUEUE 2
+
+#if !defined(__ASSEMBLER__)
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start recording. The buffer is cleared.
+ */
+void TraceStart(void);
+/**
+ * @brief Stop recording. The buffer is kept.
+ */
+void TraceStop(void);
+/**
+ * @brief Print the buffer to the console by the murasaki::debugger.
+ * @details
+ * Call from a task after TraceStop(). It takes a while to avoid the overflow of the debugger FIFO.
+ */
+void TracePrint(void);
+
+// Called from the hooks.
+void TraceRecord(uint8_t event, const void *object, uint8_t value);
+void TraceRecordIsr(uint8_t event);
+void TraceRegisterObject(const void *object, const char *name, uint8_t kind);
+void TraceTick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if TRACE_RECORDER_ENABLE
+
+// Kind of the queue. Expanded in queue.c, where the Queue_t is visible.
+#define TRACE_QUEUE_KIND(pxQueue) \
+    (((pxQueue)->uxItemSize != 0) ? TRACE_EVENT_KIND_QUEUE : \
+     ((pxQueue)->pcHead == NULL) ? TRACE_EVENT_KIND_MUTEX : TRACE_EVENT_KIND_SEMAPHORE)
+#define TRACE_QUEUE(event, pxQueue) \
+    TraceRecord((event) | TRACE_QUEUE_KIND(pxQueue), (pxQueue), (uint8_t)(pxQueue)->uxMessagesWaiting)
+
+#define traceTASK_CREATE(pxNewTCB) TraceRegisterObject((pxNewTCB), (pxNewTCB)->pcTaskName, TRACE_OBJECT_TASK)
+#define traceTASK_SWITCHED_IN() TraceRecord(TRACE_EVENT_TASK_SWITCHED_IN, pxCurrentTCB, 0)
+#define traceTASK_SWITCHED_OUT() TraceRecord(TRACE_EVENT_TASK_SWITCHED_OUT, pxCurrentTCB, 0)
+#define traceTASK_INCREMENT_TICK(xTickCount) TraceTick()
+#define traceQUEUE_REGISTRY_ADD(xQueue, pcQueueName) TraceRegisterObject((xQueue), (pcQueueName), TRACE_OBJECT_QUEUE)
+#define traceQUEUE_SEND(pxQueue) TRACE_QUEUE(TRACE_EVENT_QUEUE_SEND, pxQueue)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) TRACE_QUEUE(TRACE_EVENT_QUEUE_SEND | TRACE_EVENT_FROM_ISR, pxQueue)
+#define traceQUEUE_SEND_FAILED(pxQueue) TRACE_QUEUE(TRACE_EVENT_QUEUE_FAILED, pxQueue)
+#define traceQUEUE_RECEIVE(pxQueue) TRACE_QUEUE(TRACE_EVENT_QUEUE_RECEIVE, pxQueue)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) TRACE_QUEUE(TRACE_EVENT_QUEUE_RECEIVE | TRACE_EVENT_FROM_ISR, pxQueue)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) TRACE_QUEUE(TRACE_EVENT_QUEUE_FAILED, pxQueue)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) TRACE_QUEUE(TRACE_EVENT_QUEUE_BLOCK_SEND, pxQueue)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) TRACE_QUEUE(TRACE_EVENT_QUEUE_BLOCK_RECEIVE, pxQueue)
+
+#define TRACE_ISR_ENTER() TraceRecordIsr(TRACE_EVENT_ISR_ENTER)
+#define TRACE_ISR_EXIT() TraceRecordIsr(TRACE_EVENT_ISR_EXIT)
+
+#else
+
+#define TRACE_ISR_ENTER()
+#define TRACE_ISR_EXIT()
+
+#endif /* TRACE_RECORDER_ENABLE */
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* TRACERECORDER_H_ */
@@ -0,0 +1,73 @@
+/**
+ * @file cyclecounter.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Portable CPU cycle counter and busy wait.
+ */
+
+#include "cyclecounter.hpp"
+
+namespace murasaki {
+
+#if !defined(DWT_CTRL_CYCCNTENA_Msk)
+uint32_t CycleCounter::last_value_;
+uint32_t CycleCounter::count_;
+#endif
+
+void CycleCounter::Init()
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if (__CORTEX_M == 7U)
+    // Cortex-M7 DWT is locked after reset.
+    DWT->LAR = 0xC5ACCE55;
+#endif
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#else
+    last_value_ = SysTick->VAL;
+#endif
+}
+
+uint32_t CycleCounter::Get()
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    return DWT->CYCCNT;
+#else
+    // SysTick counts down from LOAD to 0, then reloads.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t value = SysTick->VAL;
+    if (value <= last_value_)
+        count_ += last_value_ - value;
+    else
+        count_ += last_value_ + (SysTick->LOAD + 1) - value;
+    last_value_ = value;
+
+    uint32_t count = count_;
+    __set_PRIMASK(primask);
+    return count;
+#endif
+}
+
+uint32_t CycleCounter::MicroSecondsToCycles(unsigned int us)
+{
+    return static_cast<uint32_t>((static_cast<uint64_t>(SystemCoreClock) * us) / 1000000);
+}
+
+unsigned int CycleCounter::CyclesToMicroSeconds(uint32_t cycles)
+{
+    return static_cast<unsigned int>((static_cast<uint64_t>(cycles) * 1000000) / SystemCoreClock);
+}
+
+void CycleCounter::DelayMicroSeconds(unsigned int us)
+{
+    const uint32_t cycles = MicroSecondsToCycles(us);
+    const uint32_t start = Get();
+
+    while (Get() - start < cycles)
+        ;
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,290 @@
+/**
+ * @file i2cregistermap.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Cached register map of an I2C device.
+ */
+
+#include "i2cregistermap.hpp"
+
+#include <string.h>
+
+// Number of the uint32_t words to hold the bit table of n registers.
+#define BIT_TABLE_WORDS(n) (((n) + 31) / 32)
+
+namespace murasaki {
+
+I2cRegisterMap::I2cRegisterMap(
+                               I2cMasterStrategy *master,
+                               unsigned int device_addrs,
+                               unsigned int num_registers,
+                               bool write_back,
+                               WaitMilliSeconds timeout_ms)
+        :
+        master_(master),
+        device_addrs_(device_addrs),
+        num_registers_(num_registers),
+        write_back_(write_back),
+        timeout_ms_(timeout_ms),
+        critical_section_(new CriticalSection()),
+        cache_(new uint8_t[num_registers]),
+        valid_(new uint32_t[BIT_TABLE_WORDS(num_registers)]),
+        dirty_(new uint32_t[BIT_TABLE_WORDS(num_registers)]),
+        volatile_(new uint32_t[BIT_TABLE_WORDS(num_registers)]),
+        transfer_count_(0),
+        avoided_count_(0)
+{
+    MURASAKI_ASSERT(nullptr != master_)
+    MURASAKI_ASSERT(device_addrs_ < 128)
+    MURASAKI_ASSERT(0 < num_registers_ && num_registers_ <= 256)
+    MURASAKI_ASSERT(nullptr != critical_section_)
+    MURASAKI_ASSERT(nullptr != cache_)
+    MURASAKI_ASSERT(nullptr != valid_)
+    MURASAKI_ASSERT(nullptr != dirty_)
+    MURASAKI_ASSERT(nullptr != volatile_)
+
+    ::memset(cache_, 0, num_registers_);
+    ::memset(valid_, 0, BIT_TABLE_WORDS(num_registers_) * sizeof(uint32_t));
+    ::memset(dirty_, 0, BIT_TABLE_WORDS(num_registers_) * sizeof(uint32_t));
+    ::memset(volatile_, 0, BIT_TABLE_WORDS(num_registers_) * sizeof(uint32_t));
+}
+
+I2cRegisterMap::~I2cRegisterMap()
+{
+    delete critical_section_;
+    delete[] cache_;
+    delete[] valid_;
+    delete[] dirty_;
+    delete[] volatile_;
+}
+
+void I2cRegisterMap::SetVolatile(unsigned int first_reg, unsigned int last_reg)
+{
+    MURASAKI_ASSERT(first_reg <= last_reg)
+    MURASAKI_ASSERT(last_reg < num_registers_)
+
+    critical_section_->Enter();
+    for (unsigned int reg = first_reg; reg <= last_reg; reg++) {
+        SetBit(volatile_, reg);
+        ClearBit(valid_, reg);
+        ClearBit(dirty_, reg);
+    }
+    critical_section_->Leave();
+}
+
+I2cStatus I2cRegisterMap::Read(unsigned int reg, uint8_t *value)
+{
+    return ReadBlock(reg, value, 1);
+}
+
+I2cStatus I2cRegisterMap::ReadBlock(unsigned int reg, uint8_t values[], unsigned int count)
+{
+    MURASAKI_ASSERT(nullptr != values)
+    MURASAKI_ASSERT(0 < count)
+    MURASAKI_ASSERT(reg + count <= num_registers_)
+
+    I2cStatus status;
+
+    critical_section_->Enter();
+    status = ReadInternal(reg, values, count);
+    critical_section_->Leave();
+
+    return status;
+}
+
+I2cStatus I2cRegisterMap::Write(unsigned int reg, uint8_t value)
+{
+    MURASAKI_ASSERT(reg < num_registers_)
+
+    I2cStatus status;
+
+    critical_section_->Enter();
+    status = WriteInternal(reg, value);
+    critical_section_->Leave();
+
+    return status;
+}
+
+I2cStatus I2cRegisterMap::UpdateBits(unsigned int reg, uint8_t mask, uint8_t value)
+{
+    MURASAKI_ASSERT(reg < num_registers_)
+
+    uint8_t current;
+    I2cStatus status;
+
+    critical_section_->Enter();
+
+    status = ReadInternal(reg, &current, 1);
+    if (ki2csOK == status)
+        status = WriteInternal(reg, (current & ~mask) | (value & mask));
+
+    critical_section_->Leave();
+    return status;
+}
+
+I2cStatus I2cRegisterMap::ReadInternal(unsigned int reg, uint8_t values[], unsigned int count)
+{
+    I2cStatus status = ki2csOK;
+    bool all_cached = true;
+
+    for (unsigned int i = 0; i < count; i++)
+        if (!TestBit(valid_, reg + i)) {
+            all_cached = false;
+            break;
+        }
+
+    if (all_cached) {
+        ::memcpy(values, &cache_[reg], count);
+        avoided_count_++;
+    }
+    else {
+        uint8_t reg_addrs = reg;
+
+        status = master_->TransmitThenReceive(
+                                              device_addrs_,
+                                              &reg_addrs,
+                                              1,
+                                              values,
+                                              count,
+                                              nullptr,
+                                              nullptr,
+                                              timeout_ms_);
+        transfer_count_++;
+
+        if (ki2csOK == status)
+            for (unsigned int i = 0; i < count; i++) {
+                unsigned int index = reg + i;
+
+                if (TestBit(volatile_, index))
+                    continue;
+                if (TestBit(dirty_, index))
+                    values[i] = cache_[index];  // Not written yet. Cache is the latest.
+                else {
+                    cache_[index] = values[i];
+                    SetBit(valid_, index);
+                }
+            }
+    }
+
+    return status;
+}
+
+I2cStatus I2cRegisterMap::WriteInternal(unsigned int reg, uint8_t value)
+{
+    I2cStatus status = ki2csOK;
+
+    if (TestBit(volatile_, reg))
+        status = WriteToDevice(reg, &value, 1);
+    else if (TestBit(valid_, reg) && cache_[reg] == value)
+        avoided_count_++;
+    else if (write_back_) {
+        cache_[reg] = value;
+        SetBit(valid_, reg);
+        SetBit(dirty_, reg);
+        avoided_count_++;
+    }
+    else {
+        status = WriteToDevice(reg, &value, 1);
+        if (ki2csOK == status) {
+            cache_[reg] = value;
+            SetBit(valid_, reg);
+        }
+        else
+            ClearBit(valid_, reg);  // The device value is unknown.
+    }
+
+    return status;
+}
+
+I2cStatus I2cRegisterMap::Flush()
+{
+    I2cStatus status;
+
+    critical_section_->Enter();
+    status = FlushInternal();
+    critical_section_->Leave();
+
+    return status;
+}
+
+void I2cRegisterMap::Invalidate()
+{
+    critical_section_->Enter();
+    ::memset(valid_, 0, BIT_TABLE_WORDS(num_registers_) * sizeof(uint32_t));
+    ::memset(dirty_, 0, BIT_TABLE_WORDS(num_registers_) * sizeof(uint32_t));
+    critical_section_->Leave();
+}
+
+unsigned int I2cRegisterMap::GetTransferCount() const
+{
+    return transfer_count_;
+}
+
+unsigned int I2cRegisterMap::GetAvoidedTransferCount() const
+{
+    return avoided_count_;
+}
+
+I2cStatus I2cRegisterMap::WriteToDevice(unsigned int reg, const uint8_t values[], unsigned int count)
+{
+    // Register address followed by data.
+    uint8_t buffer[kMaxBurstLength + 1];
+
+    MURASAKI_ASSERT(count <= kMaxBurstLength)
+
+    buffer[0] = reg;
+    ::memcpy(&buffer[1], values, count);
+
+    transfer_count_++;
+    return master_->Transmit(device_addrs_, buffer, count + 1, nullptr, timeout_ms_);
+}
+
+I2cStatus I2cRegisterMap::FlushInternal()
+{
+    unsigned int reg = 0;
+
+    while (reg < num_registers_) {
+        // Skip the whole word if nothing is dirty.
+        if (dirty_[reg / 32] == 0) {
+            reg = (reg / 32 + 1) * 32;
+            continue;
+        }
+        if (!TestBit(dirty_, reg)) {
+            reg++;
+            continue;
+        }
+
+        // Find the end of the contiguous dirty run.
+        unsigned int length = 1;
+        while (reg + length < num_registers_ && length < kMaxBurstLength && TestBit(dirty_, reg + length))
+            length++;
+
+        I2cStatus status = WriteToDevice(reg, &cache_[reg], length);
+        if (ki2csOK != status)
+            return status;  // Keep dirty to retry later.
+
+        for (unsigned int i = 0; i < length; i++)
+            ClearBit(dirty_, reg + i);
+        reg += length;
+    }
+
+    return ki2csOK;
+}
+
+bool I2cRegisterMap::TestBit(const uint32_t table[], unsigned int index)
+{
+    return table[index / 32] & (1u << (index % 32));
+}
+
+void I2cRegisterMap::SetBit(uint32_t table[], unsigned int index)
+{
+    table[index / 32] |= 1u << (index % 32);
+}
+
+void I2cRegisterMap::ClearBit(uint32_t table[], unsigned int index)
+{
+    table[index / 32] &= ~(1u << (index % 32));
+}
+
+} /* namespace murasaki */
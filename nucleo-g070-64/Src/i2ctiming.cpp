@@ -0,0 +1,275 @@
+/**
+ * @file i2ctiming.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Runtime I2C bus speed configuration.
+ */
+
+#include "i2ctiming.hpp"
+
+/*
+ * I2C specification values in nano seconds.
+ *
+ * The rise and fall times are the assumed values of the board, not the specification limits.
+ * They are same with the default of the Linux stm32f7 I2C driver. The slower edges than these values
+ * make the SCL frequency lower. Thus, it never exceeds the requested speed.
+ */
+struct I2cSpecTiming
+{
+    unsigned int speed;       // Max SCL frequency [Hz]
+    unsigned int low_min;     // tLOW min
+    unsigned int high_min;    // tHIGH min
+    unsigned int su_dat_min;  // tSU;DAT min
+    unsigned int vd_dat_max;  // tVD;DAT max
+    unsigned int rise;        // tr
+    unsigned int fall;        // tf
+};
+
+static const I2cSpecTiming kI2cSpecs[] = {
+        { murasaki::kibsStandard, 4700, 4000, 250, 3450, 25, 10 },
+        { murasaki::kibsFast, 1300, 600, 100, 900, 25, 10 },
+        { murasaki::kibsFastPlus, 500, 260, 50, 450, 25, 10 },
+};
+
+// Analog filter delay range [nS]
+#define I2C_ANALOG_FILTER_DELAY_MIN 50
+#define I2C_ANALOG_FILTER_DELAY_MAX 260
+
+// Field position of the TIMINGR. Defined here because the STM32F4 / L1 headers don't have it.
+#define I2C_TIMINGR_PRESC_SHIFT 28
+#define I2C_TIMINGR_SCLDEL_SHIFT 20
+#define I2C_TIMINGR_SDADEL_SHIFT 16
+#define I2C_TIMINGR_SCLH_SHIFT 8
+#define I2C_TIMINGR_SCLL_SHIFT 0
+
+namespace murasaki {
+
+I2C_HandleTypeDef *I2cTiming::handles_[I2cTiming::kMaxHandles];
+unsigned int I2cTiming::bus_speeds_[I2cTiming::kMaxHandles];
+
+unsigned int I2cTiming::GetKernelClock(I2C_HandleTypeDef *hi2c)
+{
+    MURASAKI_ASSERT(nullptr != hi2c)
+
+#if defined(I2C_CCR_CCR)
+    // STM32F4 / L1. All I2C are on the APB1.
+    return HAL_RCC_GetPCLK1Freq();
+#elif defined(RCC_DCKCFGR2_I2C1SEL)
+    // STM32F7. The HAL doesn't tell the I2C clock.
+    if (hi2c->Instance == I2C1)
+        switch (__HAL_RCC_GET_I2C1_SOURCE())
+        {
+            case RCC_I2C1CLKSOURCE_PCLK1:
+                return HAL_RCC_GetPCLK1Freq();
+            case RCC_I2C1CLKSOURCE_SYSCLK:
+                return HAL_RCC_GetSysClockFreq();
+            case RCC_I2C1CLKSOURCE_HSI:
+                return HSI_VALUE;
+            default:
+                return 0;
+        }
+    return HAL_RCC_GetPCLK1Freq();
+#elif defined(RCC_D2CCIP2R_I2C123SEL)
+    // STM32H7. The HAL doesn't tell the I2C clock.
+    if (hi2c->Instance == I2C1 || hi2c->Instance == I2C2 || hi2c->Instance == I2C3)
+        switch (__HAL_RCC_GET_I2C123_SOURCE())
+        {
+            case RCC_I2C123CLKSOURCE_D2PCLK1:
+                return HAL_RCC_GetPCLK1Freq();
+            case RCC_I2C123CLKSOURCE_HSI:
+                return HSI_VALUE >> (__HAL_RCC_GET_HSI_DIVIDER() >> RCC_CR_HSIDIV_Pos);
+            case RCC_I2C123CLKSOURCE_CSI:
+                return CSI_VALUE;
+            default:
+                return 0;
+        }
+    return 0;
+#else
+    // STM32F0 / G0 / G4 / L4 / H5.
+    if (hi2c->Instance == I2C1)
+        return HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_I2C1);
+    return HAL_RCC_GetPCLK1Freq();
+#endif
+}
+
+bool I2cTiming::ComputeTimingRegister(unsigned int kernel_clock, unsigned int bus_speed, uint32_t *timing)
+{
+    MURASAKI_ASSERT(nullptr != timing)
+
+    if (kernel_clock == 0 || bus_speed == 0)
+        return false;
+
+    // Pick up the slowest specification which covers the requested speed.
+    const I2cSpecTiming *spec = nullptr;
+    for (unsigned int i = 0; i < sizeof(kI2cSpecs) / sizeof(kI2cSpecs[0]); i++)
+        if (bus_speed <= kI2cSpecs[i].speed) {
+            spec = &kI2cSpecs[i];
+            break;
+        }
+    if (nullptr == spec)
+        return false;
+
+    // All calculation is done in pico second.
+    const uint64_t clock_ps = 1000000000000ull / kernel_clock;
+    const uint64_t period_ps = 1000000000000ull / bus_speed;
+    // Synchronization delay of SCL edges. Minimum delay to avoid the over speed.
+    const uint64_t sync_ps = (spec->rise + spec->fall) * 1000ull
+            + 2 * (I2C_ANALOG_FILTER_DELAY_MIN * 1000ull + 2 * clock_ps);
+
+    if (period_ps <= sync_ps)
+        return false;
+
+    // Search the smallest prescaler which satisfies all constraints. Smaller is better resolution.
+    for (unsigned int presc = 0; presc < 16; presc++) {
+        const uint64_t presc_ps = (presc + 1) * clock_ps;
+
+        // Data setup time.
+        uint64_t scldel = ((spec->rise + spec->su_dat_min) * 1000ull + presc_ps - 1) / presc_ps;
+        scldel = (scldel > 0) ? scldel - 1 : 0;
+        if (scldel > 15)
+            continue;
+
+        // Data hold time.
+        int64_t sdadel_min_ps = spec->fall * 1000ll - I2C_ANALOG_FILTER_DELAY_MIN * 1000ll - 3 * (int64_t) clock_ps;
+        int64_t sdadel_max_ps = spec->vd_dat_max * 1000ll - spec->rise * 1000ll - I2C_ANALOG_FILTER_DELAY_MAX * 1000ll
+                - 4 * (int64_t) clock_ps;
+        uint64_t sdadel = (sdadel_min_ps > 0) ? (sdadel_min_ps + presc_ps - 1) / presc_ps : 0;
+        if (sdadel > 15 || (int64_t) (sdadel * presc_ps) > sdadel_max_ps)
+            continue;
+
+        // SCL low and high period in prescaled clock.
+        uint64_t low = (spec->low_min * 1000ull + presc_ps - 1) / presc_ps;
+        uint64_t high = (spec->high_min * 1000ull + presc_ps - 1) / presc_ps;
+        uint64_t cycles = (period_ps - sync_ps + presc_ps - 1) / presc_ps;
+
+        // Distribute the margin to the low and high period evenly.
+        if (cycles > low + high) {
+            uint64_t margin = cycles - low - high;
+            low += margin - margin / 2;
+            high += margin / 2;
+        }
+
+        if (low > 256 || high > 256)
+            continue;
+
+        *timing = (presc << I2C_TIMINGR_PRESC_SHIFT)
+                | ((uint32_t) scldel << I2C_TIMINGR_SCLDEL_SHIFT)
+                | ((uint32_t) sdadel << I2C_TIMINGR_SDADEL_SHIFT)
+                | ((uint32_t) (high - 1) << I2C_TIMINGR_SCLH_SHIFT)
+                | ((uint32_t) (low - 1) << I2C_TIMINGR_SCLL_SHIFT);
+        return true;
+    }
+
+    // The kernel clock is too fast even with the maximum prescaler.
+    return false;
+}
+
+bool I2cTiming::SetBusSpeed(I2C_HandleTypeDef *hi2c, unsigned int bus_speed)
+{
+    MURASAKI_ASSERT(nullptr != hi2c)
+
+    if (!ApplyTiming(hi2c, GetKernelClock(hi2c), bus_speed))
+        return false;
+
+    StoreBusSpeed(hi2c, bus_speed);
+    return true;
+}
+
+bool I2cTiming::Retime(I2C_HandleTypeDef *hi2c)
+{
+    return ApplyTiming(hi2c, GetKernelClock(hi2c), GetBusSpeed(hi2c));
+}
+
+unsigned int I2cTiming::GetBusSpeed(I2C_HandleTypeDef *hi2c)
+{
+    for (unsigned int i = 0; i < kMaxHandles; i++)
+        if (handles_[i] == hi2c)
+            return bus_speeds_[i];
+
+    // CubeIDE configuration of this project.
+    return kibsStandard;
+}
+
+bool I2cTiming::ApplyTiming(I2C_HandleTypeDef *hi2c, unsigned int kernel_clock, unsigned int bus_speed)
+{
+#if defined(I2C_CCR_CCR)
+    // STM32F4 / L1 I2C. Fast mode plus is not supported.
+    const unsigned int freq_mhz = kernel_clock / 1000000;
+    uint32_t ccr;
+    uint32_t trise;
+
+    if (bus_speed == 0 || bus_speed > kibsFast || freq_mhz < 2 || freq_mhz > 50)
+        return false;
+
+    if (bus_speed <= kibsStandard) {
+        // Tlow = Thigh = CCR * Tpclk1
+        ccr = (kernel_clock + 2 * bus_speed - 1) / (2 * bus_speed);
+        if (ccr < 4)
+            ccr = 4;
+        if (ccr > I2C_CCR_CCR)
+            return false;
+        trise = freq_mhz + 1;             // 1000nS
+    }
+    else {
+        // Tlow = 16 * CCR * Tpclk1, Thigh = 9 * CCR * Tpclk1
+        ccr = (kernel_clock + 25 * bus_speed - 1) / (25 * bus_speed);
+        if (ccr < 1)
+            ccr = 1;
+        if (ccr > I2C_CCR_CCR)
+            return false;
+        ccr |= I2C_CCR_FS | I2C_CCR_DUTY;
+        trise = freq_mhz * 300 / 1000 + 1;  // 300nS
+    }
+    __HAL_I2C_DISABLE(hi2c);
+    MODIFY_REG(hi2c->Instance->CR2, I2C_CR2_FREQ, freq_mhz);
+    hi2c->Instance->TRISE = trise;
+    hi2c->Instance->CCR = ccr;
+    __HAL_I2C_ENABLE(hi2c);
+
+    // Keep the HAL handle consistent with the hardware.
+    hi2c->Init.ClockSpeed = bus_speed;
+    hi2c->Init.DutyCycle = (bus_speed <= kibsStandard) ? I2C_DUTYCYCLE_2 : I2C_DUTYCYCLE_16_9;
+    return true;
+#else
+    uint32_t timing;
+
+    if (!ComputeTimingRegister(kernel_clock, bus_speed, &timing))
+        return false;
+
+    // The Fast mode plus needs the stronger drive of the I/O pins.
+#if defined(I2C_FASTMODEPLUS_I2C1)
+    if (hi2c->Instance == I2C1) {
+        if (bus_speed > kibsFast)
+            HAL_I2CEx_EnableFastModePlus(I2C_FASTMODEPLUS_I2C1);
+        else
+            HAL_I2CEx_DisableFastModePlus(I2C_FASTMODEPLUS_I2C1);
+    }
+#elif defined(I2C_FASTMODEPLUS_ENABLE)
+    HAL_I2CEx_ConfigFastModePlus(hi2c, (bus_speed > kibsFast) ? I2C_FASTMODEPLUS_ENABLE : I2C_FASTMODEPLUS_DISABLE);
+#endif
+
+    // TIMINGR is writable only while PE = 0.
+    __HAL_I2C_DISABLE(hi2c);
+    hi2c->Instance->TIMINGR = timing;
+    __HAL_I2C_ENABLE(hi2c);
+
+    // Keep the HAL handle consistent with the hardware.
+    hi2c->Init.Timing = timing;
+    return true;
+#endif
+}
+
+void I2cTiming::StoreBusSpeed(I2C_HandleTypeDef *hi2c, unsigned int bus_speed)
+{
+    for (unsigned int i = 0; i < kMaxHandles; i++)
+        if (handles_[i] == hi2c || handles_[i] == nullptr) {
+            handles_[i] = hi2c;
+            bus_speeds_[i] = bus_speed;
+            return;
+        }
+
+    MURASAKI_ASSERT(false)  // Too many handles.
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,480 @@
+/**
+ * @file rtosbenchmark.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Micro benchmark of the RTOS primitives and the murasaki classes.
+ */
+
+#include "rtosbenchmark.hpp"
+#include "busio.hpp"
+#include "callbackdispatcher.hpp"
+#include "cyclecounter.hpp"
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+
+#include <cstdio>
+
+// Stack size of the context switch partner task [word].
+#define SWITCH_TASK_STACK_SIZE 128
+
+// Size of the memory block to allocate [byte].
+#define ALLOCATION_SIZE 32
+
+// Maximum number of the I2C instances in the dispatch benchmark.
+#define DISPATCH_INSTANCES 4
+
+// Size of the image in the checksum benchmark [byte].
+#define CRC_IMAGE_SIZE 4096
+// Size of the short frame in the checksum benchmark [byte]. As the record of the FramedConsole.
+#define CRC_FRAME_SIZE 16
+
+namespace {
+
+// I2C master which only counts the callbacks. Answers only to its own handle, as the murasaki classes do.
+class DispatchProbe : public murasaki::I2cMasterStrategy
+{
+ public:
+    DispatchProbe(I2C_HandleTypeDef *handle)
+            :
+            handle_(handle),
+            count_(0)
+    {
+    }
+
+    virtual murasaki::I2cStatus Transmit(unsigned int, const uint8_t*, unsigned int, unsigned int*, unsigned int)
+    {
+        return murasaki::ki2csOK;
+    }
+    virtual murasaki::I2cStatus Receive(unsigned int, uint8_t*, unsigned int, unsigned int*, unsigned int)
+    {
+        return murasaki::ki2csOK;
+    }
+    virtual murasaki::I2cStatus TransmitThenReceive(unsigned int, const uint8_t*, unsigned int, uint8_t*, unsigned int,
+                                                    unsigned int*, unsigned int*, unsigned int)
+    {
+        return murasaki::ki2csOK;
+    }
+    virtual bool TransmitCompleteCallback(void *ptr)
+    {
+        return Count(ptr);
+    }
+    virtual bool ReceiveCompleteCallback(void *ptr)
+    {
+        return Count(ptr);
+    }
+    virtual bool HandleError(void *ptr)
+    {
+        return Count(ptr);
+    }
+
+ private:
+    bool Count(void *ptr)
+    {
+        if (handle_ != ptr)
+            return false;
+        count_ = count_ + 1;
+        return true;
+    }
+    virtual void* GetPeripheralHandle()
+    {
+        return handle_;
+    }
+
+    I2C_HandleTypeDef *const handle_;
+    volatile unsigned int count_;
+};
+
+} /* namespace */
+
+namespace murasaki {
+
+RtosBenchmark::RtosBenchmark(const char *board, BitOutStrategy *led, unsigned int iterations)
+        :
+        board_(board),
+        led_(led),
+        iterations_(iterations),
+        overhead_(0),
+        min_(0),
+        max_(0),
+        sum_(0),
+        count_(0),
+        caller_(nullptr),
+        switch_task_(nullptr),
+        switched_(0),
+        allocated_(nullptr),
+        read_value_(0)
+{
+    MURASAKI_ASSERT(nullptr != board)
+    MURASAKI_ASSERT(0 < iterations)
+}
+
+RtosBenchmark::~RtosBenchmark()
+{
+}
+
+void RtosBenchmark::Begin()
+{
+    min_ = UINT32_MAX;
+    max_ = 0;
+    sum_ = 0;
+    count_ = 0;
+}
+
+void RtosBenchmark::Sample(uint32_t start, uint32_t end)
+{
+    uint32_t cycles = end - start;
+
+    cycles = (cycles > overhead_) ? cycles - overhead_ : 0;
+    if (cycles < min_)
+        min_ = cycles;
+    if (cycles > max_)
+        max_ = cycles;
+    sum_ += cycles;
+    count_++;
+}
+
+void RtosBenchmark::Report(const char *name)
+{
+    murasaki::debugger->Printf("%s,%u,%s,%u,%u,%u,%u\n",
+                               board_,
+                               static_cast<unsigned int>(SystemCoreClock),
+                               name,
+                               count_,
+                               static_cast<unsigned int>(min_),
+                               static_cast<unsigned int>(sum_ / count_),
+                               static_cast<unsigned int>(max_));
+}
+
+// Cost of reading the counter. Subtracted from all samples.
+void RtosBenchmark::MeasureOverhead()
+{
+    uint32_t start;
+
+    overhead_ = 0;
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        Sample(start, CycleCounter::Get());
+    }
+    overhead_ = min_;
+}
+
+void RtosBenchmark::SwitchTaskBody(void *ptr)
+{
+    RtosBenchmark *const this_ptr = static_cast<RtosBenchmark*>(ptr);
+
+    while (true) {
+        ::ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        this_ptr->switched_ = CycleCounter::Get();
+        ::xTaskNotifyGive(this_ptr->caller_);
+    }
+}
+
+void RtosBenchmark::Run()
+{
+    SemaphoreHandle_t semaphore = ::xSemaphoreCreateBinary();
+    QueueHandle_t queue = ::xQueueCreate(1, sizeof(uint32_t));
+    uint32_t item = 0;
+    uint32_t start;
+
+    MURASAKI_ASSERT(nullptr != semaphore)
+    MURASAKI_ASSERT(nullptr != queue)
+
+    CycleCounter::Init();
+    caller_ = ::xTaskGetCurrentTaskHandle();
+    ::xTaskCreate(SwitchTaskBody,
+                  "bench",
+                  SWITCH_TASK_STACK_SIZE,
+                  this,
+                  ::uxTaskPriorityGet(nullptr) + 1,
+                  &switch_task_);
+    MURASAKI_ASSERT(nullptr != switch_task_)
+
+    MeasureOverhead();
+
+    murasaki::debugger->Printf("board,clock_hz,benchmark,iterations,min_cycles,avg_cycles,max_cycles\n");
+
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        ::xTaskNotifyGive(switch_task_);        // Preempted here.
+        ::ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        Sample(start, switched_);
+    }
+    Report("context_switch");
+
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        ::xSemaphoreGive(semaphore);
+        ::xSemaphoreTake(semaphore, 0);
+        Sample(start, CycleCounter::Get());
+    }
+    Report("semaphore_give_take");
+
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        ::xQueueSend(queue, &item, 0);
+        ::xQueueReceive(queue, &item, 0);
+        Sample(start, CycleCounter::Get());
+    }
+    Report("queue_send_receive");
+
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        ::xTaskNotifyGive(caller_);
+        ::ulTaskNotifyTake(pdTRUE, 0);
+        Sample(start, CycleCounter::Get());
+    }
+    Report("task_notify");
+
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        murasaki::Sleep(0);
+        Sample(start, CycleCounter::Get());
+    }
+    Report("sleep_0");
+
+    if (nullptr != led_) {
+        Begin();
+        for (unsigned int i = 0; i < iterations_; i++) {
+            start = CycleCounter::Get();
+            led_->Toggle();
+            Sample(start, CycleCounter::Get());
+        }
+        Report("bitout_toggle");
+    }
+
+    // The FIFO of the debugger is filled by the comment lines. Measure before printing the result.
+    Begin();
+    for (unsigned int i = 0; i < kPrintfIterations; i++) {
+        start = CycleCounter::Get();
+        murasaki::debugger->Printf("# printf\n");
+        Sample(start, CycleCounter::Get());
+    }
+    Report("debugger_printf");
+
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        allocated_ = new uint8_t[ALLOCATION_SIZE];
+        delete[] static_cast<uint8_t*>(allocated_);
+        Sample(start, CycleCounter::Get());
+    }
+    Report("new_delete");
+
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        allocated_ = ::pvPortMalloc(ALLOCATION_SIZE);
+        ::vPortFree(allocated_);
+        Sample(start, CycleCounter::Get());
+    }
+    Report("malloc_free");
+
+    murasaki::debugger->Printf("# end of benchmark\n");
+
+    ::vTaskDelete(switch_task_);
+    switch_task_ = nullptr;
+    ::vQueueDelete(queue);
+    ::vSemaphoreDelete(semaphore);
+}
+
+void RtosBenchmark::RunBus(GPIO_TypeDef *port, uint16_t pins)
+{
+    BusPin bus_pins[BUS_MAX_PINS];
+    BitOut *bits[BUS_MAX_PINS];
+    unsigned int width = 0;
+    char name[32];
+    uint32_t start;
+
+    MURASAKI_ASSERT(nullptr != port)
+    MURASAKI_ASSERT(0 != pins)
+
+    for (unsigned int pin = 0; pin < 16; pin++)
+        if (pins & (1u << pin)) {
+            bus_pins[width].port = port;
+            bus_pins[width].pin = 1u << pin;
+            bits[width] = new BitOut(port, 1u << pin);
+            MURASAKI_ASSERT(nullptr != bits[width])
+            width++;
+        }
+
+    BusOut *bus_out = new BusOut(bus_pins, width);
+    BusIn *bus_in = new BusIn(bus_pins, width);
+    MURASAKI_ASSERT(nullptr != bus_out)
+    MURASAKI_ASSERT(nullptr != bus_in)
+
+    CycleCounter::Init();
+    MeasureOverhead();
+
+    // The same value sequence for both.
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        for (unsigned int bit = 0; bit < width; bit++)
+            bits[bit]->Set((i >> bit) & 1);
+        Sample(start, CycleCounter::Get());
+    }
+    ::snprintf(name, sizeof(name), "bitout_write_x%u", width);
+    Report(name);
+
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        bus_out->Write(i);
+        Sample(start, CycleCounter::Get());
+    }
+    ::snprintf(name, sizeof(name), "busout_write_%u", width);
+    Report(name);
+
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        read_value_ = bus_in->Read();
+        Sample(start, CycleCounter::Get());
+    }
+    ::snprintf(name, sizeof(name), "busin_read_%u", width);
+    Report(name);
+
+    murasaki::debugger->Printf("# end of bus benchmark\n");
+
+    delete bus_in;
+    delete bus_out;
+    for (unsigned int bit = 0; bit < width; bit++)
+        delete bits[bit];
+}
+
+void RtosBenchmark::RunDispatch()
+{
+    // Zero cleared. The registration needs the ready state.
+    I2C_HandleTypeDef *handles = new I2C_HandleTypeDef[DISPATCH_INSTANCES]();
+    DispatchProbe *probes[DISPATCH_INSTANCES];
+    char name[32];
+    uint32_t start;
+
+    MURASAKI_ASSERT(nullptr != handles)
+    for (unsigned int i = 0; i < DISPATCH_INSTANCES; i++) {
+        handles[i].State = HAL_I2C_STATE_READY;
+        probes[i] = new DispatchProbe(&handles[i]);
+        MURASAKI_ASSERT(nullptr != probes[i])
+    }
+
+    CycleCounter::Init();
+    MeasureOverhead();
+
+    for (unsigned int instances = 1; instances <= DISPATCH_INSTANCES; instances *= DISPATCH_INSTANCES) {
+        I2C_HandleTypeDef *const target = &handles[instances - 1];
+
+        Begin();
+        for (unsigned int i = 0; i < iterations_; i++) {
+            start = CycleCounter::Get();
+            for (unsigned int probe = 0; probe < instances; probe++)
+                if (probes[probe]->TransmitCompleteCallback(target))
+                    break;
+            Sample(start, CycleCounter::Get());
+        }
+        ::snprintf(name, sizeof(name), "i2c_callback_search_%u", instances);
+        Report(name);
+
+        bool registered = true;
+        for (unsigned int probe = 0; probe < instances; probe++)
+            registered = CallbackDispatcher::Register(&handles[probe], probes[probe]) && registered;
+        if (!registered) {
+            murasaki::debugger->Printf("# registered callbacks are disabled\n");
+            continue;
+        }
+
+#if (USE_HAL_I2C_REGISTER_CALLBACKS == 1)
+        Begin();
+        for (unsigned int i = 0; i < iterations_; i++) {
+            start = CycleCounter::Get();
+            target->MasterTxCpltCallback(target);      // As the ISR of the HAL does.
+            Sample(start, CycleCounter::Get());
+        }
+        ::snprintf(name, sizeof(name), "i2c_callback_registered_%u", instances);
+        Report(name);
+#endif
+    }
+
+    murasaki::debugger->Printf("# end of dispatch benchmark\n");
+
+    for (unsigned int i = 0; i < DISPATCH_INSTANCES; i++) {
+        CallbackDispatcher::Unregister(&handles[i]);
+        delete probes[i];
+    }
+    delete[] handles;
+}
+
+void RtosBenchmark::MeasureCrc(const char *name, CrcService *service, bool crc16, const uint8_t *data,
+                               unsigned int size)
+{
+    const uint32_t expected = crc16 ? CrcService::SoftwareCrc16(data, size) : CrcService::SoftwareCrc32(data, size);
+    uint32_t result = expected;
+    char row[32];
+    uint32_t start;
+
+    Begin();
+    for (unsigned int i = 0; i < iterations_; i++) {
+        start = CycleCounter::Get();
+        if (nullptr == service)
+            result = crc16 ? CrcService::SoftwareCrc16(data, size) : CrcService::SoftwareCrc32(data, size);
+        else
+            result = crc16 ? service->Crc16(data, size) : service->Crc32(data, size);
+        Sample(start, CycleCounter::Get());
+    }
+    ::snprintf(row, sizeof(row), "%s_%u", name, size);
+    Report(row);
+
+    if (result != expected)
+        murasaki::debugger->Printf("# %s : 0x%08x, expected 0x%08x\n",
+                                   row,
+                                   static_cast<unsigned int>(result),
+                                   static_cast<unsigned int>(expected));
+}
+
+void RtosBenchmark::RunCrc(CrcDmaChannel *dma)
+{
+    uint8_t *image = new uint8_t[CRC_IMAGE_SIZE];
+    CrcService *cpu = new CrcService();
+    CrcService *fed = new CrcService(dma, 0);       // DMA at any size.
+
+    MURASAKI_ASSERT(nullptr != image)
+    MURASAKI_ASSERT(nullptr != cpu)
+    MURASAKI_ASSERT(nullptr != fed)
+
+    for (unsigned int i = 0; i < CRC_IMAGE_SIZE; i++)
+        image[i] = i * 7 + (i >> 8);
+
+    CycleCounter::Init();
+    MeasureOverhead();
+
+    MeasureCrc("crc32_software", nullptr, false, image, CRC_IMAGE_SIZE);
+    MeasureCrc("crc32_hardware", cpu, false, image, CRC_IMAGE_SIZE);
+    if (fed->IsDmaEnabled())
+        MeasureCrc("crc32_dma", fed, false, image, CRC_IMAGE_SIZE);
+    MeasureCrc("crc32_software", nullptr, false, image, CRC_FRAME_SIZE);
+    MeasureCrc("crc32_hardware", cpu, false, image, CRC_FRAME_SIZE);
+
+    if (!CrcService::IsProgrammable())
+        murasaki::debugger->Printf("# the CRC unit has the fixed polynomial. crc16_hardware is the software\n");
+    MeasureCrc("crc16_software", nullptr, true, image, CRC_IMAGE_SIZE);
+    MeasureCrc("crc16_hardware", cpu, true, image, CRC_IMAGE_SIZE);
+    MeasureCrc("crc16_software", nullptr, true, image, CRC_FRAME_SIZE);
+    MeasureCrc("crc16_hardware", cpu, true, image, CRC_FRAME_SIZE);
+
+    murasaki::debugger->Printf("# end of crc benchmark\n");
+
+    delete fed;
+    delete cpu;
+    delete[] image;
+}
+
+} /* namespace murasaki */
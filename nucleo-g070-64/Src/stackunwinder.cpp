@@ -0,0 +1,91 @@
+/**
+ * @file stackunwinder.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Heuristic call chain unwinder for the fault and assert reports.
+ */
+
+#include "stackunwinder.hpp"
+
+#include <cstdio>
+
+// Symbols of the startup code and the linker script.
+extern "C" const uint32_t g_pfnVectors[];       // Start of the flash code area.
+extern "C" const uint32_t _etext[];             // End of the code.
+extern "C" uint32_t _sdata[];                   // Start of the RAM used by the program.
+extern "C" uint32_t _estack[];                  // End of the RAM.
+
+namespace murasaki {
+
+bool StackUnwinder::IsReturnAddress(uint32_t address)
+{
+    // Thumb state.
+    if (0 == (address & 1))
+        return false;
+
+    // Address of the instruction after the call. The call is 2 or 4 byte before.
+    const uint32_t next = address & ~1u;
+    if (next < reinterpret_cast<uintptr_t>(g_pfnVectors) + 4 || next > reinterpret_cast<uintptr_t>(_etext))
+        return false;
+
+    const uint16_t *const code = reinterpret_cast<const uint16_t*>(next);
+
+    // BLX Rm : 0100 0111 1xxx x000
+    if (0x4780 == (code[-1] & 0xFF87))
+        return true;
+
+    // BL <label> : 1111 0xxx xxxx xxxx, 11x1 xxxx xxxx xxxx
+    if (0xF000 == (code[-2] & 0xF800) && 0xD000 == (code[-1] & 0xD000))
+        return true;
+
+    return false;
+}
+
+bool StackUnwinder::IsStackAddress(const void *address, unsigned int size)
+{
+    const uintptr_t start = reinterpret_cast<uintptr_t>(address);
+
+    return (0 == (start & 3))
+            && start >= reinterpret_cast<uintptr_t>(_sdata)
+            && start + size <= reinterpret_cast<uintptr_t>(_estack);
+}
+
+unsigned int StackUnwinder::Unwind(const uint32_t *stack_pointer, uint32_t *chain, unsigned int depth)
+{
+    unsigned int count = 0;
+
+    MURASAKI_ASSERT(nullptr != chain)
+
+    if (!IsStackAddress(stack_pointer, sizeof(uint32_t)))
+        return 0;
+
+    for (unsigned int i = 0; i < kScanWords && count < depth; i++) {
+        if (!IsStackAddress(&stack_pointer[i], sizeof(uint32_t)))
+            break;
+        if (IsReturnAddress(stack_pointer[i]))
+            chain[count++] = stack_pointer[i];
+    }
+    return count;
+}
+
+unsigned int StackUnwinder::Here(uint32_t *chain, unsigned int depth)
+{
+    // The local variable is at the top of the stack.
+    uint32_t marker = 0;
+
+    return Unwind(&marker, chain, depth);
+}
+
+void StackUnwinder::Print(const uint32_t *chain, unsigned int count)
+{
+    char line[128];
+    unsigned int length;
+
+    length = ::snprintf(line, sizeof(line), "Call chain :");
+    for (unsigned int i = 0; i < count && length < sizeof(line) - 12; i++)
+        length += ::snprintf(&line[length], sizeof(line) - length, " 0x%08x", static_cast<unsigned int>(chain[i]));
+    murasaki::debugger->Printf("%s\n", line);
+}
+
+} /* namespace murasaki */
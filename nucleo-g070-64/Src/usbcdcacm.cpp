@@ -0,0 +1,638 @@
+/**
+ * @file usbcdcacm.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief USB CDC-ACM virtual COM port as the console.
+ */
+
+#include "usbcdcacm.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef HAL_PCD_MODULE_ENABLED
+
+// The FIFO allocation below is for the OTG. The registered callbacks carry the events to the object.
+#if defined(USB_OTG_FS) && (USE_HAL_PCD_REGISTER_CALLBACKS == 1)
+#define USB_CDC_ACM_SUPPORTED 1
+#else
+#define USB_CDC_ACM_SUPPORTED 0
+#endif
+
+// Endpoint addresses. Must match the configuration descriptor.
+#define EP_CONTROL_OUT 0x00
+#define EP_CONTROL_IN 0x80
+#define EP_DATA_OUT 0x01
+#define EP_DATA_IN 0x81
+#define EP_NOTIFICATION 0x82
+#define EP_NOTIFICATION_SIZE 8
+
+// Size of the FIFO RAM of the OTG FS [word]. 320 words on the F7. The H7 has more.
+// The Rx FIFO is shared by all OUT endpoints. The Tx FIFO 1 holds 8 packets of the bulk IN.
+#define FIFO_RX 0x80
+#define FIFO_TX_CONTROL 0x20
+#define FIFO_TX_DATA 0x80
+#define FIFO_TX_NOTIFICATION 0x10
+
+// Standard requests. USB 2.0 Table 9-4.
+#define REQUEST_GET_STATUS 0x00
+#define REQUEST_CLEAR_FEATURE 0x01
+#define REQUEST_SET_FEATURE 0x03
+#define REQUEST_SET_ADDRESS 0x05
+#define REQUEST_GET_DESCRIPTOR 0x06
+#define REQUEST_GET_CONFIGURATION 0x08
+#define REQUEST_SET_CONFIGURATION 0x09
+#define REQUEST_GET_INTERFACE 0x0A
+#define REQUEST_SET_INTERFACE 0x0B
+// CDC PSTN requests. PSTN 1.2 Table 13.
+#define REQUEST_SET_LINE_CODING 0x20
+#define REQUEST_GET_LINE_CODING 0x21
+#define REQUEST_SET_CONTROL_LINE_STATE 0x22
+#define REQUEST_SEND_BREAK 0x23
+
+#define FEATURE_ENDPOINT_HALT 0
+
+static const uint8_t kDeviceDescriptor[] = {
+        18, 0x01,                           // Device.
+        0x00, 0x02,                         // USB 2.0.
+        0x02, 0x02, 0x00,                   // CDC, ACM.
+        USB_CDC_ACM_PACKET_SIZE,            // EP0.
+        USB_CDC_ACM_VID & 0xFF, USB_CDC_ACM_VID >> 8,
+        USB_CDC_ACM_PID & 0xFF, USB_CDC_ACM_PID >> 8,
+        0x00, 0x02,                         // Release 2.00.
+        1, 2, 3,                            // Manufacturer, product, serial number.
+        1                                   // Configurations.
+};
+
+static const uint8_t kConfigurationDescriptor[] = {
+        9, 0x02, 67, 0,                     // Configuration, total length.
+        2, 1, 0,                            // Interfaces, value, no string.
+        0xC0, 50,                           // Self powered, 100mA.
+        // Communication class interface.
+        9, 0x04, 0, 0, 1, 0x02, 0x02, 0x01, 0,
+        5, 0x24, 0x00, 0x10, 0x01,          // Header, CDC 1.10.
+        5, 0x24, 0x01, 0x00, 1,             // Call management, data interface 1.
+        4, 0x24, 0x02, 0x02,                // ACM, line coding and line state.
+        5, 0x24, 0x06, 0, 1,                // Union, 0 controls 1.
+        7, 0x05, EP_NOTIFICATION, 0x03, EP_NOTIFICATION_SIZE, 0, 16,
+        // Data class interface.
+        9, 0x04, 1, 0, 2, 0x0A, 0x00, 0x00, 0,
+        7, 0x05, EP_DATA_OUT, 0x02, USB_CDC_ACM_PACKET_SIZE, 0, 0,
+        7, 0x05, EP_DATA_IN, 0x02, USB_CDC_ACM_PACKET_SIZE, 0, 0
+};
+static_assert(sizeof(kConfigurationDescriptor) == 67, "Total length of the configuration descriptor is wrong.");
+
+// Language ID, English (United States).
+static const uint8_t kLanguageDescriptor[] = { 4, 0x03, 0x09, 0x04 };
+static const char kManufacturer[] = "Murasaki";
+static const char kProduct[] = "Murasaki Console";
+
+namespace murasaki {
+
+UsbCdcAcm *UsbCdcAcm::instance_ = nullptr;
+
+UsbCdcAcm::UsbCdcAcm(PCD_HandleTypeDef *hpcd)
+        :
+        hpcd_(hpcd),
+        control_state_(kcsIdle),
+        control_data_(nullptr),
+        control_remaining_(0),
+        control_zlp_(false),
+        control_request_(0),
+        line_coding_ { 0x00, 0xC2, 0x01, 0x00, 0, 0, 8 },  // 115200, 8N1.
+        configuration_(0),
+        dtr_(false),
+        tx_length_ { 0, 0 },
+        tx_fill_(0),
+        tx_busy_(false),
+        tx_last_length_(0),
+        rx_length_ { 0, 0 },
+        rx_armed_(0),
+        rx_busy_(false),
+        rx_read_(0),
+        rx_position_(0)
+{
+    MURASAKI_ASSERT(nullptr != hpcd)
+
+    tx_critical_section_ = new CriticalSection();
+    MURASAKI_ASSERT(nullptr != tx_critical_section_)
+    rx_critical_section_ = new CriticalSection();
+    MURASAKI_ASSERT(nullptr != rx_critical_section_)
+    tx_sync_ = new Synchronizer();
+    MURASAKI_ASSERT(nullptr != tx_sync_)
+    rx_sync_ = new Synchronizer();
+    MURASAKI_ASSERT(nullptr != rx_sync_)
+}
+
+bool UsbCdcAcm::Start()
+{
+    MURASAKI_ASSERT(nullptr == instance_)
+
+#if USB_CDC_ACM_SUPPORTED
+    instance_ = this;
+
+    // The HAL calls them in the OTG_FS interrupt.
+    if (HAL_OK != HAL_PCD_RegisterCallback(hpcd_, HAL_PCD_SETUPSTAGE_CB_ID, &UsbCdcAcm::SetupStageCallback)
+            || HAL_OK != HAL_PCD_RegisterCallback(hpcd_, HAL_PCD_RESET_CB_ID, &UsbCdcAcm::ResetCallback)
+            || HAL_OK != HAL_PCD_RegisterCallback(hpcd_, HAL_PCD_DISCONNECT_CB_ID, &UsbCdcAcm::DisconnectCallback)
+            || HAL_OK != HAL_PCD_RegisterDataOutStageCallback(hpcd_, &UsbCdcAcm::DataOutStageCallback)
+            || HAL_OK != HAL_PCD_RegisterDataInStageCallback(hpcd_, &UsbCdcAcm::DataInStageCallback))
+        return false;
+
+    HAL_PCDEx_SetRxFiFo(hpcd_, FIFO_RX);
+    HAL_PCDEx_SetTxFiFo(hpcd_, EP_CONTROL_IN & 0x7F, FIFO_TX_CONTROL);
+    HAL_PCDEx_SetTxFiFo(hpcd_, EP_DATA_IN & 0x7F, FIFO_TX_DATA);
+    HAL_PCDEx_SetTxFiFo(hpcd_, EP_NOTIFICATION & 0x7F, FIFO_TX_NOTIFICATION);
+
+    // Pull up the D+. The host starts the enumeration.
+    return HAL_OK == HAL_PCD_Start(hpcd_);
+#else
+    return false;
+#endif
+}
+
+UartStatus UsbCdcAcm::Transmit(const uint8_t *data, unsigned int size, WaitMilliSeconds timeout_ms)
+{
+    UartStatus status = kursOK;
+    unsigned int sent = 0;
+
+    tx_critical_section_->Enter();
+    while (sent < size) {
+        taskENTER_CRITICAL();
+        const bool open = IsOpen();
+        const unsigned int index = tx_fill_;
+        const unsigned int offset = tx_length_[index];
+        taskEXIT_CRITICAL();
+
+        const unsigned int length = std::min(USB_CDC_ACM_TX_BUFFER_SIZE - offset, size - sent);
+
+        if (!open || 0 == length) {
+            // Wait for the terminal, or for the end of the transfer in flight.
+            if (!tx_sync_->Wait(timeout_ms)) {
+                status = kursTimeOut;
+                break;
+            }
+            continue;
+        }
+
+        // Out of the critical section. The interrupt doesn't touch the data of the filling buffer.
+        std::memcpy(&tx_buffers_[index][offset], data + sent, length);
+
+        taskENTER_CRITICAL();
+        // The interrupt may have started this buffer, or the bus reset may have dropped it. Then, copy again.
+        if (index == tx_fill_ && offset == tx_length_[index]) {
+            tx_length_[index] = offset + length;
+            sent += length;
+            if (!tx_busy_)
+                StartTransmit();
+        }
+        taskEXIT_CRITICAL();
+    }
+    tx_critical_section_->Leave();
+
+    return status;
+}
+
+UartStatus UsbCdcAcm::Receive(
+                              uint8_t *data,
+                              unsigned int count,
+                              unsigned int *transfered_count,
+                              UartTimeout uart_timeout,
+                              WaitMilliSeconds timeout_ms)
+{
+    UartStatus status = kursOK;
+    unsigned int received = 0;
+
+    rx_critical_section_->Enter();
+    while (received < count) {
+        // A packet is 64 bytes at most. Copy it in the critical section.
+        taskENTER_CRITICAL();
+        const unsigned int length = rx_length_[rx_read_];
+        if (0 != length) {
+            const unsigned int copy = std::min(length - rx_position_, count - received);
+
+            std::memcpy(data + received, &rx_buffers_[rx_read_][rx_position_], copy);
+            received += copy;
+            rx_position_ += copy;
+            if (rx_position_ == length) {
+                // Give the buffer back to the USB.
+                rx_length_[rx_read_] = 0;
+                rx_position_ = 0;
+                if (!rx_busy_ && 0 != configuration_)
+                    ArmReceive(rx_read_);
+                rx_read_ ^= 1;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if (0 != length)
+            continue;
+        if (kutIdleTimeout == uart_timeout && 0 < received)
+            break;
+        if (!rx_sync_->Wait(timeout_ms)) {
+            status = kursTimeOut;
+            break;
+        }
+    }
+    rx_critical_section_->Leave();
+
+    if (nullptr != transfered_count)
+        *transfered_count = received;
+    return status;
+}
+
+bool UsbCdcAcm::TransmitCompleteCallback(void *ptr)
+{
+    return false;
+}
+
+bool UsbCdcAcm::ReceiveCompleteCallback(void *ptr)
+{
+    return false;
+}
+
+bool UsbCdcAcm::HandleError(void *ptr)
+{
+    return false;
+}
+
+bool UsbCdcAcm::IsOpen() const
+{
+    return 0 != configuration_ && dtr_;
+}
+
+unsigned int UsbCdcAcm::GetLineCodingBaudRate() const
+{
+    return line_coding_[0] | (line_coding_[1] << 8) | (line_coding_[2] << 16) | (line_coding_[3] << 24);
+}
+
+void* UsbCdcAcm::GetPeripheralHandle()
+{
+    return hpcd_;
+}
+
+void UsbCdcAcm::SetupStageCallback(PCD_HandleTypeDef *hpcd)
+{
+    instance_->OnSetup(reinterpret_cast<const uint8_t*>(hpcd->Setup));
+}
+
+void UsbCdcAcm::ResetCallback(PCD_HandleTypeDef *hpcd)
+{
+    instance_->OnReset();
+}
+
+void UsbCdcAcm::DisconnectCallback(PCD_HandleTypeDef *hpcd)
+{
+    instance_->configuration_ = 0;
+    instance_->dtr_ = false;
+    instance_->tx_sync_->Release();
+}
+
+void UsbCdcAcm::DataOutStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum)
+{
+    if (0 == epnum)
+        instance_->OnControlOut();
+    else if ((EP_DATA_OUT & 0x7F) == epnum)
+        instance_->OnBulkOut();
+}
+
+void UsbCdcAcm::DataInStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum)
+{
+    if (0 == epnum)
+        instance_->OnControlIn();
+    else if ((EP_DATA_IN & 0x7F) == epnum)
+        instance_->OnBulkIn();
+}
+
+void UsbCdcAcm::OnSetup(const uint8_t *setup)
+{
+    bool handled;
+
+    // A new SETUP aborts the control transfer in progress.
+    control_state_ = kcsIdle;
+
+    switch (setup[0] & 0x60) {
+        case 0x00:
+            handled = OnStandardRequest(setup);
+            break;
+        case 0x20:
+            handled = OnClassRequest(setup);
+            break;
+        default:
+            handled = false;
+            break;
+    }
+
+    if (!handled)
+        StallControl();
+}
+
+void UsbCdcAcm::OnReset()
+{
+    // The endpoints are closed by the reset. Drop the data in flight.
+    HAL_PCD_EP_Open(hpcd_, EP_CONTROL_OUT, USB_CDC_ACM_PACKET_SIZE, EP_TYPE_CTRL);
+    HAL_PCD_EP_Open(hpcd_, EP_CONTROL_IN, USB_CDC_ACM_PACKET_SIZE, EP_TYPE_CTRL);
+
+    control_state_ = kcsIdle;
+    configuration_ = 0;
+    dtr_ = false;
+    tx_length_[0] = tx_length_[1] = 0;
+    tx_busy_ = false;
+    tx_last_length_ = 0;
+    rx_length_[0] = rx_length_[1] = 0;
+    rx_busy_ = false;
+    rx_read_ = 0;
+    rx_position_ = 0;
+
+    tx_sync_->Release();
+}
+
+void UsbCdcAcm::OnControlOut()
+{
+    if (kcsDataOut == control_state_) {
+        if (REQUEST_SET_LINE_CODING == control_request_)
+            std::memcpy(line_coding_, control_buffer_, sizeof(line_coding_));
+        SendStatus();
+    }
+    else if (kcsStatusOut == control_state_)
+        control_state_ = kcsIdle;
+}
+
+void UsbCdcAcm::OnControlIn()
+{
+    if (kcsDataIn == control_state_) {
+        if (0 < control_remaining_) {
+            const unsigned int length = std::min(control_remaining_, (unsigned int) USB_CDC_ACM_PACKET_SIZE);
+
+            HAL_PCD_EP_Transmit(hpcd_, EP_CONTROL_IN, const_cast<uint8_t*>(control_data_), length);
+            control_data_ += length;
+            control_remaining_ -= length;
+        }
+        else if (control_zlp_) {
+            // Shorter than the request, and the multiple of the packet.
+            control_zlp_ = false;
+            HAL_PCD_EP_Transmit(hpcd_, EP_CONTROL_IN, nullptr, 0);
+        }
+        else {
+            control_state_ = kcsStatusOut;
+            HAL_PCD_EP_Receive(hpcd_, EP_CONTROL_OUT, nullptr, 0);
+        }
+    }
+    else if (kcsStatusIn == control_state_)
+        control_state_ = kcsIdle;
+}
+
+void UsbCdcAcm::OnBulkOut()
+{
+    const unsigned int count = HAL_PCD_EP_GetRxCount(hpcd_, EP_DATA_OUT);
+    const unsigned int index = rx_armed_;
+
+    rx_busy_ = false;
+    if (0 == count) {
+        ArmReceive(index);
+        return;
+    }
+
+    // Receive the next packet to the other buffer, if the task has read it.
+    rx_length_[index] = count;
+    if (0 == rx_length_[index ^ 1])
+        ArmReceive(index ^ 1);
+    rx_sync_->Release();
+}
+
+void UsbCdcAcm::OnBulkIn()
+{
+    tx_busy_ = false;
+    if (0 < tx_length_[tx_fill_])
+        StartTransmit();
+    else if (0 < tx_last_length_ && 0 == tx_last_length_ % USB_CDC_ACM_PACKET_SIZE) {
+        // The host waits for the short packet to end the transfer.
+        tx_last_length_ = 0;
+        tx_busy_ = true;
+        HAL_PCD_EP_Transmit(hpcd_, EP_DATA_IN, nullptr, 0);
+    }
+    tx_sync_->Release();
+}
+
+bool UsbCdcAcm::OnStandardRequest(const uint8_t *setup)
+{
+    const uint8_t recipient = setup[0] & 0x1F;
+    const unsigned int value = setup[2] | (setup[3] << 8);
+    const unsigned int index = setup[4] | (setup[5] << 8);
+    const unsigned int length = setup[6] | (setup[7] << 8);
+
+    switch (setup[1]) {
+        case REQUEST_GET_DESCRIPTOR:
+            switch (value >> 8) {
+                case 0x01:
+                    SendControl(kDeviceDescriptor, sizeof(kDeviceDescriptor), length);
+                    return true;
+                case 0x02:
+                    SendControl(kConfigurationDescriptor, sizeof(kConfigurationDescriptor), length);
+                    return true;
+                case 0x03:
+                    if (0 == (value & 0xFF))
+                        SendControl(kLanguageDescriptor, sizeof(kLanguageDescriptor), length);
+                    else {
+                        const unsigned int size = MakeStringDescriptor(value & 0xFF);
+
+                        if (0 == size)
+                            return false;
+                        SendControl(control_buffer_, size, length);
+                    }
+                    return true;
+                default:
+                    // Device qualifier and so on. Full speed only.
+                    return false;
+            }
+        case REQUEST_SET_ADDRESS:
+            // The OTG takes the address before the status stage.
+            HAL_PCD_SetAddress(hpcd_, value & 0x7F);
+            SendStatus();
+            return true;
+        case REQUEST_SET_CONFIGURATION:
+            if (1 < value)
+                return false;
+            Configure(value);
+            SendStatus();
+            return true;
+        case REQUEST_GET_CONFIGURATION:
+            control_buffer_[0] = configuration_;
+            SendControl(control_buffer_, 1, length);
+            return true;
+        case REQUEST_GET_STATUS:
+            // Self powered. No remote wakeup, no halt.
+            control_buffer_[0] = (0 == recipient) ? 0x01 : 0x00;
+            control_buffer_[1] = 0;
+            SendControl(control_buffer_, 2, length);
+            return true;
+        case REQUEST_CLEAR_FEATURE:
+        case REQUEST_SET_FEATURE:
+            if (2 == recipient && FEATURE_ENDPOINT_HALT == value && 0 != (index & 0x7F)) {
+                if (REQUEST_SET_FEATURE == setup[1])
+                    HAL_PCD_EP_SetStall(hpcd_, index & 0xFF);
+                else
+                    HAL_PCD_EP_ClrStall(hpcd_, index & 0xFF);
+            }
+            SendStatus();
+            return true;
+        case REQUEST_GET_INTERFACE:
+            control_buffer_[0] = 0;
+            SendControl(control_buffer_, 1, length);
+            return true;
+        case REQUEST_SET_INTERFACE:
+            if (0 != value)
+                return false;
+            SendStatus();
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool UsbCdcAcm::OnClassRequest(const uint8_t *setup)
+{
+    const unsigned int value = setup[2] | (setup[3] << 8);
+    const unsigned int length = setup[6] | (setup[7] << 8);
+
+    control_request_ = setup[1];
+    switch (setup[1]) {
+        case REQUEST_SET_LINE_CODING:
+            if (sizeof(line_coding_) != length)
+                return false;
+            control_state_ = kcsDataOut;
+            HAL_PCD_EP_Receive(hpcd_, EP_CONTROL_OUT, control_buffer_, length);
+            return true;
+        case REQUEST_GET_LINE_CODING:
+            SendControl(line_coding_, sizeof(line_coding_), length);
+            return true;
+        case REQUEST_SET_CONTROL_LINE_STATE:
+            // The terminal asserts DTR when it opens the port.
+            dtr_ = (0 != (value & 0x01));
+            SendStatus();
+            tx_sync_->Release();
+            return true;
+        case REQUEST_SEND_BREAK:
+            SendStatus();
+            return true;
+        default:
+            return false;
+    }
+}
+
+void UsbCdcAcm::SendControl(const uint8_t *data, unsigned int length, unsigned int requested)
+{
+    length = std::min(length, requested);
+
+    control_data_ = data;
+    control_remaining_ = length;
+    control_zlp_ = (length < requested) && (0 == length % USB_CDC_ACM_PACKET_SIZE);
+    control_state_ = kcsDataIn;
+    OnControlIn();
+}
+
+void UsbCdcAcm::SendStatus()
+{
+    control_state_ = kcsStatusIn;
+    HAL_PCD_EP_Transmit(hpcd_, EP_CONTROL_IN, nullptr, 0);
+}
+
+void UsbCdcAcm::StallControl()
+{
+    // The OTG clears the stall of the EP0 by the next SETUP.
+    control_state_ = kcsIdle;
+    HAL_PCD_EP_SetStall(hpcd_, EP_CONTROL_IN);
+    HAL_PCD_EP_SetStall(hpcd_, EP_CONTROL_OUT);
+}
+
+void UsbCdcAcm::Configure(uint8_t configuration)
+{
+    if (configuration == configuration_)
+        return;
+
+    if (0 != configuration) {
+        HAL_PCD_EP_Open(hpcd_, EP_DATA_OUT, USB_CDC_ACM_PACKET_SIZE, EP_TYPE_BULK);
+        HAL_PCD_EP_Open(hpcd_, EP_DATA_IN, USB_CDC_ACM_PACKET_SIZE, EP_TYPE_BULK);
+        HAL_PCD_EP_Open(hpcd_, EP_NOTIFICATION, EP_NOTIFICATION_SIZE, EP_TYPE_INTR);
+        configuration_ = configuration;
+        if (!rx_busy_ && 0 == rx_length_[rx_read_])
+            ArmReceive(rx_read_);
+    }
+    else {
+        configuration_ = 0;
+        dtr_ = false;
+        rx_busy_ = false;
+        tx_busy_ = false;
+        HAL_PCD_EP_Close(hpcd_, EP_DATA_OUT);
+        HAL_PCD_EP_Close(hpcd_, EP_DATA_IN);
+        HAL_PCD_EP_Close(hpcd_, EP_NOTIFICATION);
+    }
+    tx_sync_->Release();
+}
+
+unsigned int UsbCdcAcm::MakeStringDescriptor(uint8_t index)
+{
+    char text[25];
+    const char *string;
+
+    switch (index) {
+        case 1:
+            string = kManufacturer;
+            break;
+        case 2:
+            string = kProduct;
+            break;
+        case 3: {
+            // Serial number from the unique device ID. Different on each board.
+            const uint32_t uid[] = { HAL_GetUIDw0(), HAL_GetUIDw1(), HAL_GetUIDw2() };
+            static const char kHex[] = "0123456789ABCDEF";
+
+            for (unsigned int i = 0; i < 24; i++)
+                text[i] = kHex[(uid[i / 8] >> (28 - 4 * (i % 8))) & 0xF];
+            text[24] = '\0';
+            string = text;
+            break;
+        }
+        default:
+            return 0;
+    }
+
+    // UTF-16LE.
+    const unsigned int length = std::min((unsigned int) std::strlen(string),
+                                         (unsigned int) (sizeof(control_buffer_) - 2) / 2);
+
+    control_buffer_[0] = 2 + 2 * length;
+    control_buffer_[1] = 0x03;
+    for (unsigned int i = 0; i < length; i++) {
+        control_buffer_[2 + 2 * i] = string[i];
+        control_buffer_[3 + 2 * i] = 0;
+    }
+    return control_buffer_[0];
+}
+
+void UsbCdcAcm::StartTransmit()
+{
+    const unsigned int index = tx_fill_;
+
+    // The task fills the other buffer from here.
+    tx_last_length_ = tx_length_[index];
+    tx_busy_ = true;
+    tx_fill_ = index ^ 1;
+    tx_length_[tx_fill_] = 0;
+    HAL_PCD_EP_Transmit(hpcd_, EP_DATA_IN, tx_buffers_[index], tx_last_length_);
+}
+
+void UsbCdcAcm::ArmReceive(unsigned int index)
+{
+    rx_armed_ = index;
+    rx_busy_ = true;
+    HAL_PCD_EP_Receive(hpcd_, EP_DATA_OUT, rx_buffers_[index], USB_CDC_ACM_PACKET_SIZE);
+}
+
+} /* namespace murasaki */
+
+#endif /* HAL_PCD_MODULE_ENABLED */
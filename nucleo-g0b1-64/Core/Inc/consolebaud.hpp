@@ -0,0 +1,144 @@
+/**
+ * @file consolebaud.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Runtime baud rate negotiation of the console UART.
+ */
+
+#ifndef CONSOLEBAUD_HPP_
+#define CONSOLEBAUD_HPP_
+
+#include "murasaki.hpp"
+
+// Wait for the SYNC of the host tool at the new baud rate [mS].
+#define CONSOLE_BAUD_SYNC_TIMEOUT 500
+// Period of the framing error check [mS].
+#define CONSOLE_BAUD_CHECK_PERIOD 1000
+// Number of the framing errors in a period, to fall back to the default baud rate.
+#define CONSOLE_BAUD_MAX_ERRORS 4
+// Longest line of the handshake, including the terminator.
+#define CONSOLE_BAUD_LINE_SIZE 24
+
+namespace murasaki {
+
+/**
+ * @brief Baud rate of the console UART, negotiated with the host tool.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The CubeIDE fixes the console at 115200 baud. That is around 11kB/s of the log. This class switches the
+ * console to the higher baud rate by the handshake with the tools/consolebaud.py :
+ *
+ * | Host tool                      | Board                                            |
+ * |--------------------------------|--------------------------------------------------|
+ * | "BAUD 921600\r" repeatedly     | At the default rate, within the window of boot.  |
+ * |                                | "ACK\r\n", or "NAK\r\n" if the rate is not made. |
+ * | Switch to 921600               | Switch to 921600                                 |
+ * | "SYNC\r" repeatedly            | "SYNC\r\n"                                       |
+ *
+ * When the SYNC doesn't arrive in CONSOLE_BAUD_SYNC_TIMEOUT mS, the board goes back to the default rate.
+ * The handshake is done by the polling, before the first transfer of the console object.
+ *
+ * @code
+ * murasaki::platform.console_baud = new murasaki::ConsoleBaud(&huart2);
+ * murasaki::platform.console_baud->Negotiate(300);
+ * murasaki::platform.uart_console = new murasaki::DebuggerUart(&huart2);
+ * murasaki::CallbackDispatcher::Register(&huart2, murasaki::platform.uart_console);
+ * murasaki::platform.console_baud->Start(murasaki::platform.uart_console);
+ * @endcode
+ *
+ * Start() hooks the error callback of the UART, and starts a task to watch the framing errors.
+ * When CONSOLE_BAUD_MAX_ERRORS errors are counted in a CONSOLE_BAUD_CHECK_PERIOD, the console goes back
+ * to the default rate. The host tool does the same on the broken text. The hook needs the registered
+ * callbacks of the HAL, and must be set after the CallbackDispatcher::Register() of the console.
+ *
+ * SetBaudRate() computes the BRR from the current clock of the UART. The oversampling by 16 is used
+ * if possible, otherwise by 8. The reachable rate depends on the clock. For example, 4Mbaud needs
+ * 64MHz of the UART clock. The ST-Link VCP has its own limit, too.
+ */
+class ConsoleBaud
+{
+ public:
+    /**
+     * @brief Constructor.
+     * @param huart Console UART. The baud rate of the handle is the default rate.
+     */
+    ConsoleBaud(UART_HandleTypeDef *huart);
+
+    /**
+     * @brief Negotiate the baud rate with the host tool.
+     * @param window_ms Wait for the request of the host tool [mS]. 0 to skip.
+     * @return true if switched to the new rate.
+     * @details
+     * Call before the first transfer of the console object.
+     */
+    bool Negotiate(unsigned int window_ms);
+
+    /**
+     * @brief Hook the error callback, and start the framing error watch.
+     * @param console Object which handles the callbacks of the console UART.
+     */
+    void Start(UartStrategy *console);
+
+    /**
+     * @brief Go back to the default baud rate.
+     * @details
+     * The transmission in progress is drained. Can be called from any task.
+     */
+    void FallBack();
+
+    /**
+     * @brief Get the current baud rate.
+     * @return Baud rate [baud].
+     */
+    unsigned int GetBaudRate() const;
+
+    /**
+     * @brief Get the number of the framing errors since Start().
+     * @return Number of the errors.
+     */
+    unsigned int GetFramingErrors() const;
+
+    /**
+     * @brief Set the baud rate of the UART from its current clock.
+     * @param huart UART to set.
+     * @param baud_rate Baud rate [baud].
+     * @return true if success. false if the rate is not made from the clock, or its error is over 2.5% ( 2% with the
+     * oversampling by 8 ). The UART is left untouched.
+     * @details
+     * The oversampling by 16 is preferred. The oversampling by 8 is used for the higher rate.
+     * The baud rate and the oversampling of the handle are updated. The UART must be idle.
+     */
+    static bool SetBaudRate(UART_HandleTypeDef *huart, unsigned int baud_rate);
+
+    /**
+     * @brief Set the current baud rate again, after the change of the UART clock.
+     * @param huart UART to set.
+     * @return true if the current rate is kept. false if the console went back to the default rate.
+     * @details
+     * If the new clock can't make the current rate, the console goes back to the default rate of the
+     * started ConsoleBaud. The console is usually transmit only, and no framing error tells the wrong rate.
+     * The UART must be idle.
+     */
+    static bool Retime(UART_HandleTypeDef *huart);
+
+ private:
+    static void TaskBody(const void *ptr);
+    static void ErrorCallback(UART_HandleTypeDef *huart);
+    // Receive a line terminated by CR or LF, until the deadline.
+    bool ReceiveLine(char *line, unsigned int size, uint32_t start, unsigned int timeout_ms);
+    void Send(const char *message);
+
+    UART_HandleTypeDef *const huart_;
+    const unsigned int default_baud_rate_;
+    UartStrategy *console_;
+    murasaki::SimpleTask *task_;
+    volatile unsigned int framing_errors_;
+
+    // The error callback of the HAL has no context.
+    static ConsoleBaud *instance_;
+};
+
+} /* namespace murasaki */
+
+#endif /* CONSOLEBAUD_HPP_ */
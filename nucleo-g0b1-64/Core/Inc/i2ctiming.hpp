@@ -0,0 +1,112 @@
+/**
+ * @file i2ctiming.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Runtime I2C bus speed configuration.
+ */
+
+#ifndef I2CTIMING_HPP_
+#define I2CTIMING_HPP_
+
+#include "murasaki.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Standard I2C bus speed [Hz].
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ */
+enum I2cBusSpeed
+{
+    kibsStandard = 100000,     ///< Standard mode. 100kHz.
+    kibsFast = 400000,         ///< Fast mode. 400kHz.
+    kibsFastPlus = 1000000     ///< Fast mode plus. 1MHz.
+};
+
+/**
+ * @brief I2C bus timing calculator and runtime re-configurator.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The CubeIDE freezes the I2C bus timing into the generated main.c. For example,
+ * hi2c1.Init.ClockSpeed on the STM32F4/L1 and hi2c1.Init.Timing on the other series.
+ * This class computes the register values from the current I2C kernel clock, and
+ * re-configures the peripheral at run time.
+ *
+ * Two I2C peripheral generations are supported :
+ * @li The STM32F4 / L1 I2C : CCR, TRISE and CR2.FREQ are computed from the PCLK1. Up to 400kHz.
+ * @li The other series : TIMINGR is computed from the kernel clock of the I2C.
+ *     Up to 1MHz. The Fast mode plus drive of the I2C pins is enabled when 1MHz is requested.
+ *
+ * The bus must be idle while the re-configuration. That is, no other task must use the I2C master
+ * during the SetBusSpeed() / Retime() call.
+ *
+ * @code
+ * murasaki::I2cTiming::SetBusSpeed(&hi2c1, murasaki::kibsFastPlus);
+ * @endcode
+ */
+class I2cTiming
+{
+ public:
+    /**
+     * @brief Get the kernel clock of the given I2C peripheral.
+     * @param hi2c Peripheral handle created by CubeIDE.
+     * @return Kernel clock [Hz]. 0 if the clock source is not supported.
+     */
+    static unsigned int GetKernelClock(I2C_HandleTypeDef *hi2c);
+
+    /**
+     * @brief Compute the TIMINGR value from the kernel clock.
+     * @param kernel_clock I2C kernel clock [Hz]
+     * @param bus_speed Desired SCL frequency [Hz]. Up to 1MHz.
+     * @param timing Computed TIMINGR value.
+     * @return true if success. false if the kernel clock is too slow or too fast for the bus speed.
+     * @details
+     * The analog noise filter is assumed enabled and digital noise filter disabled,
+     * as CubeIDE default.
+     *
+     * The computed SCL frequency doesn't exceed the given bus_speed. The rise and fall time
+     * are the assumed values of the board ( 25nS and 10nS ), not the maximum value of the I2C specification.
+     * The slower edges make the SCL frequency lower.
+     */
+    static bool ComputeTimingRegister(unsigned int kernel_clock, unsigned int bus_speed, uint32_t *timing);
+
+    /**
+     * @brief Re-configure the bus speed at run time.
+     * @param hi2c Peripheral handle created by CubeIDE.
+     * @param bus_speed Desired SCL frequency [Hz].
+     * @return true if success. false if the speed is not supported by the peripheral or the clock.
+     * @details
+     * If failed, the peripheral is left untouched.
+     */
+    static bool SetBusSpeed(I2C_HandleTypeDef *hi2c, unsigned int bus_speed);
+
+    /**
+     * @brief Re-compute the timing with the current kernel clock.
+     * @param hi2c Peripheral handle created by CubeIDE.
+     * @return true if success.
+     * @details
+     * Call this function after the change of the I2C kernel clock. The last bus speed given to
+     * SetBusSpeed() is kept. If SetBusSpeed() was never called, the standard mode is assumed.
+     */
+    static bool Retime(I2C_HandleTypeDef *hi2c);
+
+    /**
+     * @brief Get the last bus speed given by SetBusSpeed().
+     * @param hi2c Peripheral handle created by CubeIDE.
+     * @return Bus speed [Hz].
+     */
+    static unsigned int GetBusSpeed(I2C_HandleTypeDef *hi2c);
+
+ private:
+    static bool ApplyTiming(I2C_HandleTypeDef *hi2c, unsigned int kernel_clock, unsigned int bus_speed);
+    static void StoreBusSpeed(I2C_HandleTypeDef *hi2c, unsigned int bus_speed);
+
+    static const unsigned int kMaxHandles = 4;
+    static I2C_HandleTypeDef *handles_[kMaxHandles];
+    static unsigned int bus_speeds_[kMaxHandles];
+};
+
+} /* namespace murasaki */
+
+#endif /* I2CTIMING_HPP_ */
@@ -0,0 +1,236 @@
+/**
+ * @file staticbitout.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Compile time GPIO output pin with the direct BSRR access.
+ */
+
+#ifndef STATICBITOUT_HPP_
+#define STATICBITOUT_HPP_
+
+#include "murasaki.hpp"
+
+// Force the inline expansion even in the Debug build ( -O0 ).
+#define STATIC_BITOUT_INLINE inline __attribute__((always_inline))
+
+namespace murasaki {
+
+/**
+ * @brief GPIO port ID for the template parameter.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The GPIOx macro of the CMSIS is a cast of an integer. It can't be a template parameter.
+ */
+enum GpioPort
+{
+    kgpA = 0,
+    kgpB,
+    kgpC,
+    kgpD,
+    kgpE,
+    kgpF,
+    kgpG,
+    kgpH,
+    kgpI,
+    kgpJ,
+    kgpK
+};
+
+/**
+ * @brief Registers of the GPIO port.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @param port Port ID.
+ * @return The same pointer with the GPIOx macro.
+ * @details
+ * The interval of the GPIO ports is not the same in all series. For example, the GPIOH of the STM32L1 is
+ * placed before the GPIOF. So, the port is looked up by the GPIOx macro of the CMSIS.
+ * The result is a constant when the port is a constant.
+ */
+STATIC_BITOUT_INLINE GPIO_TypeDef* GpioPortRegisters(GpioPort port)
+{
+    switch (port) {
+#if defined(GPIOA)
+        case kgpA:
+            return GPIOA;
+#endif
+#if defined(GPIOB)
+        case kgpB:
+            return GPIOB;
+#endif
+#if defined(GPIOC)
+        case kgpC:
+            return GPIOC;
+#endif
+#if defined(GPIOD)
+        case kgpD:
+            return GPIOD;
+#endif
+#if defined(GPIOE)
+        case kgpE:
+            return GPIOE;
+#endif
+#if defined(GPIOF)
+        case kgpF:
+            return GPIOF;
+#endif
+#if defined(GPIOG)
+        case kgpG:
+            return GPIOG;
+#endif
+#if defined(GPIOH)
+        case kgpH:
+            return GPIOH;
+#endif
+#if defined(GPIOI)
+        case kgpI:
+            return GPIOI;
+#endif
+#if defined(GPIOJ)
+        case kgpJ:
+            return GPIOJ;
+#endif
+#if defined(GPIOK)
+        case kgpK:
+            return GPIOK;
+#endif
+        default:
+            // The port doesn't exist in this device.
+            return nullptr;
+    }
+}
+
+/**
+ * @brief GPIO output pin fixed at the compile time.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @tparam kPort Port of the pin.
+ * @tparam kPin Pin mask. One of the GPIO_PIN_x.
+ * @details
+ * All member functions are static and inline. No object, no virtual call and no HAL call.
+ * Set() and Clear() are a store of the constant to the BSRR. Toggle() is a load of the ODR and a store to the BSRR.
+ * The other pins of the port are not disturbed by the interrupt, because there is no read-modify-write of ODR.
+ *
+ * @code
+ * typedef murasaki::StaticBitOut<murasaki::kgpA, GPIO_PIN_5> Strobe;
+ *
+ * Strobe::Set();
+ * Strobe::Clear();
+ * @endcode
+ *
+ * The pin must be configured as output by CubeIDE. Use @ref StaticBitOutAdapter where the
+ * @ref murasaki::BitOutStrategy is needed.
+ */
+template<GpioPort kPort, uint16_t kPin>
+class StaticBitOut
+{
+ public:
+    /**
+     * @brief Set the pin.
+     * @param state 0 to clear the pin, the others to set the pin.
+     */
+    static STATIC_BITOUT_INLINE void Set(unsigned int state = 1)
+    {
+        Port()->BSRR = state ? kPin : (static_cast<uint32_t>(kPin) << 16);
+    }
+
+    /**
+     * @brief Clear the pin.
+     */
+    static STATIC_BITOUT_INLINE void Clear()
+    {
+        Port()->BSRR = static_cast<uint32_t>(kPin) << 16;
+    }
+
+    /**
+     * @brief Invert the pin.
+     */
+    static STATIC_BITOUT_INLINE void Toggle()
+    {
+        const uint32_t output = Port()->ODR;
+
+        // Reset the pin if it is set. Set the pin if it is cleared.
+        Port()->BSRR = ((output & kPin) << 16) | (~output & kPin);
+    }
+
+    /**
+     * @brief Read the output state of the pin.
+     * @return 1 if the pin is set, 0 if cleared.
+     */
+    static STATIC_BITOUT_INLINE unsigned int Get()
+    {
+        return (Port()->ODR & kPin) ? 1 : 0;
+    }
+
+    /**
+     * @brief Registers of the port.
+     */
+    static STATIC_BITOUT_INLINE GPIO_TypeDef* Port()
+    {
+        return GpioPortRegisters(kPort);
+    }
+};
+
+/**
+ * @brief Adapter of the @ref StaticBitOut to the @ref murasaki::BitOutStrategy.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @tparam kPort Port of the pin.
+ * @tparam kPin Pin mask. One of the GPIO_PIN_x.
+ * @details
+ * Drop-in replacement of the @ref murasaki::BitOut for the code which needs the polymorphism.
+ * The call is still virtual. But the body is the BSRR access, instead of the HAL.
+ *
+ * @code
+ * murasaki::platform.led = new murasaki::StaticBitOutAdapter<murasaki::kgpA, GPIO_PIN_5>();
+ * @endcode
+ */
+template<GpioPort kPort, uint16_t kPin>
+class StaticBitOutAdapter : public BitOutStrategy
+{
+ public:
+    /**
+     * @brief Set the pin.
+     * @param state 0 to clear the pin, the others to set the pin.
+     */
+    virtual void Set(unsigned int state = 1)
+    {
+        StaticBitOut<kPort, kPin>::Set(state);
+    }
+
+    /**
+     * @brief Clear the pin.
+     */
+    virtual void Clear()
+    {
+        StaticBitOut<kPort, kPin>::Clear();
+    }
+
+    /**
+     * @brief Read the output state of the pin.
+     * @return 1 if the pin is set, 0 if cleared.
+     */
+    virtual unsigned int Get()
+    {
+        return StaticBitOut<kPort, kPin>::Get();
+    }
+
+    /**
+     * @brief Invert the pin.
+     */
+    virtual void Toggle()
+    {
+        StaticBitOut<kPort, kPin>::Toggle();
+    }
+
+ private:
+    /**
+     * @brief Return the GPIO_TypeDef of the port.
+     */
+    virtual void* GetPeripheralHandle()
+    {
+        return StaticBitOut<kPort, kPin>::Port();
+    }
+};
+
+} /* namespace murasaki */
+
+#endif /* STATICBITOUT_HPP_ */
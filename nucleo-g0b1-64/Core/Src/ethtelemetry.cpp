@@ -0,0 +1,379 @@
+/**
+ * @file ethtelemetry.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Zero-copy UDP telemetry sink on the Ethernet.
+ */
+
+#include "ethtelemetry.hpp"
+
+#include <cstring>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef HAL_ETH_MODULE_ENABLED
+
+// The descriptor list and the TxFreeCallback are of the ETH HAL of the H7.
+#if defined(ETH) && defined(ETH_TX_DESC_CNT)
+#define ETH_TELEMETRY_SUPPORTED 1
+#else
+#define ETH_TELEMETRY_SUPPORTED 0
+#endif
+
+// Offsets in the frame buffer.
+#define OFFSET_SOURCE_MAC 6
+#define OFFSET_ETHER_TYPE 12
+#define OFFSET_IP 14
+#define OFFSET_IP_LENGTH 16
+#define OFFSET_IP_ID 18
+#define OFFSET_IP_CHECKSUM 24
+#define OFFSET_UDP 34
+#define OFFSET_UDP_LENGTH 38
+#define OFFSET_UDP_CHECKSUM 40
+#define IP_HEADER_SIZE 20
+#define UDP_HEADER_SIZE 8
+
+// Registers of the PHY.
+#define PHY_BSR 1
+#define PHY_BSR_LINK_STATUS 0x0004
+// Special control / status of the LAN8742A. Speed indication at [4:2].
+#define PHY_SCSR 31
+#define PHY_SCSR_100M 0x0008
+#define PHY_SCSR_FULL_DUPLEX 0x0010
+
+// MPU region of the descriptors and the buffers. The highest number overrides the other regions.
+#define MPU_REGION_ETH MPU_REGION_NUMBER7
+#define MPU_REGION_ETH_SIZE (32 * 1024)
+
+// Frame buffers next to the DMA descriptors. The linker script puts the section in the D2 SRAM.
+static uint8_t buffers[ETH_TELEMETRY_BUFFER_COUNT][ETH_TELEMETRY_BUFFER_SIZE]
+__attribute__((section(".EthBufferSection"), aligned(32)));
+
+static void PutBe16(uint8_t *p, uint16_t value)
+{
+    p[0] = value >> 8;
+    p[1] = value;
+}
+
+static void PutBe32(uint8_t *p, uint32_t value)
+{
+    PutBe16(p, value >> 16);
+    PutBe16(p + 2, value);
+}
+
+namespace murasaki {
+
+EthTelemetry *EthTelemetry::instance_ = nullptr;
+
+EthTelemetry::EthTelemetry(
+                           ETH_HandleTypeDef *heth,
+                           ETH_TxPacketConfig *tx_config,
+                           uint32_t source_ip,
+                           uint32_t destination_ip,
+                           uint16_t port)
+        :
+        heth_(heth),
+        tx_config_(tx_config),
+        source_ip_(source_ip),
+        destination_ip_(destination_ip),
+        port_(port),
+        current_(-1),
+        fill_(0),
+        frame_start_(0),
+        frame_records_(0),
+        sequence_(0),
+        ip_id_(0),
+        free_count_(0),
+        tx_buffer_ { nullptr, 0, nullptr },
+        frames_(0),
+        records_(0),
+        drops_(0)
+{
+    MURASAKI_ASSERT(nullptr != heth)
+    MURASAKI_ASSERT(nullptr != tx_config)
+
+    critical_section_ = new CriticalSection();
+    MURASAKI_ASSERT(nullptr != critical_section_)
+}
+
+bool EthTelemetry::Start()
+{
+    MURASAKI_ASSERT(nullptr == instance_)
+
+#if ETH_TELEMETRY_SUPPORTED
+    instance_ = this;
+
+    ConfigureMpu();
+
+    // The headers are built once. Send() fills the lengths, the IP ID and the sequence number.
+    for (unsigned int i = 0; i < ETH_TELEMETRY_BUFFER_COUNT; i++) {
+        uint8_t *frame = buffers[i];
+
+        memset(frame, 0, ETH_TELEMETRY_HEADER_SIZE);
+        memset(frame, 0xFF, 6);                                 // Broadcast. No ARP.
+        memcpy(frame + OFFSET_SOURCE_MAC, heth_->Init.MACAddr, 6);
+        PutBe16(frame + OFFSET_ETHER_TYPE, 0x0800);             // IPv4.
+        frame[OFFSET_IP] = 0x45;                                // Version 4, 20 bytes header.
+        PutBe16(frame + OFFSET_IP + 6, 0x4000);                 // Don't fragment.
+        frame[OFFSET_IP + 8] = 64;                              // TTL.
+        frame[OFFSET_IP + 9] = 17;                              // UDP.
+        PutBe32(frame + OFFSET_IP + 12, source_ip_);
+        PutBe32(frame + OFFSET_IP + 16, destination_ip_);
+        PutBe16(frame + OFFSET_UDP, port_);
+        PutBe16(frame + OFFSET_UDP + 2, port_);
+
+        free_[i] = i;
+    }
+    free_count_ = ETH_TELEMETRY_BUFFER_COUNT;
+
+    if (HAL_OK != HAL_ETH_RegisterTxFreeCallback(heth_, &EthTelemetry::TxFreeCallback))
+        return false;
+
+    // The HCLK may be changed by the ClockProfile after the HAL_ETH_Init(). Before the first access to the PHY.
+    Retime();
+    ConfigureMac();
+    return HAL_OK == HAL_ETH_Start(heth_);
+#else
+    return false;
+#endif
+}
+
+uint8_t* EthTelemetry::Reserve(unsigned int size, unsigned int timeout_ms)
+{
+#if ETH_TELEMETRY_SUPPORTED
+    const uint32_t start = HAL_GetTick();
+
+    critical_section_->Enter();
+
+    // Doesn't fit. Send the current frame first.
+    bool ready = size <= ETH_TELEMETRY_MAX_RECORD
+            && (!(current_ >= 0 && fill_ + size > ETH_TELEMETRY_PAYLOAD_SIZE) || Send(timeout_ms));
+
+    if (ready && current_ < 0) {
+        Reclaim();
+        while (ready && 0 == free_count_) {
+            if (ElapsedMs(start) >= timeout_ms)
+                ready = false;
+            else {
+                // A frame takes around 120uS on the 100Mbps. Let the other tasks run meanwhile.
+                taskYIELD();
+                Reclaim();
+            }
+        }
+        if (ready) {
+            current_ = free_[--free_count_];
+            fill_ = ETH_TELEMETRY_SEQUENCE_SIZE;
+            frame_start_ = HAL_GetTick();
+            frame_records_ = 0;
+        }
+    }
+
+    // Still locked. Commit() unlocks.
+    if (ready)
+        return buffers[current_] + ETH_TELEMETRY_HEADER_SIZE + fill_;
+
+    drops_++;
+    critical_section_->Leave();
+#endif
+    return nullptr;
+}
+
+void EthTelemetry::Commit(unsigned int size)
+{
+    MURASAKI_ASSERT(current_ >= 0)
+    MURASAKI_ASSERT(fill_ + size <= ETH_TELEMETRY_PAYLOAD_SIZE)
+
+    fill_ += size;
+    frame_records_++;
+
+    // Don't keep a full frame, or an old record. The frame waits if all descriptors are busy.
+    if (fill_ == ETH_TELEMETRY_PAYLOAD_SIZE || ElapsedMs(frame_start_) >= ETH_TELEMETRY_FLUSH_INTERVAL)
+        Send(0);
+
+    critical_section_->Leave();
+}
+
+bool EthTelemetry::Write(const void *record, unsigned int size, unsigned int timeout_ms)
+{
+    uint8_t *destination = Reserve(size, timeout_ms);
+
+    if (nullptr == destination)
+        return false;
+
+    // The only copy. From the caller to the DMA buffer.
+    memcpy(destination, record, size);
+    Commit(size);
+    return true;
+}
+
+bool EthTelemetry::Flush(unsigned int timeout_ms)
+{
+    bool result;
+
+    critical_section_->Enter();
+    Reclaim();
+    result = Send(timeout_ms);
+    critical_section_->Leave();
+
+    return result;
+}
+
+void EthTelemetry::Retime()
+{
+#if ETH_TELEMETRY_SUPPORTED
+    if (nullptr == instance_)
+        return;
+
+    HAL_ETH_SetMDIOClockRange(instance_->heth_);
+    instance_->heth_->Instance->MAC1USTCR = HAL_RCC_GetHCLKFreq() / 1000000 - 1;
+#endif
+}
+
+bool EthTelemetry::IsLinkUp()
+{
+    uint32_t value = 0;
+
+    // The link status is latched low. The second read is the current status.
+    HAL_ETH_ReadPHYRegister(heth_, ETH_TELEMETRY_PHY_ADDRESS, PHY_BSR, &value);
+    if (HAL_OK != HAL_ETH_ReadPHYRegister(heth_, ETH_TELEMETRY_PHY_ADDRESS, PHY_BSR, &value))
+        return false;
+    return value & PHY_BSR_LINK_STATUS;
+}
+
+unsigned int EthTelemetry::GetFrameCount() const
+{
+    return frames_;
+}
+
+unsigned int EthTelemetry::GetRecordCount() const
+{
+    return records_;
+}
+
+unsigned int EthTelemetry::GetDropCount() const
+{
+    return drops_;
+}
+
+bool EthTelemetry::Send(unsigned int timeout_ms)
+{
+#if ETH_TELEMETRY_SUPPORTED
+    // Nothing to send.
+    if (current_ < 0 || fill_ == ETH_TELEMETRY_SEQUENCE_SIZE)
+        return true;
+
+    const uint32_t start = HAL_GetTick();
+    uint8_t *frame = buffers[current_];
+    const unsigned int udp_length = UDP_HEADER_SIZE + fill_;
+
+    PutBe16(frame + OFFSET_IP_LENGTH, IP_HEADER_SIZE + udp_length);
+    PutBe16(frame + OFFSET_IP_ID, ip_id_);
+    PutBe16(frame + OFFSET_IP_CHECKSUM, 0);     // Inserted by the MAC.
+    PutBe16(frame + OFFSET_UDP_LENGTH, udp_length);
+    PutBe16(frame + OFFSET_UDP_CHECKSUM, 0);    // Inserted by the MAC.
+    frame[ETH_TELEMETRY_HEADER_SIZE] = sequence_;
+    frame[ETH_TELEMETRY_HEADER_SIZE + 1] = sequence_ >> 8;
+    frame[ETH_TELEMETRY_HEADER_SIZE + 2] = sequence_ >> 16;
+    frame[ETH_TELEMETRY_HEADER_SIZE + 3] = sequence_ >> 24;
+
+    // The buffer goes to the descriptor as is. pData comes back by the TxFreeCallback.
+    tx_buffer_.buffer = frame;
+    tx_buffer_.len = ETH_TELEMETRY_HEADER_SIZE + fill_;
+    tx_buffer_.next = nullptr;
+    tx_config_->Length = tx_buffer_.len;
+    tx_config_->TxBuffer = &tx_buffer_;
+    tx_config_->pData = frame;
+
+    while (HAL_OK != HAL_ETH_Transmit_IT(heth_, tx_config_)) {
+        // All descriptors are in flight.
+        if (ElapsedMs(start) >= timeout_ms)
+            return false;
+        taskYIELD();
+        Reclaim();
+    }
+
+    frames_++;
+    records_ += frame_records_;
+    sequence_++;
+    ip_id_++;
+    current_ = -1;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void EthTelemetry::Reclaim()
+{
+#if ETH_TELEMETRY_SUPPORTED
+    // The DMA cleared the OWN bit of the sent frames. The HAL calls TxFreeCallback() for each.
+    HAL_ETH_ReleaseTxPacket(heth_);
+#endif
+}
+
+uint32_t EthTelemetry::ElapsedMs(uint32_t start)
+{
+    return HAL_GetTick() - start;
+}
+
+void EthTelemetry::ConfigureMpu()
+{
+#if ETH_TELEMETRY_SUPPORTED && defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    MPU_Region_InitTypeDef region = { };
+
+    // Normal memory, shareable, not cacheable. The CPU writes go to the SRAM for the DMA.
+    region.Enable = MPU_REGION_ENABLE;
+    region.Number = MPU_REGION_ETH;
+    region.BaseAddress = D2_AHBSRAM_BASE;
+    region.Size = MPU_REGION_SIZE_32KB;
+    region.SubRegionDisable = 0x00;
+    region.TypeExtField = MPU_TEX_LEVEL1;
+    region.AccessPermission = MPU_REGION_FULL_ACCESS;
+    region.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+    region.IsShareable = MPU_ACCESS_SHAREABLE;
+    region.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+    region.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+
+    taskENTER_CRITICAL();
+    {
+        // Don't leave the dirty lines of the region in the cache.
+        SCB_CleanInvalidateDCache_by_Addr(reinterpret_cast<uint32_t*>(D2_AHBSRAM_BASE), MPU_REGION_ETH_SIZE);
+        HAL_MPU_Disable();
+        HAL_MPU_ConfigRegion(&region);
+        HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+    }
+    taskEXIT_CRITICAL();
+#endif
+}
+
+void EthTelemetry::ConfigureMac()
+{
+#if ETH_TELEMETRY_SUPPORTED
+    ETH_MACConfigTypeDef mac_config;
+    uint32_t value;
+
+    // Without the link, keep the 100Mbps full duplex of the CubeIDE. The later change of the link is not followed.
+    if (!IsLinkUp()
+            || HAL_OK != HAL_ETH_ReadPHYRegister(heth_, ETH_TELEMETRY_PHY_ADDRESS, PHY_SCSR, &value)
+            || HAL_OK != HAL_ETH_GetMACConfig(heth_, &mac_config))
+        return;
+
+    mac_config.Speed = (value & PHY_SCSR_100M) ? ETH_SPEED_100M : ETH_SPEED_10M;
+    mac_config.DuplexMode = (value & PHY_SCSR_FULL_DUPLEX) ? ETH_FULLDUPLEX_MODE : ETH_HALFDUPLEX_MODE;
+    HAL_ETH_SetMACConfig(heth_, &mac_config);
+#endif
+}
+
+void EthTelemetry::TxFreeCallback(uint32_t *buff)
+{
+    const unsigned int index = (reinterpret_cast<uint8_t*>(buff) - &buffers[0][0]) / ETH_TELEMETRY_BUFFER_SIZE;
+
+    MURASAKI_ASSERT(index < ETH_TELEMETRY_BUFFER_COUNT)
+    instance_->free_[instance_->free_count_++] = index;
+}
+
+} /* namespace murasaki */
+
+#endif /* HAL_ETH_MODULE_ENABLED */
@@ -23,6 +23,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "murasaki_platform.hpp"
+#include "FreeRTOS.h"        // Trace recorder hooks.
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -88,7 +89,8 @@ void NMI_Handler(void)
 void HardFault_Handler(void)
 {
   /* USER CODE BEGIN HardFault_IRQn 0 */
-  CustomDefaultHandler();
+  // Jump with the EXC_RETURN in LR. The crash record is printed at the next boot.
+  __asm volatile ("ldr r0, =CrashRecordHandler \n bx r0");
 
   /* USER CODE END HardFault_IRQn 0 */
   while (1)
@@ -111,11 +113,11 @@ void HardFault_Handler(void)
 void EXTI4_15_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI4_15_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END EXTI4_15_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(B1_Pin);
   /* USER CODE BEGIN EXTI4_15_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END EXTI4_15_IRQn 1 */
 }
 
@@ -153,7 +155,7 @@ void DMA1_Channel2_3_IRQHandler(void)
 void I2C1_IRQHandler(void)
 {
   /* USER CODE BEGIN I2C1_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END I2C1_IRQn 0 */
   if (hi2c1.Instance->ISR & (I2C_FLAG_BERR | I2C_FLAG_ARLO | I2C_FLAG_OVR)) {
     HAL_I2C_ER_IRQHandler(&hi2c1);
@@ -161,7 +163,7 @@ void I2C1_IRQHandler(void)
     HAL_I2C_EV_IRQHandler(&hi2c1);
   }
   /* USER CODE BEGIN I2C1_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END I2C1_IRQn 1 */
 }
 
@@ -171,11 +173,11 @@ void I2C1_IRQHandler(void)
 void USART2_LPUART2_IRQHandler(void)
 {
   /* USER CODE BEGIN USART2_LPUART2_IRQn 0 */
-
+  TRACE_ISR_ENTER();
   /* USER CODE END USART2_LPUART2_IRQn 0 */
   HAL_UART_IRQHandler(&huart2);
   /* USER CODE BEGIN USART2_LPUART2_IRQn 1 */
-
+  TRACE_ISR_EXIT();
   /* USER CODE END USART2_LPUART2_IRQn 1 */
 }
 
@@ -0,0 +1,352 @@
+/**
+ * @file crcservice.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Checksum by the CRC unit, with the software fallback.
+ */
+
+#include "crcservice.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <algorithm>
+#include <cstring>
+
+// CRC-32 polynomial, not reflected. The unit reflects the input and output.
+#define CRC32_POLYNOMIAL 0x04C11DB7u
+// CRC-16/CCITT-FALSE polynomial.
+#define CRC16_POLYNOMIAL 0x1021u
+
+#if defined(D1_DTCMRAM_BASE)
+// The DMA1 and DMA2 of the H7 can't access the 64KB ITCM and the 128KB DTCM.
+#define IS_DMA_REACHABLE(address) \
+    ((address) >= D1_ITCMRAM_BASE + 0x10000u && ((address) < D1_DTCMRAM_BASE || (address) >= D1_DTCMRAM_BASE + 0x20000u))
+#else
+#define IS_DMA_REACHABLE(address) (true)
+#endif
+
+// CRC-32 by 8 bits, reflected.
+static const uint32_t crc32_table[256] = {
+        0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F, 0xE963A535, 0x9E6495A3,
+        0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988, 0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91,
+        0x1DB71064, 0x6AB020F2, 0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
+        0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9, 0xFA0F3D63, 0x8D080DF5,
+        0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172, 0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B,
+        0x35B5A8FA, 0x42B2986C, 0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
+        0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423, 0xCFBA9599, 0xB8BDA50F,
+        0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924, 0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D,
+        0x76DC4190, 0x01DB7106, 0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
+        0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D, 0x91646C97, 0xE6635C01,
+        0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E, 0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457,
+        0x65B0D9C6, 0x12B7E950, 0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
+        0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7, 0xA4D1C46D, 0xD3D6F4FB,
+        0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0, 0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9,
+        0x5005713C, 0x270241AA, 0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
+        0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81, 0xB7BD5C3B, 0xC0BA6CAD,
+        0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A, 0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683,
+        0xE3630B12, 0x94643B84, 0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
+        0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB, 0x196C3671, 0x6E6B06E7,
+        0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC, 0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5,
+        0xD6D6A3E8, 0xA1D1937E, 0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
+        0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55, 0x316E8EEF, 0x4669BE79,
+        0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236, 0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F,
+        0xC5BA3BBE, 0xB2BD0B28, 0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
+        0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F, 0x72076785, 0x05005713,
+        0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38, 0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21,
+        0x86D3D2D4, 0xF1D4E242, 0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
+        0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69, 0x616BFFD3, 0x166CCF45,
+        0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2, 0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB,
+        0xAED16A4A, 0xD9D65ADC, 0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
+        0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693, 0x54DE5729, 0x23D967BF,
+        0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94, 0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D };
+
+// CRC-16/CCITT-FALSE by 8 bits.
+static const uint16_t crc16_table[256] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+        0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+        0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+        0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+        0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+        0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+        0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+        0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+        0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+        0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+        0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+        0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+        0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+        0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+        0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+        0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+        0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+        0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+        0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+        0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+        0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+        0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+        0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+        0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+        0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+        0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+        0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+        0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+        0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+        0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+        0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0 };
+
+namespace murasaki {
+
+CriticalSection *CrcService::unit_lock_ = nullptr;
+
+CrcService::CrcService(CrcDmaChannel *dma, unsigned int dma_threshold)
+        :
+        dma_(dma),
+        dma_threshold_(dma_threshold)
+{
+    // Shared by all instances, because there is only one CRC unit. The first instance is created by the
+    // InitPlatform(), before the other tasks run.
+    if (nullptr == unit_lock_) {
+        unit_lock_ = new CriticalSection();
+        MURASAKI_ASSERT(nullptr != unit_lock_)
+    }
+
+    __HAL_RCC_CRC_CLK_ENABLE();
+}
+
+CrcService::~CrcService()
+{
+    // The unit_lock_ is kept for the other instances.
+}
+
+uint32_t CrcService::Crc32(const void *data, unsigned int size, uint32_t crc)
+{
+    const uint8_t *bytes = static_cast<const uint8_t*>(data);
+    uint32_t state = ~crc;
+    uint32_t word;
+
+#if defined(CRC_CR_REV_IN)
+    // The bytes before the word boundary.
+    const unsigned int head = std::min<unsigned int>(size, (4u - reinterpret_cast<uintptr_t>(bytes) % 4) % 4);
+
+    state = UpdateCrc32(state, bytes, head);
+    bytes += head;
+    size -= head;
+
+    if (size >= 4) {
+        const uint8_t *const words = static_cast<const uint8_t*>(__builtin_assume_aligned(bytes, 4));
+        const unsigned int count = size / 4;
+
+        unit_lock_->Enter();
+        // 32bit polynomial. The input is reversed by word, and the output too. The INIT is not reversed.
+        CRC->POL = CRC32_POLYNOMIAL;
+        CRC->INIT = __RBIT(state);
+        CRC->CR = CRC_CR_REV_IN | CRC_CR_REV_OUT;
+        CRC->CR |= CRC_CR_RESET;
+
+        if (!IsDmaEnabled() || size < dma_threshold_ || !IS_DMA_REACHABLE(reinterpret_cast<uintptr_t>(words))
+                || !FeedByDma(words, count)) {
+            // Start over, if the DMA failed in the middle.
+            CRC->CR |= CRC_CR_RESET;
+            for (unsigned int i = 0; i < count; i++) {
+                memcpy(&word, &words[i * 4], sizeof(word));
+                CRC->DR = word;
+            }
+        }
+        state = CRC->DR;
+        unit_lock_->Leave();
+
+        bytes += count * 4;
+        size -= count * 4;
+    }
+#else
+    // The fixed unit starts from 0xFFFFFFFF. The input and output are reversed by the CPU.
+    if (0xFFFFFFFFu == state && size >= 4) {
+        const unsigned int count = size / 4;
+
+        unit_lock_->Enter();
+        CRC->CR = CRC_CR_RESET;
+        for (unsigned int i = 0; i < count; i++) {
+            memcpy(&word, &bytes[i * 4], sizeof(word));
+            CRC->DR = __RBIT(word);
+        }
+        state = __RBIT(CRC->DR);
+        unit_lock_->Leave();
+
+        bytes += count * 4;
+        size -= count * 4;
+    }
+#endif
+
+    // The bytes after the last word.
+    return ~UpdateCrc32(state, bytes, size);
+}
+
+uint16_t CrcService::Crc16(const void *data, unsigned int size, uint16_t crc)
+{
+    const uint8_t *bytes = static_cast<const uint8_t*>(data);
+
+#if defined(CRC_CR_REV_IN)
+    const unsigned int head = std::min<unsigned int>(size, (4u - reinterpret_cast<uintptr_t>(bytes) % 4) % 4);
+    uint32_t word;
+
+    crc = UpdateCrc16(crc, bytes, head);
+    bytes += head;
+    size -= head;
+
+    if (size >= 4) {
+        const uint8_t *const words = static_cast<const uint8_t*>(__builtin_assume_aligned(bytes, 4));
+        const unsigned int count = size / 4;
+
+        unit_lock_->Enter();
+        // 16bit polynomial, no reversal. The first byte must be the MSB of the word.
+        CRC->POL = CRC16_POLYNOMIAL;
+        CRC->INIT = crc;
+        CRC->CR = CRC_CR_POLYSIZE_0;
+        CRC->CR |= CRC_CR_RESET;
+        for (unsigned int i = 0; i < count; i++) {
+            memcpy(&word, &words[i * 4], sizeof(word));
+            CRC->DR = __REV(word);
+        }
+        crc = CRC->DR & 0xFFFFu;
+        unit_lock_->Leave();
+
+        bytes += count * 4;
+        size -= count * 4;
+    }
+#endif
+
+    return UpdateCrc16(crc, bytes, size);
+}
+
+uint32_t CrcService::SoftwareCrc32(const void *data, unsigned int size, uint32_t crc)
+{
+    return ~UpdateCrc32(~crc, static_cast<const uint8_t*>(data), size);
+}
+
+uint16_t CrcService::SoftwareCrc16(const void *data, unsigned int size, uint16_t crc)
+{
+    return UpdateCrc16(crc, static_cast<const uint8_t*>(data), size);
+}
+
+bool CrcService::IsProgrammable()
+{
+#if defined(CRC_CR_REV_IN)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool CrcService::IsDmaEnabled() const
+{
+#if defined(CRC_CR_REV_IN) && (defined(DMA_SxCR_EN) || defined(DMA_CCR_MEM2MEM))
+    return nullptr != dma_;
+#else
+    return false;
+#endif
+}
+
+uint32_t CrcService::UpdateCrc32(uint32_t state, const uint8_t *data, unsigned int size)
+{
+    for (unsigned int i = 0; i < size; i++)
+        state = crc32_table[(state ^ data[i]) & 0xFFu] ^ (state >> 8);
+    return state;
+}
+
+uint16_t CrcService::UpdateCrc16(uint16_t state, const uint8_t *data, unsigned int size)
+{
+    for (unsigned int i = 0; i < size; i++)
+        state = (state << 8) ^ crc16_table[(state >> 8) ^ data[i]];
+    return state;
+}
+
+#if defined(CRC_CR_REV_IN) && defined(DMA_SxCR_EN)
+
+bool CrcService::FeedByDma(const uint8_t *data, unsigned int words)
+{
+    // The flags of the stream 0-3 are in the LISR, and 4-7 in the HISR. The streams are at 0x10 + 0x18 * n.
+    static const uint8_t shifts[4] = { 0, 6, 16, 22 };
+    DMA_TypeDef *const controller = reinterpret_cast<DMA_TypeDef*>(reinterpret_cast<uintptr_t>(dma_) & ~0xFFu);
+    const unsigned int index = ((reinterpret_cast<uintptr_t>(dma_) & 0xFFu) - 0x10u) / 0x18u;
+    const unsigned int shift = shifts[index % 4];
+    volatile uint32_t *const isr = (index < 4) ? &controller->LISR : &controller->HISR;
+    volatile uint32_t *const ifcr = (index < 4) ? &controller->LIFCR : &controller->HIFCR;
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    // The DMA reads the memory, not the cache.
+    if (SCB->CCR & SCB_CCR_DC_Msk) {
+        const uintptr_t start = reinterpret_cast<uintptr_t>(data) & ~31u;
+
+        SCB_CleanDCache_by_Addr(reinterpret_cast<uint32_t*>(start),
+                                reinterpret_cast<uintptr_t>(data) + words * 4 - start);
+    }
+#endif
+
+    while (words > 0) {
+        const unsigned int count = std::min(words, CRC_SERVICE_DMA_MAX_WORDS);
+
+        // The flags must be cleared before the start.
+        *ifcr = 0x3Du << shift;
+        // Memory to memory. The source is the peripheral port. The FIFO is mandatory.
+        dma_->PAR = reinterpret_cast<uintptr_t>(data);
+        dma_->M0AR = reinterpret_cast<uintptr_t>(&CRC->DR);
+        dma_->NDTR = count;
+        dma_->FCR = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH;
+        dma_->CR = DMA_SxCR_DIR_1 | DMA_SxCR_PINC | DMA_SxCR_PSIZE_1 | DMA_SxCR_MSIZE_1 | DMA_SxCR_EN;
+
+        // The EN is cleared when the FIFO is flushed to the CRC unit, or on the error.
+        while (dma_->CR & DMA_SxCR_EN)
+            taskYIELD();
+        if (!(*isr & (DMA_LISR_TCIF0 << shift)) || (*isr & ((DMA_LISR_TEIF0 | DMA_LISR_DMEIF0) << shift)))
+            return false;
+
+        data += count * 4;
+        words -= count;
+    }
+    return true;
+}
+
+#elif defined(CRC_CR_REV_IN) && defined(DMA_CCR_MEM2MEM)
+
+bool CrcService::FeedByDma(const uint8_t *data, unsigned int words)
+{
+    // The flags of the channel n+1 are at 4 * n. The channels are at 0x08 + 0x14 * n.
+    DMA_TypeDef *const controller = reinterpret_cast<DMA_TypeDef*>(reinterpret_cast<uintptr_t>(dma_) & ~0xFFu);
+    const unsigned int shift = ((reinterpret_cast<uintptr_t>(dma_) & 0xFFu) - 0x08u) / 0x14u * 4;
+    bool completed = true;
+
+    while (words > 0 && completed) {
+        const unsigned int count = std::min(words, CRC_SERVICE_DMA_MAX_WORDS);
+
+        controller->IFCR = DMA_IFCR_CGIF1 << shift;
+        // Memory to memory. From the memory port to the peripheral port.
+        dma_->CCR = 0;
+        dma_->CPAR = reinterpret_cast<uintptr_t>(&CRC->DR);
+        dma_->CMAR = reinterpret_cast<uintptr_t>(data);
+        dma_->CNDTR = count;
+        dma_->CCR = DMA_CCR_MEM2MEM | DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PSIZE_1 | DMA_CCR_MSIZE_1 | DMA_CCR_EN;
+
+        while (!(controller->ISR & ((DMA_ISR_TCIF1 | DMA_ISR_TEIF1) << shift)))
+            taskYIELD();
+        completed = !(controller->ISR & (DMA_ISR_TEIF1 << shift));
+        dma_->CCR = 0;
+
+        data += count * 4;
+        words -= count;
+    }
+    return completed;
+}
+
+#else
+
+bool CrcService::FeedByDma(const uint8_t *data, unsigned int words)
+{
+    return false;
+}
+
+#endif
+
+} /* namespace murasaki */
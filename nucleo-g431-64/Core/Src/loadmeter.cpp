@@ -0,0 +1,121 @@
+/**
+ * @file loadmeter.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Always-on CPU load meter with the moving averages.
+ */
+
+#include "loadmeter.hpp"
+#include "cyclecounter.hpp"
+#include "idletime.hpp"
+
+// Length of each average [sample].
+static const unsigned int kWindowSamples[] = { 1, 10, LOAD_METER_HISTORY };
+
+namespace murasaki {
+
+LoadMeter::LoadMeter(unsigned int report_period_ms)
+        :
+        report_samples_(report_period_ms / LOAD_METER_PERIOD_MS),
+        task_(nullptr),
+        head_(0),
+        count_(0),
+        last_idle_(0),
+        last_total_(0)
+{
+    // The idle hook measures by the cycle counter.
+    CycleCounter::Init();
+
+    for (unsigned int i = 0; i <= klmOneMinute; i++)
+        loads_[i] = 0;
+}
+
+void LoadMeter::Start()
+{
+    MURASAKI_ASSERT(nullptr == task_)
+
+    // Above the application tasks, to sample in time. The work of each period is short.
+    task_ = new murasaki::SimpleTask(
+                                     "loadmeter",
+                                     256,
+                                     murasaki::ktpHigh,
+                                     this,
+                                     &LoadMeter::TaskBody);
+    MURASAKI_ASSERT(nullptr != task_)
+
+    last_idle_ = IdleTime::GetCycles();
+    last_total_ = IdleTime::GetTotalCycles();
+
+    task_->Start();
+}
+
+unsigned int LoadMeter::GetLoad(LoadMeterWindow window) const
+{
+    MURASAKI_ASSERT(klmOneSecond <= window && window <= klmOneMinute)
+
+    return loads_[window];
+}
+
+void LoadMeter::Print() const
+{
+    const unsigned int second = loads_[klmOneSecond];
+    const unsigned int ten = loads_[klmTenSeconds];
+    const unsigned int minute = loads_[klmOneMinute];
+
+    murasaki::debugger->Printf("CPU load : %3u.%u%% (1s), %3u.%u%% (10s), %3u.%u%% (60s)\n",
+                               second / 10, second % 10,
+                               ten / 10, ten % 10,
+                               minute / 10, minute % 10);
+}
+
+void LoadMeter::TaskBody(const void *ptr)
+{
+    LoadMeter *const self = const_cast<LoadMeter*>(static_cast<const LoadMeter*>(ptr));
+    unsigned int samples = 0;
+
+    while (true) {
+        murasaki::Sleep(LOAD_METER_PERIOD_MS);
+
+        self->Sample();
+
+        if (0 < self->report_samples_ && ++samples >= self->report_samples_) {
+            samples = 0;
+            self->Print();
+        }
+    }
+}
+
+void LoadMeter::Sample()
+{
+    const uint32_t idle_now = IdleTime::GetCycles();
+    const uint32_t total_now = IdleTime::GetTotalCycles();
+    uint32_t idle = idle_now - last_idle_;
+    const uint32_t total = total_now - last_total_;
+
+    last_idle_ = idle_now;
+    last_total_ = total_now;
+    if (0 == total)
+        return;
+    if (idle > total)
+        idle = total;
+
+    history_[head_] = 1000 - static_cast<uint16_t>(static_cast<uint64_t>(idle) * 1000 / total);
+    head_ = (head_ + 1) % LOAD_METER_HISTORY;
+    if (count_ < LOAD_METER_HISTORY)
+        count_++;
+
+    // Walk back from the latest sample. The shorter window is the prefix of the longer one.
+    unsigned int sum = 0;
+    unsigned int window = klmOneSecond;
+
+    for (unsigned int i = 1; i <= count_; i++) {
+        sum += history_[(head_ + LOAD_METER_HISTORY - i) % LOAD_METER_HISTORY];
+        while (window <= klmOneMinute && (i == kWindowSamples[window] || i == count_)) {
+            loads_[window] = sum / i;
+            window++;
+        }
+    }
+}
+
+} /* namespace murasaki */
@@ -0,0 +1,111 @@
+/**
+ * @file uartfifo.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief FIFO mode of the UART on the STM32G0, G4, H5 and H7.
+ */
+
+#include "uartfifo.hpp"
+
+#if defined(HAL_UART_MODULE_ENABLED) && defined(USART_CR1_FIFOEN)
+#define UART_FIFO_SUPPORTED 1
+#else
+#define UART_FIFO_SUPPORTED 0
+#endif
+
+#if UART_FIFO_SUPPORTED
+// Indexed by the murasaki::UartFifoThreshold.
+static const uint32_t kTxThresholds[] = {
+        UART_TXFIFO_THRESHOLD_1_8, UART_TXFIFO_THRESHOLD_1_4, UART_TXFIFO_THRESHOLD_1_2,
+        UART_TXFIFO_THRESHOLD_3_4, UART_TXFIFO_THRESHOLD_7_8, UART_TXFIFO_THRESHOLD_8_8
+};
+static const uint32_t kRxThresholds[] = {
+        UART_RXFIFO_THRESHOLD_1_8, UART_RXFIFO_THRESHOLD_1_4, UART_RXFIFO_THRESHOLD_1_2,
+        UART_RXFIFO_THRESHOLD_3_4, UART_RXFIFO_THRESHOLD_7_8, UART_RXFIFO_THRESHOLD_8_8
+};
+static_assert(sizeof(kTxThresholds) / sizeof(kTxThresholds[0]) == murasaki::kuftFull + 1,
+              "Threshold must be given for all UartFifoThreshold.");
+#endif
+
+namespace murasaki {
+
+bool UartFifo::IsSupported(UART_HandleTypeDef *huart)
+{
+    MURASAKI_ASSERT(nullptr != huart)
+
+#if UART_FIFO_SUPPORTED
+    return IS_UART_FIFO_INSTANCE(huart->Instance);
+#else
+    return false;
+#endif
+}
+
+bool UartFifo::Enable(UART_HandleTypeDef *huart, UartFifoThreshold tx_threshold, UartFifoThreshold rx_threshold)
+{
+    MURASAKI_ASSERT(kuftOneEighth <= tx_threshold && tx_threshold <= kuftFull)
+    MURASAKI_ASSERT(kuftOneEighth <= rx_threshold && rx_threshold <= kuftFull)
+
+    if (!IsSupported(huart))
+        return false;
+
+#if UART_FIFO_SUPPORTED
+    // Each function disables the UART during the change, and restores the CR1.
+    // The bytes per interrupt of the HAL are updated by them, too.
+    return HAL_OK == HAL_UARTEx_SetTxFifoThreshold(huart, kTxThresholds[tx_threshold])
+            && HAL_OK == HAL_UARTEx_SetRxFifoThreshold(huart, kRxThresholds[rx_threshold])
+            && HAL_OK == HAL_UARTEx_EnableFifoMode(huart);
+#else
+    return false;
+#endif
+}
+
+bool UartFifo::Disable(UART_HandleTypeDef *huart)
+{
+    if (!IsSupported(huart))
+        return false;
+
+#if UART_FIFO_SUPPORTED
+    return HAL_OK == HAL_UARTEx_DisableFifoMode(huart);
+#else
+    return false;
+#endif
+}
+
+bool UartFifo::IsEnabled(UART_HandleTypeDef *huart)
+{
+    if (!IsSupported(huart))
+        return false;
+
+#if UART_FIFO_SUPPORTED
+    return UART_FIFOMODE_ENABLE == huart->FifoMode;
+#else
+    return false;
+#endif
+}
+
+unsigned int UartFifo::GetTxBytesPerInterrupt(UART_HandleTypeDef *huart)
+{
+    if (!IsEnabled(huart))
+        return 1;
+
+#if UART_FIFO_SUPPORTED
+    return huart->NbTxDataToProcess;
+#else
+    return 1;
+#endif
+}
+
+unsigned int UartFifo::GetRxBytesPerInterrupt(UART_HandleTypeDef *huart)
+{
+    if (!IsEnabled(huart))
+        return 1;
+
+#if UART_FIFO_SUPPORTED
+    return huart->NbRxDataToProcess;
+#else
+    return 1;
+#endif
+}
+
+} /* namespace murasaki */
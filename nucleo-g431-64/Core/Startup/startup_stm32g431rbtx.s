@@ -115,13 +115,13 @@ LoopForever:
  * @retval : None
 */
     .section	.text.Default_Handler,"ax",%progbits
-    .global CustomDefaultHandler
+    .global CrashRecordHandler
 Default_Handler:
 #if (__ARM_ARCH == 6 )
-  ldr r0, = CustomDefaultHandler
+  ldr r0, = CrashRecordHandler
   bx r0
 #else
-  b.w CustomDefaultHandler
+  b.w CrashRecordHandler
 #endif
 Infinite_Loop:
 	b	Infinite_Loop
@@ -0,0 +1,147 @@
+/**
+ * @file rtosbenchmark.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Micro benchmark of the RTOS primitives and the murasaki classes.
+ */
+
+#ifndef RTOSBENCHMARK_HPP_
+#define RTOSBENCHMARK_HPP_
+
+#include "murasaki.hpp"
+#include "crcservice.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace murasaki {
+
+/**
+ * @brief Cycle count benchmark of the operations the firmware does all day.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * Measures each operation by the @ref CycleCounter, and prints the result as CSV to the debugger console :
+ *
+ * @code
+ * board,clock_hz,benchmark,iterations,min_cycles,avg_cycles,max_cycles
+ * nucleo-f446-64,180000000,context_switch,1000,...
+ * @endcode
+ *
+ * The lines start with '#' are not a part of the table. The measured operations are :
+ * @li context_switch : xTaskNotifyGive() to a higher priority task, until the task runs.
+ * @li semaphore_give_take : xSemaphoreGive() and xSemaphoreTake() of a binary semaphore.
+ * @li queue_send_receive : xQueueSend() and xQueueReceive() of a 4 byte item.
+ * @li task_notify : xTaskNotifyGive() and ulTaskNotifyTake() to the calling task.
+ * @li sleep_0 : murasaki::Sleep(0).
+ * @li bitout_toggle : BitOutStrategy::Toggle(). Give the murasaki::BitOut to measure the HAL.
+ * @li debugger_printf : murasaki::Debugger::Printf() of a short line.
+ * @li new_delete : new and delete of 32 byte array.
+ * @li malloc_free : pvPortMalloc() and vPortFree() of 32 byte. The heap_4 of the FreeRTOS.
+ *
+ * RunBus() adds the rows of the multi-pin GPIO access :
+ * @li bitout_write_xN : BitOut::Set() of N pins one by one.
+ * @li busout_write_N : BusOut::Write() of N pins.
+ * @li busin_read_N : BusIn::Read() of N pins.
+ *
+ * RunDispatch() adds the rows of the I2C completion callback dispatch, with N instances :
+ * @li i2c_callback_search_N : Asking each object whether the handle is its own, as the global callback does.
+ *     The handle of the last object is given. That is the worst case.
+ * @li i2c_callback_registered_N : The function pointer of the handle, set by the @ref CallbackDispatcher.
+ *
+ * RunCrc() adds the rows of the checksum of N bytes, by the @ref CrcService :
+ * @li crc32_software_N, crc16_software_N : The table driven software.
+ * @li crc32_hardware_N, crc16_hardware_N : The CRC unit, written by the CPU. Including the lock of the service.
+ * @li crc32_dma_N : The CRC unit, fed by the DMA. Only with the DMA channel.
+ *
+ * The cost of reading the counter itself is subtracted from each sample. The max_cycles may
+ * include the interrupts and the tick. On Cortex-M0/M0+, the CycleCounter is an extension of the
+ * SysTick and its reading cost is larger.
+ *
+ * The benchmark must be run from a task. The other tasks should be idle during the benchmark.
+ */
+class RtosBenchmark
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param board Name of the board. Printed in the first column of the table.
+     * @param led GPIO to toggle in the bitout_toggle benchmark.
+     * @param iterations Number of the samples of each benchmark.
+     */
+    RtosBenchmark(const char *board, BitOutStrategy *led, unsigned int iterations = PLATFORM_CONFIG_BENCHMARK_ITERATIONS);
+    /**
+     * @brief Destructor
+     */
+    virtual ~RtosBenchmark();
+
+    /**
+     * @brief Run all benchmarks and print the table.
+     * @details
+     * Takes a few seconds. The debugger_printf benchmark prints some comment lines.
+     */
+    void Run();
+
+    /**
+     * @brief Run the multi-pin GPIO benchmarks and print the rows of the table.
+     * @param port GPIO port of the bus.
+     * @param pins Mask of the pins of the bus. The pins are driven by the benchmark.
+     * @details
+     * Compares the update of the pins by the individual murasaki::BitOut and by the @ref BusOut.
+     * Call after Run(). The rows follow the table of Run().
+     */
+    void RunBus(GPIO_TypeDef *port, uint16_t pins);
+
+    /**
+     * @brief Run the HAL callback dispatch benchmarks and print the rows of the table.
+     * @details
+     * Measures the cost from the HAL to the object in the interrupt, with 1 and 4 instances.
+     * The I2C handles of the benchmark are not connected to the hardware. Call after Run().
+     * The registered rows are skipped when the registered callbacks are disabled in the hal_conf.h.
+     */
+    void RunDispatch();
+
+    /**
+     * @brief Run the checksum benchmarks and print the rows of the table.
+     * @param dma Free DMA channel to feed the CRC unit. nullptr to skip the DMA rows.
+     * @details
+     * Compares the software and the CRC unit, on the 4KB image and on the frames. A comment line is printed if
+     * the results differ. The CRC unit must not be used by the other tasks. Call after Run().
+     */
+    void RunCrc(CrcDmaChannel *dma);
+
+    /**
+     * @brief Number of the samples of the debugger_printf. Limited to avoid the FIFO overflow.
+     */
+    static const unsigned int kPrintfIterations = 16;
+
+ private:
+    // Statistics of a benchmark.
+    void Begin();
+    void Sample(uint32_t start, uint32_t end);
+    void Report(const char *name);
+    void MeasureOverhead();
+    // Checksum of a buffer by the service. The software if the service is nullptr.
+    void MeasureCrc(const char *name, CrcService *service, bool crc16, const uint8_t *data, unsigned int size);
+
+    // Higher priority task for the context_switch benchmark.
+    static void SwitchTaskBody(void *ptr);
+
+    const char *const board_;
+    BitOutStrategy *const led_;
+    const unsigned int iterations_;
+    uint32_t overhead_;                  // Cycles to read the counter.
+    uint32_t min_;
+    uint32_t max_;
+    uint64_t sum_;
+    unsigned int count_;
+    TaskHandle_t caller_;
+    TaskHandle_t switch_task_;
+    volatile uint32_t switched_;         // Counter value when the SwitchTaskBody() wake up.
+    void *volatile allocated_;           // Keeps the new/delete from the optimization.
+    volatile unsigned int read_value_;   // Keeps the BusIn::Read() from the optimization.
+};
+
+} /* namespace murasaki */
+
+#endif /* RTOSBENCHMARK_HPP_ */
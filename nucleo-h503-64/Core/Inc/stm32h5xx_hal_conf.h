@@ -222,7 +222,7 @@
 #define  USE_HAL_NOR_REGISTER_CALLBACKS       0U    /* NOR register callback disabled       */
 #define  USE_HAL_HASH_REGISTER_CALLBACKS      0U    /* HASH register callback disabled      */
 #define  USE_HAL_HCD_REGISTER_CALLBACKS       0U    /* HCD register callback disabled       */
-#define  USE_HAL_I2C_REGISTER_CALLBACKS       0U    /* I2C register callback disabled       */
+#define  USE_HAL_I2C_REGISTER_CALLBACKS       1U    /* I2C register callback enabled        */
 #define  USE_HAL_I2S_REGISTER_CALLBACKS       0U    /* I2S register callback disabled       */
 #define  USE_HAL_I3C_REGISTER_CALLBACKS       0U    /* I3C register callback disabled       */
 #define  USE_HAL_IRDA_REGISTER_CALLBACKS      0U    /* IRDA register callback disabled      */
@@ -246,7 +246,7 @@
 #define  USE_HAL_SPI_REGISTER_CALLBACKS       0U    /* SPI register callback disabled       */
 #define  USE_HAL_SRAM_REGISTER_CALLBACKS      0U    /* SRAM register callback disabled      */
 #define  USE_HAL_TIM_REGISTER_CALLBACKS       0U    /* TIM register callback disabled       */
-#define  USE_HAL_UART_REGISTER_CALLBACKS      0U    /* UART register callback disabled      */
+#define  USE_HAL_UART_REGISTER_CALLBACKS      1U    /* UART register callback enabled       */
 #define  USE_HAL_USART_REGISTER_CALLBACKS     0U    /* USART register callback disabled     */
 #define  USE_HAL_WWDG_REGISTER_CALLBACKS      0U    /* WWDG register callback disabled      */
 #define  USE_HAL_XSPI_REGISTER_CALLBACKS      0U    /* XSPI register callback disabled      */
@@ -0,0 +1,326 @@
+/**
+ * @file clockprofile.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Selectable system clock profiles with the runtime switching.
+ */
+
+#include "clockprofile.hpp"
+#include "consolebaud.hpp"
+#include "ethtelemetry.hpp"
+#include "i2crecoveringmaster.hpp"
+#include "statusled.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Upper bound of the wait for the end of the UART transmission [mS].
+#define UART_DRAIN_TIMEOUT 100
+
+#if defined(STM32F446xx) || defined(STM32F746xx)
+#define CLOCK_PROFILE_SUPPORTED 1
+
+struct ClockSetting
+{
+    uint32_t sysclk;
+    uint32_t pllm;          // 0 : PLL is stopped. The SYSCLK is the 16MHz HSI.
+    uint32_t plln;
+    uint32_t pllp;
+    uint32_t pllq;
+    uint32_t voltage;
+    bool overdrive;
+    uint32_t apb1;
+    uint32_t apb2;
+    uint32_t latency;
+};
+
+// Time base of the HAL. Defined in the stm32xxxx_hal_timebase_tim.c.
+#define CLOCK_HAL_TIMEBASE htim14
+
+#if defined(STM32F446xx)
+// The PLL input is 1MHz from the HSI, as CubeIDE.
+#define CLOCK_PLL_SOURCE RCC_PLLSOURCE_HSI
+static const ClockSetting kClockSettings[] = {
+        { 16000000, 0, 0, 0, 0, PWR_REGULATOR_VOLTAGE_SCALE3, false, RCC_HCLK_DIV1, RCC_HCLK_DIV1, FLASH_LATENCY_0 },
+        { 84000000, 16, 336, RCC_PLLP_DIV4, 2, PWR_REGULATOR_VOLTAGE_SCALE3, false, RCC_HCLK_DIV2, RCC_HCLK_DIV1, FLASH_LATENCY_2 },
+        { 180000000, 16, 360, RCC_PLLP_DIV2, 8, PWR_REGULATOR_VOLTAGE_SCALE1, true, RCC_HCLK_DIV4, RCC_HCLK_DIV2, FLASH_LATENCY_5 },
+};
+#else
+// The PLL input is 2MHz from the 8MHz HSE of the ST-Link. The PLLQ is 48MHz.
+#define CLOCK_PLL_SOURCE RCC_PLLSOURCE_HSE
+static const ClockSetting kClockSettings[] = {
+        { 16000000, 0, 0, 0, 0, PWR_REGULATOR_VOLTAGE_SCALE3, false, RCC_HCLK_DIV1, RCC_HCLK_DIV1, FLASH_LATENCY_0 },
+        { 72000000, 4, 72, RCC_PLLP_DIV2, 3, PWR_REGULATOR_VOLTAGE_SCALE3, false, RCC_HCLK_DIV2, RCC_HCLK_DIV1, FLASH_LATENCY_2 },
+        { 216000000, 4, 216, RCC_PLLP_DIV2, 9, PWR_REGULATOR_VOLTAGE_SCALE1, true, RCC_HCLK_DIV4, RCC_HCLK_DIV2, FLASH_LATENCY_7 },
+};
+#endif
+
+#elif defined(STM32H743xx)
+#define CLOCK_PROFILE_SUPPORTED 1
+#define CLOCK_HAL_TIMEBASE htim17
+
+struct ClockSetting
+{
+    uint32_t sysclk;
+    uint32_t plln;
+    uint32_t pllp;
+    uint32_t pllq;
+    uint32_t voltage;
+    uint32_t ahb;           // AXI and AHB. The CPU runs at the PLL1P.
+    bool apb_div2;          // All APB.
+    uint32_t latency;
+};
+
+// The PLL1 input is 8MHz from the HSE of the ST-Link. The PLL1Q is 48MHz for the USB.
+static const ClockSetting kClockSettings[] = {
+        { 48000000, 48, 8, 8, PWR_REGULATOR_VOLTAGE_SCALE3, RCC_HCLK_DIV1, false, FLASH_LATENCY_1 },
+        { 96000000, 24, 2, 4, PWR_REGULATOR_VOLTAGE_SCALE1, RCC_HCLK_DIV1, false, FLASH_LATENCY_1 },
+        { 480000000, 120, 2, 20, PWR_REGULATOR_VOLTAGE_SCALE0, RCC_HCLK_DIV2, true, FLASH_LATENCY_4 },
+};
+// The rev.Y doesn't have the VOS0. 384MHz keeps the PLL1Q at 48MHz.
+static const ClockSetting kClockSettingRevY =
+        { 384000000, 96, 2, 16, PWR_REGULATOR_VOLTAGE_SCALE1, RCC_HCLK_DIV2, true, FLASH_LATENCY_2 };
+
+#else
+#define CLOCK_PROFILE_SUPPORTED 0
+#endif
+
+#if CLOCK_PROFILE_SUPPORTED
+extern TIM_HandleTypeDef CLOCK_HAL_TIMEBASE;
+
+static const ClockSetting& GetSetting(murasaki::ClockProfileLevel level)
+{
+#if defined(STM32H743xx)
+    if (murasaki::kcpMax == level && HAL_GetREVID() < REV_ID_V)
+        return kClockSettingRevY;
+#endif
+    return kClockSettings[level];
+}
+#endif
+
+namespace murasaki {
+
+ClockProfile::ClockProfile(UART_HandleTypeDef *uart, I2cRecoveringMaster *i2c_master, StatusLed *status_led)
+        :
+        uart_(uart),
+        i2c_master_(i2c_master),
+        status_led_(status_led),
+        level_(kcpBalanced)
+{
+}
+
+bool ClockProfile::Set(ClockProfileLevel level)
+{
+    if (!IsSupported(level))
+        return false;
+    if (level == level_)
+        return true;
+
+    // Wait for the end of the current I2C transfer. Can't block after the scheduler is suspended.
+    if (nullptr != i2c_master_)
+        i2c_master_->Suspend();
+
+    // No task can start the transmission from here.
+    vTaskSuspendAll();
+    DrainUart();
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+#if CLOCK_PROFILE_SUPPORTED
+    // Start at the tick boundary. Reading the CTRL clears the COUNTFLAG.
+    if (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk)
+        while (!(SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk))
+            ;
+    // The HAL time base counts in uS. HAL_InitTick() in the HAL_RCC_ClockConfig() clears it.
+    const uint32_t elapsed_us = CLOCK_HAL_TIMEBASE.Instance->CNT;
+#endif
+
+    const bool result = SwitchClock(level);
+
+#if CLOCK_PROFILE_SUPPORTED
+    CLOCK_HAL_TIMEBASE.Instance->CNT = elapsed_us;
+#endif
+    // The FreeRTOS port set the reload value at the start of the scheduler. Follow the new clock.
+    SysTick->LOAD = SystemCoreClock / configTICK_RATE_HZ - 1;
+    SysTick->VAL = 0;
+    RetimeUart();
+#ifdef HAL_ETH_MODULE_ENABLED
+    // The MDC follows the HCLK.
+    EthTelemetry::Retime();
+#endif
+
+    __set_PRIMASK(primask);
+    xTaskResumeAll();
+
+    if (nullptr != i2c_master_)
+        i2c_master_->Resume();
+    if (nullptr != status_led_)
+        status_led_->Retime();
+
+    if (result)
+        level_ = level;
+    return result;
+}
+
+ClockProfileLevel ClockProfile::Get() const
+{
+    return level_;
+}
+
+bool ClockProfile::IsSupported(ClockProfileLevel level)
+{
+#if CLOCK_PROFILE_SUPPORTED
+    return kcpLow <= level && level <= kcpMax;
+#else
+    // The CubeIDE configuration only.
+    return kcpBalanced == level;
+#endif
+}
+
+unsigned int ClockProfile::GetFrequency(ClockProfileLevel level)
+{
+    if (!IsSupported(level))
+        return 0;
+#if CLOCK_PROFILE_SUPPORTED
+    return GetSetting(level).sysclk;
+#else
+    return SystemCoreClock;
+#endif
+}
+
+void ClockProfile::DrainUart()
+{
+    if (nullptr == uart_)
+        return;
+
+    // TC stays cleared while the DMA feeds the data register.
+    const uint32_t start = HAL_GetTick();
+    while (!__HAL_UART_GET_FLAG(uart_, UART_FLAG_TC) && HAL_GetTick() - start < UART_DRAIN_TIMEOUT)
+        ;
+}
+
+void ClockProfile::RetimeUart()
+{
+    if (nullptr == uart_)
+        return;
+
+#if CLOCK_PROFILE_SUPPORTED
+    // The BRR and the oversampling for the new clock. A rate which the new clock can't make goes back to
+    // the default rate of the ConsoleBaud.
+    ConsoleBaud::Retime(uart_);
+#endif
+}
+
+bool ClockProfile::SwitchClock(ClockProfileLevel level)
+{
+#if CLOCK_PROFILE_SUPPORTED
+    RCC_OscInitTypeDef osc = { };
+    RCC_ClkInitTypeDef clk = { };
+
+#if defined(STM32H743xx)
+    const ClockSetting &setting = GetSetting(level);
+
+    // Step 1 : Run from the 64MHz HSI, to release the PLL1. It is slow enough for any VOS and wait states.
+    clk.ClockType = RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_D1PCLK1 | RCC_CLOCKTYPE_PCLK1
+            | RCC_CLOCKTYPE_PCLK2 | RCC_CLOCKTYPE_D3PCLK1;
+    clk.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+    clk.SYSCLKDivider = RCC_SYSCLK_DIV1;
+    clk.AHBCLKDivider = RCC_HCLK_DIV2;
+    clk.APB3CLKDivider = RCC_APB3_DIV2;
+    clk.APB1CLKDivider = RCC_APB1_DIV2;
+    clk.APB2CLKDivider = RCC_APB2_DIV2;
+    clk.APB4CLKDivider = RCC_APB4_DIV2;
+    if (HAL_OK != HAL_RCC_ClockConfig(&clk, __HAL_FLASH_GET_LATENCY()))
+        return false;
+
+    // Step 2 : Voltage scaling. The VOS0 needs the SYSCFG.
+    __HAL_RCC_SYSCFG_CLK_ENABLE();
+    __HAL_PWR_VOLTAGESCALING_CONFIG(setting.voltage);
+    while (!__HAL_PWR_GET_FLAG(PWR_FLAG_VOSRDY))
+        ;
+
+    // Step 3 : Re-configure the PLL1. The HAL stops it before the configuration.
+    osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    osc.PLL.PLLState = RCC_PLL_ON;
+    osc.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+    osc.PLL.PLLM = 1;
+    osc.PLL.PLLN = setting.plln;
+    osc.PLL.PLLP = setting.pllp;
+    osc.PLL.PLLQ = setting.pllq;
+    osc.PLL.PLLR = 2;
+    osc.PLL.PLLRGE = RCC_PLL1VCIRANGE_3;
+    osc.PLL.PLLVCOSEL = RCC_PLL1VCOWIDE;
+    osc.PLL.PLLFRACN = 0;
+    if (HAL_OK != HAL_RCC_OscConfig(&osc))
+        return false;
+
+    // Step 4 : Run from the PLL1. The HAL orders the dividers and the wait states.
+    clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+    clk.AHBCLKDivider = setting.ahb;
+    clk.APB3CLKDivider = setting.apb_div2 ? RCC_APB3_DIV2 : RCC_APB3_DIV1;
+    clk.APB1CLKDivider = setting.apb_div2 ? RCC_APB1_DIV2 : RCC_APB1_DIV1;
+    clk.APB2CLKDivider = setting.apb_div2 ? RCC_APB2_DIV2 : RCC_APB2_DIV1;
+    clk.APB4CLKDivider = setting.apb_div2 ? RCC_APB4_DIV2 : RCC_APB4_DIV1;
+    return HAL_OK == HAL_RCC_ClockConfig(&clk, setting.latency);
+#else
+    const ClockSetting &setting = GetSetting(level);
+
+    // Step 1 : Run from the 16MHz HSI, to release the PLL. The wait states are kept.
+    clk.ClockType = RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    clk.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+    clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+    clk.APB1CLKDivider = RCC_HCLK_DIV1;
+    clk.APB2CLKDivider = RCC_HCLK_DIV1;
+    if (HAL_OK != HAL_RCC_ClockConfig(&clk, __HAL_FLASH_GET_LATENCY()))
+        return false;
+    HAL_PWREx_DisableOverDrive();
+
+    // Step 2 : The VOS is writable only while the PLL is off.
+    osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    osc.PLL.PLLState = RCC_PLL_OFF;
+    if (HAL_OK != HAL_RCC_OscConfig(&osc))
+        return false;
+    __HAL_PWR_VOLTAGESCALING_CONFIG(setting.voltage);
+
+    if (0 == setting.pllm)
+        // Stay on the HSI. Decrease the wait states.
+        return HAL_OK == HAL_RCC_ClockConfig(&clk, setting.latency);
+
+    // Step 3 : Restart the PLL with the new multiplier.
+    osc.PLL.PLLState = RCC_PLL_ON;
+    osc.PLL.PLLSource = CLOCK_PLL_SOURCE;
+    osc.PLL.PLLM = setting.pllm;
+    osc.PLL.PLLN = setting.plln;
+    osc.PLL.PLLP = setting.pllp;
+    osc.PLL.PLLQ = setting.pllq;
+#if defined(RCC_PLLCFGR_PLLR)
+    osc.PLL.PLLR = 2;
+#endif
+    if (HAL_OK != HAL_RCC_OscConfig(&osc))
+        return false;
+    if (setting.overdrive && HAL_OK != HAL_PWREx_EnableOverDrive())
+        return false;
+
+    // Step 4 : Run from the PLL. The HAL orders the dividers and the wait states.
+    clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+    clk.APB1CLKDivider = setting.apb1;
+    clk.APB2CLKDivider = setting.apb2;
+    if (HAL_OK != HAL_RCC_ClockConfig(&clk, setting.latency))
+        return false;
+
+#if defined(FLASH_ACR_ARTEN)
+    // STM32F7. The code runs from the AXIM flash interface. The ART hides the wait states.
+    __HAL_FLASH_ART_ENABLE();
+    __HAL_FLASH_PREFETCH_BUFFER_ENABLE();
+#endif
+    return true;
+#endif
+#else
+    (void) level;
+    return false;
+#endif
+}
+
+} /* namespace murasaki */
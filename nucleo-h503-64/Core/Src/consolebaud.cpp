@@ -0,0 +1,294 @@
+/**
+ * @file consolebaud.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Runtime baud rate negotiation of the console UART.
+ */
+
+#include "consolebaud.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Upper bound of the wait for the end of the UART transmission [mS].
+#define UART_DRAIN_TIMEOUT 100
+// Largest error of the baud rate made by the BRR [1/1000]. The oversampling by 8 has the less margin.
+#define BAUD_ERROR_OVERSAMPLING_16 25
+#define BAUD_ERROR_OVERSAMPLING_8 20
+
+namespace murasaki {
+
+ConsoleBaud *ConsoleBaud::instance_ = nullptr;
+
+ConsoleBaud::ConsoleBaud(UART_HandleTypeDef *huart)
+        :
+        huart_(huart),
+        default_baud_rate_(huart->Init.BaudRate),
+        console_(nullptr),
+        task_(nullptr),
+        framing_errors_(0)
+{
+    MURASAKI_ASSERT(nullptr != huart)
+}
+
+bool ConsoleBaud::Negotiate(unsigned int window_ms)
+{
+    char line[CONSOLE_BAUD_LINE_SIZE];
+    unsigned int baud_rate = 0;
+    const uint32_t start = HAL_GetTick();
+
+    // The host tool repeats the request at the default rate, while the board boots.
+    while (0 == baud_rate) {
+        if (!ReceiveLine(line, sizeof(line), start, window_ms))
+            return false;
+        if (0 == std::strncmp(line, "BAUD ", 5))
+            baud_rate = std::strtoul(line + 5, nullptr, 10);
+    }
+
+    // Try the rate before the answer. The answer must be at the rate of the host tool.
+    if (!SetBaudRate(huart_, baud_rate)) {
+        Send("NAK\r\n");
+        return false;
+    }
+    SetBaudRate(huart_, default_baud_rate_);
+    Send("ACK\r\n");
+    SetBaudRate(huart_, baud_rate);
+
+    // The host tool repeats the SYNC at the new rate. The broken lines are ignored.
+    const uint32_t sync_start = HAL_GetTick();
+    while (ReceiveLine(line, sizeof(line), sync_start, CONSOLE_BAUD_SYNC_TIMEOUT))
+        if (0 == std::strcmp(line, "SYNC")) {
+            Send("SYNC\r\n");
+            return true;
+        }
+
+    SetBaudRate(huart_, default_baud_rate_);
+    return false;
+}
+
+void ConsoleBaud::Start(UartStrategy *console)
+{
+    MURASAKI_ASSERT(nullptr != console)
+    MURASAKI_ASSERT(nullptr == task_)
+    MURASAKI_ASSERT(nullptr == instance_)
+
+    console_ = console;
+    instance_ = this;
+#if defined(HAL_UART_MODULE_ENABLED) && (USE_HAL_UART_REGISTER_CALLBACKS == 1)
+    // Replaces the error trampoline of the CallbackDispatcher. The console still gets the error.
+    HAL_UART_RegisterCallback(huart_, HAL_UART_ERROR_CB_ID, &ConsoleBaud::ErrorCallback);
+#endif
+
+    task_ = new murasaki::SimpleTask(
+                                     "consolebaud",
+                                     256,
+                                     murasaki::ktpHigh,
+                                     this,
+                                     &ConsoleBaud::TaskBody);
+    MURASAKI_ASSERT(nullptr != task_)
+
+    task_->Start();
+}
+
+void ConsoleBaud::FallBack()
+{
+    // No task can start the transmission from here. TC stays cleared while the DMA feeds the data register.
+    vTaskSuspendAll();
+    const uint32_t start = HAL_GetTick();
+    while (!__HAL_UART_GET_FLAG(huart_, UART_FLAG_TC) && HAL_GetTick() - start < UART_DRAIN_TIMEOUT)
+        ;
+    SetBaudRate(huart_, default_baud_rate_);
+    xTaskResumeAll();
+}
+
+unsigned int ConsoleBaud::GetBaudRate() const
+{
+    return huart_->Init.BaudRate;
+}
+
+unsigned int ConsoleBaud::GetFramingErrors() const
+{
+    return framing_errors_;
+}
+
+bool ConsoleBaud::SetBaudRate(UART_HandleTypeDef *huart, unsigned int baud_rate)
+{
+    MURASAKI_ASSERT(nullptr != huart)
+
+    if (0 == baud_rate)
+        return false;
+
+#if defined(UART_BRR_SAMPLING16)
+    // STM32F4 / L1. The UART_SetConfig() of the HAL is static. The BRR is writable while UE = 1.
+    uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+    if (huart->Instance == USART1)
+        pclk = HAL_RCC_GetPCLK2Freq();
+#if defined(USART6)
+    if (huart->Instance == USART6)
+        pclk = HAL_RCC_GetPCLK2Freq();
+#endif
+
+    // 16 x USARTDIV for the oversampling by 16, 8 x USARTDIV for the oversampling by 8.
+    const uint32_t divider = (pclk + baud_rate / 2) / baud_rate;
+    uint32_t oversampling;
+    uint32_t brr;
+
+    if (16 <= divider) {
+        oversampling = UART_OVERSAMPLING_16;
+        brr = divider;
+    }
+    else if (8 <= divider) {
+        // The fraction is 3 bits. BRR[3] must be 0.
+        oversampling = UART_OVERSAMPLING_8;
+        brr = ((divider >> 3) << 4) | (divider & 0x7);
+    }
+    else
+        return false;
+    if (0xFFFF < brr)
+        return false;
+
+    // The rounded divider may be far from the rate. For example, 4Mbaud from 42MHz is 4.5% slow.
+    const uint64_t made = static_cast<uint64_t>(baud_rate) * divider;
+    const uint64_t error = (made > pclk) ? made - pclk : pclk - made;
+    if (error * 1000 > made * ((UART_OVERSAMPLING_16 == oversampling) ?
+                               BAUD_ERROR_OVERSAMPLING_16 : BAUD_ERROR_OVERSAMPLING_8))
+        return false;
+
+    if (oversampling == huart->Init.OverSampling)
+        huart->Instance->BRR = brr;
+    else {
+        // The OVER8 is changed while UE = 0.
+        __HAL_UART_DISABLE(huart);
+        MODIFY_REG(huart->Instance->CR1, USART_CR1_OVER8, oversampling);
+        huart->Instance->BRR = brr;
+        __HAL_UART_ENABLE(huart);
+    }
+    huart->Init.OverSampling = oversampling;
+    huart->Init.BaudRate = baud_rate;
+    return true;
+#else
+    // The other series. UART_SetConfig() computes the BRR from the kernel clock, including the prescaler
+    // and the LPUART. The BRR is writable only while UE = 0. The interrupt enables are kept.
+    const UART_InitTypeDef saved = huart->Init;
+#if defined(USART_CR1_FIFOEN)
+    // UART_SetConfig() also rewrites the FIFO thresholds in the CR3. Keep the ones of the UartFifo.
+    const uint32_t thresholds = READ_BIT(huart->Instance->CR3, USART_CR3_TXFTCFG | USART_CR3_RXFTCFG);
+#endif
+    HAL_StatusTypeDef status;
+
+    __HAL_UART_DISABLE(huart);
+    huart->Init.BaudRate = baud_rate;
+    huart->Init.OverSampling = UART_OVERSAMPLING_16;
+    status = UART_SetConfig(huart);
+#if defined(LPUART1)
+    // The LPUART has no oversampling.
+    if (HAL_OK != status && !IS_LPUART_INSTANCE(huart->Instance))
+#else
+    if (HAL_OK != status)
+#endif
+    {
+        huart->Init.OverSampling = UART_OVERSAMPLING_8;
+        status = UART_SetConfig(huart);
+    }
+    if (HAL_OK != status) {
+        huart->Init = saved;
+        UART_SetConfig(huart);
+    }
+#if defined(USART_CR1_FIFOEN)
+    // UART_SetConfig() clears the FIFOEN and the thresholds. Restore them. The NbTxDataToProcess and the
+    // NbRxDataToProcess of the handle still match.
+    MODIFY_REG(huart->Instance->CR3, USART_CR3_TXFTCFG | USART_CR3_RXFTCFG, thresholds);
+    if (UART_FIFOMODE_ENABLE == huart->FifoMode)
+        SET_BIT(huart->Instance->CR1, USART_CR1_FIFOEN);
+#endif
+    __HAL_UART_ENABLE(huart);
+    return HAL_OK == status;
+#endif
+}
+
+bool ConsoleBaud::Retime(UART_HandleTypeDef *huart)
+{
+    MURASAKI_ASSERT(nullptr != huart)
+
+    if (SetBaudRate(huart, huart->Init.BaudRate))
+        return true;
+
+    // The old BRR would stream the garbage forever.
+    if (nullptr != instance_ && huart == instance_->huart_)
+        SetBaudRate(huart, instance_->default_baud_rate_);
+    return false;
+}
+
+void ConsoleBaud::TaskBody(const void *ptr)
+{
+    ConsoleBaud *const self = const_cast<ConsoleBaud*>(static_cast<const ConsoleBaud*>(ptr));
+    unsigned int last_errors = self->framing_errors_;
+
+    while (true) {
+        murasaki::Sleep(CONSOLE_BAUD_CHECK_PERIOD);
+
+        const unsigned int errors = self->framing_errors_;
+        const unsigned int new_errors = errors - last_errors;
+
+        last_errors = errors;
+        if (new_errors >= CONSOLE_BAUD_MAX_ERRORS && self->GetBaudRate() != self->default_baud_rate_) {
+            self->FallBack();
+            murasaki::debugger->Printf("Console baud rate : fell back to %u baud by %u framing errors\n",
+                                       self->default_baud_rate_,
+                                       new_errors);
+        }
+    }
+}
+
+void ConsoleBaud::ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->ErrorCode & HAL_UART_ERROR_FE)
+        instance_->framing_errors_ = instance_->framing_errors_ + 1;
+    instance_->console_->HandleError(huart);
+}
+
+bool ConsoleBaud::ReceiveLine(char *line, unsigned int size, uint32_t start, unsigned int timeout_ms)
+{
+    unsigned int length = 0;
+
+    while (true) {
+        const uint32_t elapsed = HAL_GetTick() - start;
+        uint8_t c;
+
+        if (elapsed >= timeout_ms)
+            return false;
+
+        // The overrun and the framing error of the previous byte must not stop the reception.
+        if (__HAL_UART_GET_FLAG(huart_, UART_FLAG_ORE))
+            __HAL_UART_CLEAR_OREFLAG(huart_);
+        if (__HAL_UART_GET_FLAG(huart_, UART_FLAG_FE))
+            __HAL_UART_CLEAR_FEFLAG(huart_);
+
+        if (HAL_OK != HAL_UART_Receive(huart_, &c, 1, timeout_ms - elapsed))
+            continue;
+
+        if ('\r' == c || '\n' == c) {
+            if (0 == length)
+                continue;
+            line[length] = '\0';
+            return true;
+        }
+        if (length < size - 1)
+            line[length++] = c;
+    }
+}
+
+void ConsoleBaud::Send(const char *message)
+{
+    // Returns after the last stop bit.
+    HAL_UART_Transmit(huart_,
+                      reinterpret_cast<const uint8_t*>(message),
+                      std::strlen(message),
+                      UART_DRAIN_TIMEOUT);
+}
+
+} /* namespace murasaki */
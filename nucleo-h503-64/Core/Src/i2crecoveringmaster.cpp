@@ -0,0 +1,402 @@
+/**
+ * @file i2crecoveringmaster.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief I2C master with the bus recovery and the error accounting.
+ */
+
+#include "i2crecoveringmaster.hpp"
+#include "callbackdispatcher.hpp"
+#include "cyclecounter.hpp"
+#include "i2ctiming.hpp"
+
+#include <string.h>
+
+// Number of the SCL pulses to release the SDA held by a slave. 8 data bits and 1 ACK.
+#define I2C_RECOVERY_CLOCKS 9
+
+namespace murasaki {
+
+I2cRecoveringMaster::I2cRecoveringMaster(
+                                         I2C_HandleTypeDef *i2c_handle,
+                                         GPIO_TypeDef *scl_port,
+                                         uint16_t scl_pin,
+                                         GPIO_TypeDef *sda_port,
+                                         uint16_t sda_pin,
+                                         WaitMilliSeconds transfer_timeout_ms,
+                                         unsigned int max_retries)
+        :
+        peripheral_(i2c_handle),
+        master_(new I2cMaster(i2c_handle)),
+        scl_port_(scl_port),
+        scl_pin_(scl_pin),
+        sda_port_(sda_port),
+        sda_pin_(sda_pin),
+        transfer_timeout_ms_(transfer_timeout_ms),
+        max_retries_(max_retries),
+        critical_section_(new CriticalSection()),
+        recoveries_(0),
+        failed_recoveries_(0),
+        max_recovery_cycles_(0),
+        bus_errors_(0),
+        arbitration_losts_(0),
+        overruns_(0),
+        acknowledge_failures_(0)
+{
+    MURASAKI_ASSERT(nullptr != peripheral_)
+    MURASAKI_ASSERT(nullptr != master_)
+    MURASAKI_ASSERT(nullptr != scl_port_)
+    MURASAKI_ASSERT(nullptr != sda_port_)
+    MURASAKI_ASSERT(nullptr != critical_section_)
+
+    ::memset(devices_, 0, sizeof(devices_));
+    for (unsigned int i = 0; i < kMaxDevices; i++)
+        devices_[i].addrs = kEmptySlot;
+
+    CycleCounter::Init();
+
+    // The HAL calls this object directly, instead of the global callbacks.
+    CallbackDispatcher::Register(peripheral_, this);
+}
+
+I2cRecoveringMaster::~I2cRecoveringMaster()
+{
+    CallbackDispatcher::Unregister(peripheral_);
+    delete master_;
+    delete critical_section_;
+}
+
+I2cStatus I2cRecoveringMaster::Transmit(
+                                        unsigned int addrs,
+                                        const uint8_t *tx_data,
+                                        unsigned int tx_size,
+                                        unsigned int *transfered_count,
+                                        unsigned int timeout_ms)
+{
+    return DoTransfer(kttTransmit, addrs, tx_data, tx_size, nullptr, 0, transfered_count, nullptr, timeout_ms);
+}
+
+I2cStatus I2cRecoveringMaster::Receive(
+                                       unsigned int addrs,
+                                       uint8_t *rx_data,
+                                       unsigned int rx_size,
+                                       unsigned int *transfered_count,
+                                       unsigned int timeout_ms)
+{
+    return DoTransfer(kttReceive, addrs, nullptr, 0, rx_data, rx_size, nullptr, transfered_count, timeout_ms);
+}
+
+I2cStatus I2cRecoveringMaster::TransmitThenReceive(
+                                                   unsigned int addrs,
+                                                   const uint8_t *tx_data,
+                                                   unsigned int tx_size,
+                                                   uint8_t *rx_data,
+                                                   unsigned int rx_size,
+                                                   unsigned int *tx_transfered_count,
+                                                   unsigned int *rx_transfered_count,
+                                                   unsigned int timeout_ms)
+{
+    return DoTransfer(
+                      kttTransmitThenReceive,
+                      addrs,
+                      tx_data,
+                      tx_size,
+                      rx_data,
+                      rx_size,
+                      tx_transfered_count,
+                      rx_transfered_count,
+                      timeout_ms);
+}
+
+bool I2cRecoveringMaster::TransmitCompleteCallback(void *ptr)
+{
+    return master_->TransmitCompleteCallback(ptr);
+}
+
+bool I2cRecoveringMaster::ReceiveCompleteCallback(void *ptr)
+{
+    return master_->ReceiveCompleteCallback(ptr);
+}
+
+bool I2cRecoveringMaster::HandleError(void *ptr)
+{
+    if (ptr != peripheral_)
+        return false;
+
+    // Called from the I2C error interrupt. Just count.
+    const uint32_t error_code = peripheral_->ErrorCode;
+
+    if (error_code & HAL_I2C_ERROR_BERR)
+        bus_errors_++;
+    if (error_code & HAL_I2C_ERROR_ARLO)
+        arbitration_losts_++;
+    if (error_code & HAL_I2C_ERROR_OVR)
+        overruns_++;
+    if (error_code & HAL_I2C_ERROR_AF)
+        acknowledge_failures_++;
+
+    return master_->HandleError(ptr);
+}
+
+bool I2cRecoveringMaster::Recover()
+{
+    bool released;
+
+    critical_section_->Enter();
+    released = RecoverInternal();
+    critical_section_->Leave();
+
+    return released;
+}
+
+void I2cRecoveringMaster::Suspend()
+{
+    critical_section_->Enter();
+}
+
+bool I2cRecoveringMaster::Resume()
+{
+    bool retimed = I2cTiming::Retime(peripheral_);
+
+    critical_section_->Leave();
+    return retimed;
+}
+
+const I2cDeviceStatistics* I2cRecoveringMaster::GetDeviceStatistics(unsigned int addrs) const
+{
+    for (unsigned int i = 0; i < kMaxDevices; i++)
+        if (devices_[i].addrs == addrs)
+            return &devices_[i];
+
+    return nullptr;
+}
+
+void I2cRecoveringMaster::PrintStatistics() const
+{
+    murasaki::debugger->Printf("\n            I2C bus statistics \n");
+    murasaki::debugger->Printf("Recoveries : %d ( failed %d ), longest %d uS\n",
+                               recoveries_,
+                               failed_recoveries_,
+                               CycleCounter::CyclesToMicroSeconds(max_recovery_cycles_));
+    murasaki::debugger->Printf("Interrupt  : bus error %d, arbitration lost %d, overrun %d, NAK %d\n",
+                               bus_errors_,
+                               arbitration_losts_,
+                               overruns_,
+                               acknowledge_failures_);
+    murasaki::debugger->Printf("addrs | transfers       naks     errors    retries\n");
+    murasaki::debugger->Printf("------+-------------------------------------------\n");
+
+    for (unsigned int i = 0; i < kMaxDevices; i++)
+        if (devices_[i].addrs != kEmptySlot)
+            murasaki::debugger->Printf("   %2x | %9d %10d %10d %10d\n",
+                                       devices_[i].addrs,
+                                       devices_[i].transfers,
+                                       devices_[i].naks,
+                                       devices_[i].errors,
+                                       devices_[i].retries);
+}
+
+I2cStatus I2cRecoveringMaster::DoTransfer(
+                                          TransferType type,
+                                          unsigned int addrs,
+                                          const uint8_t *tx_data,
+                                          unsigned int tx_size,
+                                          uint8_t *rx_data,
+                                          unsigned int rx_size,
+                                          unsigned int *tx_transfered_count,
+                                          unsigned int *rx_transfered_count,
+                                          unsigned int timeout_ms)
+{
+    I2cStatus status = ki2csUnknown;
+    unsigned int errors = 0;
+    unsigned int retries = 0;
+
+    // Never wait longer than the limit, even if the caller wants to wait forever.
+    if (timeout_ms > transfer_timeout_ms_)
+        timeout_ms = transfer_timeout_ms_;
+
+    critical_section_->Enter();
+
+    // A slave is holding SDA. The transfer will fail anyway. Don't wait for the timeout.
+    if (!IsSdaHigh())
+        RecoverInternal();
+
+    for (unsigned int attempt = 0;; attempt++) {
+        switch (type)
+        {
+            case kttTransmit:
+                status = master_->Transmit(addrs, tx_data, tx_size, tx_transfered_count, timeout_ms);
+                break;
+            case kttReceive:
+                status = master_->Receive(addrs, rx_data, rx_size, rx_transfered_count, timeout_ms);
+                break;
+            default:
+                status = master_->TransmitThenReceive(
+                                                      addrs,
+                                                      tx_data,
+                                                      tx_size,
+                                                      rx_data,
+                                                      rx_size,
+                                                      tx_transfered_count,
+                                                      rx_transfered_count,
+                                                      timeout_ms);
+                break;
+        }
+
+        if (ki2csOK == status || ki2csNak == status)
+            break;
+
+        errors++;
+        if (!NeedsRecovery(status))
+            break;
+
+        RecoverInternal();
+
+        if (attempt >= max_retries_)
+            break;
+        retries++;
+    }
+
+    // The NAK only devices are not registered, to keep the table for the real devices.
+    // For example, the bus scan makes NAK on every empty address.
+    I2cDeviceStatistics *device = FindDevice(addrs, ki2csNak != status || errors != 0);
+    if (nullptr != device) {
+        device->transfers++;
+        if (ki2csNak == status)
+            device->naks++;
+        device->errors += errors;
+        device->retries += retries;
+    }
+
+    critical_section_->Leave();
+
+    return status;
+}
+
+bool I2cRecoveringMaster::RecoverInternal()
+{
+    const uint32_t start = CycleCounter::Get();
+    const uint32_t limit = CycleCounter::MicroSecondsToCycles(kRecoveryLimitUs);
+    bool in_time = true;
+
+    // Take the pins from the I2C peripheral.
+    HAL_I2C_DeInit(peripheral_);
+    ConfigurePins(true);
+
+    // Clock out until the slave releases the SDA.
+    for (unsigned int i = 0; i < I2C_RECOVERY_CLOCKS && in_time && !IsSdaHigh(); i++) {
+        HAL_GPIO_WritePin(scl_port_, scl_pin_, GPIO_PIN_RESET);
+        CycleCounter::DelayMicroSeconds(kHalfClockUs);
+        HAL_GPIO_WritePin(scl_port_, scl_pin_, GPIO_PIN_SET);
+        in_time = WaitForSclHigh(start, limit);
+        CycleCounter::DelayMicroSeconds(kHalfClockUs);
+    }
+
+    // STOP condition. SDA rises while SCL is high.
+    if (in_time) {
+        HAL_GPIO_WritePin(scl_port_, scl_pin_, GPIO_PIN_RESET);
+        CycleCounter::DelayMicroSeconds(kHalfClockUs);
+        HAL_GPIO_WritePin(sda_port_, sda_pin_, GPIO_PIN_RESET);
+        CycleCounter::DelayMicroSeconds(kHalfClockUs);
+        HAL_GPIO_WritePin(scl_port_, scl_pin_, GPIO_PIN_SET);
+        in_time = WaitForSclHigh(start, limit);
+        CycleCounter::DelayMicroSeconds(kHalfClockUs);
+        HAL_GPIO_WritePin(sda_port_, sda_pin_, GPIO_PIN_SET);
+        CycleCounter::DelayMicroSeconds(kHalfClockUs);
+    }
+
+    const bool released = in_time && IsSdaHigh();
+
+    // Give the pins back to the I2C peripheral. HAL_I2C_MspInit() configures them.
+    ConfigurePins(false);
+    HAL_I2C_Init(peripheral_);
+    // The initialization from the reset state restored the default callbacks.
+    CallbackDispatcher::Register(peripheral_, this);
+
+    const uint32_t cycles = CycleCounter::Get() - start;
+    if (cycles > max_recovery_cycles_)
+        max_recovery_cycles_ = cycles;
+    recoveries_++;
+    if (!released)
+        failed_recoveries_++;
+
+    return released;
+}
+
+bool I2cRecoveringMaster::WaitForSclHigh(uint32_t start, uint32_t limit)
+{
+    // A slave may stretch the clock.
+    while (GPIO_PIN_RESET == HAL_GPIO_ReadPin(scl_port_, scl_pin_))
+        if (CycleCounter::Get() - start > limit)
+            return false;
+
+    return true;
+}
+
+bool I2cRecoveringMaster::IsSdaHigh()
+{
+    // The input buffer is alive in the alternate function mode, too.
+    return GPIO_PIN_SET == HAL_GPIO_ReadPin(sda_port_, sda_pin_);
+}
+
+void I2cRecoveringMaster::ConfigurePins(bool gpio)
+{
+    if (gpio) {
+        GPIO_InitTypeDef GPIO_InitStruct = { 0 };
+
+        // Release both lines before switching to the output.
+        HAL_GPIO_WritePin(scl_port_, scl_pin_, GPIO_PIN_SET);
+        HAL_GPIO_WritePin(sda_port_, sda_pin_, GPIO_PIN_SET);
+
+        GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+        GPIO_InitStruct.Pull = GPIO_NOPULL;
+        GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+
+        GPIO_InitStruct.Pin = scl_pin_;
+        HAL_GPIO_Init(scl_port_, &GPIO_InitStruct);
+        GPIO_InitStruct.Pin = sda_pin_;
+        HAL_GPIO_Init(sda_port_, &GPIO_InitStruct);
+    }
+    else {
+        HAL_GPIO_DeInit(scl_port_, scl_pin_);
+        HAL_GPIO_DeInit(sda_port_, sda_pin_);
+    }
+}
+
+I2cDeviceStatistics* I2cRecoveringMaster::FindDevice(unsigned int addrs, bool allocate)
+{
+    for (unsigned int i = 0; i < kMaxDevices; i++)
+        if (devices_[i].addrs == addrs)
+            return &devices_[i];
+
+    if (allocate)
+        for (unsigned int i = 0; i < kMaxDevices; i++)
+            if (devices_[i].addrs == kEmptySlot) {
+                devices_[i].addrs = addrs;
+                return &devices_[i];
+            }
+
+    return nullptr;
+}
+
+bool I2cRecoveringMaster::NeedsRecovery(I2cStatus status)
+{
+    switch (status)
+    {
+        case ki2csTimeOut:
+        case ki2csBussError:
+        case ki2csArbitrationLost:
+        case ki2csUnknown:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void* I2cRecoveringMaster::GetPeripheralHandle()
+{
+    return peripheral_;
+}
+
+} /* namespace murasaki */
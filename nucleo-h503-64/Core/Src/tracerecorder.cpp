@@ -0,0 +1,175 @@
+/**
+ * @file tracerecorder.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Kernel trace recorder.
+ * @details
+ * The hooks are called from the kernel with the interrupt disabled or inside the scheduler,
+ * and from the interrupt handlers. The record is protected by PRIMASK.
+ */
+
+#include "FreeRTOS.h"        // TRACE_RECORDER_ENABLE is defined in the FreeRTOSConfig.h
+#include "tracerecorder.h"
+#include "cyclecounter.hpp"
+#include "murasaki.hpp"
+
+#include <cstring>
+
+#if TRACE_RECORDER_ENABLE
+
+// Printing the buffer.
+#define TRACE_PRINT_LINES_PER_BURST 16
+#define TRACE_PRINT_INTERVAL_MS 50
+
+#define TRACE_OBJECT_NAME_LENGTH 12
+
+namespace {
+
+// An entry of the ring buffer.
+struct TraceEntry {
+    uint32_t timestamp;    // CycleCounter::Get()
+    uint16_t object;       // Address of the task or queue, or the exception number for the ISR.
+    uint8_t event;         // TRACE_EVENT_*
+    uint8_t value;         // Messages in the queue before the operation.
+};
+
+struct TraceObject {
+    uint16_t id;
+    uint8_t kind;          // TRACE_OBJECT_*
+    char name[TRACE_OBJECT_NAME_LENGTH + 1];
+};
+
+TraceEntry entries[TRACE_RECORDER_BUFFER_SIZE];
+unsigned int head = 0;          // Next entry to write.
+unsigned int count = 0;         // Number of the valid entries.
+unsigned int lost = 0;          // Number of the overwritten entries.
+volatile bool recording = false;
+
+TraceObject objects[TRACE_RECORDER_MAX_OBJECTS];
+unsigned int object_count = 0;
+
+// 16bit ID of the object. The objects are word aligned in the heap. So, the lower 2 bits are not used.
+inline uint16_t ObjectId(const void *object)
+{
+    return static_cast<uint16_t>(reinterpret_cast<uintptr_t>(object) >> 2);
+}
+
+void Store(uint8_t event, uint16_t object, uint8_t value)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (recording) {
+        TraceEntry &entry = entries[head];
+
+        entry.timestamp = murasaki::CycleCounter::Get();
+        entry.object = object;
+        entry.event = event;
+        entry.value = value;
+        head = (head + 1) % TRACE_RECORDER_BUFFER_SIZE;
+        if (count < TRACE_RECORDER_BUFFER_SIZE)
+            count++;
+        else
+            lost++;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+}  // namespace
+
+void TraceStart(void)
+{
+    murasaki::CycleCounter::Init();
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    head = 0;
+    count = 0;
+    lost = 0;
+    recording = true;
+    __set_PRIMASK(primask);
+}
+
+void TraceStop(void)
+{
+    recording = false;
+}
+
+void TraceRecord(uint8_t event, const void *object, uint8_t value)
+{
+    Store(event, ObjectId(object), value);
+}
+
+void TraceRecordIsr(uint8_t event)
+{
+    Store(event, static_cast<uint16_t>(__get_IPSR()), 0);
+}
+
+void TraceRegisterObject(const void *object, const char *name, uint8_t kind)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // The tasks and queues are created in the initialization. The later ones are not named.
+    if (object_count < TRACE_RECORDER_MAX_OBJECTS && nullptr != name) {
+        TraceObject &entry = objects[object_count++];
+
+        entry.id = ObjectId(object);
+        entry.kind = kind;
+        std::strncpy(entry.name, name, TRACE_OBJECT_NAME_LENGTH);
+        entry.name[TRACE_OBJECT_NAME_LENGTH] = '\0';
+    }
+
+    __set_PRIMASK(primask);
+}
+
+void TraceTick(void)
+{
+#if !defined(DWT_CTRL_CYCCNTENA_Msk)
+    // The SysTick based counter must be read every tick to extend it.
+    if (recording)
+        murasaki::CycleCounter::Get();
+#endif
+}
+
+void TracePrint(void)
+{
+    unsigned int lines = 0;
+    // The oldest entry.
+    unsigned int index = (head + TRACE_RECORDER_BUFFER_SIZE - count) % TRACE_RECORDER_BUFFER_SIZE;
+
+    MURASAKI_ASSERT(!recording)
+
+    murasaki::debugger->Printf("#trace begin version=1 clock=%u entries=%u lost=%u\n",
+                               static_cast<unsigned int>(SystemCoreClock),
+                               count,
+                               lost);
+
+    for (unsigned int i = 0; i < object_count; i++) {
+        murasaki::debugger->Printf("#object %04x %s %s\n",
+                                   objects[i].id,
+                                   (TRACE_OBJECT_TASK == objects[i].kind) ? "task" : "queue",
+                                   objects[i].name);
+        if (++lines % TRACE_PRINT_LINES_PER_BURST == 0)
+            murasaki::Sleep(TRACE_PRINT_INTERVAL_MS);
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        const TraceEntry &entry = entries[index];
+
+        murasaki::debugger->Printf("%08x %02x %04x %u\n",
+                                   static_cast<unsigned int>(entry.timestamp),
+                                   entry.event,
+                                   entry.object,
+                                   entry.value);
+        index = (index + 1) % TRACE_RECORDER_BUFFER_SIZE;
+        if (++lines % TRACE_PRINT_LINES_PER_BURST == 0)
+            murasaki::Sleep(TRACE_PRINT_INTERVAL_MS);
+    }
+
+    murasaki::debugger->Printf("#trace end\n");
+}
+
+#endif /* TRACE_RECORDER_ENABLE */
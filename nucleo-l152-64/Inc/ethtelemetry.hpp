@@ -0,0 +1,196 @@
+/**
+ * @file ethtelemetry.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Zero-copy UDP telemetry sink on the Ethernet.
+ */
+
+#ifndef ETHTELEMETRY_HPP_
+#define ETHTELEMETRY_HPP_
+
+#include "murasaki.hpp"
+
+// Number of the frame buffers. One is filled while the others are in the Tx descriptors.
+#define ETH_TELEMETRY_BUFFER_COUNT 6
+// Size of each frame buffer [byte]. Multiple of the cache line.
+#define ETH_TELEMETRY_BUFFER_SIZE 1536
+// Ethernet, IPv4 and UDP headers at the top of the frame buffer [byte].
+#define ETH_TELEMETRY_HEADER_SIZE 42
+// Sequence number at the top of the UDP payload [byte].
+#define ETH_TELEMETRY_SEQUENCE_SIZE 4
+// Largest payload of a frame without the IP fragmentation. MTU 1500 minus IPv4 and UDP headers [byte].
+#define ETH_TELEMETRY_PAYLOAD_SIZE 1472
+// Largest record. The payload without the sequence number [byte].
+#define ETH_TELEMETRY_MAX_RECORD (ETH_TELEMETRY_PAYLOAD_SIZE - ETH_TELEMETRY_SEQUENCE_SIZE)
+// A partially filled frame is sent at the next Commit() after this time [mS].
+#define ETH_TELEMETRY_FLUSH_INTERVAL 10
+// PHY address of the LAN8742A on the Nucleo-144.
+#define ETH_TELEMETRY_PHY_ADDRESS 0
+
+namespace murasaki {
+
+#ifdef HAL_ETH_MODULE_ENABLED
+/**
+ * @brief UDP telemetry sink, writing the records directly into the Tx DMA buffers.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The frame buffers are in the D2 SRAM with the DMA descriptors. Each buffer has the Ethernet, IPv4 and UDP
+ * headers built at Start(). The records are written after the headers, and the buffer goes to the Tx descriptor
+ * as is. There is no intermediate copy, and no IP stack :
+ *
+ * @code
+ * murasaki::EthTelemetry *telemetry = new murasaki::EthTelemetry(&heth, &TxConfig, 0xC0A800C8, 0xFFFFFFFF, 5555);
+ * telemetry->Start();
+ *
+ * uint8_t *record = telemetry->Reserve(sizeof(Sample));
+ * if (record != nullptr) {
+ *     FillSample(record);     // Write in the DMA buffer.
+ *     telemetry->Commit(sizeof(Sample));
+ * }
+ * @endcode
+ *
+ * Several records are batched in a frame, up to ETH_TELEMETRY_PAYLOAD_SIZE. The frame goes out when the next
+ * record doesn't fit, at the Commit() after ETH_TELEMETRY_FLUSH_INTERVAL mS, or by Flush(). The payload starts
+ * with the 32bit little endian sequence number of the frame. Then, the records follow as written. The receiver
+ * finds the lost frame by the sequence number. See tools/ethtelemetry.py.
+ *
+ * The completed Tx descriptors are reclaimed by HAL_ETH_ReleaseTxPacket() in Reserve(). The HAL returns the
+ * buffers through the registered TxFreeCallback. The Ethernet interrupt is not used. The IPv4 header checksum
+ * and the UDP checksum are inserted by the MAC, as configured in the TxConfig of the CubeIDE.
+ *
+ * The destination MAC is the broadcast. There is no ARP. Set the broadcast or the IP address of the receiver
+ * on the same segment.
+ *
+ * The Reserve() and the Commit() are a pair. The sink is locked between them. Thread safe. Not callable
+ * from the ISR.
+ *
+ * The D-cache doesn't hold the descriptors and the buffers. Start() makes the 32kB from the top of the
+ * D2 SRAM non-cacheable by the MPU. The linker script places them there.
+ */
+class EthTelemetry
+{
+ public:
+    /**
+     * @brief Constructor.
+     * @param heth ETH handle initialized by the CubeIDE generated code.
+     * @param tx_config Tx packet configuration of the CubeIDE generated code. The checksum insertion is taken.
+     * @param source_ip IPv4 address of this board. 0xC0A800C8 is 192.168.0.200.
+     * @param destination_ip IPv4 address of the receiver. 0xFFFFFFFF to broadcast.
+     * @param port UDP port of the source and the destination.
+     */
+    EthTelemetry(
+                 ETH_HandleTypeDef *heth,
+                 ETH_TxPacketConfig *tx_config,
+                 uint32_t source_ip,
+                 uint32_t destination_ip,
+                 uint16_t port);
+
+    /**
+     * @brief Build the headers, follow the link of the PHY, and start the MAC.
+     * @return true if success. false if the Ethernet is not supported.
+     */
+    bool Start();
+
+    /**
+     * @brief Reserve the space for a record in the current frame.
+     * @param size Size of the record [byte]. Up to ETH_TELEMETRY_MAX_RECORD.
+     * @param timeout_ms Wait for the free buffer [mS]. 0 to drop the record at once.
+     * @return Pointer to write the record in the DMA buffer. nullptr if dropped. Not aligned.
+     * @details
+     * Must be followed by Commit() if not nullptr.
+     */
+    uint8_t* Reserve(unsigned int size, unsigned int timeout_ms = 0);
+
+    /**
+     * @brief Close the record written after the Reserve().
+     * @param size Size of the written record [byte]. Up to the reserved size.
+     */
+    void Commit(unsigned int size);
+
+    /**
+     * @brief Copy a record into the current frame.
+     * @param record Record to send.
+     * @param size Size of the record [byte]. Up to ETH_TELEMETRY_MAX_RECORD.
+     * @param timeout_ms Wait for the free buffer [mS]. 0 to drop the record at once.
+     * @return true if queued. false if dropped.
+     */
+    bool Write(const void *record, unsigned int size, unsigned int timeout_ms = 0);
+
+    /**
+     * @brief Send the current frame if it has a record.
+     * @param timeout_ms Wait for the free Tx descriptor [mS].
+     * @return true if sent or empty. false if all descriptors are still busy.
+     */
+    bool Flush(unsigned int timeout_ms = 0);
+
+    /**
+     * @brief Read the link status of the PHY.
+     * @return true if the link is up.
+     */
+    bool IsLinkUp();
+
+    /**
+     * @brief Follow the new HCLK.
+     * @details
+     * The MDC divider and the 1uS tick of the MAC are set by the HAL_ETH_Init() from the HCLK at that time.
+     * Call this function after the change of the system clock, to keep the MDC under 2.5MHz.
+     * Nothing happens before Start().
+     */
+    static void Retime();
+
+    /**
+     * @brief Number of the sent frames.
+     */
+    unsigned int GetFrameCount() const;
+    /**
+     * @brief Number of the records in the sent frames.
+     */
+    unsigned int GetRecordCount() const;
+    /**
+     * @brief Number of the records dropped by no free buffer.
+     */
+    unsigned int GetDropCount() const;
+
+ private:
+    // Called while locked.
+    bool Send(unsigned int timeout_ms);
+    void Reclaim();
+    static uint32_t ElapsedMs(uint32_t start);
+    void ConfigureMpu();
+    void ConfigureMac();
+
+    // Returns the buffer to the pool. Called by HAL_ETH_ReleaseTxPacket().
+    static void TxFreeCallback(uint32_t *buff);
+
+    ETH_HandleTypeDef *const heth_;
+    ETH_TxPacketConfig *const tx_config_;
+    const uint32_t source_ip_;
+    const uint32_t destination_ip_;
+    const uint16_t port_;
+    CriticalSection *critical_section_;
+
+    // Buffer in the fill. -1 if none.
+    int current_;
+    unsigned int fill_;
+    uint32_t frame_start_;
+    unsigned int frame_records_;
+    uint32_t sequence_;
+    uint16_t ip_id_;
+
+    unsigned int free_[ETH_TELEMETRY_BUFFER_COUNT];
+    unsigned int free_count_;
+    ETH_BufferTypeDef tx_buffer_;
+
+    unsigned int frames_;
+    unsigned int records_;
+    unsigned int drops_;
+
+    // The TxFreeCallback of the HAL has no context.
+    static EthTelemetry *instance_;
+};
+#endif
+
+} /* namespace murasaki */
+
+#endif /* ETHTELEMETRY_HPP_ */
@@ -0,0 +1,106 @@
+/**
+ * @file loadmeter.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Always-on CPU load meter with the moving averages.
+ */
+
+#ifndef LOADMETER_HPP_
+#define LOADMETER_HPP_
+
+#include "murasaki.hpp"
+
+// Sampling period of the load meter [mS].
+#define LOAD_METER_PERIOD_MS 1000
+// Number of the samples kept for the longest average.
+#define LOAD_METER_HISTORY 60
+
+namespace murasaki {
+
+/**
+ * @brief Length of the moving average of the CPU load.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ */
+enum LoadMeterWindow
+{
+    klmOneSecond = 0,   ///< The last sample.
+    klmTenSeconds,      ///< Average of the last 10 samples.
+    klmOneMinute        ///< Average of the last 60 samples.
+};
+
+/**
+ * @brief CPU load meter by the idle time.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The meter task samples the idle cycles and the total cycles of @ref IdleTime every second.
+ * The load of each second is kept for a minute, and averaged over 1, 10 and 60 seconds.
+ * Until the history is filled, the average is taken on the available samples.
+ *
+ * @code
+ * murasaki::platform.load_meter = new murasaki::LoadMeter(10000);
+ * murasaki::platform.load_meter->Start();
+ * ...
+ * unsigned int headroom = 1000 - murasaki::platform.load_meter->GetLoad(murasaki::klmOneMinute);
+ * @endcode
+ *
+ * The load of each second is the ratio of the time, not the cycles. So, the averages are valid
+ * while the @ref Governor changes the clock. The cost is a few hundred cycles per second, in addition
+ * to the idle hook.
+ *
+ * When the report period is given, the meter task prints the averages to the murasaki::debugger :
+ *
+ * @code
+ * CPU load :  12.3% (1s),  10.8% (10s),  11.0% (60s)
+ * @endcode
+ */
+class LoadMeter
+{
+ public:
+    /**
+     * @brief Constructor.
+     * @param report_period_ms Period of the report to the debugger [mS]. 0 to disable.
+     * @details
+     * The measurement doesn't start until Start() is called. The report period is rounded to the
+     * multiple of LOAD_METER_PERIOD_MS.
+     */
+    LoadMeter(unsigned int report_period_ms);
+
+    /**
+     * @brief Start the meter task.
+     */
+    void Start();
+
+    /**
+     * @brief Get the moving average of the CPU load.
+     * @param window Length of the average.
+     * @return Load [0.1%]. 0 to 1000. 0 until the first sample.
+     * @details
+     * Can be called from any task.
+     */
+    unsigned int GetLoad(LoadMeterWindow window) const;
+
+    /**
+     * @brief Print the moving averages to the debugger.
+     */
+    void Print() const;
+
+ private:
+    static void TaskBody(const void *ptr);
+    // Add the load of the last period, and update the averages.
+    void Sample();
+
+    const unsigned int report_samples_;
+    murasaki::SimpleTask *task_;
+    // Following members are written by the meter task only.
+    unsigned int head_;
+    unsigned int count_;
+    uint32_t last_idle_;
+    uint32_t last_total_;
+    uint16_t history_[LOAD_METER_HISTORY];   // [0.1%]
+    volatile unsigned int loads_[klmOneMinute + 1];
+};
+
+} /* namespace murasaki */
+
+#endif /* LOADMETER_HPP_ */
@@ -0,0 +1,107 @@
+/**
+ * @file busio.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Multi-pin GPIO bus output and input.
+ */
+
+#include "busio.hpp"
+
+namespace murasaki {
+
+BusPinMap::BusPinMap(const BusPin pins[], unsigned int count)
+        :
+        num_ports_(0)
+{
+    unsigned int num_runs = 0;
+
+    MURASAKI_ASSERT(nullptr != pins)
+    MURASAKI_ASSERT(0 < count && count <= BUS_MAX_PINS)
+
+    // Group the pins by the port, in the order of the first appearance.
+    for (unsigned int i = 0; i < count; i++) {
+        unsigned int p = 0;
+
+        MURASAKI_ASSERT(nullptr != pins[i].port)
+        // Exactly one pin.
+        MURASAKI_ASSERT(0 != pins[i].pin && 0 == (pins[i].pin & (pins[i].pin - 1)))
+
+        while (p < num_ports_ && ports_[p].registers != pins[i].port)
+            p++;
+        if (p == num_ports_) {
+            ports_[p].registers = pins[i].port;
+            ports_[p].mask = 0;
+            num_ports_++;
+        }
+        // The same pin twice.
+        MURASAKI_ASSERT(0 == (ports_[p].mask & pins[i].pin))
+        ports_[p].mask |= pins[i].pin;
+    }
+
+    // Group the pins of each port by the distance. The runs of a port are contiguous in runs_.
+    for (unsigned int p = 0; p < num_ports_; p++) {
+        ports_[p].first_run = num_runs;
+        ports_[p].num_runs = 0;
+
+        for (unsigned int i = 0; i < count; i++) {
+            if (pins[i].port != ports_[p].registers)
+                continue;
+
+            const int shift = __builtin_ctz(pins[i].pin) - static_cast<int>(i);
+            unsigned int r = ports_[p].first_run;
+
+            while (r < num_runs && runs_[r].shift != shift)
+                r++;
+            if (r == num_runs) {
+                runs_[r].mask = 0;
+                runs_[r].shift = shift;
+                num_runs++;
+                ports_[p].num_runs++;
+            }
+            runs_[r].mask |= pins[i].pin;
+        }
+    }
+}
+
+BusOut::BusOut(const BusPin pins[], unsigned int count)
+        :
+        BusPinMap(pins, count)
+{
+}
+
+void BusOut::Write(unsigned int value)
+{
+    for (unsigned int p = 0; p < num_ports_; p++) {
+        const uint32_t set = Scatter(ports_[p], value);
+
+        // Upper half resets, lower half sets. One store per port.
+        ports_[p].registers->BSRR = ((ports_[p].mask & ~set) << 16) | set;
+    }
+}
+
+unsigned int BusOut::Read()
+{
+    unsigned int value = 0;
+
+    for (unsigned int p = 0; p < num_ports_; p++)
+        value |= Gather(ports_[p], ports_[p].registers->ODR);
+    return value;
+}
+
+BusIn::BusIn(const BusPin pins[], unsigned int count)
+        :
+        BusPinMap(pins, count)
+{
+}
+
+unsigned int BusIn::Read()
+{
+    unsigned int value = 0;
+
+    for (unsigned int p = 0; p < num_ports_; p++)
+        value |= Gather(ports_[p], ports_[p].registers->IDR);
+    return value;
+}
+
+} /* namespace murasaki */
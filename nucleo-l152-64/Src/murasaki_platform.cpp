@@ -13,10 +13,37 @@
 // Include the murasaki class library.
 #include "murasaki.hpp"
 
+// Include the platform classes of this project.
+#include "callbackdispatcher.hpp"
+#include "clockprofile.hpp"
+#include "consolebaud.hpp"
+#include "crashrecord.hpp"
+#include "crcservice.hpp"
+#include "ethtelemetry.hpp"
+#include "framedconsole.hpp"
+#include "governor.hpp"
+#include "loadmeter.hpp"
+#include "i2crecoveringmaster.hpp"
+#include "rtosbenchmark.hpp"
+#include "stackunwinder.hpp"
+#include "staticbitout.hpp"
+#include "statusled.hpp"
+#include "supervisor.hpp"
+#include "uartfifo.hpp"
+#include "usbcdcacm.hpp"
+#include "i2cscanner.hpp"
+#include "i2ctiming.hpp"
+#include "tracerecorder.h"
+
+#include <stdio.h>
+
 // Include the prototype  of functions of this file.
 
 /* -------------------- PLATFORM Macros -------------------------- */
 
+// Number of the return addresses printed by PrintCallChain().
+#define CALL_CHAIN_DEPTH 8
+
 /* -------------------- PLATFORM Type and classes -------------------------- */
 
 /* -------------------- PLATFORM Variables-------------------------- */
@@ -52,110 +79,199 @@ extern UART_HandleTypeDef huart2;
 // Which has multiple Nucleo ( ex: G431 32/48 pin, F446 48/144 pin ) may cause problem.
 #if defined(STM32F091xC)
 // For Nucleo F091RC (32pin)
+#define BOARD_NAME "nucleo-f091-64"
 #define UART_PORT huart2
 #define LED_PORT LD2_GPIO_Port
 #define LED_PIN LD2_Pin
+#define LED_GPIO murasaki::kgpA
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOB
+#define I2C_SCL_PIN GPIO_PIN_8
+#define I2C_SDA_PORT GPIOB
+#define I2C_SDA_PIN GPIO_PIN_9
 extern UART_HandleTypeDef UART_PORT;
+// Free DMA channel to feed the CRC unit. The console uses the channel 1 and 2.
+#define CRC_DMA_CHANNEL DMA1_Channel5
 
 #elif defined(STM32F446xx)
 // For Nucleo F446RE (48pin)
+#define BOARD_NAME "nucleo-f446-64"
 #define UART_PORT huart2
 #define LED_PORT LD2_GPIO_Port
 #define LED_PIN LD2_Pin
+#define LED_GPIO murasaki::kgpA
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOB
+#define I2C_SCL_PIN GPIO_PIN_8
+#define I2C_SDA_PORT GPIOB
+#define I2C_SDA_PIN GPIO_PIN_9
 extern UART_HandleTypeDef UART_PORT;
 
 #elif defined(STM32F722xx)
 // For Nucleo F722ZE (144pin)
+#define BOARD_NAME "nucleo-f722-144"
 #define UART_PORT huart3
 #define LED_PORT LD2_GPIO_Port
 #define LED_PIN LD2_Pin
+#define LED_GPIO murasaki::kgpB
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOB
+#define I2C_SCL_PIN GPIO_PIN_8
+#define I2C_SDA_PORT GPIOB
+#define I2C_SDA_PIN GPIO_PIN_9
 extern UART_HandleTypeDef UART_PORT;
+// The user USB connector.
+#define USB_CONSOLE_PORT hpcd_USB_OTG_FS
+extern PCD_HandleTypeDef USB_CONSOLE_PORT;
 
 #elif defined(STM32F746xx)
 // For Nucleo F746ZG (144pin)
+#define BOARD_NAME "nucleo-f746-144"
 #define UART_PORT huart3
 #define LED_PORT LD2_GPIO_Port
 #define LED_PIN LD2_Pin
+#define LED_GPIO murasaki::kgpB
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOB
+#define I2C_SCL_PIN GPIO_PIN_8
+#define I2C_SDA_PORT GPIOB
+#define I2C_SDA_PIN GPIO_PIN_9
 extern UART_HandleTypeDef UART_PORT;
 
 #elif defined(STM32G070xx)
 // For Nucleo G070RB (48pin)
+#define BOARD_NAME "nucleo-g070-64"
 #define UART_PORT huart2
 #define LED_PORT LD2_GPIO_Port
 #define LED_PIN LD2_Pin
+#define LED_GPIO murasaki::kgpA
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOB
+#define I2C_SCL_PIN GPIO_PIN_8
+#define I2C_SDA_PORT GPIOB
+#define I2C_SDA_PIN GPIO_PIN_9
 extern UART_HandleTypeDef UART_PORT;
 
 #elif defined(STM32G431xx)
 // For Nucleo G431RB (48pin)
+#define BOARD_NAME "nucleo-g431-64"
 #define UART_PORT hlpuart1
 #define LED_PORT LD2_GPIO_Port
 #define LED_PIN LD2_Pin
+#define LED_GPIO murasaki::kgpA
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOB
+#define I2C_SCL_PIN GPIO_PIN_8
+#define I2C_SDA_PORT GPIOB
+#define I2C_SDA_PIN GPIO_PIN_9
 extern UART_HandleTypeDef UART_PORT;
 
 #elif defined(STM32H743xx)
 // For Nucleo H743ZI (144pin)
+#define BOARD_NAME "nucleo-h743-144"
 #define UART_PORT huart3
 #define LED_PORT LD2_GPIO_Port
 #define LED_PIN LD2_Pin
+#define LED_GPIO murasaki::kgpB
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOB
+#define I2C_SCL_PIN GPIO_PIN_8
+#define I2C_SDA_PORT GPIOB
+#define I2C_SDA_PIN GPIO_PIN_9
 extern UART_HandleTypeDef UART_PORT;
+// The user USB connector.
+#define USB_CONSOLE_PORT hpcd_USB_OTG_FS
+extern PCD_HandleTypeDef USB_CONSOLE_PORT;
+// The RJ45 connector. The Tx packet configuration is made by the CubeIDE.
+#define ETH_TELEMETRY_PORT heth
+extern ETH_HandleTypeDef ETH_TELEMETRY_PORT;
+extern ETH_TxPacketConfig TxConfig;
+// Free DMA stream to feed the CRC unit. The console uses the stream 0 and 1.
+#define CRC_DMA_CHANNEL DMA1_Stream7
 
 #elif defined(STM32L152xE)
 // For Nucleo L152RE (48pin)
+#define BOARD_NAME "nucleo-l152-64"
 #define UART_PORT huart2
 #define LED_PORT LD2_GPIO_Port
 #define LED_PIN LD2_Pin
+#define LED_GPIO murasaki::kgpA
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOB
+#define I2C_SCL_PIN GPIO_PIN_8
+#define I2C_SDA_PORT GPIOB
+#define I2C_SDA_PIN GPIO_PIN_9
 extern UART_HandleTypeDef UART_PORT;
 
 #elif defined(STM32L412xx)
 // For Nucleo L412RB (48pin)
+#define BOARD_NAME "nucleo-l412-64"
 #define UART_PORT huart2
 #define LED_PORT LD4_GPIO_Port
 #define LED_PIN LD4_Pin
+#define LED_GPIO murasaki::kgpB
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOB
+#define I2C_SCL_PIN GPIO_PIN_8
+#define I2C_SDA_PORT GPIOB
+#define I2C_SDA_PIN GPIO_PIN_9
 extern UART_HandleTypeDef UART_PORT;
 
 #elif defined(STM32G0B1xx)
 // For Nucleo G01B1RE (48pin)
+#define BOARD_NAME "nucleo-g0b1-64"
 #define UART_PORT huart2
 #define LED_PORT LED_GREEN_GPIO_Port
 #define LED_PIN LED_GREEN_Pin
+#define LED_GPIO murasaki::kgpA
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOA
+#define I2C_SCL_PIN GPIO_PIN_9
+#define I2C_SDA_PORT GPIOA
+#define I2C_SDA_PIN GPIO_PIN_10
 extern UART_HandleTypeDef UART_PORT;
 
 #elif defined(STM32H503xx)
 // For Nucleo G01B1RE (48pin)
+#define BOARD_NAME "nucleo-h503-64"
 #define UART_PORT huart3
 #define LED_PORT USER_LED_GPIO_Port
 #define LED_PIN USER_LED_Pin
+#define LED_GPIO murasaki::kgpA
 #define USER_BUTTON_PORT B1_GPIO_Port
 #define USER_BUTTON_PIN B1_Pin
+#define I2C_SCL_PORT GPIOB
+#define I2C_SCL_PIN GPIO_PIN_8
+#define I2C_SDA_PORT GPIOB
+#define I2C_SDA_PIN GPIO_PIN_7
 extern UART_HandleTypeDef UART_PORT;
 
 #else
-#error "Unknown Nucleo. Please define the UART_PORT, LED_PORT, LED_PIN macro."
+#error "Unknown Nucleo. Please define the UART_PORT, LED_PORT, LED_GPIO, LED_PIN macro."
 #endif
 
-/* -------------------- PLATFORM Prototypes ------------------------- */
+#if !defined(CRC_DMA_CHANNEL)
+// The CRC unit is written by the CPU.
+#define CRC_DMA_CHANNEL nullptr
+#endif
 
-void TaskBodyFunction(const void *ptr);
+// Firmware image. Defined by the linker script.
+extern "C" const uint32_t g_pfnVectors[];       // Start of the image.
+extern "C" const uint32_t _sidata[];            // Initial values of the .data. The end of the image.
+extern "C" uint32_t _sdata[];                   // Start of the .data.
+extern "C" uint32_t _edata[];                   // End of the .data.
+
+/* -------------------- PLATFORM Prototypes ------------------------- */
 
 /* -------------------- PLATFORM Implementation ------------------------- */
 
@@ -165,16 +281,55 @@ void InitPlatform()
     // Start the cycle counter to measure the cycle in MURASAKI_SYSLOG.
     murasaki::InitCycleCounter();
 #endif
+#if PLATFORM_CONFIG_UART_FIFO
+    // Before the first transfer. One interrupt per threshold, instead of per byte.
+    murasaki::UartFifo::Enable(&UART_PORT,
+                               PLATFORM_CONFIG_UART_TX_FIFO_THRESHOLD,
+                               PLATFORM_CONFIG_UART_RX_FIFO_THRESHOLD);
+#endif
+
+#if PLATFORM_CONFIG_USB_CONSOLE && defined(USB_CONSOLE_PORT)
+    // USB CDC-ACM device on the user USB connector. The log goes out when a terminal opens the port.
+    murasaki::platform.usb_console = new murasaki::UsbCdcAcm(&USB_CONSOLE_PORT);
+    while (nullptr == murasaki::platform.usb_console)
+        ;  // stop here on the memory allocation failure.
+    while (!murasaki::platform.usb_console->Start())
+        ;  // stop here if the registered callbacks of the PCD are disabled.
+    murasaki::platform.uart_console = murasaki::platform.usb_console;
+#else
+    // Switch to the higher baud rate, if the host tool asks. Before the first transfer of the console.
+    murasaki::platform.console_baud = new murasaki::ConsoleBaud(&UART_PORT);
+    while (nullptr == murasaki::platform.console_baud)
+        ;  // stop here on the memory allocation failure.
+    murasaki::platform.console_baud->Negotiate(PLATFORM_CONFIG_CONSOLE_BAUD_WINDOW);
+
     // UART device setting for console interface.
     // On Nucleo, the port connected to the USB port of ST-Link is
     // referred here.
     murasaki::platform.uart_console = new murasaki::DebuggerUart(&UART_PORT);
     while (nullptr == murasaki::platform.uart_console)
         ;  // stop here on the memory allocation failure.
+    // The HAL calls the console directly, instead of the global callbacks.
+    murasaki::CallbackDispatcher::Register(&UART_PORT, murasaki::platform.uart_console);
+    // Fall back to the default baud rate on the framing errors. After the registration above.
+    murasaki::platform.console_baud->Start(murasaki::platform.uart_console);
+#endif
+
+    // Checksum by the CRC unit. The large buffers are fed by the DMA, if the board has a free channel.
+    murasaki::platform.crc_service = new murasaki::CrcService(CRC_DMA_CHANNEL);
+    while (nullptr == murasaki::platform.crc_service)
+        ;  // stop here on the memory allocation failure.
 
     // UART is used for logging port.
     // At least one logger is needed to run the debugger class.
+#if PLATFORM_CONFIG_FRAMED_CONSOLE
+    // The text goes to the channel 0 of the frames. The other channels are for the binary records.
+    murasaki::platform.framed_console = new murasaki::FramedConsole(murasaki::platform.uart_console,
+                                                                    murasaki::platform.crc_service);
+    murasaki::platform.logger = murasaki::platform.framed_console;
+#else
     murasaki::platform.logger = new murasaki::UartLogger(murasaki::platform.uart_console);
+#endif
     while (nullptr == murasaki::platform.logger)
         ;  // stop here on the memory allocation failure.
 
@@ -186,25 +341,107 @@ void InitPlatform()
     // Set the debugger as AutoRePrint mode, for the easy operation.
     murasaki::debugger->AutoRePrint();  // type any key to show history.
 
+    if (nullptr != murasaki::platform.usb_console)
+        murasaki::debugger->Printf("Console : USB CDC-ACM\n");
+    else {
+        murasaki::debugger->Printf("Console baud rate : %u\n", murasaki::platform.console_baud->GetBaudRate());
+        if (murasaki::UartFifo::IsEnabled(&UART_PORT))
+            murasaki::debugger->Printf("Console UART FIFO : %u bytes (Tx), %u bytes (Rx) per interrupt\n",
+                                       murasaki::UartFifo::GetTxBytesPerInterrupt(&UART_PORT),
+                                       murasaki::UartFifo::GetRxBytesPerInterrupt(&UART_PORT));
+    }
+
+    // Identify the firmware on the console. The code, and the initial values of the .data after it.
+    const unsigned int image_size = reinterpret_cast<uintptr_t>(_sidata) - reinterpret_cast<uintptr_t>(g_pfnVectors)
+            + reinterpret_cast<uintptr_t>(_edata) - reinterpret_cast<uintptr_t>(_sdata);
+    murasaki::debugger->Printf("Firmware CRC-32 : 0x%08x (%u bytes)\n",
+                               (unsigned int) murasaki::platform.crc_service->Crc32(g_pfnVectors, image_size),
+                               image_size);
+
+    // Report the fault which caused the last reset.
+    if (murasaki::CrashRecord::IsValid()) {
+        murasaki::CrashRecord::Print();
+        murasaki::CrashRecord::Clear();
+    }
+
+    // Report the task which stopped the watchdog before the last reset.
+    if (murasaki::Supervisor::IsWatchdogReset())
+        murasaki::debugger->Printf("!!! The last reset was caused by the watchdog.\n");
+    if (murasaki::Supervisor::IsRecordValid()) {
+        murasaki::Supervisor::PrintRecord();
+        murasaki::Supervisor::ClearRecord();
+    }
+
+    // Supervisor of the tasks. Each task registers itself, and checks in regularly.
+    murasaki::platform.supervisor = new murasaki::Supervisor(PLATFORM_CONFIG_WATCHDOG_TIMEOUT);
+    MURASAKI_ASSERT(nullptr != murasaki::platform.supervisor)
+
     // For demonstration, one GPIO LED port is reserved.
-    // The port and pin names are fined by CubeIDE.
-    murasaki::platform.led = new murasaki::BitOut(LED_PORT, LED_PIN);
+    // The port and pin names are fined by CubeIDE. The LED is driven by the BSRR, not by the HAL.
+    murasaki::platform.led = new murasaki::StaticBitOutAdapter<LED_GPIO, LED_PIN>();
     MURASAKI_ASSERT(nullptr != murasaki::platform.led)
+    MURASAKI_ASSERT(LED_PORT == murasaki::GpioPortRegisters(LED_GPIO))
 
-    // For demonstration of FreeRTOS task.
-    murasaki::platform.task1 = new murasaki::SimpleTask(
-                                                        "task1",
-                                                        256,
-                                                        murasaki::ktpNormal,
-                                                        nullptr,
-                                                        &TaskBodyFunction
-                                                        );
-    MURASAKI_ASSERT(nullptr != murasaki::platform.task1)
+    // The blink patterns on the same LED, by the timer interrupt. No task is needed.
+    murasaki::platform.status_led = new murasaki::StatusLed(LED_PORT, LED_PIN);
+    MURASAKI_ASSERT(nullptr != murasaki::platform.status_led)
 
     // Following block is just for sample.
+    // Override the bus timing generated by CubeIDE.
+    if (!murasaki::I2cTiming::SetBusSpeed(&hi2c1, PLATFORM_CONFIG_I2C_BUS_SPEED))
+        murasaki::debugger->Printf("I2C bus speed %d Hz is not supported. Keep the default.\n",
+                                   PLATFORM_CONFIG_I2C_BUS_SPEED);
+
     // For demonstration of master and slave I2C
-    murasaki::platform.i2c_master = new murasaki::I2cMaster(&hi2c1);
-    MURASAKI_ASSERT(nullptr != murasaki::platform.i2c_master)
+    // The bus is recovered automatically when a slave holds SDA.
+    murasaki::platform.i2c_recovering_master = new murasaki::I2cRecoveringMaster(
+                                                                                 &hi2c1,
+                                                                                 I2C_SCL_PORT,
+                                                                                 I2C_SCL_PIN,
+                                                                                 I2C_SDA_PORT,
+                                                                                 I2C_SDA_PIN);
+    MURASAKI_ASSERT(nullptr != murasaki::platform.i2c_recovering_master)
+    murasaki::platform.i2c_master = murasaki::platform.i2c_recovering_master;
+
+    // Switch the system clock. The console, the I2C and the status LED follow the new clock.
+    murasaki::platform.clock_profile = new murasaki::ClockProfile(&UART_PORT,
+                                                                  murasaki::platform.i2c_recovering_master,
+                                                                  murasaki::platform.status_led);
+    MURASAKI_ASSERT(nullptr != murasaki::platform.clock_profile)
+    if (murasaki::platform.clock_profile->Set(PLATFORM_CONFIG_CLOCK_PROFILE))
+        murasaki::debugger->Printf("System clock : %u MHz\n", (unsigned int) (SystemCoreClock / 1000000));
+    else
+        murasaki::debugger->Printf("Clock profile %d is not supported. Keep the CubeIDE configuration.\n",
+                                   PLATFORM_CONFIG_CLOCK_PROFILE);
+
+    // Select the clock profile by the CPU load. Started by ExecPlatform().
+    murasaki::platform.governor = new murasaki::Governor(murasaki::platform.clock_profile,
+                                                         PLATFORM_CONFIG_GOVERNOR_PERIOD);
+    MURASAKI_ASSERT(nullptr != murasaki::platform.governor)
+
+    // Measure the CPU load. Started by ExecPlatform().
+    murasaki::platform.load_meter = new murasaki::LoadMeter(PLATFORM_CONFIG_LOAD_METER_REPORT);
+    MURASAKI_ASSERT(nullptr != murasaki::platform.load_meter)
+
+    // Fast bus enumeration. The result is cached for the later device discovery.
+    murasaki::platform.i2c_scanner = new murasaki::I2cScanner(murasaki::platform.i2c_master);
+    MURASAKI_ASSERT(nullptr != murasaki::platform.i2c_scanner)
+
+#if PLATFORM_CONFIG_ETH_TELEMETRY && defined(ETH_TELEMETRY_PORT)
+    // UDP telemetry. The records are written into the DMA buffers of the Ethernet.
+    murasaki::platform.eth_telemetry = new murasaki::EthTelemetry(&ETH_TELEMETRY_PORT,
+                                                                  &TxConfig,
+                                                                  PLATFORM_CONFIG_ETH_TELEMETRY_SOURCE_IP,
+                                                                  PLATFORM_CONFIG_ETH_TELEMETRY_DESTINATION_IP,
+                                                                  PLATFORM_CONFIG_ETH_TELEMETRY_PORT);
+    MURASAKI_ASSERT(nullptr != murasaki::platform.eth_telemetry)
+    if (murasaki::platform.eth_telemetry->Start())
+        murasaki::debugger->Printf("Ethernet telemetry : UDP port %u, link %s\n",
+                                   PLATFORM_CONFIG_ETH_TELEMETRY_PORT,
+                                   murasaki::platform.eth_telemetry->IsLinkUp() ? "up" : "down");
+    else
+        murasaki::debugger->Printf("!!! Ethernet telemetry failed to start\n");
+#endif
 
     murasaki::platform.b1 = new murasaki::Exti(USER_BUTTON_PIN);
     MURASAKI_ASSERT(nullptr != murasaki::platform.b1)
@@ -216,22 +453,93 @@ void ExecPlatform()
     // counter for the demonstration.
     int count = 0;
 
-    // Start LED blink
-    murasaki::platform.task1->Start();
+#if PLATFORM_CONFIG_BENCHMARK
+    // Benchmark mode. Measure the RTOS primitives instead of the demo.
+    // The bitout_toggle measures the HAL BitOut, not the StaticBitOutAdapter of the platform.led.
+    // Comparable with the result before the StaticBitOut.
+    murasaki::BitOut benchmark_led(LED_PORT, LED_PIN);
+    murasaki::RtosBenchmark benchmark(BOARD_NAME, &benchmark_led);
+    benchmark.Run();
+    // The 8 pins of the LED port around the LED. Writing the ODR doesn't affect the pins which are not output.
+    benchmark.RunBus(LED_PORT, (LED_PIN & 0x00FF) ? 0x00FF : 0xFF00);
+    // The cost from the HAL to the object in the interrupt.
+    benchmark.RunDispatch();
+    // The software checksum against the CRC unit.
+    benchmark.RunCrc(CRC_DMA_CHANNEL);
+
+    while (true)
+        murasaki::Sleep(1000);
+#endif
+
+#if TRACE_RECORDER_ENABLE
+    // Record the kernel activity until the button is pushed.
+    TraceStart();
+#endif
+
+    // Start LED blink. Breathing while waiting for the button.
+    murasaki::platform.status_led->Start(murasaki::kslBreathing);
+
+#if PLATFORM_CONFIG_WATCHDOG
+    // From here, the IWDG resets the system if a registered task stops.
+    murasaki::platform.supervisor->Start();
+#endif
+
+#if PLATFORM_CONFIG_GOVERNOR
+    // From here, the clock follows the CPU load.
+    murasaki::platform.governor->Start();
+#endif
+
+    // From here, the CPU load is reported to the console.
+    murasaki::platform.load_meter->Start();
+
+    // Enumerate the I2C bus in the background while waiting for the button.
+    murasaki::platform.i2c_scanner->StartBackgroundScan();
 
     // waiting for the Button push.
     murasaki::debugger->Printf("!!! Push blue button to start the demo \n");
     murasaki::platform.b1->Wait();
+    murasaki::platform.status_led->SetPattern(murasaki::kslHeartbeat);
+
+#if TRACE_RECORDER_ENABLE
+    // Dump the trace to the console. Convert it by tools/traceconvert.py.
+    TraceStop();
+    TracePrint();
+#endif
 
-    // List up connected I2C device to the console.
-    I2cSearch(murasaki::platform.i2c_master);
+    // List up connected I2C device to the console. Served from the cache.
+    murasaki::platform.i2c_scanner->Print();
+
+    // Error and retry counters of the I2C devices.
+    murasaki::platform.i2c_recovering_master->PrintStatistics();
+
+    // This task is supervised only in the loop. Waiting for the button is not a failure.
+    unsigned int slot = murasaki::platform.supervisor->Register("defaultTask", PLATFORM_CONFIG_WATCHDOG_DEADLINE);
 
     // Loop forever
     while (true) {
+        // Tell the supervisor that this task is alive.
+        murasaki::platform.supervisor->CheckIn(slot);
 
         // print a message with counter value to the console.
         murasaki::debugger->Printf("Hello %d \n", count);
 
+#if PLATFORM_CONFIG_ETH_TELEMETRY && defined(ETH_TELEMETRY_PORT)
+        // Same message to the Ethernet. Sent at once, not to wait for the batch.
+        char line[32];
+        murasaki::platform.eth_telemetry->Write(line, snprintf(line, sizeof(line), "Hello %d \n", count));
+        murasaki::platform.eth_telemetry->Flush();
+#endif
+
+#if PLATFORM_CONFIG_FRAMED_CONSOLE
+        // Same counter as the binary record. 12 bytes written in the transmission buffer.
+        uint32_t *record = reinterpret_cast<uint32_t*>(
+                murasaki::platform.framed_console->Begin(FRAMED_CONSOLE_CHANNEL_TELEMETRY));
+        record[0] = HAL_GetTick();
+        record[1] = count;
+        record[2] = murasaki::platform.load_meter->GetLoad(murasaki::klmOneSecond);
+        murasaki::platform.framed_console->End(3 * sizeof(uint32_t));
+#endif
+
         // update the counter value.
         count++;
 
@@ -240,20 +548,17 @@ void ExecPlatform()
     }
 }
 
-/* ------------------ User Functions -------------------------- */
-/**
- * @brief Demonstration task.
- * @param ptr Pointer to the parameter block
- * @details
- * Task body function as demonstration of the @ref murasaki::SimpleTask.
- *
- * You can delete this function if you don't use.
- */
-void TaskBodyFunction(const void *ptr) {
+void PrintCallChain()
+{
+    uint32_t chain[CALL_CHAIN_DEPTH];
 
-    while (true)  // dummy loop
-    {
-        murasaki::platform.led->Toggle();  // toggling LED
-        murasaki::Sleep(700);
-    }
+    // The HAL may assert in the MX_xxx_Init(), before the InitPlatform() creates the debugger.
+    if (nullptr == murasaki::debugger)
+        return;
+
+    unsigned int count = murasaki::StackUnwinder::Here(chain, CALL_CHAIN_DEPTH);
+
+    murasaki::StackUnwinder::Print(chain, count);
 }
+
+/* ------------------ User Functions -------------------------- */
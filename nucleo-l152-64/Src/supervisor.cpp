@@ -0,0 +1,228 @@
+/**
+ * @file supervisor.cpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Task liveness supervisor with the independent watchdog.
+ */
+
+#include "supervisor.hpp"
+#include "crcservice.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <cstddef>
+#include <cstring>
+
+// "WDOG"
+#define SUPERVISOR_RECORD_MAGIC 0x474F4457
+
+// Key register values of the IWDG.
+#define IWDG_KEY_START 0xCCCC
+#define IWDG_KEY_UNLOCK 0x5555
+#define IWDG_KEY_REFRESH 0xAAAA
+// Maximum value of the reload register.
+#define IWDG_MAX_RELOAD 0xFFF
+// Maximum value of the prescaler register. The divider is 4 << PR.
+#define IWDG_MAX_PRESCALER 6
+// Loops to wait for the register update. Several LSI cycles.
+#define IWDG_UPDATE_WAIT 100000
+
+// H7 has 2 IWDG. The IWDG1 is for the Cortex-M7.
+#if defined(IWDG1) && !defined(IWDG)
+#define IWDG IWDG1
+#endif
+
+// Some HAL defines the LSI frequency in the RCC driver only. 32kHz is typical.
+#ifndef LSI_VALUE
+#define LSI_VALUE 32000U
+#endif
+
+namespace murasaki {
+
+Supervisor::Record Supervisor::record_ __attribute__((section(".noinit")));
+
+Supervisor::Supervisor(unsigned int timeout_ms)
+        :
+        timeout_ms_(timeout_ms),
+        task_(nullptr),
+        count_(0)
+{
+    MURASAKI_ASSERT(timeout_ms >= 4)
+}
+
+unsigned int Supervisor::Register(const char *name, unsigned int deadline_ms)
+{
+    MURASAKI_ASSERT(nullptr != name)
+    MURASAKI_ASSERT(count_ < SUPERVISOR_MAX_TASKS)
+
+    taskENTER_CRITICAL();
+    unsigned int slot = count_;
+    names_[slot] = name;
+    deadlines_[slot] = pdMS_TO_TICKS(deadline_ms);
+    beats_[slot] = 0;
+    last_beats_[slot] = 0;
+    last_seen_[slot] = ::xTaskGetTickCount();
+    // Visible to the supervisor task after the all above.
+    count_ = slot + 1;
+    taskEXIT_CRITICAL();
+
+    return slot;
+}
+
+void Supervisor::Start()
+{
+    MURASAKI_ASSERT(nullptr == task_)
+
+    // Highest priority. A task which hogs the CPU is detected by its victims.
+    task_ = new murasaki::SimpleTask(
+                                     "supervisor",
+                                     256,
+                                     murasaki::ktpRealtime,
+                                     this,
+                                     &Supervisor::TaskBody);
+    MURASAKI_ASSERT(nullptr != task_)
+
+    StartWatchdog();
+    task_->Start();
+}
+
+void Supervisor::TaskBody(const void *ptr)
+{
+    Supervisor *const self = const_cast<Supervisor*>(static_cast<const Supervisor*>(ptr));
+    const unsigned int period_ms = self->timeout_ms_ / 4;
+
+    while (true) {
+        int slot = self->Inspect();
+
+        if (slot < 0)
+            self->RefreshWatchdog();
+        else {
+            self->SaveRecord(slot);
+            murasaki::debugger->Printf("!!! Task \"%s\" missed the deadline. Waiting for the watchdog reset.\n",
+                                       self->names_[slot]);
+            // Let the IWDG reset the system. Reset anyway, if the IWDG doesn't.
+            murasaki::Sleep(self->timeout_ms_ * 2);
+            HAL_NVIC_SystemReset();
+        }
+        murasaki::Sleep(period_ms);
+    }
+}
+
+int Supervisor::Inspect()
+{
+    const unsigned int count = count_;
+    const uint32_t now = ::xTaskGetTickCount();
+
+    for (unsigned int slot = 0; slot < count; slot++) {
+        const uint32_t beat = beats_[slot];
+
+        if (beat != last_beats_[slot]) {
+            last_beats_[slot] = beat;
+            last_seen_[slot] = now;
+        }
+        else if (now - last_seen_[slot] > deadlines_[slot])
+            return slot;
+    }
+    return -1;
+}
+
+void Supervisor::SaveRecord(int slot)
+{
+    std::memset(&record_, 0, sizeof(record_));
+    std::strncpy(record_.task, names_[slot], SUPERVISOR_NAME_LENGTH - 1);
+    record_.deadline_ms = deadlines_[slot] * 1000 / configTICK_RATE_HZ;
+    record_.elapsed_ms = (::xTaskGetTickCount() - last_seen_[slot]) * 1000 / configTICK_RATE_HZ;
+    record_.magic = SUPERVISOR_RECORD_MAGIC;
+    record_.crc = Crc(record_);
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    // Write back the record before the reset.
+    SCB_CleanDCache();
+#endif
+}
+
+void Supervisor::StartWatchdog()
+{
+#if defined(IWDG)
+    // Counts of the LSI until the timeout. Take the smallest prescaler which fits to the reload register.
+    uint32_t counts = static_cast<uint64_t>(LSI_VALUE) * timeout_ms_ / 1000;
+    uint32_t prescaler = 0;
+
+    while (prescaler < IWDG_MAX_PRESCALER && (counts >> (prescaler + 2)) > IWDG_MAX_RELOAD)
+        prescaler++;
+    uint32_t reload = counts >> (prescaler + 2);
+    if (reload > IWDG_MAX_RELOAD)
+        reload = IWDG_MAX_RELOAD;
+
+    // Stop the IWDG while the debugger halts the core.
+#if defined(__HAL_RCC_DBGMCU_CLK_ENABLE)
+    __HAL_RCC_DBGMCU_CLK_ENABLE();
+#endif
+#if defined(__HAL_DBGMCU_FREEZE_IWDG)
+    __HAL_DBGMCU_FREEZE_IWDG();
+#elif defined(__HAL_DBGMCU_FREEZE_IWDG1)
+    __HAL_DBGMCU_FREEZE_IWDG1();
+#endif
+
+    // Starting the IWDG starts the LSI too.
+    IWDG->KR = IWDG_KEY_START;
+    IWDG->KR = IWDG_KEY_UNLOCK;
+    IWDG->PR = prescaler;
+    IWDG->RLR = reload;
+    for (int i = 0; i < IWDG_UPDATE_WAIT && 0 != IWDG->SR; i++)
+        ;
+    IWDG->KR = IWDG_KEY_REFRESH;
+#endif
+}
+
+void Supervisor::RefreshWatchdog()
+{
+#if defined(IWDG)
+    IWDG->KR = IWDG_KEY_REFRESH;
+#endif
+}
+
+bool Supervisor::IsWatchdogReset()
+{
+#if defined(RCC_FLAG_IWDGRST)
+    bool result = __HAL_RCC_GET_FLAG(RCC_FLAG_IWDGRST);
+#elif defined(RCC_FLAG_IWDG1RST)
+    bool result = __HAL_RCC_GET_FLAG(RCC_FLAG_IWDG1RST);
+#else
+    bool result = false;
+#endif
+#if defined(__HAL_RCC_CLEAR_RESET_FLAGS)
+    __HAL_RCC_CLEAR_RESET_FLAGS();
+#endif
+    return result;
+}
+
+bool Supervisor::IsRecordValid()
+{
+    return (SUPERVISOR_RECORD_MAGIC == record_.magic) && (Crc(record_) == record_.crc);
+}
+
+void Supervisor::PrintRecord()
+{
+    MURASAKI_ASSERT(IsRecordValid())
+
+    murasaki::debugger->Printf("!!! Watchdog record of the last reset. Task \"%s\" didn't check in for %u mS. Deadline %u mS\n",
+                               record_.task,
+                               static_cast<unsigned int>(record_.elapsed_ms),
+                               static_cast<unsigned int>(record_.deadline_ms));
+}
+
+void Supervisor::ClearRecord()
+{
+    record_.magic = 0;
+}
+
+// CRC-32 ( IEEE 802.3 ), the same with the CrashRecord. By the software, just before the reset.
+uint32_t Supervisor::Crc(const Record &record)
+{
+    return CrcService::SoftwareCrc32(&record, offsetof(Record, crc));
+}
+
+} /* namespace murasaki */
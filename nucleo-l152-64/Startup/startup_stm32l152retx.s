@@ -107,9 +107,9 @@ LoopFillZerobss:
  * @retval : None
 */
     .section .text.Default_Handler,"ax",%progbits
-    .global CustomDefaultHandler
+    .global CrashRecordHandler
 Default_Handler:
-  b CustomDefaultHandler
+  b CrashRecordHandler
 Infinite_Loop:
   b Infinite_Loop
   .size Default_Handler, .-Default_Handler
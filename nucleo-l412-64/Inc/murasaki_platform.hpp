@@ -72,6 +72,20 @@ void ExecPlatform();
  */
 void CustomAssertFailed(uint8_t* file, uint32_t line);
 
+/**
+ * @brief Print the call chain of the caller to the debugger console.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * Prints the return addresses found by murasaki::StackUnwinder as one line :
+ * @code
+ * Call chain : 0x08001235 0x080045a7 0x08004c01
+ * @endcode
+ * The addresses are converted to the function names by tools/symbolize.py.
+ * Called from the assert_failed() in main.c, before the CustomAssertFailed(). Nothing is printed before
+ * the InitPlatform() creates the debugger.
+ */
+void PrintCallChain();
+
 /**
  * @brief Hook for the default exception handler. Never return.
  * @ingroup MURASAKI_PLATFORM_GROUP
@@ -120,6 +134,27 @@ void CustomDefaultHandler();
  */
 void PrintFaultResult(unsigned int * stack_pointer);
 
+/**
+ * @brief Fault handler which saves the crash record and reset. Never return.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * Replaces the CustomDefaultHandler(). Instead of printing the registers from the exception,
+ * this handler writes them into the no-init RAM by murasaki::CrashRecord::Save(), and resets the system
+ * immediately. The record is printed by the InitPlatform() at the next boot.
+ *
+ * Jump here from the exception entry, with the EXC_RETURN in LR. Use the branch, not the call :
+ * @code
+ * void HardFault_Handler(void)
+ * {
+ *   __asm volatile ("ldr r0, =CrashRecordHandler \n bx r0");
+ * }
+ * @endcode
+ *
+ * The Default_Handler of the start up code jumps here, too.
+ * Do not call from user application.
+ */
+void CrashRecordHandler();
+
 /**
  * @brief StackOverflow hook for FreeRTOS
  * @param xTask Task ID which causes stack overflow.
@@ -0,0 +1,138 @@
+/**
+ * @file statusled.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief Status LED pattern engine driven by a hardware timer.
+ */
+
+#ifndef STATUSLED_HPP_
+#define STATUSLED_HPP_
+
+#include "murasaki.hpp"
+
+namespace murasaki {
+
+/**
+ * @brief Blink pattern of the @ref StatusLed.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ */
+enum StatusLedPattern
+{
+    kslOff = 0,         ///< Always off.
+    kslOn,              ///< Always on.
+    kslBlink,           ///< 500mS on, 500mS off.
+    kslHeartbeat,       ///< Double flash per second.
+    kslBreathing,       ///< Fade in and out in 2 seconds.
+    kslErrorCode        ///< N flashes and a pause. N is given by SetPattern().
+};
+
+/**
+ * @brief Status LED engine which plays the blink patterns without the task.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * On the boards where the LED pin is a timer output, the timer drives the pin by the PWM. The DMA writes the compare
+ * register from a table of one cycle of the pattern in the circular mode. The CPU works only in SetPattern().
+ * The patterns other than the breathing are played by the 100mS periods of the full or zero duty. The breathing is
+ * the 100Hz PWM.
+ *
+ * | Board | Pin | Timer | DMA request |
+ * |-------|-----|-------|-------------|
+ * | F091 | PA5 | TIM2_CH1 | TIM2_CH2 compare at zero, DMA1 channel 3 |
+ * | F446, L152 | PA5 | TIM2_CH1 | TIM2_UP, DMA1 stream 1 / channel 2 |
+ * | F722, F746, H743 | PB7 | TIM4_CH2 | TIM4_UP, DMA1 stream 6 / stream 2 |
+ * | G0B1, G431 | PA5 | TIM2_CH1 | TIM2_UP, DMA1 channel 3 |
+ * | H503 | PA5 | TIM2_CH1 | TIM2_UP, GPDMA1 channel 0 |
+ * | L412 | PB13 | TIM15_CH1N | TIM15_UP, DMA1 channel 5 |
+ *
+ * The PA5 of the G070 is not a timer output. On this board, the basic timer TIM7 interrupts at the edges of the LED.
+ * Each interrupt writes the BSRR of the LED pin and loads the length of the next segment to the auto reload register.
+ * The heartbeat takes 4 interrupts per second. The breathing is a 100Hz software PWM, and takes up to 200 interrupts
+ * per second.
+ *
+ * No task, no stack and no RTOS call.
+ *
+ * @code
+ * murasaki::platform.status_led = new murasaki::StatusLed(LED_PORT, LED_PIN);
+ * murasaki::platform.status_led->Start(murasaki::kslHeartbeat);
+ * ...
+ * murasaki::platform.status_led->SetPattern(murasaki::kslErrorCode, 3);
+ * @endcode
+ *
+ * SetPattern() can be called from any task and ISR. The new pattern starts immediately.
+ *
+ * Start() switches the LED pin to the alternate function of the timer. After that, writing the pin by the GPIO has no
+ * effect. The timer and the DMA are driven by the registers. The HAL TIM module is not needed. Only one instance can
+ * exist.
+ */
+class StatusLed
+{
+ public:
+    /**
+     * @brief Constructor
+     * @param port GPIO port of the LED.
+     * @param pin Pin mask of the LED. One of the GPIO_PIN_x.
+     */
+    StatusLed(GPIO_TypeDef *port, uint16_t pin);
+
+    /**
+     * @brief Start the timer and the pattern.
+     * @param pattern Pattern to play.
+     * @param code Number of the flashes of the kslErrorCode. 1 to 15.
+     */
+    void Start(StatusLedPattern pattern, unsigned int code = 1);
+
+    /**
+     * @brief Change the pattern.
+     * @param pattern Pattern to play.
+     * @param code Number of the flashes of the kslErrorCode. 1 to 15.
+     * @details
+     * Can be called from the task and the ISR.
+     */
+    void SetPattern(StatusLedPattern pattern, unsigned int code = 1);
+
+    /**
+     * @brief Follow the new timer clock.
+     * @details
+     * Call this function after the change of the system clock. The new prescaler is effective
+     * from the next segment. Nothing happens before Start().
+     */
+    void Retime();
+
+    /**
+     * @brief Step the pattern. Called from the basic timer interrupt handler. Do not call from the application.
+     * @details
+     * Does nothing on the boards with the PWM.
+     */
+    static void HandleInterrupt();
+
+    /**
+     * @brief Frequency of the timer counter [Hz]. The length of the segments is counted in this unit.
+     */
+    static const unsigned int kTickHz = 10000;
+
+ private:
+    // Length and level of the next segment. Zero length segment is skipped. The others are 2 ticks at least.
+    unsigned int NextSegment(bool &on);
+    // Prescaler to count at kTickHz.
+    static uint32_t Prescaler();
+    // Compare values of one cycle of the pattern, to the table of the DMA. Returns the number of the values. PWM only.
+    unsigned int FillTable();
+    // Play the table circularly, and stop it. PWM only.
+    void StartDma(unsigned int length);
+    void StopDma();
+
+    static StatusLed *instance_;
+
+    GPIO_TypeDef *const port_;
+    const uint32_t pin_;
+    // Pattern and code in one word. Written by SetPattern(), and read by the ISR.
+    volatile uint32_t request_;
+    StatusLedPattern pattern_;
+    unsigned int code_;
+    unsigned int step_;
+};
+
+} /* namespace murasaki */
+
+#endif /* STATUSLED_HPP_ */
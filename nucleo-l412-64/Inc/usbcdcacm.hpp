@@ -0,0 +1,217 @@
+/**
+ * @file usbcdcacm.hpp
+ *
+ * @date 2026/10/19
+ * @author Seiichi "Suikan" Horie
+ * @brief USB CDC-ACM virtual COM port as the console.
+ */
+
+#ifndef USBCDCACM_HPP_
+#define USBCDCACM_HPP_
+
+#include "murasaki.hpp"
+
+// Vendor ID and product ID of the device. The ones of the ST virtual COM port.
+#define USB_CDC_ACM_VID 0x0483
+#define USB_CDC_ACM_PID 0x5740
+// Size of each of the two transmission buffers [byte].
+#define USB_CDC_ACM_TX_BUFFER_SIZE 2048
+// Max packet size of the bulk endpoints and the EP0 [byte]. Full speed.
+#define USB_CDC_ACM_PACKET_SIZE 64
+
+namespace murasaki {
+
+#ifdef HAL_PCD_MODULE_ENABLED
+/**
+ * @brief Console over the USB OTG FS, as the CDC-ACM virtual COM port.
+ * @ingroup MURASAKI_PLATFORM_GROUP
+ * @details
+ * The ST-Link VCP is a UART. Its baud rate limits the log. The full speed USB makes around 1MB/s
+ * by the bulk transfer. This class is a UartStrategy over the PCD driver of the HAL. Thus, it is
+ * the console of the debugger through the UartLogger :
+ *
+ * @code
+ * murasaki::platform.usb_console = new murasaki::UsbCdcAcm(&hpcd_USB_OTG_FS);
+ * murasaki::platform.usb_console->Start();
+ * murasaki::platform.uart_console = murasaki::platform.usb_console;
+ * murasaki::platform.logger = new murasaki::UartLogger(murasaki::platform.uart_console);
+ * @endcode
+ *
+ * The class has its own minimal device core, instead of the USB device middleware of ST. It answers
+ * the standard requests of the EP0, and the CDC requests of the ACM :
+ *
+ * | Endpoint | Type      | Usage                                                     |
+ * |----------|-----------|-----------------------------------------------------------|
+ * | 0x00     | Control   | Enumeration. SET_LINE_CODING, SET_CONTROL_LINE_STATE.     |
+ * | 0x81     | Bulk IN   | Transmit(). Two buffers of USB_CDC_ACM_TX_BUFFER_SIZE.    |
+ * | 0x01     | Bulk OUT  | Receive(). Two buffers of USB_CDC_ACM_PACKET_SIZE.        |
+ * | 0x82     | Interrupt | Notification. Opened but not used.                        |
+ *
+ * The bulk endpoints are double buffered. Transmit() fills one buffer while the USB sends the other.
+ * The completion interrupt starts the filled buffer at once. The transfer longer than a packet is
+ * sent by one call of the HAL. A zero length packet ends the transfer of the multiple of the packet.
+ * Receive() reads one packet while the USB receives the next one.
+ *
+ * The port is open while the terminal on the host asserts DTR. Transmit() waits for it. The baud rate
+ * of the SET_LINE_CODING is kept but has no effect.
+ *
+ * The class needs the registered callbacks of the PCD. Set USE_HAL_PCD_REGISTER_CALLBACKS to 1 in the
+ * hal_conf.h. And the OTG_FS interrupt must call HAL_PCD_IRQHandler(). The callbacks of the UartStrategy
+ * are not used. Only one instance is allowed.
+ */
+class UsbCdcAcm : public UartStrategy
+{
+ public:
+    /**
+     * @brief Constructor.
+     * @param hpcd PCD handle initialized by the CubeIDE generated code.
+     */
+    UsbCdcAcm(PCD_HandleTypeDef *hpcd);
+
+    /**
+     * @brief Register the callbacks, allocate the FIFO of the endpoints and connect to the bus.
+     * @return true if success. false if the registered callbacks are disabled, or the USB is not supported.
+     */
+    bool Start();
+
+    /**
+     * @brief Transmit the data to the host.
+     * @param data Data to send.
+     * @param size Number of the bytes.
+     * @param timeout_ms Wait for the open of the port and for the free buffer [mS].
+     * @return kursOK if all data are queued. kursTimeOut otherwise.
+     * @details
+     * Returns after the data is copied to the buffer. Thread safe.
+     */
+    virtual UartStatus Transmit(
+                                const uint8_t *data,
+                                unsigned int size,
+                                WaitMilliSeconds timeout_ms = kwmsIndefinitely);
+
+    /**
+     * @brief Receive the data from the host.
+     * @param data Buffer to store the data.
+     * @param count Number of the bytes to receive.
+     * @param transfered_count Number of the received bytes. Can be nullptr.
+     * @param uart_timeout kutIdleTimeout to return at the end of the packet.
+     * @param timeout_ms Wait for each packet [mS].
+     * @return kursOK if success. kursTimeOut otherwise.
+     * @details
+     * Thread safe.
+     */
+    virtual UartStatus Receive(
+                               uint8_t *data,
+                               unsigned int count,
+                               unsigned int *transfered_count = nullptr,
+                               UartTimeout uart_timeout = kutNoIdleTimeout,
+                               WaitMilliSeconds timeout_ms = kwmsIndefinitely);
+
+    /**
+     * @brief Not used. The PCD callbacks are registered to the handle.
+     * @param ptr Not used.
+     * @return false.
+     */
+    virtual bool TransmitCompleteCallback(void *ptr);
+    /**
+     * @brief Not used. The PCD callbacks are registered to the handle.
+     * @param ptr Not used.
+     * @return false.
+     */
+    virtual bool ReceiveCompleteCallback(void *ptr);
+    /**
+     * @brief Not used. The PCD callbacks are registered to the handle.
+     * @param ptr Not used.
+     * @return false.
+     */
+    virtual bool HandleError(void *ptr);
+
+    /**
+     * @brief Check whether the terminal on the host opened the port.
+     * @return true if configured by the host, and DTR is asserted.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Get the baud rate of the SET_LINE_CODING.
+     * @return Baud rate set by the terminal [baud]. No effect on the transfer.
+     */
+    unsigned int GetLineCodingBaudRate() const;
+
+ private:
+    virtual void* GetPeripheralHandle();
+
+    // Trampolines of the registered callbacks of the PCD.
+    static void SetupStageCallback(PCD_HandleTypeDef *hpcd);
+    static void ResetCallback(PCD_HandleTypeDef *hpcd);
+    static void DisconnectCallback(PCD_HandleTypeDef *hpcd);
+    static void DataOutStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum);
+    static void DataInStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum);
+
+    // Called in the interrupt.
+    void OnSetup(const uint8_t *setup);
+    void OnReset();
+    void OnControlOut();
+    void OnControlIn();
+    void OnBulkOut();
+    void OnBulkIn();
+    bool OnStandardRequest(const uint8_t *setup);
+    bool OnClassRequest(const uint8_t *setup);
+    void SendControl(const uint8_t *data, unsigned int length, unsigned int requested);
+    void SendStatus();
+    void StallControl();
+    void Configure(uint8_t configuration);
+    unsigned int MakeStringDescriptor(uint8_t index);
+
+    // Called in the critical section, or in the interrupt.
+    void StartTransmit();
+    void ArmReceive(unsigned int index);
+
+    enum ControlState
+    {
+        kcsIdle,
+        kcsDataIn,
+        kcsDataOut,
+        kcsStatusIn,
+        kcsStatusOut
+    };
+
+    PCD_HandleTypeDef *const hpcd_;
+    CriticalSection *tx_critical_section_;
+    CriticalSection *rx_critical_section_;
+    Synchronizer *tx_sync_;
+    Synchronizer *rx_sync_;
+
+    // EP0.
+    ControlState control_state_;
+    const uint8_t *control_data_;
+    unsigned int control_remaining_;
+    bool control_zlp_;
+    uint8_t control_request_;
+    uint8_t control_buffer_[2 * USB_CDC_ACM_PACKET_SIZE];
+    uint8_t line_coding_[7];
+    volatile uint8_t configuration_;
+    volatile bool dtr_;
+
+    // Bulk IN. The task fills tx_buffers_[tx_fill_]. The other one is in flight while tx_busy_.
+    uint8_t tx_buffers_[2][USB_CDC_ACM_TX_BUFFER_SIZE];
+    volatile unsigned int tx_length_[2];
+    volatile unsigned int tx_fill_;
+    volatile bool tx_busy_;
+    unsigned int tx_last_length_;
+
+    // Bulk OUT. rx_length_[i] is 0 while the buffer is free.
+    uint8_t rx_buffers_[2][USB_CDC_ACM_PACKET_SIZE];
+    volatile unsigned int rx_length_[2];
+    volatile unsigned int rx_armed_;
+    volatile bool rx_busy_;
+    unsigned int rx_read_;
+    unsigned int rx_position_;
+
+    // The registered callbacks of the PCD have no context.
+    static UsbCdcAcm *instance_;
+};
+#endif
+
+} /* namespace murasaki */
+
+#endif /* USBCDCACM_HPP_ */
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Switch the console of the board to the higher baud rate, and show the console.
+
+Talks with the murasaki::ConsoleBaud of the board. Start this tool, then reset the board.
+The board waits for the request PLATFORM_CONFIG_CONSOLE_BAUD_WINDOW mS at the boot :
+
+  tool  : "BAUD <rate>\\r" repeatedly, at the default rate
+  board : "ACK\\r\\n" ( or "NAK\\r\\n" if the board can't make the rate )
+  both  : switch to <rate>
+  tool  : "SYNC\\r" repeatedly
+  board : "SYNC\\r\\n"
+
+Then, the console output is copied to stdout. When the text is broken, the tool goes back to the
+default rate. The board does the same on the framing errors.
+
+The serial port is opened by pyserial. The ST-Link V2-1 VCP is up to 2Mbaud, the STLINK-V3 up to 16Mbaud.
+
+Usage :
+  consolebaud.py [--baud <rate>] [--default <rate>] [--timeout <sec>] <port>
+
+The default rate is 921600, from 115200.
+"""
+
+import argparse
+import sys
+import time
+
+try:
+    import serial
+except ImportError:
+    sys.exit('consolebaud: pyserial is needed. pip install pyserial')
+
+# Interval of the repeated request [sec].
+REPEAT = 0.05
+# Wait for the SYNC answer at the new rate [sec]. Shorter than the CONSOLE_BAUD_SYNC_TIMEOUT of the board.
+SYNC_TIMEOUT = 0.4
+# Ratio of the non text bytes in a chunk, to judge the text is broken.
+BROKEN_RATIO = 0.25
+
+
+def request(port, message, answers, timeout):
+    """ Repeat the message until one of the answers is received. The answer or None. """
+    received = b''
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        port.write(message)
+        end = time.monotonic() + REPEAT
+        while time.monotonic() < end:
+            received += port.read(port.in_waiting or 1)
+            for answer in answers:
+                if answer in received:
+                    return answer
+    return None
+
+
+def negotiate(port, rate, default, timeout):
+    """ True if the board is switched to the rate. """
+    port.baudrate = default
+    port.reset_input_buffer()
+    answer = request(port, b'BAUD %d\r' % rate, [b'ACK\r\n', b'NAK\r\n'], timeout)
+    if answer is None:
+        print('consolebaud: no answer from the board. Reset the board while this tool runs.', file=sys.stderr)
+        return False
+    if answer == b'NAK\r\n':
+        print('consolebaud: the board can not make %d baud.' % rate, file=sys.stderr)
+        return False
+
+    port.flush()
+    port.baudrate = rate
+    port.reset_input_buffer()
+    if request(port, b'SYNC\r', [b'SYNC\r\n'], SYNC_TIMEOUT) is None:
+        print('consolebaud: no SYNC at %d baud. Keep %d baud.' % (rate, default), file=sys.stderr)
+        port.baudrate = default
+        return False
+    return True
+
+
+def is_broken(chunk):
+    """ True if the chunk doesn't look like the text. """
+    if len(chunk) < 16:
+        return False
+    bad = sum(1 for c in chunk if c >= 0x80 or (c < 0x20 and c not in (0x09, 0x0a, 0x0d)))
+    return bad > len(chunk) * BROKEN_RATIO
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Negotiate the console baud rate with the board.')
+    parser.add_argument('--baud', type=int, default=921600)
+    parser.add_argument('--default', type=int, default=115200)
+    parser.add_argument('--timeout', type=float, default=30.0, help='wait for the reset of the board [sec]')
+    parser.add_argument('port')
+    args = parser.parse_args(argv)
+
+    try:
+        port = serial.Serial(args.port, args.default, timeout=REPEAT)
+    except serial.SerialException as e:
+        sys.exit('consolebaud: %s' % e)
+
+    if negotiate(port, args.baud, args.default, args.timeout):
+        print('consolebaud: %d baud' % args.baud, file=sys.stderr)
+
+    out = sys.stdout.buffer
+    try:
+        while True:
+            chunk = port.read(port.in_waiting or 1)
+            if port.baudrate != args.default and is_broken(chunk):
+                print('\nconsolebaud: broken text. Back to %d baud.' % args.default, file=sys.stderr)
+                port.baudrate = args.default
+                continue
+            out.write(chunk)
+            out.flush()
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
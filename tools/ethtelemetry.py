@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Receive the UDP telemetry of the board, and write the records to stdout.
+
+Receives the frames of the murasaki::EthTelemetry. The payload of each frame is :
+
+  sequence : 32bit little endian. Incremented by each frame.
+  records  : As written by the board. The records are not split between the frames.
+
+The records are written to stdout as is. The lost frames are found by the sequence number,
+and reported to stderr. The statistics are printed at the end.
+
+The board sends to the broadcast address by default. Run the tool on the same segment. Set the
+address of the PC to 192.168.0.x, as the PLATFORM_CONFIG_ETH_TELEMETRY_SOURCE_IP of the board.
+
+Usage :
+  ethtelemetry.py [--port <port>] [--bind <address>] [--quiet]
+
+The default port is 5555.
+"""
+
+import argparse
+import socket
+import struct
+import sys
+import time
+
+# Size of the sequence number at the top of the payload.
+SEQUENCE_SIZE = 4
+# Largest payload of a frame.
+MAX_PAYLOAD = 1472
+# Interval of the statistics on stderr [sec].
+REPORT_INTERVAL = 5.0
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Receive the UDP telemetry of the board.')
+    parser.add_argument('--port', type=int, default=5555)
+    parser.add_argument('--bind', default='', help='address to receive. All interfaces by default')
+    parser.add_argument('--quiet', action='store_true', help='no record on stdout. Statistics only')
+    args = parser.parse_args(argv)
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_BROADCAST, 1)
+    # Large buffer. The board sends up to 12MB/s.
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4 * 1024 * 1024)
+    try:
+        sock.bind((args.bind, args.port))
+    except OSError as e:
+        sys.exit('ethtelemetry: %s' % e)
+
+    out = sys.stdout.buffer
+    expected = None
+    frames = 0
+    lost = 0
+    received = 0
+    start = time.monotonic()
+    report = start + REPORT_INTERVAL
+    try:
+        while True:
+            payload, source = sock.recvfrom(MAX_PAYLOAD)
+            if len(payload) < SEQUENCE_SIZE:
+                continue
+            sequence, = struct.unpack_from('<I', payload)
+            # The first frame, or the board was reset.
+            if expected is not None and sequence != expected:
+                if sequence == 0:
+                    print('ethtelemetry: restarted by %s' % source[0], file=sys.stderr)
+                else:
+                    missing = (sequence - expected) & 0xFFFFFFFF
+                    lost += missing
+                    print('ethtelemetry: %d frames lost before %d' % (missing, sequence), file=sys.stderr)
+            expected = (sequence + 1) & 0xFFFFFFFF
+            frames += 1
+            received += len(payload) - SEQUENCE_SIZE
+
+            if not args.quiet:
+                out.write(payload[SEQUENCE_SIZE:])
+                out.flush()
+
+            now = time.monotonic()
+            if args.quiet and now >= report:
+                print('ethtelemetry: %d frames, %.2f MB/s' % (frames, received / (now - start) / 1e6),
+                      file=sys.stderr)
+                report = now + REPORT_INTERVAL
+    except KeyboardInterrupt:
+        pass
+
+    elapsed = time.monotonic() - start
+    print('ethtelemetry: %d frames, %d bytes, %d lost, %.2f MB/s'
+          % (frames, received, lost, received / elapsed / 1e6 if elapsed > 0 else 0.0), file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
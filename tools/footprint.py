@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+"""Flash / RAM footprint report of a Nucleo project, with the budget check.
+
+Reads the map file generated by the GNU linker, and breaks the usage down by module :
+
+  hal       : Drivers/ ( HAL, LL and CMSIS )
+  freertos  : Middlewares/Third_Party/FreeRTOS, except the heap array
+  murasaki  : murasaki/ ( class library )
+  platform  : Src/, Core/ and Startup/ of the project
+  library   : libc, libm, libstdc++ and libgcc
+  heap      : ucHeap of the FreeRTOS heap_4. The task stacks are allocated here
+  stack     : ._user_heap_stack. The main stack and the newlib heap
+
+The flash column is the code, read only data and the initial value of .data. The ram column
+is .data, .bss and the reserved area. The bss column is the .bss part of the ram column.
+
+The result is compared with the budget file ( footprint_budget.json, next to this script ).
+The module which exceeds its budget by more than the tolerance of the board, and the total which
+exceeds the memory of the linker script are reported as error. The exit status is 1 on error.
+The module which has no budget is reported as warning, until the budget is recorded by --update.
+
+Usage :
+  footprint.py <project dir> [<map file>]             report and check
+  footprint.py --update <project dir> [<map file>]    write the current usage as the budget
+
+The default map file is <project dir>/Debug/<project name>.map.
+"""
+
+import glob
+import json
+import os
+import re
+import sys
+
+MODULES = ['hal', 'freertos', 'murasaki', 'platform', 'library', 'other', 'heap', 'stack']
+
+BUDGET_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'footprint_budget.json')
+
+# Allowed growth over the budget [byte], if the board has no "tolerance" in the budget file.
+DEFAULT_TOLERANCE = {'flash': 512, 'ram': 64}
+
+# Output sections which are not loaded to the target.
+DEBUG_SECTION = re.compile(r'^\.(debug|comment|ARM\.attributes|stab|note|gnu)')
+
+# Output section header. " load address" is appended when LMA != VMA.
+# The address part is on the next line when the name is long.
+OUTPUT_NAME = re.compile(r'^(\.?[\w.]+)\s*$')
+OUTPUT_SECTION = re.compile(r'^(\.?[\w.]+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address 0x([0-9a-fA-F]+))?\s*$')
+# Input section. The name may be on the previous line when it is long.
+INPUT_SECTION = re.compile(r'^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+INPUT_NAME_ONLY = re.compile(r'^ (\S+)$')
+# MEMORY region of the linker script.
+REGION = re.compile(r'^\s*(\w+)\s*\([rwx!]+\)\s*:\s*ORIGIN\s*=\s*(0x[0-9a-fA-F]+|\d+)\s*,\s*LENGTH\s*=\s*(\d+)\s*([KM]?)')
+
+
+def read_regions(project):
+    """ MEMORY regions of the FLASH linker script. [(name, origin, length)]"""
+    scripts = glob.glob(os.path.join(project, '*_FLASH.ld'))
+    if not scripts:
+        sys.exit('footprint: no *_FLASH.ld in %s' % project)
+
+    regions = []
+    with open(scripts[0]) as f:
+        for line in f:
+            m = REGION.match(line)
+            if m:
+                scale = {'': 1, 'K': 1024, 'M': 1024 * 1024}[m.group(4)]
+                regions.append((m.group(1), int(m.group(2), 0), int(m.group(3)) * scale))
+    return regions
+
+
+def region_of(regions, address):
+    """ Name of the MEMORY region which contains the address. None if not allocated. """
+    for name, origin, length in regions:
+        if origin <= address < origin + length:
+            return name
+    return None
+
+
+def classify(section, source):
+    """ Module of the input section. """
+    path = source.replace('\\', '/')
+    if 'ucHeap' in section or (re.search(r'heap_\d\.o', path) and section.startswith(('.bss', 'COMMON'))):
+        return 'heap'
+    if '/murasaki/' in path:
+        return 'murasaki'
+    if '/FreeRTOS/' in path:
+        return 'freertos'
+    if 'Drivers/' in path:
+        return 'hal'
+    if re.search(r'lib[a-z_+]*\.a\(', path) or path.endswith('.a'):
+        return 'library'
+    if re.search(r'(^|/)(Src|Core|Startup)/', path):
+        return 'platform'
+    return 'other'
+
+
+def read_map(map_file, regions):
+    """ {module : {'flash', 'ram', 'bss'}} """
+    usage = {m: {'flash': 0, 'ram': 0, 'bss': 0} for m in MODULES}
+    in_map = False
+    output = None
+    output_name = None
+    input_name = None
+
+    with open(map_file) as f:
+        for line in f:
+            line = line.rstrip('\n')
+            if not in_map:
+                in_map = line.startswith('Linker script and memory map')
+                continue
+
+            # Output section.
+            m = OUTPUT_NAME.match(line)
+            if m:
+                output_name = m.group(1)
+                output = None
+                continue
+            m = OUTPUT_SECTION.match(line)
+            if m and (m.group(1) or output_name):
+                name = m.group(1) or output_name
+                vma = int(m.group(2), 16)
+                lma = int(m.group(4), 16) if m.group(4) else vma
+                vma_region = region_of(regions, vma)
+                lma_region = region_of(regions, lma)
+                output_name = None
+                input_name = None
+                if DEBUG_SECTION.match(name) or vma_region is None:
+                    output = None
+                    continue
+                output = (name, 'FLASH' in (lma_region or ''), 'FLASH' not in vma_region)
+                if name == '._user_heap_stack':
+                    # Reserved by the location counter. No input section.
+                    usage['stack']['ram'] += int(m.group(3), 16)
+                    output = None
+                continue
+            output_name = None
+            if output is None:
+                continue
+
+            # Input section in the output section.
+            m = INPUT_NAME_ONLY.match(line)
+            if m:
+                input_name = m.group(1)
+                continue
+            m = INPUT_SECTION.match(line)
+            if not m:
+                input_name = None
+                continue
+            section = m.group(1) or input_name or ''
+            size = int(m.group(3), 16)
+            input_name = None
+            if section.startswith('*') or size == 0:
+                continue
+
+            name, in_flash, in_ram = output
+            module = classify(section, m.group(4))
+            nobits = name.startswith('.bss') or section.startswith('COMMON')
+            if in_flash and not nobits:
+                usage[module]['flash'] += size
+            if in_ram:
+                usage[module]['ram'] += size
+                if nobits:
+                    usage[module]['bss'] += size
+    if not in_map:
+        sys.exit('footprint: %s is not a GNU ld map file' % map_file)
+    return usage
+
+
+def capacity(regions):
+    flash = sum(length for name, origin, length in regions if 'FLASH' in name)
+    ram = sum(length for name, origin, length in regions if 'FLASH' not in name)
+    return flash, ram
+
+
+def delta(value, budget):
+    if budget is None:
+        return '%9s' % '-'
+    return '%+9d' % (value - budget)
+
+
+def report(board, usage, regions, budget):
+    """ Print the table. Return the number of the errors. """
+    errors = 0
+    unchecked = []
+    tolerance = budget.get('tolerance', DEFAULT_TOLERANCE)
+    print('%-16s %9s %9s %9s %9s %9s' % (board, 'flash', 'delta', 'ram', 'delta', 'bss'))
+    for module in MODULES:
+        u = usage[module]
+        b = budget.get(module, {})
+        line = '%-16s %9d %s %9d %s %9d' % (module,
+                                            u['flash'], delta(u['flash'], b.get('flash')),
+                                            u['ram'], delta(u['ram'], b.get('ram')),
+                                            u['bss'])
+        over = [kind for kind in ('flash', 'ram') if kind in b and u[kind] > b[kind] + tolerance[kind]]
+        missing = [kind for kind in ('flash', 'ram') if kind not in b]
+        if over:
+            line += '  OVER BUDGET ( %s )' % ', '.join(over)
+            errors += 1
+        elif missing:
+            # A module without the budget can't be checked. Record it by --update.
+            line += '  NO BUDGET ( %s )' % ', '.join(missing)
+            unchecked.append(module)
+        print(line)
+
+    total_flash = sum(u['flash'] for u in usage.values())
+    total_ram = sum(u['ram'] for u in usage.values())
+    total_bss = sum(u['bss'] for u in usage.values())
+    cap_flash, cap_ram = capacity(regions)
+    print('%-16s %9d %9s %9d %9s %9d' % ('total', total_flash, '', total_ram, '', total_bss))
+    print('%-16s %9d %9s %9d' % ('capacity', cap_flash, '', cap_ram))
+    print('%-16s %9d %9s %9d' % ('tolerance', tolerance['flash'], '', tolerance['ram']))
+    if total_flash > cap_flash or total_ram > cap_ram:
+        print('footprint: %s does not fit to the device' % board)
+        errors += 1
+    if unchecked:
+        print('footprint: warning : %s of %s have no budget. Record them by --update'
+              % (', '.join(unchecked), board))
+    return errors
+
+
+def main(argv):
+    update = '--update' in argv
+    args = [a for a in argv if a != '--update']
+    if not 1 <= len(args) <= 2:
+        sys.exit(__doc__)
+
+    project = os.path.abspath(args[0])
+    board = os.path.basename(project)
+    map_file = args[1] if len(args) == 2 else os.path.join(project, 'Debug', board + '.map')
+
+    regions = read_regions(project)
+    usage = read_map(map_file, regions)
+
+    budgets = {}
+    if os.path.exists(BUDGET_FILE):
+        with open(BUDGET_FILE) as f:
+            budgets = json.load(f)
+
+    if update:
+        tolerance = budgets.get(board, {}).get('tolerance', DEFAULT_TOLERANCE)
+        budgets[board] = {m: {'flash': usage[m]['flash'], 'ram': usage[m]['ram']} for m in MODULES}
+        budgets[board]['tolerance'] = tolerance
+        with open(BUDGET_FILE, 'w') as f:
+            json.dump(budgets, f, indent=2, sort_keys=True)
+            f.write('\n')
+        print('footprint: budget of %s is updated' % board)
+        return 0
+
+    errors = report(board, usage, regions, budgets.get(board, {}))
+    return 1 if errors else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""Receive the framed console of the board, and split the text and the binary records.
+
+Decodes the frames of the murasaki::FramedConsole. Each frame is encoded by the COBS, and terminated by 0x00 :
+
+  channel  : 1 byte. 0 is the text of the debugger.
+  sequence : 1 byte. Incremented by each frame of the channel.
+  payload  : up to 250 bytes.
+  crc      : CRC-16/CCITT-FALSE of the above, 2 bytes little endian.
+
+The text of the channel 0 is written to stdout. The records of the other channels are written to stdout
+as the CSV lines "channel,field,field,...", decoded by the struct format given by --format, or as hex.
+The frames with the wrong CRC and the lost frames are reported to stderr. The exit status is not zero
+if any. The bytes before the first delimiter, like the baud rate handshake and the boot banner, are
+discarded. Only the broken frames after that are counted.
+
+The baud rate is negotiated as tools/consolebaud.py does, when --baud is given. Then, reset the board.
+The input can be a file of the captured stream, or "-" for stdin, instead of the serial port.
+
+Usage :
+  framedconsole.py [--baud <rate>] [--default <rate>] [--format <channel>=<struct format>] <port | file | ->
+
+Example :
+  framedconsole.py --baud 921600 --format 1='<III' /dev/ttyACM0
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+# Channel of the text.
+CHANNEL_TEXT = 0
+# Channel, sequence and CRC.
+FRAME_OVERHEAD = 4
+
+
+def crc16(data, crc=0xFFFF):
+    """ CRC-16/CCITT-FALSE. """
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(chunk):
+    """ Decoded bytes of a chunk between the delimiters, or None if broken. """
+    out = bytearray()
+    i = 0
+    while i < len(chunk):
+        code = chunk[i]
+        if code == 0 or i + code > len(chunk):
+            return None
+        out += chunk[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(chunk):
+            out.append(0)
+    return bytes(out)
+
+
+class Receiver:
+    """ Splits the stream into the frames, and tracks the sequence numbers. """
+
+    def __init__(self, out, formats):
+        self.out = out
+        self.formats = formats
+        self.pending = bytearray()
+        # The bytes before the first delimiter are not a frame.
+        self.synced = False
+        self.expected = {}
+        self.frames = 0
+        self.broken = 0
+        self.lost = 0
+
+    def feed(self, data):
+        self.pending += data
+        while True:
+            end = self.pending.find(0)
+            if end < 0:
+                return
+            chunk = bytes(self.pending[:end])
+            del self.pending[:end + 1]
+            if chunk and self.synced:
+                self.frame(chunk)
+            self.synced = True
+
+    def frame(self, chunk):
+        decoded = cobs_decode(chunk)
+        if decoded is None or len(decoded) < FRAME_OVERHEAD or \
+                crc16(decoded[:-2]) != struct.unpack_from('<H', decoded, len(decoded) - 2)[0]:
+            # The frame broken on the line.
+            self.broken += 1
+            return
+
+        channel, sequence = decoded[0], decoded[1]
+        payload = decoded[2:-2]
+        expected = self.expected.get(channel)
+        if expected is not None and sequence != expected:
+            missing = (sequence - expected) & 0xFF
+            self.lost += missing
+            print('framedconsole: %d frames lost in channel %d' % (missing, channel), file=sys.stderr)
+        self.expected[channel] = (sequence + 1) & 0xFF
+        self.frames += 1
+
+        if channel == CHANNEL_TEXT:
+            self.out.write(payload)
+        elif channel in self.formats and len(payload) == struct.calcsize(self.formats[channel]):
+            fields = struct.unpack(self.formats[channel], payload)
+            self.out.write(('%d,%s\n' % (channel, ','.join(str(f) for f in fields))).encode())
+        else:
+            self.out.write(('%d,%s\n' % (channel, payload.hex())).encode())
+        self.out.flush()
+
+
+def parse_formats(specs):
+    formats = {}
+    for spec in specs:
+        channel, _, fmt = spec.partition('=')
+        try:
+            struct.calcsize(fmt)
+            formats[int(channel)] = fmt
+        except (ValueError, struct.error):
+            sys.exit('framedconsole: bad format %s' % spec)
+    return formats
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Receive the framed console of the board.')
+    parser.add_argument('--baud', type=int, default=None, help='negotiate the baud rate as tools/consolebaud.py')
+    parser.add_argument('--default', type=int, default=115200)
+    parser.add_argument('--timeout', type=float, default=30.0, help='wait for the reset of the board [sec]')
+    parser.add_argument('--format', action='append', default=[], help='struct format of a channel. 1=<III')
+    parser.add_argument('port')
+    args = parser.parse_args(argv)
+
+    receiver = Receiver(sys.stdout.buffer, parse_formats(args.format))
+    try:
+        if args.port == '-' or os.path.isfile(args.port):
+            source = sys.stdin.buffer if args.port == '-' else open(args.port, 'rb')
+            for data in iter(lambda: source.read(4096), b''):
+                receiver.feed(data)
+        else:
+            try:
+                import serial
+            except ImportError:
+                sys.exit('framedconsole: pyserial is needed. pip install pyserial')
+            sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+            import consolebaud
+
+            try:
+                port = serial.Serial(args.port, args.default, timeout=consolebaud.REPEAT)
+            except serial.SerialException as e:
+                sys.exit('framedconsole: %s' % e)
+            if args.baud is not None and consolebaud.negotiate(port, args.baud, args.default, args.timeout):
+                print('framedconsole: %d baud' % args.baud, file=sys.stderr)
+            while True:
+                receiver.feed(port.read(port.in_waiting or 1))
+    except KeyboardInterrupt:
+        pass
+
+    print('framedconsole: %d frames, %d broken, %d lost' % (receiver.frames, receiver.broken, receiver.lost),
+          file=sys.stderr)
+    return 0 if receiver.broken == 0 and receiver.lost == 0 else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Symbolize the call chain and the crash record in the console log by the ELF file.
+
+Looks for the lines printed by the StackUnwinder and the CrashRecord :
+
+  Call chain : 0x08001235 0x080045a7 ...
+  PC   : 0x08001234, LR   : 0x08005679, SP   : 0x20001f00, xPSR : 0x21000000
+
+and prints the log with the function name and the source line of each address.
+The return addresses of the call chain are looked up at the call instruction, that is,
+2 byte before the address. The PC is looked up as is.
+
+The addresses are resolved by addr2line of the GNU toolchain. The default is
+arm-none-eabi-addr2line in the PATH.
+
+Usage :
+  symbolize.py [--addr2line <command>] <elf file> [<log file>]
+
+The default log is stdin. The ELF file of the Debug build is <project>/Debug/<project>.elf.
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+CHAIN = re.compile(r'Call chain :((?:\s+0x[0-9a-fA-F]+)*)')
+REGISTER = re.compile(r'\b(PC|LR)\s*:\s*(0x[0-9a-fA-F]+)')
+
+
+def lookups(line):
+    """ [(label, address to look up)] of a line. """
+    result = []
+    m = CHAIN.search(line)
+    if m:
+        for i, word in enumerate(m.group(1).split()):
+            value = int(word, 16)
+            result.append(('#%d %s' % (i, word), (value & ~1) - 2))
+        return result
+    for m in REGISTER.finditer(line):
+        value = int(m.group(2), 16)
+        if m.group(1) == 'PC':
+            result.append(('PC %s' % m.group(2), value & ~1))
+        elif value & 1:
+            # The LR of a crash record is a return address, unless it is EXC_RETURN ( 0xFFFFFFxx ).
+            if value < 0xFFFFFF00:
+                result.append(('LR %s' % m.group(2), (value & ~1) - 2))
+    return result
+
+
+def resolve(addr2line, elf, addresses):
+    """ {address : 'function at file:line'} """
+    if not addresses:
+        return {}
+    addresses = sorted(set(addresses))
+    try:
+        output = subprocess.run([addr2line, '-f', '-C', '-p', '-e', elf] + ['0x%x' % a for a in addresses],
+                                stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout
+    except (OSError, subprocess.CalledProcessError) as e:
+        sys.exit('symbolize: cannot run %s : %s' % (addr2line, e))
+    lines = output.splitlines()
+    return dict(zip(addresses, lines))
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Symbolize the call chain in the console log.')
+    parser.add_argument('--addr2line', default='arm-none-eabi-addr2line')
+    parser.add_argument('elf')
+    parser.add_argument('log', nargs='?')
+    args = parser.parse_args(argv)
+
+    if args.log:
+        with open(args.log, errors='replace') as f:
+            log = f.read().splitlines()
+    else:
+        log = sys.stdin.read().splitlines()
+
+    pending = [lookups(line) for line in log]
+    symbols = resolve(args.addr2line, args.elf, [address for items in pending for label, address in items])
+
+    for line, items in zip(log, pending):
+        print(line)
+        for label, address in items:
+            print('    %-16s %s' % (label, symbols.get(address, '??')))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
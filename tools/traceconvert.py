@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+"""Convert the kernel trace dump of the trace recorder to the Chrome / Perfetto JSON or the CTF.
+
+The input is the console log which contains the output of TracePrint() :
+
+  #trace begin version=1 clock=<Hz> entries=<n> lost=<n>
+  #object <id> <task|queue> <name>
+  <timestamp> <event> <object> <value>
+  ...
+  #trace end
+
+The other lines in the log are ignored. The timestamp is the 32bit cycle counter in hex.
+The wrap around is unwrapped, assuming the interval of the entries is less than 2^32 cycles.
+
+JSON : Open by https://ui.perfetto.dev or chrome://tracing. The tasks and the interrupts are
+shown as the slices in their own tracks. The queue, semaphore and mutex operations are shown
+as the instant events in the track of the task or interrupt which does it.
+
+CTF : A directory with the metadata and a stream file. Readable by babeltrace2 or Trace Compass.
+
+Usage :
+  traceconvert.py [--format json|ctf] [-o <output>] [<log file>]
+
+The default format is json. The default input is stdin. The default output is trace.json or
+trace.ctf/ .
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+EVENT_TASK_SWITCHED_IN = 0x01
+EVENT_TASK_SWITCHED_OUT = 0x02
+EVENT_ISR_ENTER = 0x03
+EVENT_ISR_EXIT = 0x04
+
+QUEUE_OPERATIONS = {0x10: 'send', 0x20: 'receive', 0x30: 'block_send', 0x40: 'block_receive', 0x50: 'failed'}
+QUEUE_KINDS = {0: 'queue', 1: 'semaphore', 2: 'mutex'}
+FROM_ISR = 0x08
+
+# Exception number of the Cortex-M. The external interrupts are shown as IRQ<n>.
+EXCEPTIONS = {2: 'NMI', 3: 'HardFault', 4: 'MemManage', 5: 'BusFault', 6: 'UsageFault',
+              11: 'SVCall', 14: 'PendSV', 15: 'SysTick'}
+
+BEGIN = re.compile(r'#trace begin version=(\d+) clock=(\d+) entries=(\d+) lost=(\d+)')
+OBJECT = re.compile(r'#object ([0-9a-fA-F]+) (task|queue) (.*)$')
+ENTRY = re.compile(r'^([0-9a-fA-F]{8}) ([0-9a-fA-F]{2}) ([0-9a-fA-F]{4}) (\d+)$')
+
+CTF_MAGIC = 0xC1FC1FC1
+
+
+class Trace:
+    def __init__(self):
+        self.clock = 0
+        self.lost = 0
+        self.objects = {}     # id : (kind, name)
+        self.entries = []     # (cycles, event, object, value). cycles is unwrapped.
+
+
+def parse(lines):
+    """ The last trace in the log. """
+    trace = None
+    current = None
+    last = 0
+    high = 0
+    for line in lines:
+        line = line.strip()
+        m = BEGIN.search(line)
+        if m:
+            if int(m.group(1)) != 1:
+                sys.exit('traceconvert: unknown version %s' % m.group(1))
+            current = Trace()
+            current.clock = int(m.group(2))
+            current.lost = int(m.group(4))
+            last = 0
+            high = 0
+            continue
+        if current is None:
+            continue
+        if line.startswith('#trace end'):
+            trace = current
+            current = None
+            continue
+        m = OBJECT.match(line)
+        if m:
+            current.objects[int(m.group(1), 16)] = (m.group(2), m.group(3).strip())
+            continue
+        m = ENTRY.match(line)
+        if m:
+            timestamp = int(m.group(1), 16)
+            if current.entries and timestamp < last:
+                high += 1 << 32
+            last = timestamp
+            current.entries.append((high + timestamp, int(m.group(2), 16), int(m.group(3), 16), int(m.group(4))))
+    if trace is None:
+        sys.exit('traceconvert: no complete trace in the input')
+    if not trace.entries:
+        sys.exit('traceconvert: the trace is empty')
+    return trace
+
+
+def isr_name(number):
+    if number >= 16:
+        return 'IRQ%d' % (number - 16)
+    return EXCEPTIONS.get(number, 'exception%d' % number)
+
+
+def object_name(trace, object_id):
+    if object_id in trace.objects:
+        return trace.objects[object_id][1]
+    return '0x%05x' % (object_id << 2)
+
+
+def describe(trace, event, object_id):
+    """ (category, name) of the event. """
+    if event == EVENT_TASK_SWITCHED_IN:
+        return 'task', 'switched_in'
+    if event == EVENT_TASK_SWITCHED_OUT:
+        return 'task', 'switched_out'
+    if event == EVENT_ISR_ENTER:
+        return 'isr', 'isr_enter'
+    if event == EVENT_ISR_EXIT:
+        return 'isr', 'isr_exit'
+    operation = QUEUE_OPERATIONS.get(event & 0xF0, 'unknown')
+    kind = QUEUE_KINDS.get(event & 0x07, 'queue')
+    suffix = '_from_isr' if event & FROM_ISR else ''
+    return kind, '%s_%s%s' % (kind, operation, suffix)
+
+
+def to_json(trace, output):
+    """ Chrome trace event format. The task and the interrupt are a thread each. """
+    start = trace.entries[0][0]
+    us = 1000000.0 / trace.clock
+    events = []
+    tids = {}
+
+    def tid(name):
+        if name not in tids:
+            tids[name] = len(tids) + 1
+            events.append({'ph': 'M', 'name': 'thread_name', 'pid': 1, 'tid': tids[name], 'args': {'name': name}})
+        return tids[name]
+
+    events.append({'ph': 'M', 'name': 'process_name', 'pid': 1, 'args': {'name': 'FreeRTOS'}})
+    running = None       # Name of the running task.
+    isr_stack = []       # Names of the nested interrupts.
+    for cycles, event, object_id, value in trace.entries:
+        ts = (cycles - start) * us
+        if event == EVENT_TASK_SWITCHED_IN:
+            running = object_name(trace, object_id)
+            events.append({'ph': 'B', 'name': running, 'cat': 'task', 'pid': 1, 'tid': tid(running), 'ts': ts})
+        elif event == EVENT_TASK_SWITCHED_OUT:
+            name = object_name(trace, object_id)
+            events.append({'ph': 'E', 'name': name, 'cat': 'task', 'pid': 1, 'tid': tid(name), 'ts': ts})
+            running = None
+        elif event == EVENT_ISR_ENTER:
+            name = isr_name(object_id)
+            isr_stack.append(name)
+            events.append({'ph': 'B', 'name': name, 'cat': 'isr', 'pid': 1, 'tid': tid(name), 'ts': ts})
+        elif event == EVENT_ISR_EXIT:
+            name = isr_name(object_id)
+            if name in isr_stack:
+                isr_stack.remove(name)
+            events.append({'ph': 'E', 'name': name, 'cat': 'isr', 'pid': 1, 'tid': tid(name), 'ts': ts})
+        else:
+            category, name = describe(trace, event, object_id)
+            context = isr_stack[-1] if isr_stack else (running or 'kernel')
+            events.append({'ph': 'i', 's': 't', 'name': name, 'cat': category, 'pid': 1, 'tid': tid(context),
+                           'ts': ts, 'args': {'object': object_name(trace, object_id), 'waiting': value}})
+
+    with open(output, 'w') as f:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ns',
+                   'otherData': {'clock_hz': trace.clock, 'lost_entries': trace.lost}}, f, indent=0)
+        f.write('\n')
+
+
+CTF_METADATA = '''/* CTF 1.8 */
+
+typealias integer { size = 8; align = 8; signed = false; } := uint8_t;
+typealias integer { size = 16; align = 8; signed = false; } := uint16_t;
+typealias integer { size = 32; align = 8; signed = false; } := uint32_t;
+typealias integer { size = 64; align = 8; signed = false; } := uint64_t;
+
+trace {
+    major = 1;
+    minor = 8;
+    byte_order = le;
+    packet.header := struct {
+        uint32_t magic;
+    };
+};
+
+env {
+    domain = "freertos";
+    lost_entries = %(lost)d;
+};
+
+clock {
+    name = cycles;
+    freq = %(clock)d;
+    offset = 0;
+};
+
+typealias integer { size = 64; align = 8; signed = false; map = clock.cycles.value; } := cycles_t;
+
+stream {
+    event.header := struct {
+        uint8_t id;
+        cycles_t timestamp;
+    };
+};
+'''
+
+CTF_EVENT = '''
+event {
+    name = "%s";
+    id = %d;
+    fields := struct {
+        uint16_t object;
+        uint8_t value;
+        string name;
+    };
+};
+'''
+
+
+def to_ctf(trace, output):
+    """ CTF 1.8. One stream, one packet. """
+    os.makedirs(output, exist_ok=True)
+    ids = {}
+    stream = bytearray(struct.pack('<I', CTF_MAGIC))
+    for cycles, event, object_id, value in trace.entries:
+        category, name = describe(trace, event, object_id)
+        if name not in ids:
+            ids[name] = len(ids)
+        label = isr_name(object_id) if category == 'isr' else object_name(trace, object_id)
+        stream += struct.pack('<BQHB', ids[name], cycles, object_id, value)
+        stream += label.encode('ascii', 'replace') + b'\0'
+
+    with open(os.path.join(output, 'metadata'), 'w') as f:
+        f.write(CTF_METADATA % {'clock': trace.clock, 'lost': trace.lost})
+        for name, number in sorted(ids.items(), key=lambda item: item[1]):
+            f.write(CTF_EVENT % (name, number))
+    with open(os.path.join(output, 'stream_0'), 'wb') as f:
+        f.write(stream)
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Convert the kernel trace dump to the Perfetto JSON or CTF.')
+    parser.add_argument('--format', choices=['json', 'ctf'], default='json')
+    parser.add_argument('-o', '--output')
+    parser.add_argument('log', nargs='?')
+    args = parser.parse_args(argv)
+
+    if args.log:
+        with open(args.log, errors='replace') as f:
+            trace = parse(f)
+    else:
+        trace = parse(sys.stdin)
+
+    if args.format == 'json':
+        output = args.output or 'trace.json'
+        to_json(trace, output)
+    else:
+        output = args.output or 'trace.ctf'
+        to_ctf(trace, output)
+
+    duration = (trace.entries[-1][0] - trace.entries[0][0]) * 1000.0 / trace.clock
+    print('traceconvert: %d entries, %.3f mS, %d lost -> %s' % (len(trace.entries), duration, trace.lost, output))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))